@@ -0,0 +1,584 @@
+/**
+ * @file    CCompletionIndex.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CCompletionIndex class
+ */
+
+#include <algorithm>
+#include <queue>
+
+#include "CCompletionIndex.hpp"
+#include "cpp_extensions.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+static const int sMaxNGramSize = 3;
+// removed entries are kept in the posting lists till the next compaction
+static const std::size_t sMinNumberOfDeadEntriesForCompaction = 4096u;
+
+CCompletionIndex::CCompletionIndex():
+mEntries(),
+mEntryIds(),
+mpTrieRoot(cpp_14::make_unique<tTrieNode>()),
+mNGramIndex(),
+mNumberOfAliveEntries(0u)
+{
+}
+
+CCompletionIndex::~CCompletionIndex()
+{
+}
+
+void CCompletionIndex::addWeight( const QString& str, const tWeight& delta )
+{
+    setWeight(str, getWeight(str) + delta);
+}
+
+void CCompletionIndex::setWeight( const QString& str, const tWeight& weight )
+{
+    if(true == str.isEmpty())
+    {
+        return;
+    }
+
+    auto foundEntryId = mEntryIds.find(str);
+
+    if(foundEntryId != mEntryIds.end())
+    {
+        const auto entryId = foundEntryId.value();
+
+        if(weight <= 0)
+        {
+            mEntryIds.erase(foundEntryId);
+            eraseEntry(entryId);
+            compactIfNeeded();
+        }
+        else
+        {
+            updateEntryWeight(entryId, weight);
+        }
+    }
+    else if(weight > 0)
+    {
+        tEntry entry;
+        entry.str = str;
+        entry.foldedStr = str.toCaseFolded();
+
+        if(entry.foldedStr == entry.str)
+        {
+            // share the data of the string
+            entry.foldedStr = entry.str;
+        }
+
+        entry.weight = weight;
+        entry.bAlive = true;
+
+        const auto entryId = static_cast<tEntryId>(mEntries.size());
+        mEntries.push_back(entry);
+        mEntryIds.insert(str, entryId);
+        insertEntry(entryId);
+    }
+}
+
+CCompletionIndex::tWeight CCompletionIndex::getWeight( const QString& str ) const
+{
+    tWeight result = 0;
+
+    auto foundEntryId = mEntryIds.find(str);
+
+    if(foundEntryId != mEntryIds.end())
+    {
+        result = mEntries[foundEntryId.value()].weight;
+    }
+
+    return result;
+}
+
+void CCompletionIndex::clear()
+{
+    std::vector<tEntry>().swap(mEntries);
+    mEntryIds.clear();
+    mpTrieRoot = cpp_14::make_unique<tTrieNode>();
+    tNGramIndex().swap(mNGramIndex);
+    mNumberOfAliveEntries = 0u;
+}
+
+std::size_t CCompletionIndex::size() const
+{
+    return mNumberOfAliveEntries;
+}
+
+bool CCompletionIndex::empty() const
+{
+    return 0u == mNumberOfAliveEntries;
+}
+
+QStringList CCompletionIndex::find( const QString& input,
+                                    const eSearchPolicy& searchPolicy,
+                                    const Qt::CaseSensitivity& caseSensitivity,
+                                    const int& maxNumberOfResults ) const
+{
+    QStringList result;
+
+    if(maxNumberOfResults > 0 && false == empty())
+    {
+        const QString foldedInput = input.toCaseFolded();
+
+        // empty input matches all strings, which is served faster by the trie
+        if(eSearchPolicy::eStartsWith == searchPolicy || true == input.isEmpty())
+        {
+            findStartsWith(input, foldedInput, caseSensitivity, maxNumberOfResults, result);
+        }
+        else
+        {
+            findContains(input, foldedInput, caseSensitivity, maxNumberOfResults, result);
+        }
+    }
+
+    return result;
+}
+
+void CCompletionIndex::insertEntry( const tEntryId& entryId )
+{
+    const auto& entry = mEntries[entryId];
+
+    auto pNode = findTrieNode(entry.foldedStr, true);
+
+    if(nullptr != pNode)
+    {
+        pNode->entries.push_back(entryId);
+        raiseMaxWeightOnPath(entry.foldedStr, entry.weight);
+    }
+
+    // short n-grams are indexed as well, so that the short input does not require the scan of all entries
+    for(int nGramSize = 1; nGramSize <= sMaxNGramSize; ++nGramSize)
+    {
+        for(const auto& nGram : getNGrams(entry.foldedStr, nGramSize))
+        {
+            mNGramIndex[nGram].push_back(entryId);
+        }
+    }
+
+    ++mNumberOfAliveEntries;
+}
+
+void CCompletionIndex::eraseEntry( const tEntryId& entryId )
+{
+    auto& entry = mEntries[entryId];
+
+    eraseFromTrie(mpTrieRoot.get(), entry.foldedStr, 0, entryId);
+
+    // posting lists are cleaned up lazily, during the compaction
+    entry.bAlive = false;
+    entry.weight = 0;
+    entry.str.clear();
+    entry.foldedStr.clear();
+
+    --mNumberOfAliveEntries;
+}
+
+void CCompletionIndex::updateEntryWeight( const tEntryId& entryId, const tWeight& weight )
+{
+    auto& entry = mEntries[entryId];
+    const auto prevWeight = entry.weight;
+    entry.weight = weight;
+
+    if(weight >= prevWeight)
+    {
+        raiseMaxWeightOnPath(entry.foldedStr, weight);
+    }
+    else
+    {
+        updateMaxWeightOnPath(mpTrieRoot.get(), entry.foldedStr, 0);
+    }
+}
+
+CCompletionIndex::tTrieNode* CCompletionIndex::findTrieNode( const QString& foldedKey, bool bCreate )
+{
+    tTrieNode* pNode = mpTrieRoot.get();
+    int offset = 0;
+
+    while(nullptr != pNode && offset < foldedKey.size())
+    {
+        auto foundChild = pNode->children.find(foldedKey[offset]);
+
+        if(foundChild == pNode->children.end())
+        {
+            if(false == bCreate)
+            {
+                return nullptr;
+            }
+
+            auto pNewNode = cpp_14::make_unique<tTrieNode>();
+            pNewNode->label = foldedKey.mid(offset);
+            auto pResult = pNewNode.get();
+            pNode->children.emplace(foldedKey[offset], std::move(pNewNode));
+            return pResult;
+        }
+
+        auto pChild = foundChild->second.get();
+        const auto& label = pChild->label;
+
+        int commonLength = 0;
+
+        while(commonLength < label.size() &&
+              offset + commonLength < foldedKey.size() &&
+              label[commonLength] == foldedKey[offset + commonLength])
+        {
+            ++commonLength;
+        }
+
+        if(commonLength < label.size())
+        {
+            if(false == bCreate)
+            {
+                return nullptr;
+            }
+
+            // split the edge, so that the key ends exactly at the node
+            auto pSplitNode = cpp_14::make_unique<tTrieNode>();
+            pSplitNode->label = label.left(commonLength);
+            pSplitNode->maxWeight = pChild->maxWeight;
+
+            std::unique_ptr<tTrieNode> pOldChild = std::move(foundChild->second);
+            pOldChild->label = pOldChild->label.mid(commonLength);
+            const QChar oldChildKey = pOldChild->label[0];
+            pSplitNode->children.emplace(oldChildKey, std::move(pOldChild));
+
+            foundChild->second = std::move(pSplitNode);
+            pChild = foundChild->second.get();
+        }
+
+        pNode = pChild;
+        offset += commonLength;
+    }
+
+    return pNode;
+}
+
+void CCompletionIndex::eraseFromTrie( tTrieNode* pNode, const QString& foldedKey, int offset, const tEntryId& entryId )
+{
+    if(nullptr == pNode)
+    {
+        return;
+    }
+
+    if(offset >= foldedKey.size())
+    {
+        auto foundEntry = std::find(pNode->entries.begin(), pNode->entries.end(), entryId);
+
+        if(foundEntry != pNode->entries.end())
+        {
+            pNode->entries.erase(foundEntry);
+        }
+    }
+    else
+    {
+        auto foundChild = pNode->children.find(foldedKey[offset]);
+
+        if(foundChild != pNode->children.end())
+        {
+            auto pChild = foundChild->second.get();
+
+            eraseFromTrie(pChild, foldedKey, offset + pChild->label.size(), entryId);
+
+            if(true == pChild->entries.empty())
+            {
+                if(true == pChild->children.empty())
+                {
+                    pNode->children.erase(foundChild);
+                }
+                else if(1u == pChild->children.size())
+                {
+                    // merge the edges to keep the trie compressed
+                    std::unique_ptr<tTrieNode> pGrandChild = std::move(pChild->children.begin()->second);
+                    pGrandChild->label.prepend(pChild->label);
+                    foundChild->second = std::move(pGrandChild);
+                }
+            }
+        }
+    }
+
+    updateMaxWeight(pNode);
+}
+
+void CCompletionIndex::raiseMaxWeightOnPath( const QString& foldedKey, const tWeight& weight )
+{
+    tTrieNode* pNode = mpTrieRoot.get();
+    int offset = 0;
+
+    while(nullptr != pNode)
+    {
+        pNode->maxWeight = std::max(pNode->maxWeight, weight);
+
+        if(offset >= foldedKey.size())
+        {
+            break;
+        }
+
+        auto foundChild = pNode->children.find(foldedKey[offset]);
+
+        if(foundChild == pNode->children.end())
+        {
+            break;
+        }
+
+        pNode = foundChild->second.get();
+        offset += pNode->label.size();
+    }
+}
+
+void CCompletionIndex::updateMaxWeightOnPath( tTrieNode* pNode, const QString& foldedKey, int offset )
+{
+    if(nullptr == pNode)
+    {
+        return;
+    }
+
+    if(offset < foldedKey.size())
+    {
+        auto foundChild = pNode->children.find(foldedKey[offset]);
+
+        if(foundChild != pNode->children.end())
+        {
+            auto pChild = foundChild->second.get();
+            updateMaxWeightOnPath(pChild, foldedKey, offset + pChild->label.size());
+        }
+    }
+
+    updateMaxWeight(pNode);
+}
+
+void CCompletionIndex::updateMaxWeight( tTrieNode* pNode ) const
+{
+    tWeight maxWeight = 0;
+
+    for(const auto& entryId : pNode->entries)
+    {
+        maxWeight = std::max(maxWeight, mEntries[entryId].weight);
+    }
+
+    for(const auto& child : pNode->children)
+    {
+        maxWeight = std::max(maxWeight, child.second->maxWeight);
+    }
+
+    pNode->maxWeight = maxWeight;
+}
+
+void CCompletionIndex::findStartsWith( const QString& input,
+                                       const QString& foldedInput,
+                                       const Qt::CaseSensitivity& caseSensitivity,
+                                       const int& maxNumberOfResults,
+                                       QStringList& result ) const
+{
+    // find the node, which sub-tree contains all keys with the specified prefix
+    const tTrieNode* pNode = mpTrieRoot.get();
+    int offset = 0;
+
+    while(offset < foldedInput.size())
+    {
+        auto foundChild = pNode->children.find(foldedInput[offset]);
+
+        if(foundChild == pNode->children.end())
+        {
+            return;
+        }
+
+        const auto pChild = foundChild->second.get();
+        const int comparedLength = std::min(pChild->label.size(), foldedInput.size() - offset);
+
+        for(int i = 0; i < comparedLength; ++i)
+        {
+            if(pChild->label[i] != foldedInput[offset + i])
+            {
+                return;
+            }
+        }
+
+        pNode = pChild;
+        offset += comparedLength;
+    }
+
+    // best-first traversal. Node's max weight is never less than the weight of any of its entries,
+    // so the entries are popped from the queue in the order of their weight.
+    struct tQueueItem
+    {
+        tWeight weight;
+        const tTrieNode* pNode; // nullptr for the entries
+        tEntryId entryId;
+
+        bool operator< (const tQueueItem& rhs) const
+        {
+            if(weight != rhs.weight)
+            {
+                return weight < rhs.weight;
+            }
+
+            // entries first, then the earlier added entries first
+            if((nullptr == pNode) != (nullptr == rhs.pNode))
+            {
+                return nullptr != pNode;
+            }
+
+            return entryId > rhs.entryId;
+        }
+    };
+
+    std::priority_queue<tQueueItem> queue;
+    queue.push(tQueueItem{pNode->maxWeight, pNode, 0u});
+
+    while(false == queue.empty() && result.size() < maxNumberOfResults)
+    {
+        const tQueueItem item = queue.top();
+        queue.pop();
+
+        if(nullptr != item.pNode)
+        {
+            for(const auto& entryId : item.pNode->entries)
+            {
+                queue.push(tQueueItem{mEntries[entryId].weight, nullptr, entryId});
+            }
+
+            for(const auto& child : item.pNode->children)
+            {
+                queue.push(tQueueItem{child.second->maxWeight, child.second.get(), 0u});
+            }
+        }
+        else
+        {
+            const auto& entry = mEntries[item.entryId];
+
+            if(Qt::CaseInsensitive == caseSensitivity ||
+               true == entry.str.startsWith(input, Qt::CaseSensitive))
+            {
+                result.push_back(entry.str);
+            }
+        }
+    }
+}
+
+void CCompletionIndex::findContains( const QString& input,
+                                     const QString& foldedInput,
+                                     const Qt::CaseSensitivity& caseSensitivity,
+                                     const int& maxNumberOfResults,
+                                     QStringList& result ) const
+{
+    typedef std::pair<tWeight, tEntryId> tCandidate;
+    std::vector<tCandidate> foundCandidates;
+
+    auto checkEntry = [this, &input, &foldedInput, &caseSensitivity, &foundCandidates](const tEntryId& entryId)
+    {
+        const auto& entry = mEntries[entryId];
+
+        if(true == entry.bAlive &&
+           true == entry.foldedStr.contains(foldedInput) &&
+           ( Qt::CaseInsensitive == caseSensitivity || true == entry.str.contains(input, Qt::CaseSensitive) ))
+        {
+            foundCandidates.push_back(std::make_pair(entry.weight, entryId));
+        }
+    };
+
+    // each candidate should contain all n-grams of the input, thus it is enough to check the shortest posting list
+    const tPostingList* pShortestPostingList = nullptr;
+
+    for(const auto& nGram : getNGrams(foldedInput, std::min<int>(foldedInput.size(), sMaxNGramSize)))
+    {
+        auto foundPostingList = mNGramIndex.find(nGram);
+
+        if(foundPostingList == mNGramIndex.end())
+        {
+            return;
+        }
+
+        if(nullptr == pShortestPostingList || foundPostingList->second.size() < pShortestPostingList->size())
+        {
+            pShortestPostingList = &foundPostingList->second;
+        }
+    }
+
+    if(nullptr != pShortestPostingList)
+    {
+        for(const auto& entryId : *pShortestPostingList)
+        {
+            checkEntry(entryId);
+        }
+    }
+
+    auto compareCandidates = [](const tCandidate& lhs, const tCandidate& rhs)
+    {
+        if(lhs.first != rhs.first)
+        {
+            return lhs.first > rhs.first;
+        }
+
+        return lhs.second < rhs.second;
+    };
+
+    const auto numberOfResults = std::min(foundCandidates.size(), static_cast<std::size_t>(maxNumberOfResults));
+
+    std::partial_sort(foundCandidates.begin(),
+                      foundCandidates.begin() + static_cast<std::ptrdiff_t>(numberOfResults),
+                      foundCandidates.end(),
+                      compareCandidates);
+
+    for(std::size_t i = 0u; i < numberOfResults; ++i)
+    {
+        result.push_back(mEntries[foundCandidates[i].second].str);
+    }
+}
+
+std::vector<CCompletionIndex::tNGram> CCompletionIndex::getNGrams( const QString& foldedStr, const int& nGramSize )
+{
+    std::vector<tNGram> result;
+
+    if(nGramSize > 0 && foldedStr.size() >= nGramSize)
+    {
+        result.reserve(static_cast<std::size_t>(foldedStr.size() - nGramSize + 1));
+
+        for(int i = 0; i + nGramSize <= foldedStr.size(); ++i)
+        {
+            // size of the n-gram occupies the highest bits, so that n-grams of different sizes never collide
+            tNGram nGram = static_cast<tNGram>(nGramSize);
+
+            for(int j = 0; j < nGramSize; ++j)
+            {
+                nGram = ( nGram << 16 ) | static_cast<tNGram>(foldedStr[i + j].unicode());
+            }
+
+            result.push_back(nGram);
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    return result;
+}
+
+void CCompletionIndex::compactIfNeeded()
+{
+    const auto numberOfDeadEntries = mEntries.size() - mNumberOfAliveEntries;
+
+    if(numberOfDeadEntries >= sMinNumberOfDeadEntriesForCompaction &&
+       numberOfDeadEntries > mNumberOfAliveEntries)
+    {
+        std::vector<tEntry> entries;
+        entries.swap(mEntries);
+
+        clear();
+
+        for(const auto& entry : entries)
+        {
+            if(true == entry.bAlive)
+            {
+                setWeight(entry.str, entry.weight);
+            }
+        }
+    }
+}
+
+PUML_PACKAGE_BEGIN(DMA_Common)
+    PUML_CLASS_BEGIN_CHECKED(CCompletionIndex)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
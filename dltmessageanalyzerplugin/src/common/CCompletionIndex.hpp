@@ -0,0 +1,143 @@
+/**
+ * @file    CCompletionIndex.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CCompletionIndex class
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "QString"
+#include "QStringList"
+#include "QHash"
+
+/**
+ * @brief The CCompletionIndex class - indexed collection of the completion strings.
+ * Each string has a weight, which is used to rank the search results. E.g. number of occurrences of the string.
+ * - search by prefix is served by the compressed prefix trie. Each node of the trie knows the max weight of its sub-tree,
+ * thus only the best ranked branches are visited in order to get top-K results.
+ * - search by sub-string is served by the index of the n-grams, from 1 up to 3 characters long. Input is split into
+ * the n-grams of the max available length, and only the strings from the shortest posting list are checked.
+ * Both indexes are built over the case folded strings. Case sensitive search additionally checks the original strings.
+ * Note! The class is not thread-safe.
+ */
+class CCompletionIndex
+{
+public:
+
+    typedef int64_t tWeight;
+
+    enum class eSearchPolicy
+    {
+        eStartsWith = 0,
+        eContains
+    };
+
+    CCompletionIndex();
+    ~CCompletionIndex();
+
+    /**
+     * @brief addWeight - adds the string to the index or changes the weight of the existing string.
+     * String is removed from the index, when its weight becomes less or equal to 0.
+     * @param str - string to be updated
+     * @param delta - value, which should be added to the weight of the string
+     */
+    void addWeight( const QString& str, const tWeight& delta = 1 );
+
+    /**
+     * @brief setWeight - sets the weight of the string. String is removed from the index, if weight is less or equal to 0.
+     * @param str - string to be updated
+     * @param weight - new weight of the string
+     */
+    void setWeight( const QString& str, const tWeight& weight );
+
+    /**
+     * @brief getWeight - gets the weight of the string
+     * @param str - string to be checked
+     * @return - weight of the string or 0, if there is no such string in the index
+     */
+    tWeight getWeight( const QString& str ) const;
+
+    void clear();
+    std::size_t size() const;
+    bool empty() const;
+
+    /**
+     * @brief find - finds the best ranked strings, which are matching the input
+     * @param input - input to be matched. Empty input matches all strings
+     * @param searchPolicy - whether the string should start with the input or just contain it
+     * @param caseSensitivity - case sensitivity of the search
+     * @param maxNumberOfResults - max number of the returned strings
+     * @return - found strings, sorted by their weight in descending order
+     */
+    QStringList find( const QString& input,
+                      const eSearchPolicy& searchPolicy,
+                      const Qt::CaseSensitivity& caseSensitivity,
+                      const int& maxNumberOfResults ) const;
+
+private:
+
+    typedef uint32_t tEntryId;
+    typedef uint64_t tNGram;
+
+    struct tEntry
+    {
+        QString str;
+        QString foldedStr;
+        tWeight weight = 0;
+        bool bAlive = false;
+    };
+
+    struct tTrieNode
+    {
+        // part of the key between the parent and this node
+        QString label;
+        std::map<QChar, std::unique_ptr<tTrieNode>> children;
+        // entries, which case folded key ends at this node
+        std::vector<tEntryId> entries;
+        // max weight of the entries within the whole sub-tree
+        tWeight maxWeight = 0;
+    };
+
+    typedef std::vector<tEntryId> tPostingList;
+    typedef std::unordered_map<tNGram, tPostingList> tNGramIndex;
+
+    void insertEntry( const tEntryId& entryId );
+    void eraseEntry( const tEntryId& entryId );
+    void updateEntryWeight( const tEntryId& entryId, const tWeight& weight );
+
+    tTrieNode* findTrieNode( const QString& foldedKey, bool bCreate );
+    void eraseFromTrie( tTrieNode* pNode, const QString& foldedKey, int offset, const tEntryId& entryId );
+    void raiseMaxWeightOnPath( const QString& foldedKey, const tWeight& weight );
+    void updateMaxWeightOnPath( tTrieNode* pNode, const QString& foldedKey, int offset );
+    void updateMaxWeight( tTrieNode* pNode ) const;
+
+    void findStartsWith( const QString& input,
+                         const QString& foldedInput,
+                         const Qt::CaseSensitivity& caseSensitivity,
+                         const int& maxNumberOfResults,
+                         QStringList& result ) const;
+
+    void findContains( const QString& input,
+                       const QString& foldedInput,
+                       const Qt::CaseSensitivity& caseSensitivity,
+                       const int& maxNumberOfResults,
+                       QStringList& result ) const;
+
+    static std::vector<tNGram> getNGrams( const QString& foldedStr, const int& nGramSize );
+
+    void compactIfNeeded();
+
+private:
+
+    std::vector<tEntry> mEntries;
+    QHash<QString, tEntryId> mEntryIds;
+    std::unique_ptr<tTrieNode> mpTrieRoot;
+    tNGramIndex mNGramIndex;
+    std::size_t mNumberOfAliveEntries;
+};
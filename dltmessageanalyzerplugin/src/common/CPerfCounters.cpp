@@ -0,0 +1,464 @@
+/**
+ * @file    CPerfCounters.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CPerfCounters class
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#include "QThread"
+#include "QCoreApplication"
+#include "QFile"
+#include "QTextStream"
+
+#include "CPerfCounters.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+static const std::size_t sMaxTraceEventsPerThread = 16384u;
+static const std::size_t sNumberOfStages = static_cast<std::size_t>(ePerfStage::eLast);
+static const std::chrono::steady_clock::time_point sStartTimePoint = std::chrono::steady_clock::now();
+
+QString getPerfStageName( const ePerfStage& stage )
+{
+    QString result;
+
+    switch(stage)
+    {
+        case ePerfStage::eChunkStringBuilding: result = "ChunkStringBuilding"; break;
+        case ePerfStage::eQueueWait: result = "QueueWait"; break;
+        case ePerfStage::eRegexMatch: result = "RegexMatch"; break;
+        case ePerfStage::eHighlighting: result = "Highlighting"; break;
+        case ePerfStage::eUMLExtraction: result = "UMLExtraction"; break;
+        case ePerfStage::ePlotViewExtraction: result = "PlotViewExtraction"; break;
+        case ePerfStage::eGUIDelivery: result = "GUIDelivery"; break;
+        case ePerfStage::eModelInsertion: result = "ModelInsertion"; break;
+        case ePerfStage::eLast: result = "Unknown"; break;
+    }
+
+    return result;
+}
+
+static int getHistogramBucket( const CPerfCounters::tDurationNs& durationNs )
+{
+    int result = 0;
+
+    uint64_t value = durationNs > 0 ? static_cast<uint64_t>(durationNs) : 0u;
+
+    while(0u != value && result < CPerfCounters::sNumberOfHistogramBuckets - 1)
+    {
+        value >>= 1;
+        ++result;
+    }
+
+    return result;
+}
+
+struct tTraceEvent
+{
+    ePerfStage stage;
+    CPerfCounters::tTimestampNs startNs;
+    CPerfCounters::tDurationNs durationNs;
+};
+
+struct CPerfCounters::tThreadData
+{
+    struct tAtomicStageStats
+    {
+        std::atomic<uint64_t> count;
+        std::atomic<int64_t> totalNs;
+        std::atomic<int64_t> maxNs;
+        std::array<std::atomic<uint64_t>, sNumberOfHistogramBuckets> histogram;
+    };
+
+    tThreadData(int threadIndex_, const QString& threadName_):
+        threadIndex(threadIndex_),
+        threadName(threadName_),
+        bInUse(true),
+        stages(),
+        eventsMutex(),
+        events(),
+        nextEventIdx(0u)
+    {
+        resetStats();
+    }
+
+    void resetStats()
+    {
+        for(auto& stageStats : stages)
+        {
+            stageStats.count.store(0u, std::memory_order_relaxed);
+            stageStats.totalNs.store(0, std::memory_order_relaxed);
+            stageStats.maxNs.store(0, std::memory_order_relaxed);
+
+            for(auto& bucket : stageStats.histogram)
+            {
+                bucket.store(0u, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    tStagesStats getStats() const
+    {
+        tStagesStats result;
+
+        for(std::size_t i = 0; i < sNumberOfStages; ++i)
+        {
+            const auto& source = stages[i];
+            auto& target = result[i];
+
+            target.count = source.count.load(std::memory_order_relaxed);
+            target.totalNs = source.totalNs.load(std::memory_order_relaxed);
+            target.maxNs = source.maxNs.load(std::memory_order_relaxed);
+
+            for(int j = 0; j < sNumberOfHistogramBuckets; ++j)
+            {
+                target.histogram[static_cast<std::size_t>(j)] =
+                    source.histogram[static_cast<std::size_t>(j)].load(std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    }
+
+    int threadIndex;
+    // name and usage flag are guarded by the threads mutex of CPerfCounters
+    QString threadName;
+    bool bInUse;
+    // written only by the owner thread. Atomics are used to allow the consistent reading from the console
+    std::array<tAtomicStageStats, sNumberOfStages> stages;
+    // ring buffer of the recent trace events. Mutex is contended only during the export
+    mutable std::mutex eventsMutex;
+    std::vector<tTraceEvent> events;
+    std::size_t nextEventIdx;
+};
+
+/**
+ * @brief The tThreadDataHolder struct - returns the counters of the thread to CPerfCounters on the thread's exit
+ */
+struct tThreadDataHolder
+{
+    ~tThreadDataHolder()
+    {
+        if(nullptr != pThreadData)
+        {
+            CPerfCounters::getInstance().releaseThreadData(pThreadData);
+        }
+    }
+
+    CPerfCounters::tThreadDataPtr pThreadData;
+};
+
+static thread_local tThreadDataHolder tlThreadDataHolder;
+
+CPerfCounters::tDurationNs CPerfCounters::tStageStats::getPercentileNs( double percentile ) const
+{
+    tDurationNs result = 0;
+
+    if(0u != count)
+    {
+        const double boundedPercentile = qBound(0.0, percentile, 100.0);
+        uint64_t targetCount = static_cast<uint64_t>( std::ceil( static_cast<double>(count) * boundedPercentile / 100.0 ) );
+
+        if(0u == targetCount)
+        {
+            targetCount = 1u;
+        }
+
+        uint64_t cumulativeCount = 0u;
+
+        for(int i = 0; i < sNumberOfHistogramBuckets; ++i)
+        {
+            cumulativeCount += histogram[static_cast<std::size_t>(i)];
+
+            if(cumulativeCount >= targetCount)
+            {
+                result = 0 == i ? 0 : qMin( static_cast<tDurationNs>(1) << i, maxNs );
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+CPerfCounters& CPerfCounters::getInstance()
+{
+    static CPerfCounters sInstance;
+    return sInstance;
+}
+
+CPerfCounters::CPerfCounters():
+    mThreadsMutex(),
+    mThreads()
+{
+}
+
+CPerfCounters::tTimestampNs CPerfCounters::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - sStartTimePoint ).count();
+}
+
+CPerfCounters::tThreadDataPtr CPerfCounters::createThreadData()
+{
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+
+    tThreadDataPtr pThreadData;
+
+    for(const auto& pReleasedThreadData : mThreads)
+    {
+        if(false == pReleasedThreadData->bInUse)
+        {
+            pThreadData = pReleasedThreadData;
+            break;
+        }
+    }
+
+    const int threadIndex = nullptr != pThreadData ? pThreadData->threadIndex : static_cast<int>(mThreads.size());
+
+    QThread* pCurrentThread = QThread::currentThread();
+    QString threadName = nullptr != pCurrentThread ? pCurrentThread->objectName() : QString();
+
+    if(true == threadName.isEmpty())
+    {
+        if(nullptr != QCoreApplication::instance() &&
+           pCurrentThread == QCoreApplication::instance()->thread())
+        {
+            threadName = "Main";
+        }
+        else
+        {
+            threadName = QString("Thread_%1").arg(threadIndex);
+        }
+    }
+
+    if(nullptr != pThreadData)
+    {
+        // counters of the exited thread are continued by the new one
+        pThreadData->threadName = threadName;
+        pThreadData->bInUse = true;
+    }
+    else
+    {
+        pThreadData = std::make_shared<tThreadData>(threadIndex, threadName);
+        mThreads.push_back(pThreadData);
+    }
+
+    return pThreadData;
+}
+
+void CPerfCounters::releaseThreadData( const tThreadDataPtr& pThreadData )
+{
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+    pThreadData->bInUse = false;
+}
+
+void CPerfCounters::record( const ePerfStage& stage, const tTimestampNs& startNs, const tDurationNs& durationNs )
+{
+    if(stage == ePerfStage::eLast)
+    {
+        return;
+    }
+
+    auto& pThreadData = tlThreadDataHolder.pThreadData;
+
+    if(nullptr == pThreadData)
+    {
+        pThreadData = createThreadData();
+    }
+
+    auto& stageStats = pThreadData->stages[static_cast<std::size_t>(stage)];
+
+    stageStats.count.fetch_add(1u, std::memory_order_relaxed);
+    stageStats.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+
+    if(durationNs > stageStats.maxNs.load(std::memory_order_relaxed))
+    {
+        stageStats.maxNs.store(durationNs, std::memory_order_relaxed);
+    }
+
+    stageStats.histogram[static_cast<std::size_t>(getHistogramBucket(durationNs))].fetch_add(1u, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(pThreadData->eventsMutex);
+
+        auto& events = pThreadData->events;
+        tTraceEvent traceEvent{stage, startNs, durationNs};
+
+        if(events.size() < sMaxTraceEventsPerThread)
+        {
+            events.push_back(traceEvent);
+        }
+        else
+        {
+            events[pThreadData->nextEventIdx] = traceEvent;
+        }
+
+        pThreadData->nextEventIdx = ( pThreadData->nextEventIdx + 1u ) % sMaxTraceEventsPerThread;
+    }
+}
+
+CPerfCounters::tThreadStatsVec CPerfCounters::getThreadStats() const
+{
+    tThreadStatsVec result;
+
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+
+    result.reserve(mThreads.size());
+
+    for(const auto& pThreadData : mThreads)
+    {
+        tThreadStats threadStats;
+        threadStats.threadIndex = pThreadData->threadIndex;
+        threadStats.threadName = pThreadData->threadName;
+        threadStats.stagesStats = pThreadData->getStats();
+        result.push_back(threadStats);
+    }
+
+    return result;
+}
+
+CPerfCounters::tStagesStats CPerfCounters::getAggregatedStats() const
+{
+    tStagesStats result;
+
+    const auto threadStatsVec = getThreadStats();
+
+    for(const auto& threadStats : threadStatsVec)
+    {
+        for(std::size_t i = 0; i < sNumberOfStages; ++i)
+        {
+            const auto& source = threadStats.stagesStats[i];
+            auto& target = result[i];
+
+            target.count += source.count;
+            target.totalNs += source.totalNs;
+            target.maxNs = qMax(target.maxNs, source.maxNs);
+
+            for(std::size_t j = 0; j < target.histogram.size(); ++j)
+            {
+                target.histogram[j] += source.histogram[j];
+            }
+        }
+    }
+
+    return result;
+}
+
+void CPerfCounters::reset()
+{
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+
+    for(const auto& pThreadData : mThreads)
+    {
+        pThreadData->resetStats();
+
+        std::lock_guard<std::mutex> eventsLock(pThreadData->eventsMutex);
+        pThreadData->events.clear();
+        pThreadData->nextEventIdx = 0u;
+    }
+}
+
+int CPerfCounters::exportChromeTrace( const QString& filePath ) const
+{
+    QFile file(filePath);
+
+    if(false == file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        return -1;
+    }
+
+    auto toUs = [](const int64_t& ns)
+    {
+        return QString::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+    };
+
+    QTextStream stream(&file);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    int numberOfEvents = 0;
+    bool bFirstEvent = true;
+
+    auto separator = [&bFirstEvent]()
+    {
+        QString result = true == bFirstEvent ? "\n" : ",\n";
+        bFirstEvent = false;
+        return result;
+    };
+
+    std::vector<std::pair<tThreadDataPtr, QString /*thread name*/>> threads;
+
+    {
+        std::lock_guard<std::mutex> lock(mThreadsMutex);
+
+        for(const auto& pThreadData : mThreads)
+        {
+            threads.push_back(std::make_pair(pThreadData, pThreadData->threadName));
+        }
+    }
+
+    for(const auto& thread : threads)
+    {
+        const auto& pThreadData = thread.first;
+
+        std::vector<tTraceEvent> events;
+        std::size_t nextEventIdx = 0u;
+
+        {
+            std::lock_guard<std::mutex> eventsLock(pThreadData->eventsMutex);
+            events = pThreadData->events;
+            nextEventIdx = pThreadData->nextEventIdx;
+        }
+
+        QString escapedThreadName = thread.second;
+        escapedThreadName.replace("\\", "\\\\").replace("\"", "\\\"");
+
+        stream << separator()
+               << QString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%1,\"args\":{\"name\":\"%2\"}}")
+                  .arg(pThreadData->threadIndex)
+                  .arg(escapedThreadName);
+
+        // in case if the ring buffer is full, the oldest event is located at the next write position
+        const std::size_t firstEventIdx = events.size() < sMaxTraceEventsPerThread ? 0u : nextEventIdx;
+
+        for(std::size_t i = 0; i < events.size(); ++i)
+        {
+            const auto& event = events[( firstEventIdx + i ) % events.size()];
+
+            stream << separator()
+                   << QString("{\"name\":\"%1\",\"cat\":\"DMA\",\"ph\":\"X\",\"pid\":1,\"tid\":%2,\"ts\":%3,\"dur\":%4}")
+                      .arg(getPerfStageName(event.stage))
+                      .arg(pThreadData->threadIndex)
+                      .arg(toUs(event.startNs))
+                      .arg(toUs(event.durationNs));
+
+            ++numberOfEvents;
+        }
+    }
+
+    stream << "\n]}\n";
+    stream.flush();
+
+    return QFile::NoError == file.error() ? numberOfEvents : -1;
+}
+
+CPerfScope::CPerfScope( const ePerfStage& stage ):
+    mStage(stage),
+    mStartNs(CPerfCounters::now())
+{
+}
+
+CPerfScope::~CPerfScope()
+{
+    CPerfCounters::getInstance().record(mStage, mStartNs, CPerfCounters::now() - mStartNs);
+}
+
+PUML_PACKAGE_BEGIN(DMA_Common)
+    PUML_CLASS_BEGIN_CHECKED(CPerfCounters)
+    PUML_CLASS_END()
+    PUML_CLASS_BEGIN_CHECKED(CPerfScope)
+        PUML_USE_DEPENDENCY_CHECKED(CPerfCounters, 1, 1, records samples)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
@@ -0,0 +1,158 @@
+/**
+ * @file    CPerfCounters.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CPerfCounters class
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "QString"
+
+/**
+ * @brief The ePerfStage enum - stages of the analysis pipeline, which are measured by CPerfCounters
+ */
+enum class ePerfStage
+{
+    eChunkStringBuilding = 0, // forming of the analyzed strings of the chunk. Main thread
+    eQueueWait,               // time between posting of the chunk and start of its analysis. Worker thread
+    eRegexMatch,              // regex matching of the whole chunk. Worker thread
+    eHighlighting,            // calculation of the highlighting ranges of the whole chunk. Worker thread
+    eUMLExtraction,           // extraction of the UML data of the whole chunk. Worker thread
+    ePlotViewExtraction,      // extraction of the plot view data of the whole chunk. Worker thread
+    eGUIDelivery,             // time between the end of the chunk's analysis and its receiving in the main thread
+    eModelInsertion,          // insertion of the received matches into the models. Main thread
+    eLast
+};
+
+/**
+ * @brief getPerfStageName - gets the human-readable name of the stage
+ * @param stage - the stage
+ * @return - name of the stage
+ */
+QString getPerfStageName( const ePerfStage& stage );
+
+/**
+ * @brief The CPerfCounters class - always-on lightweight instrumentation of the analysis pipeline.
+ * Each thread writes only to its own counters, thus measurements do not contend with each other.
+ * For each stage the number of samples, total and max duration and the log2 histogram of durations are collected.
+ * Recent samples are additionally kept in the bounded per-thread ring buffers and can be exported as Chrome trace JSON,
+ * which can be opened in chrome://tracing or https://ui.perfetto.dev for the timeline analysis.
+ * Counters of the exited thread are recycled by the next new thread, which continues to accumulate them.
+ * Thus memory is bounded by the max number of the simultaneously recording threads, even if the worker threads
+ * are re-created on each analysis.
+ * Note! Samples are expected to be recorded per chunk or per notification, not per message.
+ */
+class CPerfCounters
+{
+public:
+
+    typedef int64_t tTimestampNs;
+    typedef int64_t tDurationNs;
+
+    // bucket i contains samples with duration in range [2^(i-1), 2^i) ns. Bucket 0 contains zero durations
+    static const int sNumberOfHistogramBuckets = 48;
+    typedef std::array<uint64_t, sNumberOfHistogramBuckets> tHistogram;
+
+    struct tStageStats
+    {
+        uint64_t count = 0u;
+        tDurationNs totalNs = 0;
+        tDurationNs maxNs = 0;
+        tHistogram histogram = {};
+
+        /**
+         * @brief getPercentileNs - estimates the percentile of the durations from the histogram
+         * @param percentile - value in range [0, 100]
+         * @return - upper bound of the histogram bucket, which contains the percentile. Limited by maxNs
+         */
+        tDurationNs getPercentileNs( double percentile ) const;
+    };
+
+    typedef std::array<tStageStats, static_cast<std::size_t>(ePerfStage::eLast)> tStagesStats;
+
+    struct tThreadStats
+    {
+        int threadIndex = 0;
+        QString threadName;
+        tStagesStats stagesStats;
+    };
+
+    typedef std::vector<tThreadStats> tThreadStatsVec;
+
+    static CPerfCounters& getInstance();
+
+    /**
+     * @brief now - gets the monotonic timestamp, which should be used as the start of the measured samples
+     * @return - nanoseconds since the start of the process
+     */
+    static tTimestampNs now();
+
+    /**
+     * @brief record - records the sample to the counters of the calling thread
+     * @param stage - measured stage
+     * @param startNs - timestamp of the start of the sample, obtained from now()
+     * @param durationNs - duration of the sample
+     */
+    void record( const ePerfStage& stage, const tTimestampNs& startNs, const tDurationNs& durationNs );
+
+    /**
+     * @brief getThreadStats - gets the snapshot of the counters of each thread, which has recorded at least one sample
+     * @return - per-thread stats
+     */
+    tThreadStatsVec getThreadStats() const;
+
+    /**
+     * @brief getAggregatedStats - gets the snapshot of the counters, merged over all threads
+     * @return - per-stage stats
+     */
+    tStagesStats getAggregatedStats() const;
+
+    /**
+     * @brief reset - drops all collected counters and trace events
+     */
+    void reset();
+
+    /**
+     * @brief exportChromeTrace - stores the collected trace events in the Chrome trace event format
+     * @param filePath - path to the target file
+     * @return - number of the exported events or -1 in case of an error
+     */
+    int exportChromeTrace( const QString& filePath ) const;
+
+    struct tThreadData;
+    typedef std::shared_ptr<tThreadData> tThreadDataPtr;
+
+private:
+    CPerfCounters();
+    tThreadDataPtr createThreadData();
+    void releaseThreadData( const tThreadDataPtr& pThreadData );
+
+    friend struct tThreadDataHolder;
+
+private:
+    mutable std::mutex mThreadsMutex;
+    std::vector<tThreadDataPtr> mThreads;
+};
+
+/**
+ * @brief The CPerfScope class - records the lifetime of the scope as the sample of the stage
+ */
+class CPerfScope
+{
+public:
+    explicit CPerfScope( const ePerfStage& stage );
+    ~CPerfScope();
+
+    CPerfScope( const CPerfScope& ) = delete;
+    CPerfScope& operator=( const CPerfScope& ) = delete;
+
+private:
+    ePerfStage mStage;
+    CPerfCounters::tTimestampNs mStartNs;
+};
@@ -0,0 +1,553 @@
+/**
+ * @file    CRoaringBitmap.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CRoaringBitmap class
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+
+#include "CRoaringBitmap.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+// array container with more values occupies more memory than the bitmap one
+static const uint32_t sArrayContainerMaxSize = 4096u;
+static const std::size_t sBitmapContainerNumberOfWords = 65536u / 64u;
+
+//tContainer
+bool CRoaringBitmap::tContainer::isBitmap() const
+{
+    return false == bitmap.empty();
+}
+
+bool CRoaringBitmap::tContainer::contains( const uint16_t& lowBits ) const
+{
+    bool bResult = false;
+
+    if(true == isBitmap())
+    {
+        bResult = 0u != ( bitmap[lowBits >> 6] & ( static_cast<uint64_t>(1u) << ( lowBits & 63u ) ) );
+    }
+    else
+    {
+        bResult = std::binary_search(array.begin(), array.end(), lowBits);
+    }
+
+    return bResult;
+}
+
+bool CRoaringBitmap::tContainer::add( const uint16_t& lowBits )
+{
+    bool bResult = false;
+
+    if(true == isBitmap())
+    {
+        auto& word = bitmap[lowBits >> 6];
+        const uint64_t mask = static_cast<uint64_t>(1u) << ( lowBits & 63u );
+
+        if(0u == ( word & mask ))
+        {
+            word |= mask;
+            bResult = true;
+        }
+    }
+    else
+    {
+        if(true == array.empty() || array.back() < lowBits)
+        {
+            // fast path for the ascending order
+            array.push_back(lowBits);
+            bResult = true;
+        }
+        else
+        {
+            auto it = std::lower_bound(array.begin(), array.end(), lowBits);
+
+            if(it == array.end() || *it != lowBits)
+            {
+                array.insert(it, lowBits);
+                bResult = true;
+            }
+        }
+    }
+
+    if(true == bResult)
+    {
+        ++cardinality;
+
+        if(false == isBitmap() && cardinality > sArrayContainerMaxSize)
+        {
+            convertToBitmap();
+        }
+    }
+
+    return bResult;
+}
+
+bool CRoaringBitmap::tContainer::remove( const uint16_t& lowBits )
+{
+    bool bResult = false;
+
+    if(true == isBitmap())
+    {
+        auto& word = bitmap[lowBits >> 6];
+        const uint64_t mask = static_cast<uint64_t>(1u) << ( lowBits & 63u );
+
+        if(0u != ( word & mask ))
+        {
+            word &= ~mask;
+            bResult = true;
+        }
+    }
+    else
+    {
+        auto it = std::lower_bound(array.begin(), array.end(), lowBits);
+
+        if(it != array.end() && *it == lowBits)
+        {
+            array.erase(it);
+            bResult = true;
+        }
+    }
+
+    if(true == bResult)
+    {
+        --cardinality;
+
+        if(true == isBitmap() && cardinality <= sArrayContainerMaxSize)
+        {
+            convertToArray();
+        }
+    }
+
+    return bResult;
+}
+
+uint32_t CRoaringBitmap::tContainer::rank( const uint16_t& lowBits ) const
+{
+    uint32_t result = 0u;
+
+    if(true == isBitmap())
+    {
+        const std::size_t wordIdx = lowBits >> 6;
+
+        for(std::size_t i = 0u; i < wordIdx; ++i)
+        {
+            result += popCount(bitmap[i]);
+        }
+
+        const uint64_t mask = ( static_cast<uint64_t>(1u) << ( lowBits & 63u ) ) - 1u;
+        result += popCount(bitmap[wordIdx] & mask);
+    }
+    else
+    {
+        result = static_cast<uint32_t>( std::lower_bound(array.begin(), array.end(), lowBits) - array.begin() );
+    }
+
+    return result;
+}
+
+uint16_t CRoaringBitmap::tContainer::select( const uint32_t& idx ) const
+{
+    uint16_t result = 0u;
+
+    if(true == isBitmap())
+    {
+        uint32_t remaining = idx;
+
+        for(std::size_t wordIdx = 0u; wordIdx < bitmap.size(); ++wordIdx)
+        {
+            uint64_t word = bitmap[wordIdx];
+            const uint32_t wordCardinality = popCount(word);
+
+            if(remaining < wordCardinality)
+            {
+                for(; 0u != remaining; --remaining)
+                {
+                    word &= word - 1u;
+                }
+
+                result = static_cast<uint16_t>( wordIdx * 64u + countTrailingZeros(word) );
+                break;
+            }
+
+            remaining -= wordCardinality;
+        }
+    }
+    else
+    {
+        result = array[idx];
+    }
+
+    return result;
+}
+
+void CRoaringBitmap::tContainer::convertToBitmap()
+{
+    bitmap.assign(sBitmapContainerNumberOfWords, 0u);
+
+    for(const auto& lowBits : array)
+    {
+        bitmap[lowBits >> 6] |= static_cast<uint64_t>(1u) << ( lowBits & 63u );
+    }
+
+    std::vector<uint16_t>().swap(array);
+}
+
+void CRoaringBitmap::tContainer::convertToArray()
+{
+    std::vector<uint16_t> newArray;
+    newArray.reserve(cardinality);
+
+    for(std::size_t wordIdx = 0u; wordIdx < bitmap.size(); ++wordIdx)
+    {
+        uint64_t word = bitmap[wordIdx];
+
+        while(0u != word)
+        {
+            newArray.push_back(static_cast<uint16_t>( wordIdx * 64u + countTrailingZeros(word) ));
+            word &= word - 1u;
+        }
+    }
+
+    array.swap(newArray);
+    std::vector<uint64_t>().swap(bitmap);
+}
+
+void CRoaringBitmap::tContainer::unite( const tContainer& rhs )
+{
+    if(false == isBitmap() && false == rhs.isBitmap())
+    {
+        std::vector<uint16_t> newArray;
+        newArray.reserve(array.size() + rhs.array.size());
+        std::set_union(array.begin(), array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(newArray));
+        array.swap(newArray);
+        cardinality = static_cast<uint32_t>(array.size());
+
+        if(cardinality > sArrayContainerMaxSize)
+        {
+            convertToBitmap();
+        }
+    }
+    else
+    {
+        if(false == isBitmap())
+        {
+            convertToBitmap();
+        }
+
+        if(true == rhs.isBitmap())
+        {
+            for(std::size_t wordIdx = 0u; wordIdx < bitmap.size(); ++wordIdx)
+            {
+                bitmap[wordIdx] |= rhs.bitmap[wordIdx];
+            }
+        }
+        else
+        {
+            for(const auto& lowBits : rhs.array)
+            {
+                bitmap[lowBits >> 6] |= static_cast<uint64_t>(1u) << ( lowBits & 63u );
+            }
+        }
+
+        cardinality = 0u;
+
+        for(const auto& word : bitmap)
+        {
+            cardinality += popCount(word);
+        }
+    }
+}
+
+//CRoaringBitmap
+CRoaringBitmap::CRoaringBitmap():
+    mContainers(),
+    mCumulativeCardinality(),
+    mbCumulativeCardinalityDirty(false),
+    mSize(0u)
+{
+}
+
+CRoaringBitmap::tContainers::iterator CRoaringBitmap::findContainer( const uint16_t& key )
+{
+    if(false == mContainers.empty() && mContainers.back().key == key)
+    {
+        return mContainers.end() - 1;
+    }
+
+    return std::lower_bound(mContainers.begin(), mContainers.end(), key,
+                            [](const tContainer& container, const uint16_t& key_){ return container.key < key_; });
+}
+
+CRoaringBitmap::tContainers::const_iterator CRoaringBitmap::findContainer( const uint16_t& key ) const
+{
+    if(false == mContainers.empty() && mContainers.back().key == key)
+    {
+        return mContainers.end() - 1;
+    }
+
+    return std::lower_bound(mContainers.begin(), mContainers.end(), key,
+                            [](const tContainer& container, const uint16_t& key_){ return container.key < key_; });
+}
+
+void CRoaringBitmap::add( const tValue& value )
+{
+    const uint16_t key = static_cast<uint16_t>(value >> 16);
+
+    auto it = findContainer(key);
+
+    if(it == mContainers.end() || it->key != key)
+    {
+        tContainer container;
+        container.key = key;
+        it = mContainers.insert(it, std::move(container));
+        mbCumulativeCardinalityDirty = true;
+    }
+
+    if(true == it->add(static_cast<uint16_t>(value & 0xffffu)))
+    {
+        ++mSize;
+        mbCumulativeCardinalityDirty = mbCumulativeCardinalityDirty || ( it != mContainers.end() - 1 );
+    }
+}
+
+void CRoaringBitmap::remove( const tValue& value )
+{
+    const uint16_t key = static_cast<uint16_t>(value >> 16);
+
+    auto it = findContainer(key);
+
+    if(it != mContainers.end() && it->key == key)
+    {
+        if(true == it->remove(static_cast<uint16_t>(value & 0xffffu)))
+        {
+            --mSize;
+
+            if(0u == it->cardinality)
+            {
+                mContainers.erase(it);
+            }
+
+            mbCumulativeCardinalityDirty = true;
+        }
+    }
+}
+
+bool CRoaringBitmap::contains( const tValue& value ) const
+{
+    const uint16_t key = static_cast<uint16_t>(value >> 16);
+
+    auto it = findContainer(key);
+
+    return it != mContainers.end() && it->key == key && it->contains(static_cast<uint16_t>(value & 0xffffu));
+}
+
+std::size_t CRoaringBitmap::size() const
+{
+    return mSize;
+}
+
+bool CRoaringBitmap::empty() const
+{
+    return 0u == mSize;
+}
+
+void CRoaringBitmap::clear()
+{
+    mContainers.clear();
+    mCumulativeCardinality.clear();
+    mbCumulativeCardinalityDirty = false;
+    mSize = 0u;
+}
+
+void CRoaringBitmap::updateCumulativeCardinality() const
+{
+    // growth of the last container does not affect the preceding ones
+    if(true == mbCumulativeCardinalityDirty || mCumulativeCardinality.size() != mContainers.size())
+    {
+        mCumulativeCardinality.resize(mContainers.size());
+
+        std::size_t cumulativeCardinality = 0u;
+
+        for(std::size_t i = 0u; i < mContainers.size(); ++i)
+        {
+            mCumulativeCardinality[i] = cumulativeCardinality;
+            cumulativeCardinality += mContainers[i].cardinality;
+        }
+
+        mbCumulativeCardinalityDirty = false;
+    }
+}
+
+std::size_t CRoaringBitmap::rank( const tValue& value ) const
+{
+    updateCumulativeCardinality();
+
+    std::size_t result = 0u;
+
+    const uint16_t key = static_cast<uint16_t>(value >> 16);
+
+    auto it = findContainer(key);
+
+    if(it == mContainers.end())
+    {
+        result = mSize;
+    }
+    else
+    {
+        result = mCumulativeCardinality[static_cast<std::size_t>(it - mContainers.begin())];
+
+        if(it->key == key)
+        {
+            result += it->rank(static_cast<uint16_t>(value & 0xffffu));
+        }
+    }
+
+    return result;
+}
+
+bool CRoaringBitmap::select( const std::size_t& idx, tValue& value ) const
+{
+    bool bResult = false;
+
+    if(idx < mSize)
+    {
+        updateCumulativeCardinality();
+
+        // last container, which starts at or before idx
+        auto it = std::upper_bound(mCumulativeCardinality.begin(), mCumulativeCardinality.end(), idx);
+        const std::size_t containerIdx = static_cast<std::size_t>( it - mCumulativeCardinality.begin() ) - 1u;
+        const auto& container = mContainers[containerIdx];
+
+        value = ( static_cast<tValue>(container.key) << 16 ) |
+                container.select( static_cast<uint32_t>( idx - mCumulativeCardinality[containerIdx] ) );
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+bool CRoaringBitmap::findNext( const tValue& value, tValue& nextValue ) const
+{
+    bool bResult = false;
+
+    if(value != UINT32_MAX)
+    {
+        // number of values, which are less or equal to the provided one, is the position of the next value
+        bResult = select(rank(value + 1u), nextValue);
+    }
+
+    return bResult;
+}
+
+bool CRoaringBitmap::findPrevious( const tValue& value, tValue& previousValue ) const
+{
+    bool bResult = false;
+
+    const std::size_t valueRank = rank(value);
+
+    if(0u != valueRank)
+    {
+        bResult = select(valueRank - 1u, previousValue);
+    }
+
+    return bResult;
+}
+
+void CRoaringBitmap::unite( const CRoaringBitmap& rhs )
+{
+    if(this == &rhs || true == rhs.empty())
+    {
+        return;
+    }
+
+    tContainers newContainers;
+    newContainers.reserve(mContainers.size() + rhs.mContainers.size());
+
+    auto lhsIt = mContainers.begin();
+    auto rhsIt = rhs.mContainers.begin();
+
+    while(lhsIt != mContainers.end() || rhsIt != rhs.mContainers.end())
+    {
+        if(rhsIt == rhs.mContainers.end() || ( lhsIt != mContainers.end() && lhsIt->key < rhsIt->key ))
+        {
+            newContainers.push_back(std::move(*lhsIt));
+            ++lhsIt;
+        }
+        else if(lhsIt == mContainers.end() || rhsIt->key < lhsIt->key)
+        {
+            newContainers.push_back(*rhsIt);
+            ++rhsIt;
+        }
+        else
+        {
+            newContainers.push_back(std::move(*lhsIt));
+            newContainers.back().unite(*rhsIt);
+            ++lhsIt;
+            ++rhsIt;
+        }
+    }
+
+    mContainers.swap(newContainers);
+
+    mSize = 0u;
+
+    for(const auto& container : mContainers)
+    {
+        mSize += container.cardinality;
+    }
+
+    mbCumulativeCardinalityDirty = true;
+}
+
+std::size_t CRoaringBitmap::getMemoryUsage() const
+{
+    std::size_t result = sizeof(CRoaringBitmap) +
+                         mContainers.capacity() * sizeof(tContainer) +
+                         mCumulativeCardinality.capacity() * sizeof(std::size_t);
+
+    for(const auto& container : mContainers)
+    {
+        result += container.array.capacity() * sizeof(uint16_t) + container.bitmap.capacity() * sizeof(uint64_t);
+    }
+
+    return result;
+}
+
+bool CRoaringBitmap::operator==( const CRoaringBitmap& rhs ) const
+{
+    if(mSize != rhs.mSize || mContainers.size() != rhs.mContainers.size())
+    {
+        return false;
+    }
+
+    for(std::size_t i = 0u; i < mContainers.size(); ++i)
+    {
+        const auto& lhsContainer = mContainers[i];
+        const auto& rhsContainer = rhs.mContainers[i];
+
+        if(lhsContainer.key != rhsContainer.key ||
+           lhsContainer.cardinality != rhsContainer.cardinality ||
+           lhsContainer.array != rhsContainer.array ||
+           lhsContainer.bitmap != rhsContainer.bitmap)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CRoaringBitmap::operator!=( const CRoaringBitmap& rhs ) const
+{
+    return false == ( *this == rhs );
+}
+
+PUML_PACKAGE_BEGIN(DMA_Common)
+    PUML_CLASS_BEGIN_CHECKED(CRoaringBitmap)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
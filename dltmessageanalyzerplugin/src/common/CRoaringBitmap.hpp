@@ -0,0 +1,250 @@
+/**
+ * @file    CRoaringBitmap.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CRoaringBitmap class
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief The CRoaringBitmap class - compressed set of the unsigned 32-bit values with rank / select support.
+ * Values are split into the chunks by their high 16 bits. Each chunk is stored in a separate container:
+ * - sparse chunks are stored as the sorted arrays of the low 16 bits
+ * - dense chunks ( more than 4096 values ) are stored as the 65536-bit bitmaps
+ * Memory consumption is bounded by ~2 bytes per value for the sparse sets and by ~8 KB per 65536 ids for the dense ones.
+ * Appending of the values in the ascending order is the fast path, which is used to build the indexes.
+ * Note! The class is not thread-safe.
+ */
+class CRoaringBitmap
+{
+public:
+
+    typedef uint32_t tValue;
+
+    CRoaringBitmap();
+
+    /**
+     * @brief add - adds the value to the set
+     * @param value - value to be added
+     */
+    void add( const tValue& value );
+
+    /**
+     * @brief remove - removes the value from the set
+     * @param value - value to be removed
+     */
+    void remove( const tValue& value );
+
+    bool contains( const tValue& value ) const;
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+
+    /**
+     * @brief rank - gets the number of values, which are less than the provided one.
+     * If value is contained in the set, the result is equal to its position in the ascending order.
+     * @param value - value to be checked
+     * @return - number of the smaller values
+     */
+    std::size_t rank( const tValue& value ) const;
+
+    /**
+     * @brief select - gets the value by its position in the ascending order
+     * @param idx - position of the value. Should be less than size()
+     * @param value - output value
+     * @return - true, if value was found. False otherwise
+     */
+    bool select( const std::size_t& idx, tValue& value ) const;
+
+    /**
+     * @brief findNext - finds the smallest value, which is greater than the provided one
+     * @param value - value to start from. Does not need to be contained in the set
+     * @param nextValue - output value
+     * @return - true, if value was found. False otherwise
+     */
+    bool findNext( const tValue& value, tValue& nextValue ) const;
+
+    /**
+     * @brief findPrevious - finds the greatest value, which is less than the provided one
+     * @param value - value to start from. Does not need to be contained in the set
+     * @param previousValue - output value
+     * @return - true, if value was found. False otherwise
+     */
+    bool findPrevious( const tValue& value, tValue& previousValue ) const;
+
+    /**
+     * @brief unite - adds all values of the other set to this one.
+     * Containers are merged as a whole, thus the cost does not depend on the number of values in the dense chunks.
+     * @param rhs - set to be united with
+     */
+    void unite( const CRoaringBitmap& rhs );
+
+    /**
+     * @brief forEach - iterates over the values in the ascending order
+     * @param fromIdx - position of the first visited value
+     * @param maxNumberOfValues - max number of the visited values
+     * @param func - callable with the "bool(const tValue&)" signature. Iteration stops, if it returns false
+     */
+    template<typename T_Func>
+    void forEach( const std::size_t& fromIdx, const std::size_t& maxNumberOfValues, const T_Func& func ) const;
+
+    /**
+     * @brief getMemoryUsage - gets the approximate number of the used bytes
+     */
+    std::size_t getMemoryUsage() const;
+
+    bool operator==( const CRoaringBitmap& rhs ) const;
+    bool operator!=( const CRoaringBitmap& rhs ) const;
+
+    static uint32_t popCount( const uint64_t& word )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>( __builtin_popcountll(word) );
+#else
+        return static_cast<uint32_t>( std::bitset<64>(word).count() );
+#endif
+    }
+
+    // word should not be 0
+    static uint32_t countTrailingZeros( const uint64_t& word )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>( __builtin_ctzll(word) );
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long result = 0;
+        _BitScanForward64(&result, word);
+        return static_cast<uint32_t>(result);
+#else
+        return popCount( ( word & ( ~word + 1u ) ) - 1u );
+#endif
+    }
+
+private:
+
+    struct tContainer
+    {
+        uint16_t key = 0u;
+        uint32_t cardinality = 0u;
+        // used, if container is sparse
+        std::vector<uint16_t> array;
+        // used, if container is dense
+        std::vector<uint64_t> bitmap;
+
+        bool isBitmap() const;
+        bool contains( const uint16_t& lowBits ) const;
+        bool add( const uint16_t& lowBits );
+        bool remove( const uint16_t& lowBits );
+        uint32_t rank( const uint16_t& lowBits ) const;
+        uint16_t select( const uint32_t& idx ) const;
+        void convertToBitmap();
+        void convertToArray();
+        void unite( const tContainer& rhs );
+    };
+
+    typedef std::vector<tContainer> tContainers;
+
+    tContainers::iterator findContainer( const uint16_t& key );
+    tContainers::const_iterator findContainer( const uint16_t& key ) const;
+    void updateCumulativeCardinality() const;
+
+private:
+    tContainers mContainers;
+    // number of values in the preceding containers. Lazily updated for rank / select
+    mutable std::vector<std::size_t> mCumulativeCardinality;
+    mutable bool mbCumulativeCardinalityDirty;
+    std::size_t mSize;
+};
+
+template<typename T_Func>
+void CRoaringBitmap::forEach( const std::size_t& fromIdx, const std::size_t& maxNumberOfValues, const T_Func& func ) const
+{
+    if(fromIdx >= mSize || 0u == maxNumberOfValues)
+    {
+        return;
+    }
+
+    updateCumulativeCardinality();
+
+    // find the container with the first visited value
+    std::size_t lowerBound = 0u;
+    std::size_t upperBound = mContainers.size();
+
+    while(lowerBound < upperBound)
+    {
+        const std::size_t middle = lowerBound + ( upperBound - lowerBound ) / 2u;
+
+        if(mCumulativeCardinality[middle] + mContainers[middle].cardinality <= fromIdx)
+        {
+            lowerBound = middle + 1u;
+        }
+        else
+        {
+            upperBound = middle;
+        }
+    }
+
+    std::size_t containerIdx = lowerBound;
+    std::size_t numberOfVisitedValues = 0u;
+    uint32_t skipInContainer = static_cast<uint32_t>( fromIdx - mCumulativeCardinality[containerIdx] );
+
+    for(; containerIdx < mContainers.size(); ++containerIdx)
+    {
+        const auto& container = mContainers[containerIdx];
+        const tValue highBits = static_cast<tValue>(container.key) << 16;
+
+        if(false == container.isBitmap())
+        {
+            for(std::size_t i = skipInContainer; i < container.array.size(); ++i)
+            {
+                if(false == func(highBits | container.array[i]) || ++numberOfVisitedValues >= maxNumberOfValues)
+                {
+                    return;
+                }
+            }
+        }
+        else
+        {
+            for(std::size_t wordIdx = 0u; wordIdx < container.bitmap.size(); ++wordIdx)
+            {
+                uint64_t word = container.bitmap[wordIdx];
+
+                if(0u != skipInContainer)
+                {
+                    const uint32_t wordCardinality = popCount(word);
+
+                    if(skipInContainer >= wordCardinality)
+                    {
+                        skipInContainer -= wordCardinality;
+                        continue;
+                    }
+
+                    for(; 0u != skipInContainer; --skipInContainer)
+                    {
+                        word &= word - 1u; // drop the lowest bit
+                    }
+                }
+
+                while(0u != word)
+                {
+                    const tValue lowBits = static_cast<tValue>( wordIdx * 64u + countTrailingZeros(word) );
+                    word &= word - 1u;
+
+                    if(false == func(highBits | lowBits) || ++numberOfVisitedValues >= maxNumberOfValues)
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+
+        skipInContainer = 0u;
+    }
+}
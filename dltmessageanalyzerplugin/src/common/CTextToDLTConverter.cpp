@@ -0,0 +1,642 @@
+/**
+ * @file    CTextToDLTConverter.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CTextToDLTConverter class
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "QDateTime"
+#include "QElapsedTimer"
+#include "QFile"
+#include "QRegularExpression"
+#include "QRunnable"
+#include "QThread"
+#include "QThreadPool"
+
+#include "components/log/api/CLog.hpp"
+
+#include "cpp_extensions.hpp"
+#include "CTextToDLTConverter.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+static const int sMaxPayloadSize = 8191;
+static const qint64 sNanoSecondsInSecond = 1000000000;
+static const QString sTimestampGroupName = "ts";
+
+// Pre-encoded part of the message, which precedes the string argument.
+// Storage header, standard header, extended header and the type info of the string argument.
+// Variable fields (timestamps, message counter, length) are set during the encoding.
+static const char sV1MessageTemplate[] =
+{
+    // storage header: "DLT", 0x01, seconds (4, LE), microseconds (4, LE), ECU id
+    'D', 'L', 'T', 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 'E', 'C', 'U', '1',
+    // standard header: HTYP ( UEH | WEID | WSID | WTMS | version 1 ), MCNT, LEN (BE), ECU id, session id 9999 (BE), TMSP (BE)
+    0x3D, 0, 0, 0, 'E', 'C', 'U', '1', 0x00, 0x00, 0x27, 0x0F, 0, 0, 0, 0,
+    // extended header: MSIN ( verbose log message ), NOAR, APID, CTID
+    0x61, 0x01, 'C', 'O', 'N', 'V', 'I', 'M', 'P', '1',
+    // type info of the string argument: STRG, UTF-8
+    0x00, static_cast<char>(0x82), 0x00, 0x00
+};
+
+static const char sV2MessageTemplate[] =
+{
+    // storage header: "DLT", 0x02, nanoseconds (4, LE), seconds (5, LE), ECU id length, ECU id
+    'D', 'L', 'T', 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x04, 'E', 'C', 'U', '1',
+    // base header: HTYP2 ( verbose | WEID | WACID | version 2 ), MCNT, LEN (BE), MSIN ( verbose log message ), NOAR,
+    // timestamp: nanoseconds (4, BE), seconds (5, BE)
+    0x4C, 0x00, 0x00, 0x00, 0, 0, 0, 0x60, 0x01, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0,
+    // extension header: ECU id, APID, CTID
+    0x04, 'E', 'C', 'U', '1', 0x04, 'C', 'O', 'N', 'V', 0x04, 'I', 'M', 'P', '1',
+    // type info of the string argument: STRG, UTF-8
+    0x00, static_cast<char>(0x82), 0x00, 0x00
+};
+
+struct tMessageLayout
+{
+    int version;
+    const char* pTemplate;
+    std::size_t templateSize;
+    std::size_t storageHeaderSize;
+    std::size_t messageCounterOffset;
+    std::size_t lengthOffset;
+    std::size_t timestampOffset;
+};
+
+static const tMessageLayout sV1Layout{ 1, sV1MessageTemplate, sizeof(sV1MessageTemplate), 16u, 17u, 18u, 28u };
+static const tMessageLayout sV2Layout{ 2, sV2MessageTemplate, sizeof(sV2MessageTemplate), 18u, 22u, 23u, 27u };
+
+struct tTimestamp
+{
+    // time since epoch. Stored in the storage header
+    qint64 absoluteNs = 0;
+    // time since the ECU start. Stored in the message header
+    qint64 relativeNs = 0;
+};
+
+static void putLE( char* pTarget, uint64_t value, int numberOfBytes )
+{
+    for(int i = 0; i < numberOfBytes; ++i)
+    {
+        pTarget[i] = static_cast<char>( ( value >> ( 8 * i ) ) & 0xff );
+    }
+}
+
+static void putBE( char* pTarget, uint64_t value, int numberOfBytes )
+{
+    for(int i = 0; i < numberOfBytes; ++i)
+    {
+        pTarget[i] = static_cast<char>( ( value >> ( 8 * ( numberOfBytes - 1 - i ) ) ) & 0xff );
+    }
+}
+
+static void writeTimestamp( char* pMessage, const tMessageLayout& layout, const tTimestamp& timestamp )
+{
+    const uint64_t absoluteNs = static_cast<uint64_t>( std::max<qint64>(0, timestamp.absoluteNs) );
+    const uint64_t relativeNs = static_cast<uint64_t>( std::max<qint64>(0, timestamp.relativeNs) );
+
+    if(1 == layout.version)
+    {
+        putLE( pMessage + 4, absoluteNs / sNanoSecondsInSecond, 4 );
+        putLE( pMessage + 8, absoluteNs % sNanoSecondsInSecond / 1000u, 4 );
+        // measured in 0.1 ms
+        putBE( pMessage + layout.timestampOffset, relativeNs / 100000u, 4 );
+    }
+    else
+    {
+        putLE( pMessage + 4, absoluteNs % sNanoSecondsInSecond, 4 );
+        putLE( pMessage + 8, absoluteNs / sNanoSecondsInSecond, 5 );
+        putBE( pMessage + layout.timestampOffset, relativeNs % sNanoSecondsInSecond, 4 );
+        pMessage[layout.timestampOffset] = static_cast<char>( pMessage[layout.timestampOffset] | 0x80 );
+        putBE( pMessage + layout.timestampOffset + 4, relativeNs / sNanoSecondsInSecond, 5 );
+    }
+}
+
+static std::size_t appendMessage( std::vector<char>& output,
+                                  const tMessageLayout& layout,
+                                  const qint64& messageIndex,
+                                  const char* pPayload,
+                                  int payloadSize,
+                                  const tTimestamp& timestamp )
+{
+    if(payloadSize > sMaxPayloadSize)
+    {
+        payloadSize = sMaxPayloadSize;
+
+        // do not cut the multi-byte UTF-8 sequence
+        while(payloadSize > 0 && ( static_cast<unsigned char>(pPayload[payloadSize]) & 0xC0 ) == 0x80)
+        {
+            --payloadSize;
+        }
+    }
+
+    const std::size_t messageOffset = output.size();
+    const std::size_t messageSize = layout.templateSize + 2u + static_cast<std::size_t>(payloadSize);
+
+    output.resize(messageOffset + messageSize);
+
+    char* pMessage = output.data() + messageOffset;
+
+    std::memcpy(pMessage, layout.pTemplate, layout.templateSize);
+    pMessage[layout.messageCounterOffset] = static_cast<char>( messageIndex & 0xff );
+    putBE( pMessage + layout.lengthOffset, messageSize - layout.storageHeaderSize, 2 );
+    writeTimestamp( pMessage, layout, timestamp );
+    putLE( pMessage + layout.templateSize, static_cast<uint64_t>(payloadSize), 2 );
+    std::memcpy( pMessage + layout.templateSize + 2u, pPayload, static_cast<std::size_t>(payloadSize) );
+
+    return messageOffset;
+}
+
+struct tEncodingContext
+{
+    const tMessageLayout* pLayout = nullptr;
+    bool bParseTimestamps = false;
+    QString timestampRegex;
+    QString timestampFormat;
+    qint64 referenceAbsoluteNs = 0;
+    qint64 conversionStartAbsoluteNs = 0;
+    const QElapsedTimer* pTimer = nullptr;
+};
+
+/**
+ * @brief The CTimestampParser class - extracts the timestamp from the line.
+ * Each encoding task has its own instance, so that the regex is not shared between the threads.
+ */
+class CTimestampParser
+{
+public:
+    explicit CTimestampParser( const tEncodingContext& context ):
+        mContext(context),
+        mRegex(context.timestampRegex),
+        mGroupIdx(0)
+    {
+        mRegex.optimize();
+
+        const int namedGroupIdx = static_cast<int>( mRegex.namedCaptureGroups().indexOf(sTimestampGroupName) );
+
+        if(namedGroupIdx > 0)
+        {
+            mGroupIdx = namedGroupIdx;
+        }
+        else if(mRegex.captureCount() > 0)
+        {
+            mGroupIdx = 1;
+        }
+    }
+
+    bool parse( const char* pLine, int lineSize, tTimestamp& timestamp ) const
+    {
+        bool bResult = false;
+
+        const auto match = mRegex.match( QString::fromUtf8(pLine, lineSize) );
+
+        if(true == match.hasMatch())
+        {
+            const QString timestampStr = match.captured(mGroupIdx);
+
+            if(false == timestampStr.isEmpty())
+            {
+                if(false == mContext.timestampFormat.isEmpty())
+                {
+                    const QDateTime dateTime = QDateTime::fromString(timestampStr, mContext.timestampFormat);
+
+                    if(true == dateTime.isValid())
+                    {
+                        timestamp.absoluteNs = dateTime.toMSecsSinceEpoch() * 1000000;
+                        timestamp.relativeNs = timestamp.absoluteNs - mContext.referenceAbsoluteNs;
+                        bResult = true;
+                    }
+                }
+                else
+                {
+                    bool bOk = false;
+                    const double seconds = timestampStr.toDouble(&bOk);
+
+                    if(true == bOk && seconds >= 0.0)
+                    {
+                        timestamp.relativeNs = static_cast<qint64>( std::llround( seconds * static_cast<double>(sNanoSecondsInSecond) ) );
+                        timestamp.absoluteNs = mContext.conversionStartAbsoluteNs + timestamp.relativeNs;
+                        bResult = true;
+                    }
+                }
+            }
+        }
+
+        return bResult;
+    }
+
+private:
+    const tEncodingContext& mContext;
+    QRegularExpression mRegex;
+    int mGroupIdx;
+};
+
+struct tBlock
+{
+    // complete lines of the source file
+    std::vector<char> input;
+    qint64 firstMessageIndex = 0;
+    qint64 numberOfMessages = 0;
+    // encoded messages. Buffer is reused between the waves
+    std::vector<char> output;
+    // messages at the beginning of the block, which have no own timestamp.
+    // They get the last timestamp of the previous blocks during the writing
+    std::vector<std::size_t> unresolvedMessageOffsets;
+    bool bHasTimestamp = false;
+    tTimestamp lastTimestamp;
+    qint64 numberOfParsedTimestamps = 0;
+};
+
+template<typename T_Func>
+static void forEachLine( const std::vector<char>& input, const T_Func& func )
+{
+    const char* pCurrent = input.data();
+    const char* pEnd = input.data() + input.size();
+
+    while(pCurrent < pEnd)
+    {
+        const char* pNewLine = static_cast<const char*>( std::memchr(pCurrent, '\n', static_cast<std::size_t>(pEnd - pCurrent)) );
+        const char* pLineEnd = nullptr != pNewLine ? pNewLine : pEnd;
+        int lineSize = static_cast<int>(pLineEnd - pCurrent);
+
+        if(lineSize > 0 && '\r' == pCurrent[lineSize - 1])
+        {
+            --lineSize;
+        }
+
+        if(false == func(pCurrent, lineSize))
+        {
+            break;
+        }
+
+        pCurrent = nullptr != pNewLine ? pNewLine + 1 : pEnd;
+    }
+}
+
+static void encodeBlock( tBlock& block, const tEncodingContext& context )
+{
+    block.output.clear();
+    block.output.reserve( block.input.size() + static_cast<std::size_t>(block.numberOfMessages) * ( context.pLayout->templateSize + 2u ) );
+    block.unresolvedMessageOffsets.clear();
+    block.bHasTimestamp = false;
+    block.lastTimestamp = tTimestamp();
+    block.numberOfParsedTimestamps = 0;
+
+    std::unique_ptr<CTimestampParser> pTimestampParser;
+
+    if(true == context.bParseTimestamps)
+    {
+        pTimestampParser = cpp_14::make_unique<CTimestampParser>(context);
+    }
+
+    qint64 messageIndex = block.firstMessageIndex;
+
+    forEachLine( block.input, [&](const char* pLine, int lineSize)
+    {
+        if(nullptr != pTimestampParser)
+        {
+            tTimestamp timestamp;
+
+            if(true == pTimestampParser->parse(pLine, lineSize, timestamp))
+            {
+                block.lastTimestamp = timestamp;
+                block.bHasTimestamp = true;
+                ++block.numberOfParsedTimestamps;
+            }
+        }
+        else
+        {
+            const qint64 elapsedNs = context.pTimer->nsecsElapsed();
+            block.lastTimestamp.relativeNs = elapsedNs;
+            block.lastTimestamp.absoluteNs = context.conversionStartAbsoluteNs + elapsedNs;
+            block.bHasTimestamp = true;
+        }
+
+        const auto messageOffset = appendMessage( block.output, *context.pLayout, messageIndex, pLine, lineSize, block.lastTimestamp );
+
+        if(false == block.bHasTimestamp)
+        {
+            block.unresolvedMessageOffsets.push_back(messageOffset);
+        }
+
+        ++messageIndex;
+        return true;
+    });
+}
+
+/**
+ * @brief readBlock - reads the next portion of the complete lines
+ * @param file - source file
+ * @param block - target block
+ * @param carry - incomplete line, left from the previous block. Filled in with the new incomplete line
+ * @param blockSize - number of bytes to read
+ * @return - false in case of the read error. True otherwise
+ */
+static bool readBlock( QFile& file, tBlock& block, std::vector<char>& carry, int blockSize )
+{
+    block.input.swap(carry);
+    carry.clear();
+
+    bool bResult = true;
+
+    while(true)
+    {
+        const std::size_t oldSize = block.input.size();
+        block.input.resize( oldSize + static_cast<std::size_t>(blockSize) );
+
+        const qint64 readBytes = file.read( block.input.data() + oldSize, blockSize );
+
+        if(readBytes < 0)
+        {
+            block.input.resize(oldSize);
+            bResult = false;
+            break;
+        }
+
+        block.input.resize( oldSize + static_cast<std::size_t>(readBytes) );
+
+        if(0 == readBytes)
+        {
+            // end of file. The last line has no "\n"
+            break;
+        }
+
+        const auto rIt = std::find( block.input.rbegin(), block.input.rend() - static_cast<std::ptrdiff_t>(oldSize), '\n' );
+
+        if(rIt != block.input.rend() - static_cast<std::ptrdiff_t>(oldSize))
+        {
+            const auto lineEndIt = rIt.base();
+            carry.assign( lineEndIt, block.input.end() );
+            block.input.erase( lineEndIt, block.input.end() );
+            break;
+        }
+
+        // the line is longer than the block. Continue reading
+    }
+
+    block.numberOfMessages = std::count( block.input.begin(), block.input.end(), '\n' );
+
+    if(false == block.input.empty() && '\n' != block.input.back())
+    {
+        ++block.numberOfMessages;
+    }
+
+    return bResult;
+}
+
+/**
+ * @brief The CEncodeBlockTask class - runnable, which encodes a single block on the thread pool
+ */
+class CEncodeBlockTask : public QRunnable
+{
+public:
+    typedef std::function<void()> tTask;
+
+    explicit CEncodeBlockTask(const tTask& task):
+    mTask(task)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        if(mTask)
+        {
+            mTask();
+        }
+    }
+
+private:
+    tTask mTask;
+};
+
+QString CTextToDLTConverter::tResult::getThroughputString() const
+{
+    const double seconds = std::max<qint64>(1, durationMs) / 1000.0;
+    const double inputMB = static_cast<double>(inputBytes) / ( 1024.0 * 1024.0 );
+
+    return QString("%1 messages ( %2 MB -> %3 MB ) in %4 ms; %5 MB/s; %6 messages/s; %7 parsed timestamps")
+            .arg(numberOfMessages)
+            .arg(QString::number(inputMB, 'f', 1))
+            .arg(QString::number(static_cast<double>(outputBytes) / ( 1024.0 * 1024.0 ), 'f', 1))
+            .arg(durationMs)
+            .arg(QString::number(inputMB / seconds, 'f', 1))
+            .arg(static_cast<qint64>( static_cast<double>(numberOfMessages) / seconds ))
+            .arg(numberOfParsedTimestamps);
+}
+
+CTextToDLTConverter::tResult CTextToDLTConverter::convert( const tParameters& parameters )
+{
+    tResult result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if(1 != parameters.dltVersion && 2 != parameters.dltVersion)
+    {
+        SEND_ERR(QString("[CTextToDLTConverter] Unsupported dlt protocol version %1").arg(parameters.dltVersion));
+        return result;
+    }
+
+    tEncodingContext context;
+    context.pLayout = 1 == parameters.dltVersion ? &sV1Layout : &sV2Layout;
+    context.bParseTimestamps = false == parameters.timestampRegex.isEmpty();
+    context.timestampRegex = parameters.timestampRegex;
+    context.timestampFormat = parameters.timestampFormat;
+    context.conversionStartAbsoluteNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    context.pTimer = &timer;
+
+    if(true == context.bParseTimestamps)
+    {
+        QRegularExpression regex(parameters.timestampRegex);
+
+        if(false == regex.isValid())
+        {
+            SEND_ERR(QString("[CTextToDLTConverter] Invalid timestamp regex \"%1\": %2")
+                     .arg(parameters.timestampRegex)
+                     .arg(regex.errorString()));
+            return result;
+        }
+    }
+
+    QFile sourceFile(parameters.sourceFilePath);
+
+    if(false == sourceFile.open(QFile::OpenModeFlag::ReadOnly))
+    {
+        SEND_ERR(QString("Failed to open file \"%1\". Error: \"%2\"")
+                     .arg(parameters.sourceFilePath)
+                     .arg(sourceFile.errorString()));
+        return result;
+    }
+
+    QFile targetFile(parameters.targetFilePath);
+
+    if(false == targetFile.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Truncate))
+    {
+        SEND_ERR(QString("Failed to open file \"%1\". Error: \"%2\"")
+                     .arg(parameters.targetFilePath)
+                     .arg(targetFile.errorString()));
+        return result;
+    }
+
+    const int numberOfThreads = parameters.numberOfThreads > 0 ? parameters.numberOfThreads : QThread::idealThreadCount();
+    const int blockSize = std::max(4096, parameters.blockSize);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(std::max(1, numberOfThreads));
+
+    // two waves of blocks. One is encoded, while the other one is written and re-filled
+    std::array<std::vector<tBlock>, 2> waves;
+    std::array<int, 2> numberOfFilledBlocks = {0, 0};
+
+    waves[0].resize(static_cast<std::size_t>(threadPool.maxThreadCount()));
+    waves[1].resize(static_cast<std::size_t>(threadPool.maxThreadCount()));
+
+    std::vector<char> carry;
+    qint64 nextMessageIndex = 0;
+    bool bError = false;
+
+    auto fillWave = [&](std::vector<tBlock>& wave) -> int
+    {
+        int filledBlocks = 0;
+
+        for(auto& block : wave)
+        {
+            if(false == readBlock(sourceFile, block, carry, blockSize))
+            {
+                SEND_ERR(QString("Failed to read file \"%1\". Error: \"%2\"")
+                             .arg(parameters.sourceFilePath)
+                             .arg(sourceFile.errorString()));
+                bError = true;
+                break;
+            }
+
+            if(true == block.input.empty())
+            {
+                break;
+            }
+
+            result.inputBytes += static_cast<qint64>(block.input.size());
+            block.firstMessageIndex = nextMessageIndex;
+            nextMessageIndex += block.numberOfMessages;
+            ++filledBlocks;
+        }
+
+        return filledBlocks;
+    };
+
+    auto startWave = [&threadPool, &context](std::vector<tBlock>& wave, int filledBlocks)
+    {
+        for(int i = 0; i < filledBlocks; ++i)
+        {
+            tBlock* pBlock = &wave[static_cast<std::size_t>(i)];
+
+            threadPool.start(new CEncodeBlockTask([pBlock, &context]()
+            {
+                encodeBlock(*pBlock, context);
+            }));
+        }
+    };
+
+    tTimestamp lastTimestamp;
+    lastTimestamp.absoluteNs = context.conversionStartAbsoluteNs;
+
+    auto writeWave = [&](std::vector<tBlock>& wave, int filledBlocks)
+    {
+        for(int i = 0; i < filledBlocks && false == bError; ++i)
+        {
+            auto& block = wave[static_cast<std::size_t>(i)];
+
+            for(const auto& messageOffset : block.unresolvedMessageOffsets)
+            {
+                writeTimestamp(block.output.data() + messageOffset, *context.pLayout, lastTimestamp);
+            }
+
+            if(true == block.bHasTimestamp)
+            {
+                lastTimestamp = block.lastTimestamp;
+            }
+
+            const qint64 writtenBytes = targetFile.write(block.output.data(), static_cast<qint64>(block.output.size()));
+
+            if(writtenBytes != static_cast<qint64>(block.output.size()))
+            {
+                SEND_ERR(QString("Failed to write file \"%1\". Error: \"%2\"")
+                             .arg(parameters.targetFilePath)
+                             .arg(targetFile.errorString()));
+                bError = true;
+            }
+
+            result.outputBytes += writtenBytes;
+            result.numberOfMessages += block.numberOfMessages;
+            result.numberOfParsedTimestamps += block.numberOfParsedTimestamps;
+        }
+    };
+
+    numberOfFilledBlocks[0] = fillWave(waves[0]);
+
+    if(true == context.bParseTimestamps &&
+       false == context.timestampFormat.isEmpty() &&
+       0 != numberOfFilledBlocks[0])
+    {
+        // relative timestamps are counted from the first timestamp of the file
+        CTimestampParser timestampParser(context);
+
+        forEachLine( waves[0][0].input, [&timestampParser, &context](const char* pLine, int lineSize)
+        {
+            tTimestamp timestamp;
+            bool bParsed = timestampParser.parse(pLine, lineSize, timestamp);
+
+            if(true == bParsed)
+            {
+                context.referenceAbsoluteNs = timestamp.absoluteNs;
+            }
+
+            return false == bParsed;
+        });
+    }
+
+    startWave(waves[0], numberOfFilledBlocks[0]);
+
+    std::size_t currentWaveIdx = 0u;
+
+    while(0 != numberOfFilledBlocks[currentWaveIdx] && false == bError)
+    {
+        const std::size_t otherWaveIdx = 1u - currentWaveIdx;
+
+        // reading of the next wave overlaps with the encoding of the current one
+        numberOfFilledBlocks[otherWaveIdx] = fillWave(waves[otherWaveIdx]);
+        threadPool.waitForDone();
+
+        if(false == bError)
+        {
+            startWave(waves[otherWaveIdx], numberOfFilledBlocks[otherWaveIdx]);
+        }
+
+        // writing of the current wave overlaps with the encoding of the next one
+        writeWave(waves[currentWaveIdx], numberOfFilledBlocks[currentWaveIdx]);
+
+        currentWaveIdx = otherWaveIdx;
+    }
+
+    threadPool.waitForDone();
+
+    targetFile.close();
+
+    result.bIsSuccessful = false == bError;
+    result.durationMs = timer.elapsed();
+
+    return result;
+}
+
+PUML_PACKAGE_BEGIN(DMA_Common)
+    PUML_CLASS_BEGIN_CHECKED(CTextToDLTConverter)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
@@ -0,0 +1,66 @@
+/**
+ * @file    CTextToDLTConverter.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CTextToDLTConverter class
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "QString"
+
+/**
+ * @brief The CTextToDLTConverter class - streaming converter of the text logs to the DLT format.
+ * Source file is read in large blocks, which are cut on the line boundaries.
+ * Blocks are encoded on the thread pool into the reusable output buffers and are written to the target file
+ * in the original order. Reading and writing of one wave of blocks overlaps with encoding of the other one.
+ * Each "\n" separated line becomes a verbose log message with a single string argument.
+ * Original timestamps can be taken from the lines with the help of the timestamp regex.
+ */
+class CTextToDLTConverter
+{
+public:
+
+    struct tParameters
+    {
+        QString sourceFilePath;
+        // in case if file under the specified path already exists - it will be truncated
+        QString targetFilePath;
+        // version of the dlt protocol. 1 or 2
+        int dltVersion = 2;
+        // regex, which extracts the timestamp from the line. Named group "ts" is used, if present.
+        // Otherwise the first capture group or the whole match. Empty value means the conversion time
+        QString timestampRegex;
+        // QDateTime format of the extracted timestamp, e.g. "yyyy-MM-dd hh:mm:ss.zzz".
+        // Empty value means, that the timestamp is the number of seconds since the ECU start, e.g. "1234.567890"
+        QString timestampFormat;
+        // number of the encoding threads. Values less or equal to 0 mean QThread::idealThreadCount()
+        int numberOfThreads = 0;
+        // size of the block, which is read and encoded at once
+        int blockSize = 1024 * 1024;
+    };
+
+    struct tResult
+    {
+        bool bIsSuccessful = false;
+        qint64 numberOfMessages = 0;
+        // number of messages with the timestamp, which was taken from the line
+        qint64 numberOfParsedTimestamps = 0;
+        qint64 inputBytes = 0;
+        qint64 outputBytes = 0;
+        qint64 durationMs = 0;
+
+        /**
+         * @brief getThroughputString - gets the human-readable throughput of the conversion
+         */
+        QString getThroughputString() const;
+    };
+
+    /**
+     * @brief convert - converts the source file and blocks till the conversion is finished
+     * @param parameters - parameters of the conversion
+     * @return - result of the conversion. Errors are reported to the console
+     */
+    static tResult convert( const tParameters& parameters );
+};
@@ -4,6 +4,7 @@
  * @brief   Implementation of the CTreeItem.cpp class
  */
 
+#include <map>
 #include <stack>
 
 #include "CTreeItem.hpp"
@@ -379,15 +380,17 @@ const int& CTreeItem::getIdx() const
     return mIdx;
 }
 
-void CTreeItem::removeChild( const QString& key )
+void CTreeItem::removeChild( const tDataItem& key )
 {
     auto foundChild = mChildItems.find(key);
 
     if(foundChild != mChildItems.end())
     {
-        if(true == mbFirstLevelSorted)
+        auto childIdx = getChildIdx(foundChild.value());
+
+        if(childIdx >= 0)
         {
-            mChildrenVec.erase(mChildrenVec.begin() + foundChild.value()->getIdx());
+            mChildrenVec.erase(mChildrenVec.begin() + childIdx);
 
             auto counter = 0;
 
@@ -405,6 +408,23 @@ void CTreeItem::removeChild( const QString& key )
     }
 }
 
+int CTreeItem::getChildIdx( const tTreeItemPtr pChild ) const
+{
+    return mChildrenVec.indexOf(pChild);
+}
+
+void CTreeItem::invalidateSorting()
+{
+    auto pItem = this;
+
+    while(nullptr != pItem)
+    {
+        pItem->mbFirstLevelSorted = false;
+        pItem->mbWholeSorted = false;
+        pItem = pItem->mpParentItem;
+    }
+}
+
 CTreeItem::~CTreeItem()
 {
     mChildrenVec.clear();
@@ -458,6 +478,33 @@ tTreeItemPtr CTreeItem::appendChild(const tDataItem& key, const tData& additionI
     return pTreeItem;
 }
 
+void CTreeItem::appendChildrenCopy( const CTreeItem* pSource )
+{
+    if(nullptr == pSource || this == pSource)
+    {
+        return;
+    }
+
+    std::map<const CTreeItem*, const tDataItem*> childKeys;
+
+    for(auto it = pSource->mChildItems.begin(); it != pSource->mChildItems.end(); ++it)
+    {
+        childKeys[it.value()] = &it.key();
+    }
+
+    // children vector keeps the order of the appending
+    for(const auto& pSourceChild : pSource->mChildrenVec)
+    {
+        auto foundKey = childKeys.find(pSourceChild);
+
+        if(foundKey != childKeys.end())
+        {
+            auto pChild = appendChild(*foundKey->second, pSourceChild->mData);
+            pChild->appendChildrenCopy(pSourceChild);
+        }
+    }
+}
+
 void CTreeItem::setData( const tData& data )
 {
     mData = data;
@@ -171,7 +171,20 @@ public:
      * @brief removeChild - removes first level child, if it exists
      * @param key - key to the child, which should be removed
      */
-    void removeChild( const QString& key );
+    void removeChild( const tDataItem& key );
+
+    /**
+     * @brief getChildIdx - gets index of the first level child within the ( sorted ) children's collection
+     * @param pChild - child, which index should be found
+     * @return - index of the child or -1, if it is not a child of this node
+     */
+    int getChildIdx( const tTreeItemPtr pChild ) const;
+
+    /**
+     * @brief invalidateSorting - marks this node and all its parents as unsorted.
+     * Should be called after modification of the data, which might be used for sorting.
+     */
+    void invalidateSorting();
 
     /**
      * @brief appendChild - appends child to this node of the tree
@@ -181,6 +194,13 @@ public:
      */
     tTreeItemPtr appendChild(const tDataItem& key, const tData& additionItems);
 
+    /**
+     * @brief appendChildrenCopy - appends deep copies of all children of the source item to this node.
+     * Order of appending is kept, sorting state of the copied sub-tree is reset.
+     * @param pSource - item, which children should be copied
+     */
+    void appendChildrenCopy( const CTreeItem* pSource );
+
     /**
      * @brief getValue - get's value by a specified column
      * @param column - column, for which the data was requested
@@ -8,8 +8,10 @@
 
 #include <cstdint>
 
+#include <deque>
 #include <list>
 #include <set>
+#include <vector>
 
 #include "QMap"
 #include "QSet"
@@ -23,6 +25,7 @@
 #include "../common/variant/variant.hpp"
 
 #include "BaseDefinitions.hpp"
+#include "CRoaringBitmap.hpp"
 #include "PlotDefinitions.hpp"
 
 //#define DEBUG_BUILD
@@ -92,6 +95,8 @@ extern const QString sDefaultRegexFileName;
 typedef int tMsgId;
 extern const tMsgId INVALID_MSG_ID;
 typedef std::set<tMsgId> tMsgIdSet;
+// compressed set of the message id-s. Used for the big sets, which need fast union and successor queries
+typedef CRoaringBitmap tMsgIdBitmap;
 
 typedef std::int32_t tHighlightingRangeItem;
 
@@ -239,7 +244,7 @@ struct tGroupedViewMetadata
     tGroupedViewMetadata( const unsigned int timeStamp_, const tMsgId& msgId_ );
     tTimeStamp timeStamp;
     tMsgId msgId;
-    nonstd::variant<int, tMsgIdSet> relatedMsgIds = 0;
+    nonstd::variant<int, tMsgIdBitmap> relatedMsgIds = 0;
 };
 Q_DECLARE_METATYPE(tGroupedViewMetadata)
 
@@ -284,6 +289,7 @@ enum class eRegexFiltersColumn : int
     Value = 0, /*QString*/
     Index, /*int*/
     ItemType, /*QString*/
+    Cost, /*double - average match time of the group per message in nanoseconds*/
     AfterLastVisible, /*empty string*/
     Color, /*tColorWrapper*/
     Range, /*tIntRange*/
@@ -311,6 +317,43 @@ Q_DECLARE_METATYPE( eRegexFiltersRowType )
 
 QString getName(eRegexFiltersRowType val);
 
+/**
+ * @brief The tRegexCostProfile struct - match time of the regex, attributed to its parts.
+ * Durations are summed up over all profiled messages.
+ */
+struct tRegexCostProfile
+{
+    /**
+     * @brief merge - adds the durations of the other profile of the same regex to this one
+     * @param rhs - profile to be merged
+     */
+    void merge(const tRegexCostProfile& rhs);
+    bool isEmpty() const;
+
+    /**
+     * @brief getAverageDurationNs - gets the average duration per profiled message
+     * @param durationNs - summed up duration
+     * @return - average duration in nanoseconds. 0, if no messages were profiled
+     */
+    double getAverageDurationNs(const int64_t& durationNs) const;
+
+    typedef QMap<int /*group index*/, int64_t /*duration ns*/> tGroupDurations;
+    typedef QMap<tIntRange /*range of the branch within the regex string*/, int64_t /*duration ns*/> tBranchDurations;
+
+    QString regex; // profiled regex string, without the options
+    int numberOfProfiledMessages = 0;
+    int64_t overallDurationNs = 0;
+    tGroupDurations groupDurationsNs; // capture groups
+    tBranchDurations branchDurationsNs; // top-level alternation branches
+};
+
+/**
+ * @brief formatDurationNs - formats the duration for the user
+ * @param durationNs - duration in nanoseconds
+ * @return - duration with the suitable unit, e.g. "12.3 us"
+ */
+QString formatDurationNs(const double& durationNs);
+
 //////////////////////FILTERS VIEW DEFINITIONS END//////////////////
 
 struct tHighlightingGradient
@@ -638,14 +681,15 @@ private:
 };
 
 typedef std::shared_ptr<tFoundMatchesPackItem> tFoundMatchesPackItemPtr;
-typedef std::vector<tFoundMatchesPackItemPtr> tFoundMatchesPackItemVec;
+// deque is used to be able to cheaply evict the oldest found matches from the front of the collection
+typedef std::deque<tFoundMatchesPackItemPtr> tFoundMatchesPackItemContainer;
 
 struct tFoundMatchesPack
 {
     tFoundMatchesPack();
-    tFoundMatchesPack( const tFoundMatchesPackItemVec& matchedItemVec_ );
+    tFoundMatchesPack( const tFoundMatchesPackItemContainer& matchedItemVec_ );
     int findRowByMsgId(const tMsgId& msgIdToFind) const;
-    tFoundMatchesPackItemVec matchedItemVec;
+    tFoundMatchesPackItemContainer matchedItemVec;
 };
 
 class QDltPlugin;
@@ -671,6 +715,8 @@ typedef std::shared_ptr<IFileWrapper> tFileWrapperPtr;
 
 class IMsgWrapper;
 typedef std::shared_ptr<IMsgWrapper> tMsgWrapperPtr;
+// block of the decoded messages with their non-filtered id-s
+typedef std::vector<std::pair<int /*msgId*/, tMsgWrapperPtr>> tMsgWrapperBlock;
 
 class IMsgDecoder;
 typedef std::shared_ptr<IMsgDecoder> tMsgDecoderPtr;
@@ -691,6 +737,25 @@ struct tIntRangeProperty : public tIntRange
     int toFiltered = 0;
 };
 
+enum class eTimeSource
+{
+    eStorageTime = 0,   // time of the storage header. Microseconds since epoch
+    eECUTimestamp,      // timestamp of the ECU. Microseconds since the start of the ECU
+    eLast               // last enum value
+};
+
+/**
+ * @brief The tTimeRange struct - time window, which limits the analyzed messages.
+ * Both borders are inclusive.
+ */
+struct tTimeRange
+{
+    bool isSet = false;
+    eTimeSource timeSource = eTimeSource::eStorageTime;
+    int64_t from = 0; // microseconds
+    int64_t to = 0; // microseconds
+};
+
 enum class eSearchViewLastColumnWidthStrategy
 {
     eReset = 0,             // reset width on each search ( default strategy )
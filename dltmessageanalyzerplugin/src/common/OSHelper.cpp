@@ -6,6 +6,7 @@
     #include <limits>
 #elif _WIN32
     #include <Windows.h>
+    #include <Psapi.h>
 #endif
 
 const int DIV = 1024;
@@ -58,3 +59,36 @@ uint32_t getRAMSizeUnchecked()
 
     return result;
 }
+
+bool getPeakRSSSize(uint64_t& val)
+{
+    bool bResult = false;
+
+#ifdef __linux__
+    std::string token;
+    std::ifstream file("/proc/self/status");
+    while(file >> token) {
+        if(token == "VmHWM:") {
+            unsigned long mem;
+            if(file >> mem)
+            {
+                bResult = true;
+                val = mem;
+            }
+            break; // break the loop
+        }
+        // ignore rest of the line
+        file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+    }
+#elif _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    bResult = 0 != GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+
+    if(true == bResult)
+    {
+        val = static_cast<uint64_t>(counters.PeakWorkingSetSize/DIV);
+    }
+#endif
+
+    return bResult;
+}
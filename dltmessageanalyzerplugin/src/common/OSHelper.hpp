@@ -19,4 +19,11 @@ bool getRAMSize(uint32_t& val);
  */
 uint32_t getRAMSizeUnchecked();
 
+/**
+ * @brief getPeakRSSSize - returns back the peak resident set size ( in Kb ) of the current process
+ * @return - true in case of success. False otherwise.
+ * Note! This function is supported for Windows and Linux.
+ */
+bool getPeakRSSSize(uint64_t& val);
+
 #endif // OSHELPER_HPP
@@ -125,6 +125,7 @@ public:
                     //        Value = 0, /*QString*/                                            // OK
                     //        Index, /*int*/                                                    // OK
                     //        ItemType, /*QString*/                                             // OK
+                    //        Cost, /*double*/                                                  // OK
                     //        AfterLastVisible, /*empty string*/                                // OK
                     //        Color, /*tColorWrapper*/                                          // OK
                     //        Range, /*tIntRange*/                                              // OK
@@ -497,6 +498,7 @@ private:
             data.push_back(tDataItem(currentParsingItem.value));
             data.push_back(tDataItem(currentParsingItem.range.from));
             data.push_back(tDataItem(currentParsingItem.name));
+            data.push_back(tDataItem(0.0));
             data.push_back(tDataItem(QString()));
             data.push_back(tDataItem(currentParsingItem.colorWrapper));
             data.push_back(tDataItem(currentParsingItem.range));
@@ -522,6 +524,7 @@ private:
             data_.push_back(tDataItem(mRegex.mid(range.from, range.to - range.from + 1)));           // OK
             data_.push_back(tDataItem(range.from));                                                  // OK
             data_.push_back(tDataItem(getName(eRegexFiltersRowType::Text)));                         // OK
+            data_.push_back(tDataItem(0.0));                                                         // OK
             data_.push_back(tDataItem(QString()));                                                   // OK
             data_.push_back(tDataItem(tColorWrapper()));                                             // OK
             data_.push_back(tDataItem(range));                                                       // OK
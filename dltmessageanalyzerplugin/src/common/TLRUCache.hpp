@@ -0,0 +1,103 @@
+/**
+ * @file    TLRUCache.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the TLRUCache class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+/**
+ * @brief The TLRUCache class - cache of the limited size, which evicts the least recently used items.
+ * Used to avoid repeated preparation of the same expensive objects, e.g. compiled regexes.
+ * Note! The class is not thread-safe.
+ */
+template<typename K, typename V>
+class TLRUCache
+{
+public:
+
+    typedef K tKey;
+    typedef V tValue;
+
+    explicit TLRUCache(std::size_t maxSize):
+    mItems(),
+    mItemsMap(),
+    mMaxSize(maxSize > 0u ? maxSize : 1u)
+    {}
+
+    /**
+     * @brief find - finds the value and marks it as the most recently used one
+     * @param key - key of the value
+     * @return - pointer to the found value or nullptr, if there is no such key in the cache.
+     * Pointer is valid till the next modification of the cache.
+     */
+    const tValue* find(const tKey& key)
+    {
+        const tValue* pResult = nullptr;
+
+        auto foundItem = mItemsMap.find(key);
+
+        if(foundItem != mItemsMap.end())
+        {
+            mItems.splice(mItems.begin(), mItems, foundItem->second);
+            pResult = &foundItem->second->second;
+        }
+
+        return pResult;
+    }
+
+    /**
+     * @brief insert - inserts or replaces the value. Evicts the least recently used value, if size limit is reached.
+     * @param key - key of the value
+     * @param value - value to be stored
+     * @return - reference to the stored value. Valid till the next modification of the cache.
+     */
+    const tValue& insert(const tKey& key, const tValue& value)
+    {
+        auto foundItem = mItemsMap.find(key);
+
+        if(foundItem != mItemsMap.end())
+        {
+            foundItem->second->second = value;
+            mItems.splice(mItems.begin(), mItems, foundItem->second);
+        }
+        else
+        {
+            mItems.emplace_front(key, value);
+            mItemsMap.emplace(key, mItems.begin());
+
+            if(mItems.size() > mMaxSize)
+            {
+                mItemsMap.erase(mItems.back().first);
+                mItems.pop_back();
+            }
+        }
+
+        return mItems.front().second;
+    }
+
+    void clear()
+    {
+        mItemsMap.clear();
+        mItems.clear();
+    }
+
+    std::size_t size() const
+    {
+        return mItems.size();
+    }
+
+private:
+    typedef std::list<std::pair<tKey, tValue>> tItems;
+    typedef std::map<tKey, typename tItems::iterator> tItemsMap;
+
+    // most recently used items go first
+    tItems mItems;
+    tItemsMap mItemsMap;
+    std::size_t mMaxSize;
+};
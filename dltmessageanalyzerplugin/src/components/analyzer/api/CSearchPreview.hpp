@@ -0,0 +1,111 @@
+/**
+ * @file    CSearchPreview.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CSearchPreview class
+ */
+#pragma once
+
+#include "set"
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+#include "common/Definitions.hpp"
+
+#include "components/settings/api/CSettingsManagerClient.hpp"
+
+/**
+ * @brief tSearchPreviewResult - result of the preview of the regex on the sample of the file
+ */
+struct tSearchPreviewResult
+{
+    QString regexStr;
+    // empty, if regex is valid
+    QString errorString;
+    // first matches within the sample, in the order of the messages
+    tFoundMatchesPack firstMatches;
+    int numberOfMessages = 0;
+    int numberOfSampledMessages = 0;
+    int numberOfMatchesInSample = 0;
+    // number of matches in the whole file, extrapolated from the sample
+    int estimatedNumberOfMatches = 0;
+    // true, if sampling was stopped by the time cap before the whole sample was checked
+    bool bTimeCapReached = false;
+};
+
+/**
+ * @brief The CSearchPreview class - runs the regex over the sample of the file, while the user types it.
+ * Requests are debounced. The new request cancels the previous one.
+ * Sample consists of the small blocks of messages, which are evenly spread over the file.
+ * File wrapper is not thread-safe, thus the sample is processed in the GUI thread in short time slices,
+ * and the whole preview is limited by the hard time cap.
+ */
+class CSearchPreview : public QObject,
+                       public CSettingsManagerClient
+{
+    Q_OBJECT
+
+public:
+
+    CSearchPreview(const tSettingsManagerPtr& pSettingsManager, QObject* pParent = nullptr);
+
+    /**
+     * @brief schedulePreview - starts the preview once the user stops typing.
+     * Previously scheduled or running preview is cancelled.
+     * @param pFile - file to be sampled
+     * @param regexStr - regex string, without the options
+     * @param patternOptions - options of the regex
+     * @param searchColumns - columns, which participate in the search
+     */
+    void schedulePreview( const tFileWrapperPtr& pFile,
+                          const QString& regexStr,
+                          const QRegularExpression::PatternOptions& patternOptions,
+                          const tSearchResultColumnsVisibilityMap& searchColumns );
+
+    /**
+     * @brief cancelPreview - cancels the scheduled or running preview. Its result is not reported
+     */
+    void cancelPreview();
+
+    bool isPreviewInProgress() const;
+
+signals:
+    void previewFinished( const tSearchPreviewResult& result );
+
+private:
+    void startPreview();
+    void processPreviewSlice();
+    void finishPreview();
+
+private:
+
+    struct tPreviewRequest
+    {
+        tFileWrapperPtr pFile;
+        QString regexStr;
+        QRegularExpression::PatternOptions patternOptions = QRegularExpression::NoPatternOption;
+        tSearchResultColumnsVisibilityMap searchColumns;
+    };
+
+    struct tPreviewState
+    {
+        bool bActive = false;
+        tFileWrapperPtr pFile;
+        QRegularExpression regex;
+        tRegexScriptingMetadata regexMetadata;
+        QVector<QColor> colors;
+        std::set<eSearchResultColumn> searchColumnsSet;
+        int numberOfBlocks = 0;
+        int blockStride = 0;
+        int nextBlockIdx = 0;
+        QElapsedTimer elapsedTimer;
+        tSearchPreviewResult result;
+    };
+
+    QTimer mDebounceTimer;
+    QTimer mSliceTimer;
+    tPreviewRequest mPendingRequest;
+    tPreviewState mPreviewState;
+};
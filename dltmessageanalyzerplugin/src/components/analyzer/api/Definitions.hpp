@@ -44,6 +44,13 @@ struct tRequestParameters
     tSearchResultColumnsVisibilityMap searchColumns;
     QString regexStr;
     QStringList selectedAliases;
+    // optional time window. If set, the range of messages is narrowed down to the messages within it.
+    // Request with the time window is never continuous, as new messages are out of the window.
+    tTimeRange timeRange;
+    // optional index of the message in the main table, around which the results are needed first.
+    // If set, the range is analyzed outward from this message. -1 means analysis from the first message.
+    // Ignored by the continuous requests, as their results are evicted in the order of arrival.
+    int focusMessage;
 };
 
 Q_DECLARE_METATYPE(tRequestParameters)
@@ -74,6 +81,8 @@ struct tProgressNotificationData
     tFoundMatchesPack processedMatches;
     bool bUML_Req_Res_Ev_DuplicateFound;
     tGroupedViewIndices groupedViewIndices;
+    // cost of the regex. Filled in only in the final notification of the request, if profiling was active
+    tRegexCostProfile regexCostProfile;
 };
 
 Q_DECLARE_METATYPE(tProgressNotificationData)
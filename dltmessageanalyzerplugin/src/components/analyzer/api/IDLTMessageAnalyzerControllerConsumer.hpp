@@ -5,9 +5,12 @@
  */
 #pragma once
 
+#include <tuple>
+
 #include <QObject>
 
 #include "Definitions.hpp"
+#include "common/TLRUCache.hpp"
 
 //Forward declarations
 
@@ -45,6 +48,15 @@ protected: // fields
 
 private: // fields
     bool mbGroupedViewFeatureActiveForCurrentAnalysis;
+
+    // parsed scripting metadata of the recently used regexes
+    typedef std::tuple<QString /*pattern*/,
+                       int /*pattern options*/,
+                       bool /*UML*/,
+                       bool /*plot view*/,
+                       bool /*grouped view*/> tRegexScriptingMetadataKey;
+    typedef TLRUCache<tRegexScriptingMetadataKey, tRegexScriptingMetadata> tRegexScriptingMetadataCache;
+    tRegexScriptingMetadataCache mRegexScriptingMetadataCache;
 };
 
 typedef std::shared_ptr<IDLTMessageAnalyzerControllerConsumer> tDLTMessageAnalyzerControllerConsumerPtr;
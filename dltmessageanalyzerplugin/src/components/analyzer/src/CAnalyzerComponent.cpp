@@ -27,7 +27,7 @@ DMA::tSyncInitOperationResult CAnalyzerComponent::init()
     try
     {
         auto pMTController = IDLTMessageAnalyzerController::createInstance<CMTAnalyzer>(getSettingsManager());
-        mpMessageAnalyzerController = IDLTMessageAnalyzerController::createInstance<CContinuousAnalyzer>(pMTController);
+        mpMessageAnalyzerController = IDLTMessageAnalyzerController::createInstance<CContinuousAnalyzer>(pMTController, getSettingsManager());
 
         result.bIsOperationSuccessful = true;
         result.returnCode = 0;
@@ -7,16 +7,24 @@
 #include "qdlt.h"
 
 #include "CContinuousAnalyzer.hpp"
+#include "CDLTRegexAnalyzerWorker.hpp"
 #include "../api/IDLTMessageAnalyzerControllerConsumer.hpp"
 #include "functional"
 #include "QTimer"
+#include "QThread"
 #include "QDebug"
 
 #include "components/logsWrapper/api/IFileWrapper.hpp"
+#include "common/cpp_extensions.hpp"
 
 #include "DMA_Plantuml.hpp"
 
 static const int WAITING_TIME = 50;
+// in the tail mode messages are delivered by the file wrapper. Polling is only a safety net.
+static const int TAIL_MODE_WAITING_TIME = 1000;
+// max time between the arrival of the message and the start of its analysis
+static const int TAIL_FLUSH_TIME = 5;
+static const int TAIL_MAX_PORTION_SIZE = 1000;
 
 CSubConsumer::CSubConsumer(const tDLTMessageAnalyzerControllerPtr& pController):
     IDLTMessageAnalyzerControllerConsumer(pController),
@@ -37,14 +45,42 @@ void CSubConsumer::progressNotification( const tProgressNotificationData& progre
 }
 
 //CContinuousAnalyzer
-CContinuousAnalyzer::CContinuousAnalyzer(const tDLTMessageAnalyzerControllerPtr& pSubAnalyzer):
+CContinuousAnalyzer::CContinuousAnalyzer(const tDLTMessageAnalyzerControllerPtr& pSubAnalyzer,
+                                         const tSettingsManagerPtr& pSettingsManager):
 IDLTMessageAnalyzerController(),
+CSettingsManagerClient(pSettingsManager),
 mpSubConsumer( nullptr ),
 mpSubAnalyzer( pSubAnalyzer ),
 mRequestDataMap(),
 mSubRequestDataMap(),
-mRequestIdCounter(static_cast<uint64_t>(-1))
+mRequestIdCounter(static_cast<uint64_t>(-1)),
+mpTailWorkerThread(nullptr),
+mpTailWorker(nullptr),
+mTailFlushTimer(),
+mpConnectedFile(nullptr),
+mFileConnection()
 {
+    mpTailWorker = new CDLTRegexAnalyzerWorker(getSettingsManager());
+
+    // standing worker, which analyzes the messages of all requests, which are in the tail mode
+    connect(mpTailWorker, &CDLTRegexAnalyzerWorker::portionAnalysisFinished,
+            this, &CContinuousAnalyzer::tailPortionAnalysisFinished, Qt::QueuedConnection);
+
+    mpTailWorkerThread = cpp_14::make_unique<QThread>();
+
+    // After worker thread will be stopped, worker object should be aynchronously deleted.
+    connect(mpTailWorkerThread.get(), &QThread::finished, mpTailWorker, &QObject::deleteLater, Qt::QueuedConnection);
+
+    mpTailWorker->moveToThread(mpTailWorkerThread.get());
+    mpTailWorkerThread->start();
+
+    mTailFlushTimer.setSingleShot(true);
+    mTailFlushTimer.setInterval(TAIL_FLUSH_TIME);
+    connect(&mTailFlushTimer, &QTimer::timeout, this, [this]()
+    {
+        flushTailPortions();
+    });
+
     auto pConsumer = IDLTMessageAnalyzerControllerConsumer::createInstance<CSubConsumer>(pSubAnalyzer);
 
     auto callback = [this](const tProgressNotificationData& progressNotificationData)
@@ -57,6 +93,15 @@ mRequestIdCounter(static_cast<uint64_t>(-1))
     mpSubConsumer = pConsumer;
 }
 
+CContinuousAnalyzer::~CContinuousAnalyzer()
+{
+    if(nullptr != mpTailWorkerThread)
+    {
+        mpTailWorkerThread->quit();
+        mpTailWorkerThread->wait();
+    }
+}
+
 void CContinuousAnalyzer::progressNotification( const tProgressNotificationData& progressNotificationData )
 {
     auto foundSubRequest = mSubRequestDataMap.find(progressNotificationData.requestId);
@@ -152,6 +197,7 @@ void CContinuousAnalyzer::progressNotification( const tProgressNotificationData&
                             progressNotificationData.processedMatches,
                             progressNotificationData.bUML_Req_Res_Ev_DuplicateFound,
                             progressNotificationData.groupedViewIndices);
+                            resultProgressNotificationData.regexCostProfile = progressNotificationData.regexCostProfile;
 
                             QMetaObject::invokeMethod(foundRequest.value().pClient.lock().get(), "progressNotification", Qt::QueuedConnection,
                                                       Q_ARG(tProgressNotificationData, resultProgressNotificationData));
@@ -161,6 +207,13 @@ void CContinuousAnalyzer::progressNotification( const tProgressNotificationData&
 
                         foundRequest.value().subRequestId = INVALID_REQUEST_ID;
                         foundRequest.value().bContinuousModeActive = true;
+
+                        if(false == foundRequest.value().bTailModeActive)
+                        {
+                            foundRequest.value().bTailModeActive = true;
+                            connectToFile(foundRequest.value().mpFile);
+                        }
+
                         triggerContinuousAnalysisIteration(foundRequest);
                     }
                         break;
@@ -203,6 +256,13 @@ tRequestId CContinuousAnalyzer::requestAnalyze( const std::weak_ptr<IDLTMessageA
             requestData.fromMessage = requestParameters.fromMessage;
             requestData.toMessage = requestParameters.fromMessage + requestParameters.numberOfMessages;
 
+            if(true == requestData.bIsContinuousAnalysis)
+            {
+                // the same regex is used for the whole life time of the continuous request.
+                // Let's compile it once, instead of doing that lazily in scope of each small portion.
+                requestData.regex.optimize();
+            }
+
             mRequestDataMap.insert(resultRequestId, requestData);
             mSubRequestDataMap.insert( subRequestId, resultRequestId );
 
@@ -251,13 +311,43 @@ int CContinuousAnalyzer::getMaximumNumberOfThreads() const
     return result;
 }
 
+void CContinuousAnalyzer::scheduleContinuousAnalysisIteration(const tRequestId& requestId)
+{
+    auto foundRequest = mRequestDataMap.find(requestId);
+
+    if(mRequestDataMap.end() != foundRequest)
+    {
+        const int waitingTime = true == foundRequest.value().bTailModeActive ? TAIL_MODE_WAITING_TIME : WAITING_TIME;
+
+        QTimer::singleShot(waitingTime, this, [this, requestId]()
+        {
+            auto foundRequest_ = mRequestDataMap.find(requestId);
+
+            if(mRequestDataMap.end() != foundRequest_ && // NOLINT
+               INVALID_REQUEST_ID == foundRequest_.value().subRequestId)
+            {
+                triggerContinuousAnalysisIteration(foundRequest_); // NOLINT
+            }
+        });
+    }
+}
+
 void CContinuousAnalyzer::triggerContinuousAnalysisIteration(const tRequestDataMap::iterator& inputIt)
 {
     auto fileSize = inputIt->mpFile->size();
 
     if(fileSize > 0)
     {
-        if(fileSize > ( inputIt.value().toMessage ) )
+        if(fileSize > ( inputIt.value().toMessage ) &&
+           true == inputIt.value().bTailModeActive &&
+           ( false == inputIt.value().tailProcessingStrings.isEmpty() ||
+             inputIt.value().tailPortionsInProgress > 0 ) )
+        {
+            // the range analysis should not overtake the tail portions, which are still in progress.
+            // Otherwise the order of the delivered results would be broken.
+            scheduleContinuousAnalysisIteration(inputIt.value().requestId);
+        }
+        else if(fileSize > ( inputIt.value().toMessage ) )
         {
             // analyze
             inputIt->fromMessage = inputIt->toMessage;
@@ -311,16 +401,12 @@ void CContinuousAnalyzer::triggerContinuousAnalysisIteration(const tRequestDataM
         else if( fileSize == ( inputIt.value().toMessage ) )
         {
             // wait more
-            auto requestId = inputIt.value().requestId;
-            QTimer::singleShot(WAITING_TIME, this, [this, requestId]()
-            {
-                auto foundRequest = mRequestDataMap.find(requestId);
-
-                if(mRequestDataMap.end() != foundRequest) // NOLINT
-                {
-                    triggerContinuousAnalysisIteration(foundRequest); // NOLINT
-                }
-            });
+            scheduleContinuousAnalysisIteration(inputIt.value().requestId);
+        }
+        else if( true == inputIt.value().bTailModeActive )
+        {
+            // tail messages might be announced before the file size is updated
+            scheduleContinuousAnalysisIteration(inputIt.value().requestId);
         }
         else
         {
@@ -345,6 +431,127 @@ void CContinuousAnalyzer::triggerContinuousAnalysisIteration(const tRequestDataM
     }
 }
 
+void CContinuousAnalyzer::connectToFile(const tFileWrapperPtr& pFile)
+{
+    if(pFile != mpConnectedFile)
+    {
+        disconnect(mFileConnection);
+        mpConnectedFile = pFile;
+
+        if(nullptr != mpConnectedFile)
+        {
+            mFileConnection = connect(mpConnectedFile.get(), &IFileWrapper::msgWrapperArrived,
+                                      this, [this](const tMsgId& msgId, const tMsgWrapperPtr& pMsgWrapper)
+            {
+                msgWrapperArrived(msgId, pMsgWrapper);
+            });
+        }
+    }
+}
+
+void CContinuousAnalyzer::msgWrapperArrived(const tMsgId& msgId, const tMsgWrapperPtr& pMsgWrapper)
+{
+    for(auto it = mRequestDataMap.begin(); it != mRequestDataMap.end(); ++it)
+    {
+        auto& requestData = it.value();
+
+        if(true == requestData.bTailModeActive &&
+           INVALID_REQUEST_ID == requestData.subRequestId && // range analysis is not running
+           requestData.mpFile == mpConnectedFile &&
+           false == requestData.mpFile->isFiltered() && // ids of the filtered file are not contiguous
+           msgId == requestData.toMessage) // gaps and already analyzed messages are handled by the range analysis
+        {
+            requestData.tailProcessingStrings.push_back(createProcessingStringItem(msgId,
+                                                                                   msgId,
+                                                                                   pMsgWrapper,
+                                                                                   requestData.searchColumnsSet));
+            requestData.fromMessage = requestData.toMessage;
+            ++requestData.toMessage;
+
+            if(requestData.tailProcessingStrings.size() >= TAIL_MAX_PORTION_SIZE)
+            {
+                flushTailPortion(it);
+            }
+            else if(false == mTailFlushTimer.isActive())
+            {
+                mTailFlushTimer.start();
+            }
+        }
+    }
+}
+
+void CContinuousAnalyzer::flushTailPortion(const tRequestDataMap::iterator& inputIt)
+{
+    auto& requestData = inputIt.value();
+
+    if(false == requestData.tailProcessingStrings.isEmpty())
+    {
+        tAnalyzePortionData analyzePortionData
+        (
+            requestData.requestId,
+            requestData.tailProcessingStrings,
+            requestData.regex,
+            requestData.regexScriptingMetadata,
+            requestData.tailWorkerThreadCookieCounter++
+        );
+
+        requestData.tailProcessingStrings.clear();
+        ++requestData.tailPortionsInProgress;
+
+        QMetaObject::invokeMethod(mpTailWorker, "analyzePortion", Qt::QueuedConnection,
+                                  Q_ARG(tAnalyzePortionData, analyzePortionData));
+    }
+}
+
+void CContinuousAnalyzer::flushTailPortions()
+{
+    for(auto it = mRequestDataMap.begin(); it != mRequestDataMap.end(); ++it)
+    {
+        flushTailPortion(it);
+    }
+}
+
+void CContinuousAnalyzer::tailPortionAnalysisFinished(const tPortionRegexAnalysisFinishedData& portionRegexAnalysisFinishedData)
+{
+    // single worker thread processes the portions in FIFO order, thus no re-ordering is needed here
+    auto foundRequest = mRequestDataMap.find(portionRegexAnalysisFinishedData.requestId);
+
+    if(mRequestDataMap.end() != foundRequest)
+    {
+        --foundRequest.value().tailPortionsInProgress;
+
+        const bool bSuccess = ePortionAnalysisState::ePortionAnalysisState_SUCCESSFUL ==
+                              portionRegexAnalysisFinishedData.portionAnalysisState;
+
+        reportRegexLimits(foundRequest.value().regexStr, portionRegexAnalysisFinishedData.regexLimitsReport);
+
+        if(false == foundRequest.value().pClient.expired())
+        {
+            tProgressNotificationData resultProgressNotificationData
+            (foundRequest.key(),
+            true == bSuccess ? eRequestState::PROGRESS : eRequestState::ERROR_STATE,
+            100,
+            portionRegexAnalysisFinishedData.processedMatches,
+            portionRegexAnalysisFinishedData.bUML_Req_Res_Ev_DuplicateFound,
+            foundRequest.value().regexScriptingMetadata.getGroupedViewIndices());
+
+            QMetaObject::invokeMethod(foundRequest.value().pClient.lock().get(), "progressNotification", Qt::QueuedConnection,
+                                      Q_ARG(tProgressNotificationData, resultProgressNotificationData));
+        }
+
+        if(false == bSuccess)
+        {
+            if(INVALID_REQUEST_ID != foundRequest.value().subRequestId)
+            {
+                mpSubAnalyzer->cancelRequest(mpSubConsumer, foundRequest.value().subRequestId);
+                mSubRequestDataMap.remove(foundRequest.value().subRequestId);
+            }
+
+            mRequestDataMap.erase(foundRequest);
+        }
+    }
+}
+
 //CContinuousAnalyzer::tRequestData
 CContinuousAnalyzer::tRequestData::tRequestData(const tRequestId& requestId_,
             const std::weak_ptr<IDLTMessageAnalyzerControllerConsumer>& pClient_,
@@ -369,7 +576,12 @@ CContinuousAnalyzer::tRequestData::tRequestData(const tRequestId& requestId_,
             bContinuousModeActive(false),
             searchColumns(searchColumns_),
             regexStr(regexStr_),
-            selectedAlises(selectedAlises_)
+            selectedAlises(selectedAlises_),
+            bTailModeActive(false),
+            searchColumnsSet(getSearchColumnsSet(searchColumns_)),
+            tailProcessingStrings(),
+            tailPortionsInProgress(0),
+            tailWorkerThreadCookieCounter(0)
 {}
 
 PUML_PACKAGE_BEGIN(DMA_Analyzer)
@@ -379,7 +591,11 @@ PUML_PACKAGE_BEGIN(DMA_Analyzer)
 
     PUML_CLASS_BEGIN_CHECKED(CContinuousAnalyzer)
         PUML_INHERITANCE_CHECKED(IDLTMessageAnalyzerController, implements)
+        PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(IDLTMessageAnalyzerControllerConsumer, 1, 1, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CDLTRegexAnalyzerWorker, 1, 1, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(QThread, 1, 1, contains)
         PUML_AGGREGATION_DEPENDENCY_CHECKED(IDLTMessageAnalyzerController, 1, 1, uses)
+        PUML_AGGREGATION_DEPENDENCY_CHECKED(IFileWrapper, 1, 1, listens to)
     PUML_CLASS_END()
 PUML_PACKAGE_END()
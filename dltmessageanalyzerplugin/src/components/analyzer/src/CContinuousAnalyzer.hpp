@@ -7,10 +7,17 @@
 
 #include "../api/IDLTMessageAnalyzerController.hpp"
 #include "../api/IDLTMessageAnalyzerControllerConsumer.hpp"
+#include "DefinitionsInternal.hpp"
 #include "functional"
+#include "memory"
 #include "QRegularExpression"
+#include "QTimer"
+
+#include "components/settings/api/CSettingsManagerClient.hpp"
 
 class IDLTMessageAnalyzerControllerConsumer;
+class CDLTRegexAnalyzerWorker;
+class QThread;
 
 /**
  * @brief The CSubConsumer class - this internal class is used as an extention of IDLTMessageAnalyzerControllerConsumer.
@@ -34,12 +41,19 @@ private:
  * "continuous analysis" capability to it.
  * It uses the undelying sub-analyzer, which is also implementation of IDLTMessageAnalyzerController in order to perform one-shot analysis
  * iterations.
+ * Once the initial analysis is done, the class switches to the "tail" mode. In this mode each message, which arrives to the file
+ * wrapper, is appended to the small batch, which is then analyzed by the dedicated standing worker. That avoids the set up of
+ * the full sub-request for each small increment of the file. Polling of the file size is still used as a fallback, e.g. for the
+ * filtered files or for the messages, which were not announced by the file wrapper.
  */
-class CContinuousAnalyzer : public IDLTMessageAnalyzerController
+class CContinuousAnalyzer : public IDLTMessageAnalyzerController,
+                            public CSettingsManagerClient
 {
     Q_OBJECT
 public:
-    CContinuousAnalyzer(const tDLTMessageAnalyzerControllerPtr& pSubAnalyzer);
+    CContinuousAnalyzer(const tDLTMessageAnalyzerControllerPtr& pSubAnalyzer,
+                        const tSettingsManagerPtr& pSettingsManager);
+    ~CContinuousAnalyzer() override;
 
     //IDLTMessageAnalyzerController implementation
 
@@ -67,6 +81,24 @@ private:// methods
     void triggerContinuousAnalysisIteration(const tRequestDataMap::iterator& inputIt);
     void progressNotification(const tProgressNotificationData& progressNotificationData);
 
+    /**
+     * @brief scheduleContinuousAnalysisIteration - schedules the next check of the file size for the specified request
+     */
+    void scheduleContinuousAnalysisIteration(const tRequestId& requestId);
+
+    /**
+     * @brief connectToFile - subscribes to the messages, which are arriving to the specified file
+     */
+    void connectToFile(const tFileWrapperPtr& pFile);
+    void msgWrapperArrived(const tMsgId& msgId, const tMsgWrapperPtr& pMsgWrapper);
+
+    /**
+     * @brief flushTailPortion - sends the collected tail messages of the request to the tail worker
+     */
+    void flushTailPortion(const tRequestDataMap::iterator& inputIt);
+    void flushTailPortions();
+    void tailPortionAnalysisFinished(const tPortionRegexAnalysisFinishedData& portionRegexAnalysisFinishedData);
+
 private:// fields
     std::shared_ptr<IDLTMessageAnalyzerControllerConsumer> mpSubConsumer;
     tDLTMessageAnalyzerControllerPtr mpSubAnalyzer;
@@ -98,10 +130,22 @@ private:// fields
         tSearchResultColumnsVisibilityMap searchColumns;
         QString regexStr;
         QStringList selectedAlises;
+        bool bTailModeActive;
+        tSearchColumnsSet searchColumnsSet;
+        tProcessingStrings tailProcessingStrings;
+        int tailPortionsInProgress;
+        tWorkerThreadCookie tailWorkerThreadCookieCounter;
     };
 
     tRequestDataMap mRequestDataMap;
     typedef QMap<tRequestId, tRequestId> tSubRequestDataMap;
     tSubRequestDataMap mSubRequestDataMap;
     tRequestId mRequestIdCounter;
+
+    typedef std::shared_ptr<QThread> tQThreadPtr;
+    tQThreadPtr mpTailWorkerThread;
+    CDLTRegexAnalyzerWorker* mpTailWorker;
+    QTimer mTailFlushTimer;
+    tFileWrapperPtr mpConnectedFile;
+    QMetaObject::Connection mFileConnection;
 };
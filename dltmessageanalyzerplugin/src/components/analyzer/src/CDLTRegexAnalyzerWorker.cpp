@@ -4,11 +4,13 @@
  * @brief   Implementation of the CDLTRegexAnalyzerWorker class
  */
 
+#include "algorithm"
 #include "atomic"
 
 #include "QDebug"
 
 #include "common/Definitions.hpp"
+#include "common/CPerfCounters.hpp"
 
 #ifdef DEBUG_BUILD
 #include "QElapsedTimer"
@@ -23,12 +25,19 @@
 Q_DECLARE_METATYPE(ePortionAnalysisState)
 
 static std::atomic<tWorkerId> sWorkerIdCounter(0);
+// profiled message is matched once per sub-pattern of the regex, thus only a few messages of each portion are profiled
+static const std::size_t sMaxProfiledMessagesPerPortion = 8u;
 
 //CDLTRegexAnalyzerWorker
 CDLTRegexAnalyzerWorker::CDLTRegexAnalyzerWorker(const tSettingsManagerPtr& pSettingsManager):
 CSettingsManagerClient(pSettingsManager),
 mWorkerId(++sWorkerIdCounter),
-mColors()
+mColors(),
+mLimitedRegexSource(),
+mLimitedRegexOptions(QRegularExpression::NoPatternOption),
+mLimitedRegexMatchLimit(0),
+mLimitedRegexDepthLimit(0),
+mLimitedRegex()
 {
     qRegisterMetaType<tFoundMatchesPack>("tFoundMatchesPack");
     qRegisterMetaType<ePortionAnalysisState>("ePortionAnalysisState");
@@ -55,8 +64,47 @@ tWorkerId CDLTRegexAnalyzerWorker::getWorkerId() const
     return mWorkerId;
 }
 
+const QRegularExpression& CDLTRegexAnalyzerWorker::getLimitedRegex( const QRegularExpression& regex )
+{
+    const auto matchLimit = getSettingsManager()->getRegexMatchLimit();
+    const auto depthLimit = getSettingsManager()->getRegexDepthLimit();
+
+    if(0 == matchLimit && 0 == depthLimit)
+    {
+        return regex;
+    }
+
+    if(regex.pattern() != mLimitedRegexSource ||
+       regex.patternOptions() != mLimitedRegexOptions ||
+       matchLimit != mLimitedRegexMatchLimit ||
+       depthLimit != mLimitedRegexDepthLimit)
+    {
+        mLimitedRegexSource = regex.pattern();
+        mLimitedRegexOptions = regex.patternOptions();
+        mLimitedRegexMatchLimit = matchLimit;
+        mLimitedRegexDepthLimit = depthLimit;
+
+        mLimitedRegex = createLimitedRegex(regex, matchLimit, depthLimit);
+    }
+
+    return mLimitedRegex;
+}
+
 void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyzePortionData )
 {
+    auto& perfCounters = CPerfCounters::getInstance();
+    const auto portionStartNs = CPerfCounters::now();
+
+    perfCounters.record(ePerfStage::eQueueWait,
+                        analyzePortionData.postTimestampNs,
+                        portionStartNs - analyzePortionData.postTimestampNs);
+
+    // portions of the cancelled request, which are still in the queue, are dropped without any processing
+    if(true == isCancelled(analyzePortionData.pCancellationToken))
+    {
+        return;
+    }
+
 #ifdef DEBUG_BUILD
     SEND_MSG( QString( "[CDLTRegexAnalyzerWorker][%1] reqID - %2; procString.size() - %3; regex - %4 mWorkerId - %5" )
               .arg(__FUNCTION__)
@@ -89,6 +137,24 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
 
     bool bUML_Req_Res_Ev_DuplicateFound = false;
 
+    // durations are accumulated over the whole portion, as per-message samples would be too fine-grained
+    CPerfCounters::tDurationNs regexMatchNs = 0;
+    CPerfCounters::tDurationNs highlightingNs = 0;
+    CPerfCounters::tDurationNs umlExtractionNs = 0;
+    CPerfCounters::tDurationNs plotViewExtractionNs = 0;
+
+    const QRegularExpression& regex = getLimitedRegex(analyzePortionData.regex);
+    const CPerfCounters::tDurationNs messageTimeBudgetNs =
+        static_cast<CPerfCounters::tDurationNs>(getSettingsManager()->getRegexMessageTimeBudgetMs()) * 1000000;
+    tRegexLimitsReport regexLimitsReport;
+
+    const auto& pRegexCostProfiler = analyzePortionData.pRegexCostProfiler;
+    tRegexCostProfile regexCostProfile;
+    const std::size_t profilingStep = std::max<std::size_t>(1u, static_cast<std::size_t>(analyzePortionData.processingStrings.size()) / sMaxProfiledMessagesPerPortion);
+    std::size_t processingStringIdx = 0u;
+
+    bool bCancelled = false;
+
     try
     {
 #ifdef DEBUG_BUILD
@@ -98,7 +164,42 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
 
         for(const auto& processingString : analyzePortionData.processingStrings)
         {
-            QRegularExpressionMatch match = analyzePortionData.regex.match(*(processingString.second));
+            if(true == isCancelled(analyzePortionData.pCancellationToken))
+            {
+                bCancelled = true;
+                break;
+            }
+
+            const bool bProfile = nullptr != pRegexCostProfiler && 0u == ( processingStringIdx++ % profilingStep );
+
+            auto stageStartNs = CPerfCounters::now();
+
+            QRegularExpressionMatch match = regex.match(*(processingString.second));
+
+            const auto matchDurationNs = CPerfCounters::now() - stageStartNs;
+
+            // invalid match means, that PCRE2 has reported an error, e.g. the match limit was hit.
+            if(false == match.isValid())
+            {
+                regexLimitsReport.addSkippedMessage(processingString.first.msgId);
+                regexMatchNs += matchDurationNs;
+                continue;
+            }
+
+            // running match can't be interrupted, thus the time budget is checked after the fact.
+            // Completed match is kept, so that the result does not depend on the machine load
+            if(0 != messageTimeBudgetNs && matchDurationNs > messageTimeBudgetNs)
+            {
+                regexLimitsReport.addSlowMessage(processingString.first.msgId);
+            }
+
+            if(true == bProfile)
+            {
+                // message, on which the sub-patterns hit the execution limits, is simply not profiled
+                static_cast<void>(pRegexCostProfiler->profile(*(processingString.second), regexCostProfile));
+                // profiling is not a part of the measured stages
+                stageStartNs = CPerfCounters::now() - matchDurationNs;
+            }
 
             if (true == match.hasMatch())
             {
@@ -135,11 +236,19 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
                     }
                 }
 
+                auto stageEndNs = CPerfCounters::now();
+                regexMatchNs += stageEndNs - stageStartNs;
+                stageStartNs = stageEndNs;
+
                 tItemMetadata itemMetadata = processingString.first;
                 auto pTree = itemMetadata.updateHighlightingInfo(foundMatches,
                                                                  mColors,
                                                                  analyzePortionData.regexMetadata);
 
+                stageEndNs = CPerfCounters::now();
+                highlightingNs += stageEndNs - stageStartNs;
+                stageStartNs = stageEndNs;
+
                 if(true == bAnalyzeUML)
                 {
                     auto updateUMLInfoResult = itemMetadata.updateUMLInfo(foundMatches,
@@ -150,6 +259,10 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
                     {
                         bUML_Req_Res_Ev_DuplicateFound = updateUMLInfoResult.bUML_Req_Res_Ev_DuplicateFound;
                     }
+
+                    stageEndNs = CPerfCounters::now();
+                    umlExtractionNs += stageEndNs - stageStartNs;
+                    stageStartNs = stageEndNs;
                 }
 
                 if(true == bAnalyzePlotView)
@@ -157,10 +270,16 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
                     auto updatePlotViewInfoResult = itemMetadata.updatePlotViewInfo(foundMatches,
                                                                           analyzePortionData.regexMetadata,
                                                                           pTree);
+
+                    plotViewExtractionNs += CPerfCounters::now() - stageStartNs;
                 }
 
                 foundMatchesPack.matchedItemVec.push_back( std::make_shared<tFoundMatchesPackItem>( std::move(itemMetadata), std::move(foundMatches) ) );
             }
+            else
+            {
+                regexMatchNs += CPerfCounters::now() - stageStartNs;
+            }
         }
 
 #ifdef DEBUG_BUILD
@@ -176,6 +295,12 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
         portionAnalysisState = ePortionAnalysisState::ePortionAnalysisState_ERROR;
     }
 
+    // nobody waits for the results of the cancelled request
+    if(true == bCancelled)
+    {
+        return;
+    }
+
     tPortionRegexAnalysisFinishedData portionRegexAnalysisFinishedData(
     analyzePortionData.requestId,
     static_cast<int>(analyzePortionData.processingStrings.size()),
@@ -185,6 +310,32 @@ void CDLTRegexAnalyzerWorker::analyzePortion(  const tAnalyzePortionData& analyz
     analyzePortionData.workerThreadCookie,
     bUML_Req_Res_Ev_DuplicateFound);
 
+    portionRegexAnalysisFinishedData.regexLimitsReport = regexLimitsReport;
+    portionRegexAnalysisFinishedData.regexCostProfile = regexCostProfile;
+
+    // accumulated stages are placed on the timeline back-to-back, starting from the beginning of the portion's analysis
+    auto stageTimestampNs = portionStartNs;
+    auto recordAccumulatedStage = [&perfCounters, &stageTimestampNs](const ePerfStage& stage, const CPerfCounters::tDurationNs& durationNs)
+    {
+        perfCounters.record(stage, stageTimestampNs, durationNs);
+        stageTimestampNs += durationNs;
+    };
+
+    recordAccumulatedStage(ePerfStage::eRegexMatch, regexMatchNs);
+    recordAccumulatedStage(ePerfStage::eHighlighting, highlightingNs);
+
+    if(true == bAnalyzeUML)
+    {
+        recordAccumulatedStage(ePerfStage::eUMLExtraction, umlExtractionNs);
+    }
+
+    if(true == bAnalyzePlotView)
+    {
+        recordAccumulatedStage(ePerfStage::ePlotViewExtraction, plotViewExtractionNs);
+    }
+
+    portionRegexAnalysisFinishedData.finishTimestampNs = CPerfCounters::now();
+
     emit portionAnalysisFinished( portionRegexAnalysisFinishedData );
 }
 
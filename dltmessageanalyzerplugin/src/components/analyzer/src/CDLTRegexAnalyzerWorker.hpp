@@ -38,7 +38,22 @@ public slots:
 signals:
     void portionAnalysisFinished( const tPortionRegexAnalysisFinishedData& portionRegexAnalysisFinishedData );
 
+private: // methods
+    /**
+     * @brief getLimitedRegex - gets the version of the regex, which is restricted by the
+     * match and depth limits from the settings. Result is cached until the regex or the limits change.
+     * @param regex - regex of the request
+     * @return - limited regex. Original regex, if no limits are set or the limited one is not valid.
+     */
+    const QRegularExpression& getLimitedRegex( const QRegularExpression& regex );
+
 private: // members
     tWorkerId mWorkerId;
     QVector<QColor> mColors;
+
+    QString mLimitedRegexSource;
+    QRegularExpression::PatternOptions mLimitedRegexOptions;
+    int mLimitedRegexMatchLimit;
+    int mLimitedRegexDepthLimit;
+    QRegularExpression mLimitedRegex;
 };
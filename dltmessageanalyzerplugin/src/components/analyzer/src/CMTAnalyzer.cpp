@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <iterator>
 
 #include "QThread"
 #include "qdebug.h"
@@ -17,7 +18,9 @@
 #include "components/logsWrapper/api/IFileWrapper.hpp"
 #include "components/logsWrapper/api/IMsgWrapper.hpp"
 #include "components/log/api/CLog.hpp"
+#include "components/settings/api/ISettingsManager.hpp"
 #include "common/cpp_extensions.hpp"
+#include "common/CPerfCounters.hpp"
 
 #include "DMA_Plantuml.hpp"
 
@@ -28,13 +31,54 @@ Q_DECLARE_METATYPE(tWorkerId)
 //Static fields and constants
 static const int CHUNK_SIZE = 4000;
 
+/**
+ * @brief createFocusChunkOrder - forms the order of the chunks, which starts from the chunk
+ * with the focus message and alternately grows the analyzed area after and before it
+ * @param numberOfMessages - number of analyzed messages
+ * @param focusOffset - offset of the focus message from the first analyzed one.
+ * Offsets outside of the analyzed range are clamped to it.
+ * @return - indexes of the chunks in the order of their analysis
+ */
+static std::vector<int> createFocusChunkOrder(const int& numberOfMessages, const int& focusOffset)
+{
+    std::vector<int> result;
+
+    const int numberOfChunks = ( numberOfMessages + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+
+    if(numberOfChunks <= 0)
+    {
+        return result;
+    }
+
+    result.reserve(static_cast<std::size_t>(numberOfChunks));
+
+    const int focusChunk = qBound(0, focusOffset / CHUNK_SIZE, numberOfChunks - 1);
+    result.push_back(focusChunk);
+
+    for(int distance = 1; static_cast<int>(result.size()) < numberOfChunks; ++distance)
+    {
+        if(focusChunk + distance < numberOfChunks)
+        {
+            result.push_back(focusChunk + distance);
+        }
+
+        if(focusChunk - distance >= 0)
+        {
+            result.push_back(focusChunk - distance);
+        }
+    }
+
+    return result;
+}
+
 //CMTAnalyzer
-CMTAnalyzer::CMTAnalyzer(const tSettingsManagerPtr& pSettingsManager):
+CMTAnalyzer::CMTAnalyzer(const tSettingsManagerPtr& pSettingsManager, const int& numberOfWorkers):
 CSettingsManagerClient(pSettingsManager),
 mWorkerItemMap(),
-mRequestIdCounter( static_cast<uint64_t>(-1) )
+mRequestIdCounter( static_cast<uint64_t>(-1) ),
+mNextFirstWorkerIndex(0)
 {
-    auto threadsNumber = QThread::idealThreadCount();
+    auto threadsNumber = numberOfWorkers > 0 ? numberOfWorkers : QThread::idealThreadCount();
 
     // Safe one thread for GUI reflectiveness
     //threadsNumber = ( threadsNumber > 1 ) ? threadsNumber - 1 : threadsNumber ;
@@ -47,6 +91,7 @@ mRequestIdCounter( static_cast<uint64_t>(-1) )
         connect(pWorker, &CDLTRegexAnalyzerWorker::portionAnalysisFinished, this, &CMTAnalyzer::portionRegexAnalysisFinished, Qt::QueuedConnection);
 
         tQThreadPtr pWorkerThread = cpp_14::make_unique<QThread>();
+        pWorkerThread->setObjectName(QString("DMA_RegexWorker_%1").arg(pWorker->getWorkerId()));
 
         // After worker thread will be stopped, worker object should be aynchronously deleted.
         connect(pWorkerThread.get(), &QThread::finished, pWorker, &QObject::deleteLater, Qt::QueuedConnection);
@@ -63,6 +108,12 @@ mRequestIdCounter( static_cast<uint64_t>(-1) )
 
 CMTAnalyzer::~CMTAnalyzer()
 {
+    // workers should not finish the portions, which are already in progress
+    for(auto& requestData : mRequestMap)
+    {
+        requestData.cancel();
+    }
+
     for(auto & workerItem : mWorkerItemMap)
     {
         workerItem.pQThread->quit();
@@ -108,6 +159,32 @@ tRequestId CMTAnalyzer::requestAnalyze( const std::weak_ptr<IDLTMessageAnalyzerC
 
             if(0 != requestData.numberOfMessagesToBeAnalyzed)
             {
+                const int numberOfWorkers = static_cast<int>(mWorkerItemMap.size());
+
+                if(0 != numberOfWorkers)
+                {
+                    requestData.firstWorkerIndex = mNextFirstWorkerIndex % numberOfWorkers;
+                    mNextFirstWorkerIndex = ( requestData.firstWorkerIndex + qMax(requestData.numberOfThreads, 1) ) % numberOfWorkers;
+                }
+
+                if(false == requestParameters.isContinuous &&
+                   requestParameters.focusMessage >= 0 &&
+                   requestData.numberOfMessagesToBeAnalyzed > CHUNK_SIZE)
+                {
+                    requestData.focusChunkOrder = createFocusChunkOrder(requestData.numberOfMessagesToBeAnalyzed,
+                                                                        requestParameters.focusMessage - requestData.fromMessage);
+                }
+
+                if(true == getSettingsManager()->getRegexCostProfiling() &&
+                   false == requestData.regexStr.isEmpty())
+                {
+                    // regex is parsed and its sub-patterns are compiled once per request, by the first profiling worker
+                    requestData.pRegexCostProfiler = std::make_shared<const CRegexCostProfiler>(requestData.regexStr,
+                                                                                               requestData.regex.patternOptions(),
+                                                                                               getSettingsManager()->getRegexMatchLimit(),
+                                                                                               getSettingsManager()->getRegexDepthLimit());
+                }
+
                 requestId = ++mRequestIdCounter;
                 auto it = mRequestMap.insert(requestId, requestData);
                 bool bResult = regexAnalysisIteration(it);
@@ -136,13 +213,19 @@ void CMTAnalyzer::sendError( tRequestMap::iterator& requestIt )
                      .arg(__FUNCTION__)
                      .arg(requestIt.key()));
 
+            tProgressNotificationData progressNotificationData
+            ( requestIt.key(),
+              eRequestState::ERROR_STATE,
+              100,
+              tFoundMatchesPack(),
+              requestIt->bUML_Req_Res_Ev_DuplicateFound,
+              requestIt->regexScriptingMetadata.getGroupedViewIndices() );
+
             QMetaObject::invokeMethod(pClient.lock().get(), "progressNotification", Qt::QueuedConnection,
-                                      Q_ARG(tRequestId, requestIt.key()),
-                                      Q_ARG(eRequestState, eRequestState::ERROR_STATE),
-                                      Q_ARG(int8_t, 100),
-                                      Q_ARG(tFoundMatchesPack, tFoundMatchesPack()));
+                                      Q_ARG(tProgressNotificationData, progressNotificationData));
         }
 
+        requestIt->cancel();
         mRequestMap.erase(requestIt);
     }
 }
@@ -160,8 +243,27 @@ bool CMTAnalyzer::regexAnalysisIteration(tRequestMap::iterator& inputIt, const t
             const tWorkerId& workerId_,
             const tWorkerItem& workerItem)
     {
-        const auto startRange = inputIt_.value().fromMessage + inputIt_.value().requestedRegexMatches;
-        const auto endRange = inputIt_.value().fromMessage + inputIt_.value().numberOfMessagesToBeAnalyzed;
+        auto startRange = inputIt_.value().fromMessage + inputIt_.value().requestedRegexMatches;
+        auto endRange = inputIt_.value().fromMessage + inputIt_.value().numberOfMessagesToBeAnalyzed;
+
+        const auto& focusChunkOrder = inputIt_.value().focusChunkOrder;
+
+        if(false == focusChunkOrder.empty())
+        {
+            auto& numberOfDispatchedChunks = inputIt_.value().numberOfDispatchedChunks;
+
+            if(numberOfDispatchedChunks < static_cast<int>(focusChunkOrder.size()))
+            {
+                const auto chunkFrom = inputIt_.value().fromMessage + focusChunkOrder[static_cast<std::size_t>(numberOfDispatchedChunks)] * CHUNK_SIZE;
+                endRange = qMin(endRange, chunkFrom + CHUNK_SIZE);
+                startRange = chunkFrom;
+                ++numberOfDispatchedChunks;
+            }
+            else
+            {
+                startRange = endRange;
+            }
+        }
 
         if(startRange < endRange)
         {
@@ -170,78 +272,33 @@ bool CMTAnalyzer::regexAnalysisIteration(tRequestMap::iterator& inputIt, const t
             tProcessingStrings processingStrings;
             processingStrings.reserve(chunkSize);
 
-            const auto& searchColumnsMap = qAsConst(inputIt_.value().searchColumns);
-            std::set<eSearchResultColumn> searchColumnsSet;
+            const auto searchColumnsSet = getSearchColumnsSet(inputIt_.value().searchColumns);
 
-            for (auto iter = searchColumnsMap.begin(); iter != searchColumnsMap.end(); ++iter)
             {
-                if(iter.value())
-                {
-                    searchColumnsSet.insert(iter.key());
-                }
-            }
+                CPerfScope perfScope(ePerfStage::eChunkStringBuilding);
 
-            for(int j= 0; j < chunkSize; ++j)
-            {
-                auto msgIdxInMainTable = startRange + j;
-                auto msgIdx = pFile->getMsgIdFromIndexInMainTable( msgIdxInMainTable );
-                auto pMsg = pFile->getMsg(msgIdx);
+                // id-s of the whole chunk are resolved at once. In case of the filtered file the bitmap index is iterated
+                std::vector<tMsgId> msgIds;
+                pFile->getMsgIdsFromIndexesInMainTable( startRange, chunkSize, msgIds );
 
-                if(nullptr != pMsg)
+                for(int j= 0; j < static_cast<int>(msgIds.size()); ++j)
                 {
-                    tQStringPtr pStr = std::make_shared<QString>();
-
-                    tFieldRanges fieldRanges;
-                    int rangeCounter = 0;
+                    auto msgIdxInMainTable = startRange + j;
+                    auto msgIdx = msgIds[static_cast<std::size_t>(j)];
+                    auto pMsg = pFile->getMsg(msgIdx);
 
-                    for (auto iter = searchColumnsSet.begin(); iter != searchColumnsSet.end(); ++iter)
-                    {
-                        int newRangeCounter = rangeCounter;
-
-                        auto pStringData = getDataStrFromMsg(msgIdx, pMsg, *iter);
-
-                        if(nullptr != pStringData)
-                        {
-                            pStr->append(*pStringData);
-                            newRangeCounter += pStringData->size() - 1;
-
-                            if (std::next(iter) != searchColumnsSet.end())
-                            {
-                                pStr->append(" ");
-                                newRangeCounter += 2;
-                            }
-
-                            tIntRange strRange(rangeCounter, rangeCounter + pStringData->size() - 1);
-                            fieldRanges.insert(*iter, strRange);
-
-                            rangeCounter = newRangeCounter;
-                        }
-                    }
-
-                    tItemMetadata itemMetadata( msgIdx,
-                                                msgIdxInMainTable,
-                                                fieldRanges,
-                                                pStr->size(),
-                                                pMsg->getSize(),
-                                                pMsg->getTimestamp());
-
-                    processingStrings.push_back( tProcessingStringItem( itemMetadata, pStr ) );
-                }
-                else
-                {
-                    qDebug() << "Failed to get msg with idx - " << startRange + j;
-                    tItemMetadata itemMetadata( msgIdx,
-                                                msgIdxInMainTable,
-                                                tFieldRanges(),
-                                                0,
-                                                0u,
-                                                0u);
-                    processingStrings.push_back( tProcessingStringItem( itemMetadata, std::make_shared<QString>( "" ) ) ); // TODO: optimize
+                    processingStrings.push_back( createProcessingStringItem( msgIdx, msgIdxInMainTable, pMsg, searchColumnsSet ) );
                 }
             }
 
             inputIt_.value().requestedRegexMatches+=static_cast<int>(processingStrings.size());
 
+            if(false == focusChunkOrder.empty() && static_cast<int>(processingStrings.size()) < chunkSize)
+            {
+                // chunks are not requested sequentially, thus the missing messages are not requested later
+                inputIt_.value().numberOfMessagesToBeAnalyzed -= chunkSize - static_cast<int>(processingStrings.size());
+            }
+
             auto workerThreadCookie = inputIt_.value().workerThreadCookieCounter++;
             tRequestData::tPendingResultsItem pendingResultsItem;
             pendingResultsItem.workerId = workerId_;
@@ -269,6 +326,10 @@ bool CMTAnalyzer::regexAnalysisIteration(tRequestMap::iterator& inputIt, const t
                 workerThreadCookie
             );
 
+            analyzePortionData.postTimestampNs = CPerfCounters::now();
+            analyzePortionData.pRegexCostProfiler = inputIt_->pRegexCostProfiler;
+            analyzePortionData.pCancellationToken = inputIt_->pCancellationToken;
+
             QMetaObject::invokeMethod(workerItem.pDLTRegexAnalyzer, "analyzePortion", Qt::QueuedConnection,
                                       Q_ARG(tAnalyzePortionData, analyzePortionData));
         }
@@ -282,11 +343,14 @@ bool CMTAnalyzer::regexAnalysisIteration(tRequestMap::iterator& inputIt, const t
         {
             if(-1 == workerId)
             {
-                auto it = mWorkerItemMap.begin();
-                auto i = 0;
+                const int numberOfWorkers = static_cast<int>(mWorkerItemMap.size());
+                const int numberOfUsedWorkers = qMin(inputIt->numberOfThreads, numberOfWorkers);
 
-                for(; it != mWorkerItemMap.end() && i < inputIt->numberOfThreads; ++it, ++i)
+                // start from the request-specific worker, so that the concurrent requests do not compete for the same threads
+                for(int i = 0; i < numberOfUsedWorkers; ++i)
                 {
+                    auto it = std::next(mWorkerItemMap.begin(), ( inputIt->firstWorkerIndex + i ) % numberOfWorkers);
+
                     // let's feed it some new activity
                     analysisIterationSpecificThread(requestId, inputIt, it.key(), it.value());
                 }
@@ -316,6 +380,10 @@ bool CMTAnalyzer::regexAnalysisIteration(tRequestMap::iterator& inputIt, const t
 
 void CMTAnalyzer::portionRegexAnalysisFinished( const tPortionRegexAnalysisFinishedData& portionRegexAnalysisFinishedData )
 {
+    CPerfCounters::getInstance().record(ePerfStage::eGUIDelivery,
+                                        portionRegexAnalysisFinishedData.finishTimestampNs,
+                                        CPerfCounters::now() - portionRegexAnalysisFinishedData.finishTimestampNs);
+
     auto requestIt = mRequestMap.find(portionRegexAnalysisFinishedData.requestId);
 
     if(requestIt != mRequestMap.end())
@@ -329,6 +397,10 @@ void CMTAnalyzer::portionRegexAnalysisFinished( const tPortionRegexAnalysisFinis
                              "The result diagram might be not what you expect to get.").arg(__FUNCTION__));
         }
 
+        requestIt->regexLimitsReport.merge(portionRegexAnalysisFinishedData.regexLimitsReport);
+
+        requestIt->regexCostProfile.merge(portionRegexAnalysisFinishedData.regexCostProfile);
+
         auto pClient = requestIt.value().pClient;
 
 #ifdef DEBUG_MESSAGES
@@ -380,6 +452,11 @@ void CMTAnalyzer::portionRegexAnalysisFinished( const tPortionRegexAnalysisFinis
                                   portionRegexAnalysisFinishedData.bUML_Req_Res_Ev_DuplicateFound,
                                   requestIt->regexScriptingMetadata.getGroupedViewIndices() );
 
+                                if(true == analysisFinished)
+                                {
+                                    progressNotificationData.regexCostProfile = requestIt->regexCostProfile;
+                                }
+
                                 QMetaObject::invokeMethod(pClient_, "progressNotification", Qt::QueuedConnection,
                                                           Q_ARG(tProgressNotificationData, progressNotificationData));
 
@@ -403,6 +480,7 @@ void CMTAnalyzer::portionRegexAnalysisFinished( const tPortionRegexAnalysisFinis
                                 {
                                     if(true == analysisFinished) // if all entries are processed
                                     {
+                                        reportRegexLimits(requestIt->regexStr, requestIt->regexLimitsReport);
                                         mRequestMap.erase(requestIt);
                                         break; // stop loop
                                     }
@@ -410,6 +488,7 @@ void CMTAnalyzer::portionRegexAnalysisFinished( const tPortionRegexAnalysisFinis
                             }
                             else
                             {
+                                requestIt->cancel();
                                 mRequestMap.erase(requestIt);
                                 break; // stop loop
                             }
@@ -447,6 +526,8 @@ void CMTAnalyzer::cancelRequest( const std::weak_ptr<IDLTMessageAnalyzerControll
         {
             if(foundRequest->pClient.lock() == pClient.lock()) // ONLY if client addresses are equal
             {
+                // workers stop the in-flight portions of the request and drop the queued ones
+                foundRequest->cancel();
                 mRequestMap.erase(foundRequest); // let's remove the request
             }
         }
@@ -455,7 +536,7 @@ void CMTAnalyzer::cancelRequest( const std::weak_ptr<IDLTMessageAnalyzerControll
 
 int CMTAnalyzer::getMaximumNumberOfThreads() const
 {
-    return QThread::idealThreadCount();
+    return static_cast<int>(mWorkerItemMap.size());
 }
 
 //CMTAnalyzer::tWorkerItem
@@ -488,8 +569,12 @@ CMTAnalyzer::tRequestData::tRequestData( const std::weak_ptr<IDLTMessageAnalyzer
     regexStr(regexStr_),
     selectedLiases(selectedLiases_),
     fromMessage(fromMessage_),
+    firstWorkerIndex(0),
     workerThreadCookieCounter(0),
     bUML_Req_Res_Ev_DuplicateFound(false),
+    focusChunkOrder(),
+    numberOfDispatchedChunks(0),
+    pCancellationToken(std::make_shared<std::atomic<bool>>(false)),
     pendingResults()
 {
     if( numberOfMessagesToBeAnalyzed >= pFile->size() )
@@ -501,6 +586,11 @@ CMTAnalyzer::tRequestData::tRequestData( const std::weak_ptr<IDLTMessageAnalyzer
     }
 }
 
+void CMTAnalyzer::tRequestData::cancel()
+{
+    pCancellationToken->store(true, std::memory_order_relaxed);
+}
+
 PUML_PACKAGE_BEGIN(DMA_Analyzer)
     PUML_CLASS_BEGIN_CHECKED(CMTAnalyzer)
         PUML_INHERITANCE_CHECKED(IDLTMessageAnalyzerController, implements)
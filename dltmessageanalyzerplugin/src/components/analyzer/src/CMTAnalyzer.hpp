@@ -6,6 +6,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include <QRegularExpression>
 
@@ -28,7 +29,13 @@ class CMTAnalyzer: public IDLTMessageAnalyzerController,
 {
     Q_OBJECT
     public:
-        CMTAnalyzer(const tSettingsManagerPtr& pSettingsManager);
+        /**
+         * @brief CMTAnalyzer - constructor
+         * @param pSettingsManager - settings manager instance
+         * @param numberOfWorkers - number of the worker threads to be created.
+         * Values less or equal to 0 mean QThread::idealThreadCount()
+         */
+        CMTAnalyzer(const tSettingsManagerPtr& pSettingsManager, const int& numberOfWorkers = 0);
         ~CMTAnalyzer() override;
 
         //IDLTMessageAnalyzerController implementation
@@ -67,8 +74,22 @@ private: // methods
         QString regexStr; // the string using which the 'regex' field was creted
         QStringList selectedLiases; // the regex aliasaes that were used to form the query
         int fromMessage; // from which message to start analysis
+        int firstWorkerIndex; // index of the first worker, which is fed by this request
         tWorkerThreadCookie workerThreadCookieCounter;
         bool bUML_Req_Res_Ev_DuplicateFound = false;
+        tRegexLimitsReport regexLimitsReport; // messages, on which the regex has exceeded the execution limits
+        tRegexCostProfilerPtr pRegexCostProfiler; // set, if the regex cost should be profiled
+        tRegexCostProfile regexCostProfile; // merged profiles of the analyzed portions
+        // order of the chunks, if the analysis starts from the focus message. Empty for the sequential analysis.
+        // Results are delivered in the same order, thus the ones around the focus message come first
+        std::vector<int> focusChunkOrder;
+        int numberOfDispatchedChunks; // number of chunks from the focusChunkOrder, which were already requested
+        tCancellationTokenPtr pCancellationToken; // shared with all portions of the request
+
+        /**
+         * @brief cancel - sets the cancellation token, so that the workers stop analyzing the portions of the request
+         */
+        void cancel();
 
         struct tPendingResultsItem
         {
@@ -105,4 +126,6 @@ private: //fields
 
     tRequestMap mRequestMap;
     tRequestId mRequestIdCounter;
+    // concurrent requests are spread over the different workers
+    int mNextFirstWorkerIndex;
 };
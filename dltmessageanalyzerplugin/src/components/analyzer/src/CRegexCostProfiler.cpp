@@ -0,0 +1,371 @@
+/**
+ * @file    CRegexCostProfiler.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CRegexCostProfiler class
+ */
+
+#include <algorithm>
+#include <map>
+
+#include "common/CTreeItem.hpp"
+#include "common/CPerfCounters.hpp"
+#include "common/PCRE/PCREHelper.hpp"
+#include "CRegexCostProfiler.hpp"
+#include "DefinitionsInternal.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+// each cut and each branch costs one extra compilation and one extra match per profiled message
+static const std::size_t sMaxNumberOfCuts = 64u;
+static const std::size_t sMaxNumberOfBranches = 64u;
+
+/**
+ * @brief scanRegex - gets the number of the groups, which are open before each position of the regex,
+ * and the positions of the top-level alternations.
+ * Escaped characters, quoted sequences, character classes and comments are skipped.
+ * @param regexStr - regex string
+ * @param openGroups - output. Has size of the regex plus one
+ * @param topLevelAlternations - output. Positions of the '|' characters outside of any group
+ */
+static void scanRegex(const QString& regexStr, std::vector<int>& openGroups, std::vector<int>& topLevelAlternations)
+{
+    const int size = regexStr.size();
+    openGroups.assign(static_cast<std::size_t>(size + 1), 0);
+    topLevelAlternations.clear();
+
+    int depth = 0;
+    int i = 0;
+
+    while(i < size)
+    {
+        const QChar ch = regexStr[i];
+        int tokenEnd = i + 1;
+
+        if(QLatin1Char('\\') == ch)
+        {
+            if(i + 1 < size && QLatin1Char('Q') == regexStr[i + 1])
+            {
+                const int quoteEnd = regexStr.indexOf(QLatin1String("\\E"), i + 2);
+                tokenEnd = quoteEnd < 0 ? size : quoteEnd + 2;
+            }
+            else
+            {
+                tokenEnd = std::min(size, i + 2);
+            }
+        }
+        else if(QLatin1Char('[') == ch)
+        {
+            int j = i + 1;
+
+            if(j < size && QLatin1Char('^') == regexStr[j])
+            {
+                ++j;
+            }
+
+            // leading ']' is a literal
+            if(j < size && QLatin1Char(']') == regexStr[j])
+            {
+                ++j;
+            }
+
+            while(j < size && QLatin1Char(']') != regexStr[j])
+            {
+                if(QLatin1Char('\\') == regexStr[j])
+                {
+                    j += 2;
+                }
+                else if(QLatin1Char('[') == regexStr[j] && j + 1 < size && QLatin1Char(':') == regexStr[j + 1])
+                {
+                    const int posixClassEnd = regexStr.indexOf(QLatin1String(":]"), j + 2);
+                    j = posixClassEnd < 0 ? size : posixClassEnd + 2;
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+
+            tokenEnd = std::min(size, j + 1);
+        }
+        else if(QLatin1Char('(') == ch && i + 2 < size &&
+                QLatin1Char('?') == regexStr[i + 1] && QLatin1Char('#') == regexStr[i + 2])
+        {
+            const int commentEnd = regexStr.indexOf(QLatin1Char(')'), i);
+            tokenEnd = commentEnd < 0 ? size : commentEnd + 1;
+        }
+        else if(QLatin1Char('(') == ch)
+        {
+            ++depth;
+        }
+        else if(QLatin1Char(')') == ch)
+        {
+            depth = std::max(0, depth - 1);
+        }
+        else if(QLatin1Char('|') == ch && 0 == depth)
+        {
+            topLevelAlternations.push_back(i);
+        }
+
+        for(int j = i + 1; j <= tokenEnd; ++j)
+        {
+            openGroups[static_cast<std::size_t>(j)] = depth;
+        }
+
+        i = tokenEnd;
+    }
+}
+
+/**
+ * @brief skipQuantifier - gets the position after the quantifier, which starts at the provided position
+ * @param regexStr - regex string
+ * @param pos - position right after the quantified item
+ * @return - position after the quantifier. Provided position, if there is no quantifier
+ */
+static int skipQuantifier(const QString& regexStr, int pos)
+{
+    const int size = regexStr.size();
+
+    if(pos >= size)
+    {
+        return pos;
+    }
+
+    const QChar ch = regexStr[pos];
+
+    if(QLatin1Char('*') == ch || QLatin1Char('+') == ch || QLatin1Char('?') == ch)
+    {
+        ++pos;
+    }
+    else if(QLatin1Char('{') == ch)
+    {
+        const int closePos = regexStr.indexOf(QLatin1Char('}'), pos);
+
+        if(closePos < 0)
+        {
+            return pos;
+        }
+
+        for(int i = pos + 1; i < closePos; ++i)
+        {
+            if(false == regexStr[i].isDigit() && QLatin1Char(',') != regexStr[i])
+            {
+                // not a quantifier, but a literal
+                return pos;
+            }
+        }
+
+        pos = closePos + 1;
+    }
+    else
+    {
+        return pos;
+    }
+
+    // lazy or possessive quantifier
+    if(pos < size && ( QLatin1Char('?') == regexStr[pos] || QLatin1Char('+') == regexStr[pos] ))
+    {
+        ++pos;
+    }
+
+    return pos;
+}
+
+CRegexCostProfiler::CRegexCostProfiler(const QString& regexStr,
+                                       const QRegularExpression::PatternOptions& patternOptions,
+                                       const int& matchLimit,
+                                       const int& depthLimit):
+mRegexStr(regexStr),
+mPatternOptions(patternOptions),
+mMatchLimit(matchLimit),
+mDepthLimit(depthLimit),
+mCompileFlag(),
+mRegex(),
+mCutRegexes(),
+mGroupCuts(),
+mBranches()
+{
+}
+
+void CRegexCostProfiler::compile() const
+{
+    const QString& regexStr = mRegexStr;
+    const QRegularExpression::PatternOptions& patternOptions = mPatternOptions;
+
+    // JIT compilation should not be attributed to the first profiled message
+    mRegex = createLimitedRegex(QRegularExpression(addRegexOptions(regexStr), patternOptions), mMatchLimit, mDepthLimit);
+
+    std::vector<int> openGroups;
+    std::vector<int> topLevelAlternations;
+    scanRegex(regexStr, openGroups, topLevelAlternations);
+
+    std::map<int /*cut position*/, int /*index in mCutRegexes*/> cutIndexes;
+
+    auto getCutIdx = [this, &regexStr, &patternOptions, &openGroups, &cutIndexes](const int& cutPos)
+    {
+        auto foundCut = cutIndexes.find(cutPos);
+
+        if(foundCut != cutIndexes.end())
+        {
+            return foundCut->second;
+        }
+
+        int result = -1;
+
+        QString prefix = regexStr.left(cutPos);
+        prefix.append(QString(openGroups[static_cast<std::size_t>(cutPos)], QLatin1Char(')')));
+
+        QRegularExpression cutRegex(addRegexOptions(prefix), patternOptions);
+
+        if(true == cutRegex.isValid())
+        {
+            result = static_cast<int>(mCutRegexes.size());
+            mCutRegexes.push_back(createLimitedRegex(cutRegex, mMatchLimit, mDepthLimit));
+        }
+
+        cutIndexes.insert(std::make_pair(cutPos, result));
+        return result;
+    };
+
+    auto pTree = std::make_shared<tTreeItem>(nullptr, 0,
+                                             CTreeItem::tSortingFunction(),
+                                             CTreeItem::tHandleDuplicateFunc(),
+                                             CTreeItem::tFindItemFunc());
+    parseRegexFiltersView(pTree, regexStr);
+
+    auto preVisitFunction = [this, &regexStr, &getCutIdx](tTreeItem* pItem)
+    {
+        // each group needs up to two new cuts. The rest of the groups is not profiled
+        if(mCutRegexes.size() + 2u > sMaxNumberOfCuts)
+        {
+            return false;
+        }
+
+        if(nullptr != pItem &&
+           eRegexFiltersRowType::Text != pItem->data(static_cast<int>(eRegexFiltersColumn::RowType)).get<eRegexFiltersRowType>())
+        {
+            const auto& range = pItem->data(static_cast<int>(eRegexFiltersColumn::Range)).get<tIntRange>();
+
+            if(range.from >= 0 && range.to < regexStr.size())
+            {
+                tGroupCut groupCut;
+                groupCut.groupIndex = pItem->data(static_cast<int>(eRegexFiltersColumn::GroupIndex)).get<int>();
+                groupCut.cutBeforeIdx = getCutIdx(range.from);
+                groupCut.cutAfterIdx = getCutIdx(skipQuantifier(regexStr, range.to + 1));
+
+                if(groupCut.cutBeforeIdx >= 0 && groupCut.cutAfterIdx >= 0)
+                {
+                    mGroupCuts.push_back(groupCut);
+                }
+            }
+        }
+
+        return true;
+    };
+
+    pTree->visit(preVisitFunction, CTreeItem::tVisitFunction(), false, true, false);
+
+    if(false == topLevelAlternations.empty())
+    {
+        topLevelAlternations.push_back(regexStr.size());
+
+        int branchFrom = 0;
+
+        for(const auto& alternationPos : topLevelAlternations)
+        {
+            if(mBranches.size() >= sMaxNumberOfBranches)
+            {
+                break;
+            }
+
+            tBranch branch;
+            branch.range = tIntRange(branchFrom, alternationPos - 1);
+            branch.regex = QRegularExpression(addRegexOptions(regexStr.mid(branchFrom, alternationPos - branchFrom)), patternOptions);
+
+            // e.g. the back-references to the groups of the other branches make the branch invalid
+            if(true == branch.regex.isValid())
+            {
+                branch.regex = createLimitedRegex(branch.regex, mMatchLimit, mDepthLimit);
+                mBranches.push_back(branch);
+            }
+
+            branchFrom = alternationPos + 1;
+        }
+    }
+}
+
+bool CRegexCostProfiler::profile(const QString& str, tRegexCostProfile& regexCostProfile) const
+{
+    std::call_once(mCompileFlag, [this]()
+    {
+        compile();
+    });
+
+    bool bWithinLimits = true;
+
+    // invalid match means, that PCRE2 has hit the execution limits
+    auto measure = [&str, &bWithinLimits](const QRegularExpression& regex)
+    {
+        const auto startNs = CPerfCounters::now();
+        const bool bValid = regex.match(str).isValid();
+        const auto durationNs = static_cast<CPerfCounters::tDurationNs>(CPerfCounters::now() - startNs);
+        bWithinLimits = bWithinLimits && bValid;
+        return durationNs;
+    };
+
+    const auto overallDurationNs = measure(mRegex);
+
+    if(false == bWithinLimits)
+    {
+        return false;
+    }
+
+    std::vector<CPerfCounters::tDurationNs> cutDurations;
+    cutDurations.reserve(mCutRegexes.size());
+
+    for(const auto& cutRegex : mCutRegexes)
+    {
+        cutDurations.push_back(measure(cutRegex));
+    }
+
+    std::vector<CPerfCounters::tDurationNs> branchDurations;
+    branchDurations.reserve(mBranches.size());
+
+    for(const auto& branch : mBranches)
+    {
+        branchDurations.push_back(measure(branch.regex));
+    }
+
+    if(false == bWithinLimits)
+    {
+        return false;
+    }
+
+    regexCostProfile.regex = mRegexStr;
+    ++regexCostProfile.numberOfProfiledMessages;
+    regexCostProfile.overallDurationNs += overallDurationNs;
+
+    for(const auto& groupCut : mGroupCuts)
+    {
+        // longer prefix might be faster than the shorter one, e.g. if it fails earlier. Such difference is not attributed
+        const auto costNs = cutDurations[static_cast<std::size_t>(groupCut.cutAfterIdx)] -
+                            cutDurations[static_cast<std::size_t>(groupCut.cutBeforeIdx)];
+        regexCostProfile.groupDurationsNs[groupCut.groupIndex] += std::max<CPerfCounters::tDurationNs>(0, costNs);
+    }
+
+    for(std::size_t i = 0u; i < mBranches.size(); ++i)
+    {
+        regexCostProfile.branchDurationsNs[mBranches[i].range] += branchDurations[i];
+    }
+
+    return true;
+}
+
+const QString& CRegexCostProfiler::getRegexStr() const
+{
+    return mRegexStr;
+}
+
+PUML_PACKAGE_BEGIN(DMA_Analyzer)
+    PUML_CLASS_BEGIN_CHECKED(CRegexCostProfiler)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
@@ -0,0 +1,89 @@
+/**
+ * @file    CRegexCostProfiler.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CRegexCostProfiler class
+ */
+#pragma once
+
+#include "memory"
+#include "mutex"
+#include "vector"
+
+#include <QRegularExpression>
+
+#include "common/Definitions.hpp"
+
+/**
+ * @brief The CRegexCostProfiler class - attributes the match time of the regex to its parts.
+ * QRegularExpression provides no access to the PCRE2 callouts, thus the cost is measured with the sub-patterns:
+ * - cost of the capture group is the difference between the match time of the regex prefix, which ends after the group
+ * ( including its quantifier ), and of the prefix, which ends before the group. Groups, which are still open at the end
+ * of the prefix, are closed.
+ * - cost of the top-level alternation branch is the match time of the branch alone.
+ * Structure of the regex is taken from the filters view parser, thus group indexes are the same as in the filters view.
+ * Results are estimations, which show the expensive parts of the regex, not the exact numbers.
+ * All sub-patterns are restricted by the same execution limits as the searched regex.
+ * Number of the profiled groups and branches is capped, so that huge regexes do not multiply the compilation and the match time.
+ * Sub-patterns are compiled lazily, on the first profiled message, thus in the worker thread.
+ * After that the instance is not modified, thus it can be shared between the worker threads.
+ */
+class CRegexCostProfiler
+{
+public:
+
+    /**
+     * @brief CRegexCostProfiler - stores the regex. It is parsed and its sub-patterns are compiled on the first profiled message.
+     * Parsing is expensive, thus instance should be created once per request.
+     * @param regexStr - regex string, without the options
+     * @param patternOptions - options of the regex, which is used for the search
+     * @param matchLimit - max number of the backtracking steps per match. 0 means no limit
+     * @param depthLimit - max depth of the backtracking per match. 0 means no limit
+     */
+    CRegexCostProfiler(const QString& regexStr,
+                       const QRegularExpression::PatternOptions& patternOptions,
+                       const int& matchLimit,
+                       const int& depthLimit);
+
+    /**
+     * @brief profile - measures the cost of the regex on the provided string and adds it to the profile
+     * @param str - analyzed string
+     * @param regexCostProfile - output profile
+     * @return - false, if any of the sub-patterns has hit the execution limits on the string.
+     * Such string is skipped and the profile is not changed.
+     */
+    bool profile(const QString& str, tRegexCostProfile& regexCostProfile) const;
+
+    const QString& getRegexStr() const;
+
+private:
+
+    struct tGroupCut
+    {
+        int groupIndex = -1;
+        int cutBeforeIdx = -1; // index in the mCutRegexes
+        int cutAfterIdx = -1;
+    };
+
+    struct tBranch
+    {
+        tIntRange range;
+        QRegularExpression regex;
+    };
+
+    void compile() const;
+
+    QString mRegexStr;
+    QRegularExpression::PatternOptions mPatternOptions;
+    int mMatchLimit;
+    int mDepthLimit;
+
+    // filled once by compile()
+    mutable std::once_flag mCompileFlag;
+    mutable QRegularExpression mRegex;
+    // regex prefixes, which end at the borders of the groups. Invalid ones are not used
+    mutable std::vector<QRegularExpression> mCutRegexes;
+    mutable std::vector<tGroupCut> mGroupCuts;
+    mutable std::vector<tBranch> mBranches;
+};
+
+typedef std::shared_ptr<const CRegexCostProfiler> tRegexCostProfilerPtr;
@@ -0,0 +1,243 @@
+/**
+ * @file    CSearchPreview.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CSearchPreview class
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../api/CSearchPreview.hpp"
+#include "DefinitionsInternal.hpp"
+
+#include "components/settings/api/ISettingsManager.hpp"
+#include "components/logsWrapper/api/IFileWrapper.hpp"
+#include "components/logsWrapper/api/IMsgWrapper.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+// preview starts, once the user does not type for this time
+static const int sDebounceTimeoutMs = 300;
+// GUI thread is not blocked for longer than that
+static const int sSliceDurationMs = 15;
+// hard cap of the whole preview
+static const int sPreviewTimeCapMs = 300;
+static const int sSampleBlockSize = 100;
+static const int sMaxSampledMessages = 20000;
+static const int sMaxNumberOfPreviewMatches = 100;
+
+CSearchPreview::CSearchPreview(const tSettingsManagerPtr& pSettingsManager, QObject* pParent):
+QObject(pParent),
+CSettingsManagerClient(pSettingsManager),
+mDebounceTimer(),
+mSliceTimer(),
+mPendingRequest(),
+mPreviewState()
+{
+    mDebounceTimer.setSingleShot(true);
+    mDebounceTimer.setInterval(sDebounceTimeoutMs);
+
+    connect(&mDebounceTimer, &QTimer::timeout, this, [this]()
+    {
+        startPreview();
+    });
+
+    mSliceTimer.setSingleShot(false);
+    mSliceTimer.setInterval(0);
+
+    connect(&mSliceTimer, &QTimer::timeout, this, [this]()
+    {
+        processPreviewSlice();
+    });
+}
+
+void CSearchPreview::schedulePreview( const tFileWrapperPtr& pFile,
+                                      const QString& regexStr,
+                                      const QRegularExpression::PatternOptions& patternOptions,
+                                      const tSearchResultColumnsVisibilityMap& searchColumns )
+{
+    cancelPreview();
+
+    mPendingRequest.pFile = pFile;
+    mPendingRequest.regexStr = regexStr;
+    mPendingRequest.patternOptions = patternOptions;
+    mPendingRequest.searchColumns = searchColumns;
+
+    mDebounceTimer.start();
+}
+
+void CSearchPreview::cancelPreview()
+{
+    mDebounceTimer.stop();
+    mSliceTimer.stop();
+    mPendingRequest = tPreviewRequest();
+    mPreviewState = tPreviewState();
+}
+
+bool CSearchPreview::isPreviewInProgress() const
+{
+    return true == mDebounceTimer.isActive() || true == mPreviewState.bActive;
+}
+
+void CSearchPreview::startPreview()
+{
+    auto request = mPendingRequest;
+    mPendingRequest = tPreviewRequest();
+
+    if(nullptr == request.pFile || true == request.regexStr.isEmpty())
+    {
+        return;
+    }
+
+    mPreviewState = tPreviewState();
+    auto& result = mPreviewState.result;
+    result.regexStr = request.regexStr;
+
+    const QRegularExpression regex(addRegexOptions(request.regexStr), request.patternOptions);
+
+    if(false == regex.isValid())
+    {
+        result.errorString = getFormattedRegexError(regex);
+        emit previewFinished(result);
+        return;
+    }
+
+    // one pathological message should not exceed the time cap of the whole preview
+    mPreviewState.regex = createLimitedRegex(regex,
+                                             getSettingsManager()->getRegexMatchLimit(),
+                                             getSettingsManager()->getRegexDepthLimit());
+    // features are not used within the preview, thus only the highlighting data is parsed
+    static_cast<void>(mPreviewState.regexMetadata.parse(regex, false, false, false));
+    mPreviewState.colors = generateColors(getSettingsManager()->getSearchResultHighlightingGradient());
+    mPreviewState.searchColumnsSet = getSearchColumnsSet(request.searchColumns);
+    mPreviewState.pFile = request.pFile;
+
+    result.numberOfMessages = request.pFile->size();
+
+    if(0 >= result.numberOfMessages)
+    {
+        emit previewFinished(result);
+        return;
+    }
+
+    // blocks are evenly spread over the file, so that the estimation is not biased by its beginning
+    const int numberOfFileBlocks = ( result.numberOfMessages + sSampleBlockSize - 1 ) / sSampleBlockSize;
+    mPreviewState.numberOfBlocks = std::min(numberOfFileBlocks, sMaxSampledMessages / sSampleBlockSize);
+    mPreviewState.blockStride = numberOfFileBlocks / mPreviewState.numberOfBlocks;
+    mPreviewState.bActive = true;
+    mPreviewState.elapsedTimer.start();
+
+    processPreviewSlice();
+
+    if(true == mPreviewState.bActive)
+    {
+        mSliceTimer.start();
+    }
+}
+
+void CSearchPreview::processPreviewSlice()
+{
+    if(false == mPreviewState.bActive)
+    {
+        mSliceTimer.stop();
+        return;
+    }
+
+    auto& result = mPreviewState.result;
+
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+
+    std::vector<tMsgId> msgIds;
+
+    while(mPreviewState.nextBlockIdx < mPreviewState.numberOfBlocks)
+    {
+        if(mPreviewState.elapsedTimer.elapsed() >= sPreviewTimeCapMs)
+        {
+            result.bTimeCapReached = true;
+            break;
+        }
+
+        if(sliceTimer.elapsed() >= sSliceDurationMs)
+        {
+            // let the GUI handle the input. Processing continues on the next timer tick
+            return;
+        }
+
+        const int blockFrom = mPreviewState.nextBlockIdx * mPreviewState.blockStride * sSampleBlockSize;
+        const int blockSize = std::min(sSampleBlockSize, result.numberOfMessages - blockFrom);
+        ++mPreviewState.nextBlockIdx;
+
+        msgIds.clear();
+        mPreviewState.pFile->getMsgIdsFromIndexesInMainTable(blockFrom, blockSize, msgIds);
+
+        for(int i = 0; i < static_cast<int>(msgIds.size()); ++i)
+        {
+            const auto msgId = msgIds[static_cast<std::size_t>(i)];
+            const auto processingString = createProcessingStringItem(msgId,
+                                                                     blockFrom + i,
+                                                                     mPreviewState.pFile->getMsg(msgId),
+                                                                     mPreviewState.searchColumnsSet);
+
+            const auto match = mPreviewState.regex.match(*(processingString.second));
+
+            ++result.numberOfSampledMessages;
+
+            if(false == match.hasMatch())
+            {
+                continue;
+            }
+
+            ++result.numberOfMatchesInSample;
+
+            if(static_cast<int>(result.firstMatches.matchedItemVec.size()) < sMaxNumberOfPreviewMatches)
+            {
+                tFoundMatches foundMatches(processingString.first.msgSize,
+                                           processingString.first.timeStamp,
+                                           processingString.first.msgId);
+
+                for (int groupIdx = 1; groupIdx <= match.lastCapturedIndex(); ++groupIdx)
+                {
+                    if(0 != match.capturedLength(groupIdx))
+                    {
+                        foundMatches.foundMatchesVec.emplace_back( tFoundMatch( match.captured(groupIdx),
+                                                                                tIntRange( match.capturedStart(groupIdx), match.capturedEnd(groupIdx) - 1 ),
+                                                                                groupIdx ) );
+                    }
+                }
+
+                tItemMetadata itemMetadata = processingString.first;
+                static_cast<void>(itemMetadata.updateHighlightingInfo(foundMatches,
+                                                                      mPreviewState.colors,
+                                                                      mPreviewState.regexMetadata));
+
+                result.firstMatches.matchedItemVec.push_back( std::make_shared<tFoundMatchesPackItem>( std::move(itemMetadata), std::move(foundMatches) ) );
+            }
+        }
+    }
+
+    finishPreview();
+}
+
+void CSearchPreview::finishPreview()
+{
+    mSliceTimer.stop();
+
+    auto result = mPreviewState.result;
+    mPreviewState = tPreviewState();
+
+    if(0 != result.numberOfSampledMessages)
+    {
+        result.estimatedNumberOfMatches = static_cast<int>( static_cast<double>(result.numberOfMatchesInSample) *
+                                                            result.numberOfMessages / result.numberOfSampledMessages + 0.5 );
+    }
+
+    emit previewFinished(result);
+}
+
+PUML_PACKAGE_BEGIN(DMA_Analyzer_API)
+    PUML_CLASS_BEGIN_CHECKED(CSearchPreview)
+        PUML_INHERITANCE_CHECKED(QObject, extends)
+        PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
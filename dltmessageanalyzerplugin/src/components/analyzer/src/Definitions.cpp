@@ -9,7 +9,9 @@ numberOfThreads(0),
 isContinuous(false),
 searchColumns(),
 regexStr(),
-selectedAliases()
+selectedAliases(),
+timeRange(),
+focusMessage(-1)
 {
 }
 
@@ -31,7 +33,9 @@ numberOfThreads(numberOfThreads_),
 isContinuous(isContinuous_),
 searchColumns(searchColumns_),
 regexStr(regexStr_),
-selectedAliases(selectedAliases_)
+selectedAliases(selectedAliases_),
+timeRange(),
+focusMessage(-1)
 {
 }
 
@@ -41,7 +45,8 @@ requestState(eRequestState::ERROR_STATE),
 progress(0),
 processedMatches(),
 bUML_Req_Res_Ev_DuplicateFound(false),
-groupedViewIndices()
+groupedViewIndices(),
+regexCostProfile()
 {
 }
 
@@ -57,6 +62,7 @@ requestState(requestState_),
 progress(progress_),
 processedMatches(processedMatches_),
 bUML_Req_Res_Ev_DuplicateFound(bUML_Req_Res_Ev_DuplicateFound_),
-groupedViewIndices(groupedViewIndices_)
+groupedViewIndices(groupedViewIndices_),
+regexCostProfile()
 {
 }
@@ -1,3 +1,8 @@
+#include "QDebug"
+
+#include "components/logsWrapper/api/IMsgWrapper.hpp"
+#include "components/log/api/CLog.hpp"
+
 #include "DefinitionsInternal.hpp"
 
 tPortionRegexAnalysisFinishedData::tPortionRegexAnalysisFinishedData():
@@ -7,7 +12,8 @@ portionAnalysisState(),
 processedMatches(),
 workerId(),
 workerThreadCookie(),
-bUML_Req_Res_Ev_DuplicateFound(false)
+bUML_Req_Res_Ev_DuplicateFound(false),
+finishTimestampNs(0)
 {}
 
 tPortionRegexAnalysisFinishedData::tPortionRegexAnalysisFinishedData(
@@ -24,7 +30,8 @@ portionAnalysisState(portionAnalysisState_),
 processedMatches(processedMatches_),
 workerId(workerId_),
 workerThreadCookie(workerThreadCookie_),
-bUML_Req_Res_Ev_DuplicateFound(bUML_Req_Res_Ev_DuplicateFound_)
+bUML_Req_Res_Ev_DuplicateFound(bUML_Req_Res_Ev_DuplicateFound_),
+finishTimestampNs(0)
 {}
 
 tAnalyzePortionData::tAnalyzePortionData():
@@ -32,7 +39,10 @@ requestId(INVALID_REQUEST_ID),
 processingStrings(),
 regex(),
 regexMetadata(),
-workerThreadCookie()
+workerThreadCookie(),
+postTimestampNs(0),
+pRegexCostProfiler(nullptr),
+pCancellationToken(nullptr)
 {}
 
 tAnalyzePortionData::tAnalyzePortionData(
@@ -45,5 +55,187 @@ requestId(requestId_),
 processingStrings(processingStrings_),
 regex(regex_),
 regexMetadata(regexMetadata_),
-workerThreadCookie(workerThreadCookie_)
+workerThreadCookie(workerThreadCookie_),
+postTimestampNs(0),
+pRegexCostProfiler(nullptr),
+pCancellationToken(nullptr)
 {}
+
+QRegularExpression createLimitedRegex(const QRegularExpression& regex, const int& matchLimit, const int& depthLimit)
+{
+    if(0 == matchLimit && 0 == depthLimit)
+    {
+        QRegularExpression result(regex);
+        result.optimize();
+        return result;
+    }
+
+    // QRegularExpression has no API for the PCRE2 match context,
+    // thus limits are passed as the start-of-pattern options.
+    // PCRE2 allows them only to lower the built-in limits.
+    QString limitsPrefix;
+
+    if(0 != matchLimit)
+    {
+        limitsPrefix.append(QString("(*LIMIT_MATCH=%1)").arg(matchLimit));
+    }
+
+    if(0 != depthLimit)
+    {
+        limitsPrefix.append(QString("(*LIMIT_DEPTH=%1)").arg(depthLimit));
+    }
+
+    QRegularExpression result(limitsPrefix + regex.pattern(), regex.patternOptions());
+
+    if(false == result.isValid())
+    {
+        SEND_WRN(QString("[createLimitedRegex] Unable to apply the regex execution limits: %1. Limits are ignored.")
+                 .arg(result.errorString()));
+        result = regex;
+    }
+
+    // compiles and JIT-s the pattern right away, so that the first match is not charged for it
+    result.optimize();
+
+    return result;
+}
+
+bool isCancelled(const tCancellationTokenPtr& pCancellationToken)
+{
+    // token carries no data, which would need to be synchronized with it
+    return nullptr != pCancellationToken && true == pCancellationToken->load(std::memory_order_relaxed);
+}
+
+tSearchColumnsSet getSearchColumnsSet(const tSearchResultColumnsVisibilityMap& searchColumns)
+{
+    tSearchColumnsSet result;
+
+    for (auto iter = searchColumns.begin(); iter != searchColumns.end(); ++iter)
+    {
+        if(iter.value())
+        {
+            result.insert(iter.key());
+        }
+    }
+
+    return result;
+}
+
+static void updateFirstMessage(tMsgId& firstMessage, const tMsgId& msgId)
+{
+    if(INVALID_MSG_ID == firstMessage || msgId < firstMessage)
+    {
+        firstMessage = msgId;
+    }
+}
+
+void tRegexLimitsReport::addSkippedMessage(const tMsgId& msgId)
+{
+    updateFirstMessage(firstSkippedMessage, msgId);
+    ++numberOfSkippedMessages;
+}
+
+void tRegexLimitsReport::addSlowMessage(const tMsgId& msgId)
+{
+    updateFirstMessage(firstSlowMessage, msgId);
+    ++numberOfSlowMessages;
+}
+
+void tRegexLimitsReport::merge(const tRegexLimitsReport& other)
+{
+    if(other.numberOfSkippedMessages > 0)
+    {
+        updateFirstMessage(firstSkippedMessage, other.firstSkippedMessage);
+        numberOfSkippedMessages += other.numberOfSkippedMessages;
+    }
+
+    if(other.numberOfSlowMessages > 0)
+    {
+        updateFirstMessage(firstSlowMessage, other.firstSlowMessage);
+        numberOfSlowMessages += other.numberOfSlowMessages;
+    }
+}
+
+void reportRegexLimits(const QString& pattern, const tRegexLimitsReport& regexLimitsReport)
+{
+    static const int sMaxReportedPatternLength = 100;
+
+    QString reportedPattern = pattern.size() > sMaxReportedPatternLength ?
+                              pattern.left(sMaxReportedPatternLength) + "..." : pattern;
+
+    if(regexLimitsReport.numberOfSkippedMessages > 0)
+    {
+        SEND_WRN(QString("Pattern \"%1\" exceeded the regex execution limits on %2 message(s), e.g. #%3. "
+                         "These messages were skipped. Check the pattern for the nested quantifiers.")
+                 .arg(reportedPattern)
+                 .arg(regexLimitsReport.numberOfSkippedMessages)
+                 .arg(regexLimitsReport.firstSkippedMessage));
+    }
+
+    if(regexLimitsReport.numberOfSlowMessages > 0)
+    {
+        SEND_WRN(QString("Pattern \"%1\" exceeded the per-message time budget on %2 message(s), e.g. #%3. "
+                         "Their matches are kept. Check the pattern for the nested quantifiers.")
+                 .arg(reportedPattern)
+                 .arg(regexLimitsReport.numberOfSlowMessages)
+                 .arg(regexLimitsReport.firstSlowMessage));
+    }
+}
+
+tProcessingStringItem createProcessingStringItem(const tMsgId& msgId,
+                                                 const int& msgIdxInMainTable,
+                                                 const tMsgWrapperPtr& pMsg,
+                                                 const tSearchColumnsSet& searchColumnsSet)
+{
+    if(nullptr != pMsg)
+    {
+        tQStringPtr pStr = std::make_shared<QString>();
+
+        tFieldRanges fieldRanges;
+        int rangeCounter = 0;
+
+        for (auto iter = searchColumnsSet.begin(); iter != searchColumnsSet.end(); ++iter)
+        {
+            int newRangeCounter = rangeCounter;
+
+            auto pStringData = getDataStrFromMsg(msgId, pMsg, *iter);
+
+            if(nullptr != pStringData)
+            {
+                pStr->append(*pStringData);
+                newRangeCounter += pStringData->size() - 1;
+
+                if (std::next(iter) != searchColumnsSet.end())
+                {
+                    pStr->append(" ");
+                    newRangeCounter += 2;
+                }
+
+                tIntRange strRange(rangeCounter, rangeCounter + pStringData->size() - 1);
+                fieldRanges.insert(*iter, strRange);
+
+                rangeCounter = newRangeCounter;
+            }
+        }
+
+        tItemMetadata itemMetadata( msgId,
+                                    msgIdxInMainTable,
+                                    fieldRanges,
+                                    pStr->size(),
+                                    pMsg->getSize(),
+                                    pMsg->getTimestamp());
+
+        return tProcessingStringItem( itemMetadata, pStr );
+    }
+    else
+    {
+        qDebug() << "Failed to get msg with idx - " << msgIdxInMainTable;
+        tItemMetadata itemMetadata( msgId,
+                                    msgIdxInMainTable,
+                                    tFieldRanges(),
+                                    0,
+                                    0u,
+                                    0u);
+        return tProcessingStringItem( itemMetadata, std::make_shared<QString>( "" ) ); // TODO: optimize
+    }
+}
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "atomic"
+#include "memory"
+#include "set"
+
 #include "QRegularExpression"
 
 #include "common/Definitions.hpp"
+#include "CRegexCostProfiler.hpp"
 
 enum class ePortionAnalysisState
 {
@@ -10,6 +15,23 @@ enum class ePortionAnalysisState
     ePortionAnalysisState_ERROR
 };
 
+/**
+ * @brief tRegexLimitsReport - summary of the messages, on which the regex has exceeded its execution limits
+ */
+struct tRegexLimitsReport
+{
+    // messages, which were skipped, as PCRE2 has hit the match or depth limit on them
+    int numberOfSkippedMessages = 0;
+    tMsgId firstSkippedMessage = INVALID_MSG_ID;
+    // messages, which were matched, but took longer than the per-message time budget
+    int numberOfSlowMessages = 0;
+    tMsgId firstSlowMessage = INVALID_MSG_ID;
+
+    void addSkippedMessage(const tMsgId& msgId);
+    void addSlowMessage(const tMsgId& msgId);
+    void merge(const tRegexLimitsReport& other);
+};
+
 struct tPortionRegexAnalysisFinishedData
 {
     tPortionRegexAnalysisFinishedData();
@@ -30,10 +52,46 @@ struct tPortionRegexAnalysisFinishedData
     tWorkerId workerId;
     tWorkerThreadCookie workerThreadCookie;
     bool bUML_Req_Res_Ev_DuplicateFound;
+    // CPerfCounters timestamp of the end of the portion's analysis. Used to measure the delivery to the main thread
+    int64_t finishTimestampNs;
+    // messages, on which the regex has exceeded the execution limits
+    tRegexLimitsReport regexLimitsReport;
+    // cost of the regex on the sampled messages of the portion. Empty, if profiling is not active
+    tRegexCostProfile regexCostProfile;
 };
 
+/**
+ * @brief reportRegexLimits - reports the summary of the messages, on which the regex has exceeded its execution limits
+ * @param pattern - used regex
+ * @param regexLimitsReport - skipped and slow messages
+ */
+void reportRegexLimits(const QString& pattern, const tRegexLimitsReport& regexLimitsReport);
+
+/**
+ * @brief createLimitedRegex - creates the version of the regex, which is restricted by the match and depth limits
+ * @param regex - original regex
+ * @param matchLimit - max number of the backtracking steps per match. 0 means no limit
+ * @param depthLimit - max depth of the backtracking per match. 0 means no limit
+ * @return - limited regex. Original regex, if no limits are set or the limited one is not valid.
+ * Returned regex is already optimized
+ */
+QRegularExpression createLimitedRegex(const QRegularExpression& regex, const int& matchLimit, const int& depthLimit);
+
 Q_DECLARE_METATYPE(tPortionRegexAnalysisFinishedData)
 
+/**
+ * @brief tCancellationTokenPtr - token, which is shared between the request and all its portions.
+ * It is set to true once the request is cancelled. Workers check it between the messages.
+ */
+typedef std::shared_ptr<std::atomic<bool>> tCancellationTokenPtr;
+
+/**
+ * @brief isCancelled - checks whether the request, which owns the token, was cancelled
+ * @param pCancellationToken - token to be checked. Might be nullptr
+ * @return - true, if the token is set. False otherwise
+ */
+bool isCancelled(const tCancellationTokenPtr& pCancellationToken);
+
 struct tAnalyzePortionData
 {
     tAnalyzePortionData();
@@ -50,6 +108,34 @@ struct tAnalyzePortionData
     QRegularExpression regex;
     tRegexScriptingMetadata regexMetadata;
     tWorkerThreadCookie workerThreadCookie;
+    // CPerfCounters timestamp of the posting of the portion to the worker. Used to measure the queue wait
+    int64_t postTimestampNs;
+    // set, if the regex cost should be profiled
+    tRegexCostProfilerPtr pRegexCostProfiler;
+    // token of the request. Analysis of the portion is dropped, once it is set
+    tCancellationTokenPtr pCancellationToken;
 };
 
 Q_DECLARE_METATYPE(tAnalyzePortionData)
+
+typedef std::set<eSearchResultColumn> tSearchColumnsSet;
+
+/**
+ * @brief getSearchColumnsSet - converts the columns visibility map to the ordered set of the searched columns
+ * @param searchColumns - columns visibility map
+ * @return - set of the columns, which participate in the search
+ */
+tSearchColumnsSet getSearchColumnsSet(const tSearchResultColumnsVisibilityMap& searchColumns);
+
+/**
+ * @brief createProcessingStringItem - forms the string, which is analyzed by the regex, from the message
+ * @param msgId - non-filtered id of the message
+ * @param msgIdxInMainTable - index of the message in the main table
+ * @param pMsg - the message. Might be nullptr, in that case an empty string is formed
+ * @param searchColumnsSet - columns, which should be added to the string
+ * @return - processing string item with the corresponding metadata
+ */
+tProcessingStringItem createProcessingStringItem(const tMsgId& msgId,
+                                                 const int& msgIdxInMainTable,
+                                                 const tMsgWrapperPtr& pMsg,
+                                                 const tSearchColumnsSet& searchColumnsSet);
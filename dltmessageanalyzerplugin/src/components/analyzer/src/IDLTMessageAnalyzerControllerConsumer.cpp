@@ -9,10 +9,14 @@
 #include "qdlt.h"
 
 #include "components/settings/api/ISettingsManager.hpp"
+#include "components/logsWrapper/api/IFileWrapper.hpp"
 #include "components/log/api/CLog.hpp"
 
 #include "DMA_Plantuml.hpp"
 
+// number of the recently used regexes, which scripting metadata is kept
+static const std::size_t sRegexScriptingMetadataCacheSize = 16u;
+
 //IDLTMessageAnalyzerControllerConsumer
 IDLTMessageAnalyzerControllerConsumer::~IDLTMessageAnalyzerControllerConsumer()
 {
@@ -21,7 +25,8 @@ IDLTMessageAnalyzerControllerConsumer::~IDLTMessageAnalyzerControllerConsumer()
 IDLTMessageAnalyzerControllerConsumer::IDLTMessageAnalyzerControllerConsumer( const std::weak_ptr<IDLTMessageAnalyzerController>& pController ):
     std::enable_shared_from_this<IDLTMessageAnalyzerControllerConsumer>(),
     mpController(pController),
-    mbGroupedViewFeatureActiveForCurrentAnalysis(false)
+    mbGroupedViewFeatureActiveForCurrentAnalysis(false),
+    mRegexScriptingMetadataCache(sRegexScriptingMetadataCacheSize)
 {
 
 }
@@ -37,10 +42,34 @@ tRequestId IDLTMessageAnalyzerControllerConsumer::requestAnalyze( const tRequest
     {
         tRegexScriptingMetadata regexMetadata;
 
-        bool bParseResult = regexMetadata.parse(requestParameters.regex,
-                                                bUMLFeatureActive,
-                                                bPlotViewFeatureActive,
-                                                bGroupedViewFeatureActive);
+        const tRegexScriptingMetadataKey regexMetadataKey(requestParameters.regex.pattern(),
+                                                          static_cast<int>(requestParameters.regex.patternOptions()),
+                                                          bUMLFeatureActive,
+                                                          bPlotViewFeatureActive,
+                                                          bGroupedViewFeatureActive);
+
+        bool bParseResult = false;
+
+        // parsed metadata is never modified, thus the cached items are safely shared between the requests
+        auto pCachedRegexMetadata = mRegexScriptingMetadataCache.find(regexMetadataKey);
+
+        if(nullptr != pCachedRegexMetadata)
+        {
+            regexMetadata = *pCachedRegexMetadata;
+            bParseResult = true;
+        }
+        else
+        {
+            bParseResult = regexMetadata.parse(requestParameters.regex,
+                                               bUMLFeatureActive,
+                                               bPlotViewFeatureActive,
+                                               bGroupedViewFeatureActive);
+
+            if(true == bParseResult)
+            {
+                mRegexScriptingMetadataCache.insert(regexMetadataKey, regexMetadata);
+            }
+        }
 
         if(false == bParseResult)
         {
@@ -75,7 +104,26 @@ tRequestId IDLTMessageAnalyzerControllerConsumer::requestAnalyze( const tRequest
             }
         }
 
-        requestId = mpController.lock()->requestAnalyze(shared_from_this(), requestParameters, regexMetadata);
+        tRequestParameters effectiveRequestParameters = requestParameters;
+
+        if(true == requestParameters.timeRange.isSet && nullptr != requestParameters.pFile)
+        {
+            // only the slice of the file, which corresponds to the time window, is analyzed
+            const auto timeRangeMessages = requestParameters.pFile->getMainTableRangeFromTimeRange(requestParameters.timeRange);
+            const int from = qMax(requestParameters.fromMessage, timeRangeMessages.from);
+            const int to = qMin(requestParameters.fromMessage + requestParameters.numberOfMessages - 1, timeRangeMessages.to);
+
+            effectiveRequestParameters.fromMessage = from;
+            effectiveRequestParameters.numberOfMessages = qMax(0, to - from + 1);
+            effectiveRequestParameters.isContinuous = false;
+
+            if(0 == effectiveRequestParameters.numberOfMessages)
+            {
+                SEND_WRN(QString("[IDLTMessageAnalyzerControllerConsumer][%1] No messages within the requested time window!").arg(__FUNCTION__));
+            }
+        }
+
+        requestId = mpController.lock()->requestAnalyze(shared_from_this(), effectiveRequestParameters, regexMetadata);
         mbGroupedViewFeatureActiveForCurrentAnalysis = bGroupedViewFeatureActive;
     }
 
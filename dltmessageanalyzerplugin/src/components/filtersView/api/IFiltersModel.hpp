@@ -16,10 +16,18 @@ public:
 
     virtual void setUsedRegex(const QString& regexStr) = 0;
     virtual void addCompletionData( const tFoundMatches& foundMatches ) = 0;
+    virtual void removeCompletionData( const tFoundMatches& foundMatches ) = 0;
     virtual void resetCompletionData() = 0;
     virtual void resetData() = 0;
     virtual void filterRegexTokens( const QString& filter ) = 0;
 
+    /**
+     * @brief setRegexCostProfile - shows the cost of the groups of the regex.
+     * Profile is applied only if it belongs to the currently used regex.
+     * @param regexCostProfile - profile of the regex
+     */
+    virtual void setRegexCostProfile( const tRegexCostProfile& regexCostProfile ) = 0;
+
     struct tFilteredEntry
     {
         QModelIndex parentIdx;
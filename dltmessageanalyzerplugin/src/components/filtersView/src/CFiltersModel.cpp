@@ -12,6 +12,7 @@
 #include "CFiltersModel.hpp"
 #include "components/log/api/CLog.hpp"
 #include "common/PCRE/PCREHelper.hpp"
+#include "common/cpp_extensions.hpp"
 
 #include "DMA_Plantuml.hpp"
 
@@ -19,6 +20,13 @@
 #include "QElapsedTimer"
 #endif
 
+// number of the recently parsed regexes, which filters view trees are kept
+static const std::size_t sFiltersViewCacheSize = 16u;
+// time, during which the completion updates are collected, before being sent to the completion thread
+static const int COMPLETION_FLUSH_TIME = 100; // ms
+// max number of the updates, which are applied to the completion indexes under a single lock
+static const std::size_t COMPLETION_UPDATES_PER_LOCK = 1024u;
+
 CFiltersModel::CFiltersModel(const tSettingsManagerPtr& pSettingsManager,
                              QObject *parent)
     : IFiltersModel(parent),
@@ -29,7 +37,15 @@ CFiltersModel::CFiltersModel(const tSettingsManagerPtr& pSettingsManager,
       mSortingHandler(),
       mFilter(),
       mCompletionCache(),
-      mVarGroupsMap()
+      mCompletionMutex(),
+      mCompletionGeneration(0u),
+      mPendingCompletionUpdates(),
+      mCompletionFlushTimer(),
+      mpCompletionThread(nullptr),
+      mpCompletionWorker(nullptr),
+      mVarGroupsMap(),
+      mFiltersViewCache(sFiltersViewCacheSize),
+      mRegexCostProfile()
 {
     mSortingHandler = [](QVector<tTreeItemPtr>& children,
                          const int& sortingColumn,
@@ -119,6 +135,40 @@ CFiltersModel::CFiltersModel(const tSettingsManagerPtr& pSettingsManager,
                 }
             }
             break;
+            case eRegexFiltersColumn::Cost:
+            {
+                QMultiMap<double, tTreeItemPtr> sortedChildrenMap;
+
+                for(const auto& pChild : children)
+                {
+                    if(nullptr != pChild)
+                    {
+                        double val = pChild->data(static_cast<int>(sortingColumn)).get<double>();
+                        sortedChildrenMap.insert(val, pChild);
+                    }
+                }
+
+                for(const auto& pChild : sortedChildrenMap)
+                {
+                    if(nullptr != pChild)
+                    {
+                        switch(sortingOrder)
+                        {
+                            case Qt::SortOrder::AscendingOrder:
+                            {
+                                result.push_back(pChild);
+                            }
+                                break;
+                            case Qt::SortOrder::DescendingOrder:
+                            {
+                                result.push_front(pChild);
+                            }
+                                break;
+                        }
+                    }
+                }
+            }
+            break;
             default:
                 break;
         }
@@ -132,27 +182,60 @@ CFiltersModel::CFiltersModel(const tSettingsManagerPtr& pSettingsManager,
         filterRegexTokensInternal();
     });
 
+    // completion indexes are built in the dedicated thread, so that the big search results do not block the GUI
+    mpCompletionWorker = new QObject();
+    mpCompletionThread = cpp_14::make_unique<QThread>();
+
+    // After worker thread will be stopped, worker object should be aynchronously deleted.
+    connect(mpCompletionThread.get(), &QThread::finished, mpCompletionWorker, &QObject::deleteLater, Qt::QueuedConnection);
+
+    mpCompletionWorker->moveToThread(mpCompletionThread.get());
+    mpCompletionThread->start();
+
+    mCompletionFlushTimer.setSingleShot(true);
+    mCompletionFlushTimer.setInterval(COMPLETION_FLUSH_TIME);
+    connect(&mCompletionFlushTimer, &QTimer::timeout, this, [this]()
+    {
+        flushCompletionUpdates();
+    });
+
     resetRootItem();
 }
 
-void CFiltersModel::resetRootItem()
+CFiltersModel::~CFiltersModel()
 {
-    mpRootItem = std::make_shared<tTreeItem>(nullptr, static_cast<int>(mSortingColumn),
+    if(nullptr != mpCompletionThread)
+    {
+        mpCompletionThread->quit();
+        mpCompletionThread->wait();
+    }
+}
+
+tTreeItemSharedPtr CFiltersModel::createRootItem() const
+{
+    auto pRootItem = std::make_shared<tTreeItem>(nullptr, static_cast<int>(mSortingColumn),
                                mSortingHandler,
                                CTreeItem::tHandleDuplicateFunc(),
                                CTreeItem::tFindItemFunc());
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::Value) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::Index) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::ItemType) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::AfterLastVisible) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::Color) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::Range) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::RowType) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::IsFiltered) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::GroupName) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::GroupSyntaxType) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::GroupIndex) );
-    mpRootItem->appendColumn( getName(eRegexFiltersColumn::Last) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Value) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Index) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::ItemType) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Cost) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::AfterLastVisible) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Color) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Range) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::RowType) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::IsFiltered) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::GroupName) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::GroupSyntaxType) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::GroupIndex) );
+    pRootItem->appendColumn( getName(eRegexFiltersColumn::Last) );
+    return pRootItem;
+}
+
+void CFiltersModel::resetRootItem()
+{
+    mpRootItem = createRootItem();
 }
 
 QModelIndex CFiltersModel::rootIndex() const
@@ -224,17 +307,52 @@ QVariant CFiltersModel::data(const QModelIndex &index, int role) const
 
     QVariant result;
 
-    if (role == Qt::DisplayRole || role == Qt::EditRole)
+    if (role == Qt::DisplayRole && static_cast<int>(eRegexFiltersColumn::Cost) == index.column())
+    {
+        tTreeItem *pItem = static_cast<tTreeItemPtr>(index.internalPointer());
+        const double& costNs = pItem->data(index.column()).get<double>();
+
+        if(costNs > 0.0)
+        {
+            QString costStr = formatDurationNs(costNs);
+
+            if(0 != mRegexCostProfile.overallDurationNs)
+            {
+                costStr.append(QString(" (%1%)").arg(100.0 * costNs / mRegexCostProfile.getAverageDurationNs(mRegexCostProfile.overallDurationNs), 0, 'f', 1));
+            }
+
+            result = costStr;
+        }
+        else
+        {
+            result = QString();
+        }
+    }
+    else if (role == Qt::DisplayRole || role == Qt::EditRole)
     {
         tTreeItem *pItem = static_cast<tTreeItemPtr>(index.internalPointer());
         result = toQVariant(pItem->data(index.column()));
     }
+    else if (role == Qt::ToolTipRole &&
+             static_cast<int>(eRegexFiltersColumn::Cost) == index.column() &&
+             false == mRegexCostProfile.isEmpty() &&
+             mRegexCostProfile.regex == mRegex)
+    {
+        result = QString("Average match time per message, which is added by the group to the preceding part of the regex.\n"
+                         "Whole regex - %1 per message. Number of profiled messages - %2.")
+                 .arg(formatDurationNs(mRegexCostProfile.getAverageDurationNs(mRegexCostProfile.overallDurationNs)))
+                 .arg(mRegexCostProfile.numberOfProfiledMessages);
+    }
     else if (role == Qt::TextAlignmentRole)
     {
         if( static_cast<int>(eRegexFiltersColumn::Index) == index.column() )
         {
             result = Qt::AlignCenter;
         }
+        else if( static_cast<int>(eRegexFiltersColumn::Cost) == index.column() )
+        {
+            result = QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        }
         else if( static_cast<int>(eRegexFiltersColumn::ItemType) == index.column() ||
                  static_cast<int>(eRegexFiltersColumn::Value) == index.column() )
         {
@@ -418,6 +536,7 @@ void CFiltersModel::resetData()
 void CFiltersModel::setUsedRegex(const QString& regexStr)
 {
     QString regex_ = addRegexOptions( regexStr );
+    mRegex = regexStr;
 
     // we should reset a group
     resetData();
@@ -455,7 +574,18 @@ void CFiltersModel::setUsedRegex(const QString& regexStr)
             timer.restart();
 #endif
 
-            parseRegexFiltersView(mpRootItem, regexStr);
+            // parsing of the regex is expensive, thus the recently parsed trees are reused.
+            // Model modifies its tree, so it always works with a copy.
+            auto pParsedTree = mFiltersViewCache.find(regexStr);
+
+            if(nullptr == pParsedTree)
+            {
+                auto pNewParsedTree = createRootItem();
+                parseRegexFiltersView(pNewParsedTree, regexStr);
+                pParsedTree = &mFiltersViewCache.insert(regexStr, pNewParsedTree);
+            }
+
+            mpRootItem->appendChildrenCopy(pParsedTree->get());
 
 #ifdef DEBUG_BUILD
             SEND_MSG(QString("[CFiltersModel][%1] It took %2 ms to parse regex")
@@ -466,6 +596,7 @@ void CFiltersModel::setUsedRegex(const QString& regexStr)
 #endif
 
             updateVarGroupsMap();
+            applyRegexCostProfile();
 
 #ifdef DEBUG_BUILD
             SEND_MSG(QString("[CFiltersModel][%1] It took %2 ms to update var group map")
@@ -511,6 +642,48 @@ void CFiltersModel::updateVarGroupsMap()
     }
 }
 
+void CFiltersModel::setRegexCostProfile( const tRegexCostProfile& regexCostProfile )
+{
+    mRegexCostProfile = regexCostProfile;
+    applyRegexCostProfile();
+
+    if(eRegexFiltersColumn::Cost == mSortingColumn)
+    {
+        sort(static_cast<int>(mSortingColumn), mSortOrder);
+    }
+    else
+    {
+        updateView();
+    }
+}
+
+void CFiltersModel::applyRegexCostProfile()
+{
+    // profile of the other regex is kept, until the user returns to its regex
+    if(nullptr != mpRootItem && mRegexCostProfile.regex == mRegex)
+    {
+        auto preVisitFunction = [this](tTreeItem* pItem)
+        {
+            if(nullptr != pItem)
+            {
+                double costNs = 0.0;
+                auto foundGroup = mRegexCostProfile.groupDurationsNs.find( pItem->data(static_cast<int>(eRegexFiltersColumn::GroupIndex)).get<int>() );
+
+                if(foundGroup != mRegexCostProfile.groupDurationsNs.end())
+                {
+                    costNs = mRegexCostProfile.getAverageDurationNs(foundGroup.value());
+                }
+
+                pItem->setColumnData(tDataItem(costNs), static_cast<int>(eRegexFiltersColumn::Cost));
+            }
+
+            return true;
+        };
+
+        mpRootItem->visit(preVisitFunction, CTreeItem::tVisitFunction(), false, true, false);
+    }
+}
+
 void CFiltersModel::sort(int column, Qt::SortOrder order)
 {
     mSortingColumn = toRegexFiltersColumn(column);
@@ -740,25 +913,111 @@ void CFiltersModel::filterRegexTokensInternal()
     //SEND_MSG(QString("~3 [CFiltersModel][%1] Processing took - %2 ms").arg(__FUNCTION__).arg(time.elapsed()));
 }
 
-void CFiltersModel::addCompletionData( const tFoundMatches& foundMatches )
+void CFiltersModel::scheduleCompletionUpdate( const tFoundMatches& foundMatches, const CCompletionIndex::tWeight& delta )
 {
-    if(false == mVarGroupsMap.empty())
+    for(const auto& foundMatch : foundMatches.foundMatchesVec)
     {
-        for(const auto& foundMatch : foundMatches.foundMatchesVec)
+        auto foundVarGroup = mVarGroupsMap.find(foundMatch.idx);
+
+        if(foundVarGroup != mVarGroupsMap.end())
         {
-            auto foundVarGroup = mVarGroupsMap.find(foundMatch.idx);
+            mPendingCompletionUpdates.push_back(tCompletionUpdate{foundMatch.idx, foundMatch.matchStr, delta});
+        }
+    }
+
+    if(false == mPendingCompletionUpdates.empty() &&
+       false == mCompletionFlushTimer.isActive())
+    {
+        mCompletionFlushTimer.start();
+    }
+}
+
+void CFiltersModel::flushCompletionUpdates()
+{
+    if(true == mPendingCompletionUpdates.empty() || nullptr == mpCompletionWorker)
+    {
+        return;
+    }
+
+    uint64_t generation = 0u;
+
+    {
+        QMutexLocker lock(&mCompletionMutex);
+        generation = mCompletionGeneration;
+    }
+
+    auto pUpdates = std::make_shared<tCompletionUpdates>();
+    pUpdates->swap(mPendingCompletionUpdates);
+
+    QTimer::singleShot(0, mpCompletionWorker, [this, pUpdates, generation]()
+    {
+        auto updatesIt = pUpdates->begin();
+
+        while(updatesIt != pUpdates->end())
+        {
+            // the lock is released from time to time, so that the GUI thread is able to get the suggestions
+            QMutexLocker lock(&mCompletionMutex);
+
+            if(generation != mCompletionGeneration)
+            {
+                // completion data was reset after the updates were scheduled
+                break;
+            }
+
+            const auto updatesPortionEnd = pUpdates->end() - updatesIt > static_cast<std::ptrdiff_t>(COMPLETION_UPDATES_PER_LOCK) ?
+                        updatesIt + static_cast<std::ptrdiff_t>(COMPLETION_UPDATES_PER_LOCK) :
+                        pUpdates->end();
 
-            if(foundVarGroup != mVarGroupsMap.end())
+            for( ; updatesIt != updatesPortionEnd; ++updatesIt )
             {
-                mCompletionCache[foundMatch.idx].insert( foundMatch.matchStr );
+                if(updatesIt->delta > 0)
+                {
+                    mCompletionCache[updatesIt->groupIdx].addWeight(updatesIt->str, updatesIt->delta);
+                }
+                else
+                {
+                    auto foundCompletionIndex = mCompletionCache.find(updatesIt->groupIdx);
+
+                    if(foundCompletionIndex != mCompletionCache.end())
+                    {
+                        foundCompletionIndex->second.addWeight(updatesIt->str, updatesIt->delta);
+                    }
+                }
             }
         }
+    });
+}
+
+void CFiltersModel::addCompletionData( const tFoundMatches& foundMatches )
+{
+    if(false == mVarGroupsMap.empty())
+    {
+        scheduleCompletionUpdate(foundMatches, 1);
+    }
+}
+
+void CFiltersModel::removeCompletionData( const tFoundMatches& foundMatches )
+{
+    if(false == mVarGroupsMap.empty())
+    {
+        scheduleCompletionUpdate(foundMatches, -1);
     }
 }
 
 void CFiltersModel::resetCompletionData()
 {
-    mCompletionCache.clear();
+    mCompletionFlushTimer.stop();
+    tCompletionUpdates().swap(mPendingCompletionUpdates);
+
+    tCompletionCache completionCache;
+
+    {
+        QMutexLocker lock(&mCompletionMutex);
+        ++mCompletionGeneration;
+        completionCache.swap(mCompletionCache);
+    }
+
+    // the indexes are destroyed outside of the lock
 }
 
 QStringList CFiltersModel::getCompletionData( const int& groupIndex,
@@ -768,42 +1027,30 @@ QStringList CFiltersModel::getCompletionData( const int& groupIndex,
 {
     QStringList result;
 
-    auto foundCompletionSet = mCompletionCache.find(groupIndex);
+    auto caseSensitiveOption = getSettingsManager()->getFiltersCompletion_CaseSensitive() ?
+                Qt::CaseSensitive :
+                Qt::CaseInsensitive;
+
+    auto searchPolicy = false == getSettingsManager()->getFiltersCompletion_SearchPolicy() ?
+                CCompletionIndex::eSearchPolicy::eStartsWith :
+                CCompletionIndex::eSearchPolicy::eContains;
 
-    if(foundCompletionSet != mCompletionCache.end())
     {
-        int numberOfSuggestions = 0;
+        QMutexLocker lock(&mCompletionMutex);
 
-        auto caseSensitiveOption = getSettingsManager()->getFiltersCompletion_CaseSensitive() ?
-                    Qt::CaseSensitive :
-                    Qt::CaseInsensitive;
+        auto foundCompletionIndex = mCompletionCache.find(groupIndex);
 
-        for(const auto& completionItem : foundCompletionSet->second)
+        if(foundCompletionIndex != mCompletionCache.end())
         {
-            bool bStringFound = false;
-
-            if(false == getSettingsManager()->getFiltersCompletion_SearchPolicy())
-            {
-                bStringFound = completionItem.startsWith(input, caseSensitiveOption);
-            }
-            else
-            {
-                bStringFound = completionItem.contains(input, caseSensitiveOption);
-            }
-
-            if(bStringFound)
-            {
-                result.push_back(completionItem.mid(0, maxLengthOfSuggestions));
-                ++numberOfSuggestions;
-            }
-
-            if(numberOfSuggestions >= maxNumberOfSuggestions)
-            {
-                break;
-            }
+            result = foundCompletionIndex->second.find(input, searchPolicy, caseSensitiveOption, maxNumberOfSuggestions);
         }
     }
 
+    for(auto& completionItem : result)
+    {
+        completionItem.truncate(maxLengthOfSuggestions);
+    }
+
     return result;
 }
 
@@ -812,5 +1059,7 @@ PUML_PACKAGE_BEGIN(DMA_FiltersView)
         PUML_INHERITANCE_CHECKED(IFiltersModel, implements)
         PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CTreeItem, 1, *, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CCompletionIndex, 1, *, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(QThread, 1, 1, contains)
     PUML_CLASS_END()
 PUML_PACKAGE_END()
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "memory"
+#include "vector"
+
+#include "QMutex"
+#include "QThread"
+#include "QTimer"
 
 #include "common/Definitions.hpp"
 #include "common/CTreeItem.hpp"
+#include "common/CCompletionIndex.hpp"
+#include "common/TLRUCache.hpp"
 
 #include "../api/IFiltersModel.hpp"
 #include "components/settings/api/CSettingsManagerClient.hpp"
@@ -16,13 +23,16 @@ class CFiltersModel : public IFiltersModel,
 public:
     explicit CFiltersModel(const tSettingsManagerPtr& pSettingsManager,
                            QObject *parent = nullptr);
+    ~CFiltersModel() override;
 
     // Implementation of the IFiltersModel
     void setUsedRegex(const QString& regexStr) override;
     void addCompletionData( const tFoundMatches& foundMatches ) override;
+    void removeCompletionData( const tFoundMatches& foundMatches ) override;
     void resetCompletionData() override;
     void resetData() override;
     void filterRegexTokens( const QString& filter ) override;
+    void setRegexCostProfile( const tRegexCostProfile& regexCostProfile ) override;
     // Implementation of the IFiltersModel ( END )
 
     QVariant data(const QModelIndex &index, int role) const override;
@@ -49,9 +59,14 @@ private:
     QModelIndex rootIndex() const;
 
     QPair<bool,QString> packRegex();
+    tTreeItemSharedPtr createRootItem() const;
     void resetRootItem();
 
     void updateVarGroupsMap();
+    void applyRegexCostProfile();
+
+    void scheduleCompletionUpdate( const tFoundMatches& foundMatches, const CCompletionIndex::tWeight& delta );
+    void flushCompletionUpdates();
 
     CFiltersModel(const CFiltersModel&) = delete;
     CFiltersModel& operator=(const CFiltersModel&) = delete;
@@ -67,12 +82,36 @@ private:
     CTreeItem::tSortingFunction mSortingHandler;
     QString mFilter;
 
-    typedef std::set<QString> tStringSet;
-    typedef std::map<int /*group id*/, tStringSet> tCompletionCache;
+    // weight of each completion string is the number of the retained matches, which have produced it.
+    // That allows to rank the suggestions and to evict the string together with the last of such matches.
+    typedef std::map<int /*group id*/, CCompletionIndex> tCompletionCache;
     tCompletionCache mCompletionCache;
+    // guards mCompletionCache and mCompletionGeneration, which are updated from the completion thread
+    mutable QMutex mCompletionMutex;
+    uint64_t mCompletionGeneration;
+
+    struct tCompletionUpdate
+    {
+        int groupIdx;
+        QString str;
+        CCompletionIndex::tWeight delta;
+    };
+
+    typedef std::vector<tCompletionUpdate> tCompletionUpdates;
+    tCompletionUpdates mPendingCompletionUpdates;
+    QTimer mCompletionFlushTimer;
+
+    typedef std::unique_ptr<QThread> tQThreadPtr;
+    tQThreadPtr mpCompletionThread;
+    QObject* mpCompletionWorker;
 
     typedef std::set<int /*group id*/> tVarGroupsMap;
     tVarGroupsMap mVarGroupsMap;
+
+    typedef TLRUCache<QString /*regex*/, tTreeItemSharedPtr /*parsed tree*/> tFiltersViewCache;
+    tFiltersViewCache mFiltersViewCache;
+
+    tRegexCostProfile mRegexCostProfile;
 };
 
 Q_DECLARE_METATYPE(CFiltersModel::tFilteredEntryVec)
@@ -538,6 +538,19 @@ void CFiltersView::handleSettingsManagerChange()
             contextMenu.addMenu(pSubMenu);
         }
 
+        contextMenu.addSeparator();
+
+        {
+            QAction* pAction = new QAction("Profile regex cost", this);
+            connect(pAction, &QAction::triggered, [this](bool checked)
+            {
+                getSettingsManager()->setRegexCostProfiling(checked);
+            });
+            pAction->setCheckable(true);
+            pAction->setChecked(getSettingsManager()->getRegexCostProfiling());
+            contextMenu.addAction(pAction);
+        }
+
         contextMenu.exec(mapToGlobal(pos));
     };
 
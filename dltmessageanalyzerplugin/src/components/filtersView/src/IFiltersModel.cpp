@@ -22,7 +22,9 @@ PUML_PACKAGE_BEGIN(DMA_FiltersView_API)
         PUML_INHERITANCE_CHECKED(QAbstractItemModel, implements)
         PUML_PURE_VIRTUAL_METHOD( +, void setUsedRegex(const QString& regexStr) )
         PUML_PURE_VIRTUAL_METHOD( +, void addCompletionData( const tFoundMatches& foundMatches ) )
+        PUML_PURE_VIRTUAL_METHOD( +, void removeCompletionData( const tFoundMatches& foundMatches ) )
         PUML_PURE_VIRTUAL_METHOD( +, void resetCompletionData() )
+        PUML_PURE_VIRTUAL_METHOD( +, void setRegexCostProfile( const tRegexCostProfile& regexCostProfile ) )
         PUML_PURE_VIRTUAL_METHOD( +, void resetData() )
         PUML_PURE_VIRTUAL_METHOD( +, void filterRegexTokens( const QString& filter ) )
     PUML_CLASS_END()
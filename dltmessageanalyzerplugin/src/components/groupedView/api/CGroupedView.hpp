@@ -22,7 +22,7 @@ public:
     void setModel(QAbstractItemModel *model) override;
 
 signals:
-    void searchViewHighlightingRequested(const tMsgIdSet& msgIDs);
+    void searchViewHighlightingRequested(const tMsgIdBitmap& msgIDs);
 
 protected:
     virtual void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles = QVector<int>()) override;
@@ -18,8 +18,11 @@ public:
     virtual void addMatches( const tGroupedViewIndices& groupedViewIndices,
                              const tFoundMatches& matches,
                              bool update ) = 0;
+    virtual void removeMatches( const tGroupedViewIndices& groupedViewIndices,
+                                const tFoundMatches& matches,
+                                bool update ) = 0;
     virtual int rowCount(const QModelIndex &parent = QModelIndex()) const = 0;
     virtual std::pair<bool /*result*/, QString /*error*/> exportToHTML(QString& resultHTML) = 0;
-    virtual tMsgIdSet getAllMessageIds(const QModelIndex& index) = 0;
+    virtual tMsgIdBitmap getAllMessageIds(const QModelIndex& index) = 0;
     virtual void sortByCurrentSortingColumn() = 0;
 };
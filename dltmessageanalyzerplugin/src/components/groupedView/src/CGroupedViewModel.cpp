@@ -27,7 +27,8 @@ CGroupedViewModel::CGroupedViewModel(const tSettingsManagerPtr& pSettingsManager
       mDuplicatesHandler(),
       mSortingHandler(),
       mFindHandler(),
-      mAnalyzedValues()
+      mAnalyzedValues(),
+      mMessageIdsCache()
 {   
     mSortingHandler = [this](QVector<tTreeItemPtr>& children,
                             const int& sortingColumn,
@@ -307,6 +308,25 @@ void CGroupedViewModel::updatePercentageValues(CTreeItem* pItem, bool updatePayl
     }
 }
 
+void CGroupedViewModel::updateStatisticsValues()
+{
+    if(nullptr == mpRootItem || 0u == mAnalyzedValues.analyzedMessages || 0u == mAnalyzedValues.analyzedPayload)
+    {
+        return;
+    }
+
+    mpRootItem->visit([this](tTreeItemPtr pItem)
+    {
+        updateAverageValues(pItem, true, true);
+        updatePercentageValues(pItem, true, true);
+        return true;
+    },
+    [](const tTreeItemPtr)
+    {
+        return true;
+    }, false, true, false);
+}
+
 CGroupedViewModel::~CGroupedViewModel()
 {
     if(nullptr != mpRootItem)
@@ -321,6 +341,14 @@ QModelIndex CGroupedViewModel::rootIndex() const
     return QModelIndex();
 }
 
+QModelIndex CGroupedViewModel::itemIndex(tTreeItemPtr pItem) const
+{
+    if(nullptr == pItem || pItem == mpRootItem || nullptr == pItem->getParent())
+        return rootIndex();
+
+    return createIndex(pItem->getParent()->getChildIdx(pItem), 0, pItem);
+}
+
 void CGroupedViewModel::updateView()
 {
     emit dataChanged( index(0,0), index ( rowCount(), columnCount()) );
@@ -525,7 +553,7 @@ void CGroupedViewModel::addMatches( const tGroupedViewIndices& groupedViewIndice
                     dataVec.emplace_back(std::move(pair.second));
                 }
 
-                auto afterAppendFunction = [](CTreeItem* pItem)
+                auto afterAppendFunction = [this](CTreeItem* pItem)
                 {
                     // if it is a leaf node
                     if(nullptr != pItem && 0 == pItem->childCount())
@@ -534,15 +562,32 @@ void CGroupedViewModel::addMatches( const tGroupedViewIndices& groupedViewIndice
                         const auto metadataColumn = static_cast<int>(eGroupedViewColumn::Metadata);
                         auto& existingMetadata = pItem->getWriteableData(metadataColumn).get<tGroupedViewMetadata>();
 
-                        if(existingMetadata.relatedMsgIds.index() == existingMetadata.relatedMsgIds.index_of<tMsgIdSet>())
+                        if(existingMetadata.relatedMsgIds.index() != existingMetadata.relatedMsgIds.index_of<tMsgIdBitmap>())
                         {
-                            existingMetadata.relatedMsgIds.get<tMsgIdSet>().insert(existingMetadata.msgId);
+                            existingMetadata.relatedMsgIds = tMsgIdBitmap();
                         }
-                        else
+
+                        const auto msgId = static_cast<tMsgIdBitmap::tValue>(existingMetadata.msgId);
+                        existingMetadata.relatedMsgIds.get<tMsgIdBitmap>().add(msgId);
+
+                        // cached unions of the leaf and of its parents are kept up to date
+                        if(false == mMessageIdsCache.empty())
                         {
-                            tMsgIdSet msgIdSet;
-                            msgIdSet.insert(existingMetadata.msgId);
-                            existingMetadata.relatedMsgIds = msgIdSet;
+                            pItem->visitParents([this, &msgId](tTreeItemPtr pParentItem)
+                            {
+                                auto foundCachedItem = mMessageIdsCache.find(pParentItem);
+
+                                if(foundCachedItem != mMessageIdsCache.end())
+                                {
+                                    foundCachedItem->second.add(msgId);
+                                }
+
+                                return true;
+                            },
+                            [](const tTreeItemPtr)
+                            {
+                                return true;
+                            }, true, true);
                         }
                     }
                 };
@@ -558,9 +603,147 @@ void CGroupedViewModel::addMatches( const tGroupedViewIndices& groupedViewIndice
     }
 }
 
+void CGroupedViewModel::removeMatches( const tGroupedViewIndices& groupedViewIndices,
+                                       const tFoundMatches& matches,
+                                       bool update )
+{
+    if(true == groupedViewIndices.empty() ||
+       nullptr == mpRootItem ||
+       true == matches.foundMatchesVec.empty())
+    {
+        return;
+    }
+
+    // keys should be formed in the same order, in which they were used in addMatches
+    std::vector<tDataItem> keys;
+    keys.reserve(matches.foundMatchesVec.size() + 1);
+    keys.push_back( tQStringPtrWrapper(sRootItemName) );
+
+    {
+        std::map<tGroupedViewIdx, tDataItem> sortingMap;
+
+        for(const auto& match : matches.foundMatchesVec)
+        {
+            auto foundIndex = groupedViewIndices.find(match.idx);
+
+            if(foundIndex != groupedViewIndices.end())
+            {
+                sortingMap.insert(std::make_pair(foundIndex->second, tDataItem(match.matchStr)));
+            }
+        }
+
+        for(auto& pair : sortingMap)
+        {
+            keys.push_back(std::move(pair.second));
+        }
+    }
+
+    const auto messagesColumn = static_cast<int>(eGroupedViewColumn::Messages);
+    const auto payloadColumn = static_cast<int>(eGroupedViewColumn::Payload);
+    const auto metadataColumn = static_cast<int>(eGroupedViewColumn::Metadata);
+    const auto msgSizeBytes = static_cast<int>(matches.msgSizeBytes);
+
+    // the highest node, which does not contain any messages anymore.
+    // It is removed together with its whole sub-tree.
+    tTreeItemPtr pItemToRemove = nullptr;
+    tTreeItemPtr pParentItem = mpRootItem;
+
+    for(const auto& key : keys)
+    {
+        const auto& children = pParentItem->getChildren();
+        auto foundChild = children.find(key);
+
+        if(foundChild == children.end() || nullptr == foundChild.value())
+        {
+            SEND_WRN(QString("[CGroupedViewModel] Evicted message %1 was not found in the grouped view").arg(matches.msgId));
+            break;
+        }
+
+        auto pItem = foundChild.value();
+
+        pItem->getWriteableData(messagesColumn) = pItem->data(messagesColumn).get<int>() - 1;
+        pItem->getWriteableData(payloadColumn) = pItem->data(payloadColumn).get<int>() - msgSizeBytes;
+
+        if(0 == pItem->childCount())
+        {
+            auto& existingMetadata = pItem->getWriteableData(metadataColumn).get<tGroupedViewMetadata>();
+
+            if(existingMetadata.relatedMsgIds.index() == existingMetadata.relatedMsgIds.index_of<tMsgIdBitmap>())
+            {
+                existingMetadata.relatedMsgIds.get<tMsgIdBitmap>().remove(static_cast<tMsgIdBitmap::tValue>(matches.msgId));
+            }
+        }
+
+        auto foundCachedItem = mMessageIdsCache.find(pItem);
+
+        if(foundCachedItem != mMessageIdsCache.end())
+        {
+            foundCachedItem->second.remove(static_cast<tMsgIdBitmap::tValue>(matches.msgId));
+        }
+
+        pParentItem->invalidateSorting();
+
+        if(nullptr == pItemToRemove && pItem->data(messagesColumn).get<int>() <= 0)
+        {
+            pItemToRemove = pItem;
+        }
+
+        pParentItem = pItem;
+    }
+
+    if(nullptr != pItemToRemove)
+    {
+        auto pRemovedItemParent = pItemToRemove->getParent();
+        auto row = pRemovedItemParent->getChildIdx(pItemToRemove);
+
+        if(row >= 0)
+        {
+            if(false == mMessageIdsCache.empty())
+            {
+                // addresses of the removed items can be reused by the new ones
+                pItemToRemove->visit([this](tTreeItemPtr pRemovedItem)
+                {
+                    mMessageIdsCache.erase(pRemovedItem);
+                    return true;
+                },
+                [](const tTreeItemPtr)
+                {
+                    return true;
+                }, true, true, false);
+            }
+
+            beginRemoveRows(itemIndex(pRemovedItemParent), row, row);
+            pRemovedItemParent->removeChild(pItemToRemove->data(static_cast<int>(eGroupedViewColumn::SubString)));
+            endRemoveRows();
+        }
+    }
+
+    if(mAnalyzedValues.analyzedMessages > 0u)
+    {
+        mAnalyzedValues.analyzedMessages -= 1;
+    }
+
+    mAnalyzedValues.analyzedPayload -= std::min(mAnalyzedValues.analyzedPayload, static_cast<unsigned int>(matches.msgSizeBytes));
+
+    // the oldest messages are evicted first, thus the time range of the remaining ones starts not earlier than the evicted one
+    if(false == mAnalyzedValues.perSecondStatisticsDiscarded &&
+       matches.timeStamp > mAnalyzedValues.minTime &&
+       matches.timeStamp <= mAnalyzedValues.maxTime)
+    {
+        mAnalyzedValues.minTime = matches.timeStamp;
+    }
+
+    if(true == update)
+    {
+        updateStatisticsValues();
+        updateView();
+    }
+}
+
 void CGroupedViewModel::resetData()
 {
     beginResetModel();
+    mMessageIdsCache.clear();
     if(mpRootItem)
         delete mpRootItem;
     mpRootItem = new tTreeItem(nullptr,
@@ -823,9 +1006,36 @@ void CGroupedViewModel::sort(int column, Qt::SortOrder order)
     updateView();
 }
 
-tMsgIdSet CGroupedViewModel::getAllMessageIds(const QModelIndex& index)
+void CGroupedViewModel::collectMessageIds(tTreeItemPtr pItem, tMsgIdBitmap& result) const
 {
-    tMsgIdSet result;
+    auto foundCachedItem = mMessageIdsCache.find(pItem);
+
+    if(foundCachedItem != mMessageIdsCache.end())
+    {
+        result.unite(foundCachedItem->second);
+        return;
+    }
+
+    const auto metadataColumn = static_cast<int>(eGroupedViewColumn::Metadata);
+    const auto& itemMetadata = pItem->data(metadataColumn).get<tGroupedViewMetadata>();
+
+    if(itemMetadata.relatedMsgIds.index() == itemMetadata.relatedMsgIds.index_of<tMsgIdBitmap>())
+    {
+        result.unite(itemMetadata.relatedMsgIds.get<tMsgIdBitmap>());
+    }
+
+    for(const auto& pChild : pItem->getChildren())
+    {
+        if(nullptr != pChild)
+        {
+            collectMessageIds(pChild, result);
+        }
+    }
+}
+
+tMsgIdBitmap CGroupedViewModel::getAllMessageIds(const QModelIndex& index)
+{
+    tMsgIdBitmap result;
 
     if(false == index.isValid())
         return result;
@@ -834,26 +1044,18 @@ tMsgIdSet CGroupedViewModel::getAllMessageIds(const QModelIndex& index)
 
     if(nullptr != pItem)
     {
-        pItem->visit([&result](tTreeItemPtr pItem)
-        {
-            if(nullptr != pItem)
-            {
-                const auto metadataColumn = static_cast<int>(eGroupedViewColumn::Metadata);
-                const auto& itemMetadata = pItem->getWriteableData(metadataColumn).get<tGroupedViewMetadata>();
+        auto foundCachedItem = mMessageIdsCache.find(pItem);
 
-                if(itemMetadata.relatedMsgIds.index() == itemMetadata.relatedMsgIds.index_of<tMsgIdSet>())
-                {
-                    auto& insertSet = itemMetadata.relatedMsgIds.get<tMsgIdSet>();
-                    result.insert(insertSet.begin(), insertSet.end());
-                }
-            }
-
-            return true;
-        },
-        [](const tTreeItemPtr)
+        if(foundCachedItem != mMessageIdsCache.end())
+        {
+            result = foundCachedItem->second;
+        }
+        else
         {
-            return true;
-        });
+            // bitmaps of the children are united container by container, which is much cheaper than the per-id merge
+            collectMessageIds(pItem, result);
+            mMessageIdsCache.insert(std::make_pair(pItem, result));
+        }
     }
 
     return result;
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "memory"
+#include "unordered_map"
 
 #include "QAbstractItemModel"
 
@@ -30,9 +31,12 @@ public:
     void addMatches( const tGroupedViewIndices& groupedViewIndices,
                      const tFoundMatches& matches,
                      bool update ) override;
+    void removeMatches( const tGroupedViewIndices& groupedViewIndices,
+                        const tFoundMatches& matches,
+                        bool update ) override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     std::pair<bool /*result*/, QString /*error*/> exportToHTML(QString& resultHTML) override;
-    tMsgIdSet getAllMessageIds(const QModelIndex& index) override;
+    tMsgIdBitmap getAllMessageIds(const QModelIndex& index) override;
     void sortByCurrentSortingColumn() override;
     // Implementation of the IGroupedViewModel ( end )
 
@@ -50,9 +54,17 @@ private:
 
     void updateView();
     QModelIndex rootIndex() const;
+    QModelIndex itemIndex(tTreeItemPtr pItem) const;
     void updateAverageValues(CTreeItem* pItem, bool updatePayload, bool updateMessages);
     void updatePercentageValues(CTreeItem* pItem, bool updatePayload, bool updateMessages);
 
+    /**
+     * @brief updateStatisticsValues - recalculates the percentage and average columns of all items.
+     * Used after the eviction, which changes the totals, on which these columns depend.
+     */
+    void updateStatisticsValues();
+    void collectMessageIds(tTreeItemPtr pItem, tMsgIdBitmap& result) const;
+
     CGroupedViewModel(const CGroupedViewModel&) = delete;
     CGroupedViewModel& operator=(const CGroupedViewModel&) = delete;
     CGroupedViewModel(const CGroupedViewModel&&) = delete;
@@ -81,4 +93,8 @@ private:
     };
 
     tAnalyzedValues mAnalyzedValues;
+
+    // unions of the message id-s of the drilled-down nodes. Kept up to date on each added or evicted message
+    typedef std::unordered_map<const CTreeItem*, tMsgIdBitmap> tMessageIdsCache;
+    tMessageIdsCache mMessageIdsCache;
 };
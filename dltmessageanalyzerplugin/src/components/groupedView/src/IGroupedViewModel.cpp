@@ -22,6 +22,7 @@ PUML_PACKAGE_BEGIN(DMA_GroupedView_API)
         PUML_PURE_VIRTUAL_METHOD(+, void setUsedRegex(const QString& regex))
         PUML_PURE_VIRTUAL_METHOD(+, void resetData())
         PUML_PURE_VIRTUAL_METHOD(+, void addMatches( const tFoundMatches& matches, bool update ))
+        PUML_PURE_VIRTUAL_METHOD(+, void removeMatches( const tGroupedViewIndices& groupedViewIndices, const tFoundMatches& matches, bool update ))
         PUML_PURE_VIRTUAL_METHOD(+, int rowCount(const QModelIndex &parent = QModelIndex()) const)
         PUML_PURE_VIRTUAL_METHOD(+, std::pair<bool__QString> exportToHTML(QString& resultHTML))
     PUML_CLASS_END()
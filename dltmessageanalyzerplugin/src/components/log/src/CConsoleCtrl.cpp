@@ -1,10 +1,16 @@
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 #include <QApplication>
 #include <QDateTime>
+#include <QScrollBar>
 #include <QTabBar>
+#include <QTextCharFormat>
+#include <QTextCursor>
 #include <QThread>
 
 #include "common/Definitions.hpp"
@@ -12,8 +18,6 @@
 
 #include "DMA_Plantuml.hpp"
 
-Q_DECLARE_METATYPE(NDLTMessageAnalyzer::NConsole::tMessageSettings)
-
 using namespace NDLTMessageAnalyzer::NConsole;
 
 static const char* g_TabName()
@@ -21,25 +25,32 @@ static const char* g_TabName()
     return "Console view";
 }
 
-/////////////////////////MESSAGE_BUFFER ACCESS/////////////////////////
-static std::atomic<bool>& g_IsBufferApplied()
+static const int sDrainPeriodMs = 100;
+// max number of messages, which are not yet drained from the buffer of one thread. Everything above is dropped
+static const quint64 sThreadBufferCapacity = 4096u;
+// max number of messages, which are shown within one drain. Everything above is deferred to the next drains
+static const int sMaxShownMessagesPerDrain = 500;
+// max number of deferred messages. Everything above is suppressed, except for the errors
+static const std::size_t sMaxDeferredMessages = 16384u;
+// max number of consecutive similar messages of one thread, which are shown. Everything above is suppressed
+static const int sMaxSimilarMessages = 5;
+static const qint64 sSuppressionReportPeriodMs = 1000;
+
+struct tMessageBufferItem
 {
-    static std::atomic<bool> sIsBufferApplied;
-    return sIsBufferApplied;
-}
+    tMessageSettings messageSettings;
+    QString message;
+    qint64 timestampMs = 0;
+};
 
+/////////////////////////MESSAGE_BUFFER ACCESS/////////////////////////
+// messages, which were sent before the instance was created
 static std::mutex& g_MessageBufferProtector()
 {
     static std::mutex sMessageBufferProtector;
     return sMessageBufferProtector;
 }
 
-struct tMessageBufferItem
-{
-    tMessageSettings messageSettings;
-    QString message;
-};
-
 typedef QList<tMessageBufferItem> tMessageBufferList;
 
 static tMessageBufferList& g_MessageBuffer()
@@ -48,6 +59,150 @@ static tMessageBufferList& g_MessageBuffer()
     return sMessageBuffer;
 }
 
+/////////////////////////THREAD_BUFFERS ACCESS/////////////////////////
+/**
+ * @brief The CThreadMessageBuffer class - single producer, single consumer lock-free ring buffer.
+ * Producer is the owning thread, consumer is the thread of the console controller.
+ */
+class CThreadMessageBuffer
+{
+public:
+
+    // rate limiting state. Used only by the consumer thread
+    struct tRateLimitState
+    {
+        QString lastMessageKey;
+        int numberOfSimilarMessages = 0;
+        int numberOfSuppressedMessages = 0;
+        qint64 lastSuppressionReportMs = 0;
+    };
+
+    CThreadMessageBuffer():
+    mItems(static_cast<std::size_t>(sThreadBufferCapacity)),
+    mHead(0u),
+    mTail(0u),
+    mNumberOfDroppedMessages(0u),
+    mbIsThreadAlive(true),
+    mThreadIdStr(QString("0x%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()),
+                                     QT_POINTER_SIZE * 2, 16, QChar('0'))),
+    mRateLimitState()
+    {}
+
+    // called only by the owning thread
+    void push( tMessageBufferItem&& item )
+    {
+        const quint64 head = mHead.load(std::memory_order_relaxed);
+
+        if(head - mTail.load(std::memory_order_acquire) >= sThreadBufferCapacity)
+        {
+            mNumberOfDroppedMessages.fetch_add(1u, std::memory_order_relaxed);
+            return;
+        }
+
+        mItems[static_cast<std::size_t>(head % sThreadBufferCapacity)] = std::move(item);
+        mHead.store(head + 1u, std::memory_order_release);
+    }
+
+    // called only by the consumer thread
+    bool pop( tMessageBufferItem& item )
+    {
+        const quint64 tail = mTail.load(std::memory_order_relaxed);
+
+        if(tail == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = std::move(mItems[static_cast<std::size_t>(tail % sThreadBufferCapacity)]);
+        mTail.store(tail + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    bool empty() const
+    {
+        return mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_acquire);
+    }
+
+    quint64 takeNumberOfDroppedMessages()
+    {
+        return mNumberOfDroppedMessages.exchange(0u, std::memory_order_relaxed);
+    }
+
+    void setThreadFinished()
+    {
+        mbIsThreadAlive = false;
+    }
+
+    bool isThreadAlive() const
+    {
+        return mbIsThreadAlive;
+    }
+
+    const QString& getThreadIdStr() const
+    {
+        return mThreadIdStr;
+    }
+
+    tRateLimitState& getRateLimitState()
+    {
+        return mRateLimitState;
+    }
+
+private:
+    std::vector<tMessageBufferItem> mItems;
+    std::atomic<quint64> mHead;
+    std::atomic<quint64> mTail;
+    std::atomic<quint64> mNumberOfDroppedMessages;
+    std::atomic<bool> mbIsThreadAlive;
+    const QString mThreadIdStr;
+    tRateLimitState mRateLimitState;
+};
+
+typedef std::shared_ptr<CThreadMessageBuffer> tThreadMessageBufferPtr;
+typedef std::vector<tThreadMessageBufferPtr> tThreadMessageBuffers;
+
+static std::mutex& g_ThreadMessageBuffersProtector()
+{
+    static std::mutex sThreadMessageBuffersProtector;
+    return sThreadMessageBuffersProtector;
+}
+
+static tThreadMessageBuffers& g_ThreadMessageBuffers()
+{
+    static tThreadMessageBuffers sThreadMessageBuffers;
+    return sThreadMessageBuffers;
+}
+
+struct tThreadMessageBufferHolder
+{
+    ~tThreadMessageBufferHolder()
+    {
+        if(nullptr != pBuffer)
+        {
+            // the remaining messages are still drained, after which the buffer is released
+            pBuffer->setThreadFinished();
+        }
+    }
+
+    tThreadMessageBufferPtr pBuffer;
+};
+
+static CThreadMessageBuffer& g_ThreadMessageBuffer()
+{
+    thread_local tThreadMessageBufferHolder sHolder;
+
+    if(nullptr == sHolder.pBuffer)
+    {
+        sHolder.pBuffer = std::make_shared<CThreadMessageBuffer>();
+
+        const std::lock_guard<std::mutex> guard(g_ThreadMessageBuffersProtector());
+        g_ThreadMessageBuffers().push_back(sHolder.pBuffer);
+    }
+
+    return *sHolder.pBuffer;
+}
+
 /////////////////////////INSTANCE_ACCESS/////////////////////////
 static std::atomic<bool>& g_IsExist()
 {
@@ -96,59 +251,124 @@ bool CConsoleCtrl::isExist()
 void CConsoleCtrl::sendMessage( const QString& message,
                                 const tMessageSettings& messageSettings )
 {
-    qRegisterMetaType<tMessageSettings>("tMessageSettings");
+    tMessageBufferItem bufferItem;
+    bufferItem.message = message;
+    bufferItem.messageSettings = messageSettings;
+    bufferItem.timestampMs = QDateTime::currentMSecsSinceEpoch();
 
     if( true == g_IsExist() )
     {
-        auto& isBufferApplied = g_IsBufferApplied();
+        g_ThreadMessageBuffer().push(std::move(bufferItem));
+    }
+    else
+    {
+        const std::lock_guard<std::mutex> guard(g_MessageBufferProtector());
+        g_MessageBuffer().push_back(bufferItem);
+    }
+}
 
-        if(false == isBufferApplied)
-        {
-            const std::lock_guard<std::mutex> guard(g_MessageBufferProtector());
+struct tConsoleLine
+{
+    QString text;
+    eMessageType messageType = eMessageType::eMsg;
+    bool bCustomColor = false;
+    QColor color;
+    qint64 timestampMs = 0;
+    // removes all lines, which were sent before it
+    bool bClear = false;
+};
 
-            if(false == isBufferApplied) // let's double check, to prevent duplicated messages.
-            {
-                auto& messageBuffer = g_MessageBuffer();
+typedef std::vector<tConsoleLine> tConsoleLines;
 
-                for(const auto& messageBufferItem : messageBuffer)
-                {
-                    QMetaObject::invokeMethod(g_InstancePtr().get(), "addMessage", Qt::QueuedConnection,
-                                              Q_ARG(QString, messageBufferItem.message),
-                                              Q_ARG(tMessageSettings, messageBufferItem.messageSettings));
-                }
+// lines, which did not fit into the previous drains, ordered by time. Accessed only from the thread of the instance
+static tConsoleLines& g_DeferredLines()
+{
+    static tConsoleLines sDeferredLines;
+    return sDeferredLines;
+}
 
-                messageBuffer.clear();
-                isBufferApplied = true;
-            }
+/**
+ * @brief getMessageKey - gets the key, which is equal for the similar messages, e.g. "Row 10 skipped" and "Row 11 skipped"
+ */
+static QString getMessageKey( const tMessageBufferItem& item )
+{
+    QString result;
+    result.reserve(item.message.size() + 1);
+    result.append(QChar('0' + static_cast<int>(item.messageSettings.messageType)));
+
+    for(const auto& character : item.message)
+    {
+        if(false == character.isDigit())
+        {
+            result.append(character);
         }
+    }
+
+    return result;
+}
 
-        QString TID = QString("0x%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()),
-                            QT_POINTER_SIZE * 2, 16, QChar('0'));
-        QString messageExtended( QString("[TID::%1] : %2")
-                                 .arg(TID)
-                                 .arg(message));
+/**
+ * @brief getTimestampString - formats the timestamp. Should be called only from the thread of the console controller
+ */
+static const QString& getTimestampString( const qint64& timestampMs )
+{
+    static qint64 sLastTimestampSec = -1;
+    static QString sLastTimestampString;
 
-        QMetaObject::invokeMethod(g_InstancePtr().get(), "addMessage", Qt::QueuedConnection,
-                                  Q_ARG(QString, messageExtended),
-                                  Q_ARG(tMessageSettings, messageSettings));
+    // default format has no milliseconds, thus the string is reused within one second
+    const qint64 timestampSec = timestampMs / 1000;
+
+    if(timestampSec != sLastTimestampSec)
+    {
+        sLastTimestampSec = timestampSec;
+        sLastTimestampString = QDateTime::fromMSecsSinceEpoch(timestampMs).toString();
     }
-    else
+
+    return sLastTimestampString;
+}
+
+static tConsoleLine createConsoleLine( const QString& message,
+                                       const tMessageSettings& messageSettings,
+                                       const qint64& timestampMs,
+                                       const QString& threadIdStr,
+                                       const unsigned int& maxMsgSize )
+{
+    tConsoleLine result;
+    result.messageType = messageSettings.messageType;
+    result.bCustomColor = messageSettings.bCustomColor;
+    result.color = messageSettings.color;
+    result.timestampMs = timestampMs;
+
+    QString messageExtended = true == threadIdStr.isEmpty() ?
+                message :
+                QString("[TID::%1] : %2").arg(threadIdStr).arg(message);
+
+    if(messageExtended.size() >= static_cast<int>(maxMsgSize))
     {
-        const std::lock_guard<std::mutex> guard(g_MessageBufferProtector());
+        messageExtended.truncate(static_cast<int>(maxMsgSize));
+        messageExtended.append("...");
+    }
 
-        tMessageBufferItem bufferItem;
-        bufferItem.message = message;
-        bufferItem.messageSettings = messageSettings;
-        g_MessageBuffer().push_back(bufferItem);
+    result.text.reserve(messageExtended.size() + 50);
+    result.text.append("[").append(getTimestampString(timestampMs)).append("]");
+
+    switch(messageSettings.messageType)
+    {
+        case eMessageType::eMsg: result.text.append("[M]"); break;
+        case eMessageType::eWrn: result.text.append("[W]"); break;
+        case eMessageType::eErr: result.text.append("[E]"); break;
     }
+
+    result.text.append(" : ").append(messageExtended);
+
+    return result;
 }
 
 CConsoleCtrl::CConsoleCtrl( const tConsoleConfig& consoleConfig ):
 mConsoleConfig(consoleConfig),
 mMessageCounters(),
 mCountedMessageType(eMessageType::eMsg),
-mBufferedMessages(),
-mFlushBufferedMessagsTimer()
+mDrainTimer()
 {
     if(nullptr != mConsoleConfig.pConsoleTextEdit)
     {
@@ -159,6 +379,8 @@ mFlushBufferedMessagsTimer()
         font.setStyleHint(QFont::TypeWriter);
         consoleConfig.pConsoleTextEdit->setFont(font);
         consoleConfig.pConsoleTextEdit->setMaximumBlockCount(static_cast<int>(mConsoleConfig.logSize));
+        // lines are never wrapped, thus the layout of the visible blocks is cheap
+        consoleConfig.pConsoleTextEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
 
         auto* pTabWidget = mConsoleConfig.pTabWidget;
         auto* pConsoleTab = mConsoleConfig.pConsoleTab;
@@ -190,148 +412,319 @@ mFlushBufferedMessagsTimer()
         }
     }
 
-    connect(&mFlushBufferedMessagsTimer, &QTimer::timeout, this, [this]()
+    connect(&mDrainTimer, &QTimer::timeout, this, &CConsoleCtrl::drainMessages);
+    mDrainTimer.start(sDrainPeriodMs);
+}
+
+void CConsoleCtrl::drainMessages()
+{
+    tConsoleLines lines;
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    auto addLine = [this, &lines](const tMessageBufferItem& item, const QString& threadIdStr)
     {
-        if(mConsoleConfig.pConsoleTextEdit)
+        if(true == item.messageSettings.clear)
         {
-            if(!mBufferedMessages.empty())
-            {
-                QString finalMessage;
+            // lines of the other threads can be sent before or after it, thus it is applied once all lines are ordered
+            tConsoleLine clearLine;
+            clearLine.timestampMs = item.timestampMs;
+            clearLine.bClear = true;
+            lines.push_back(clearLine);
+        }
+        else
+        {
+            lines.push_back(createConsoleLine(item.message, item.messageSettings, item.timestampMs,
+                                              threadIdStr, mConsoleConfig.maxMsgSize));
+        }
+    };
 
-                auto sizeCounter = 0;
+    auto addNote = [this, &lines, &nowMs](const QString& note, const QString& threadIdStr)
+    {
+        tMessageSettings messageSettings;
+        messageSettings.messageType = eMessageType::eWrn;
+        lines.push_back(createConsoleLine(note, messageSettings, nowMs, threadIdStr, mConsoleConfig.maxMsgSize));
+    };
 
-                for(const auto& message : mBufferedMessages)
-                {
-                    sizeCounter += message.size();
-                }
+    // messages, which were sent before the instance was created
+    {
+        tMessageBufferList messageBuffer;
 
-                finalMessage.reserve(sizeCounter);
+        {
+            const std::lock_guard<std::mutex> guard(g_MessageBufferProtector());
+            messageBuffer.swap(g_MessageBuffer());
+        }
 
-                for(const auto& message : mBufferedMessages)
-                {
-                    finalMessage.push_back(message);
-                }
+        for(const auto& messageBufferItem : messageBuffer)
+        {
+            addLine(messageBufferItem, QString());
+        }
+    }
 
-                mConsoleConfig.pConsoleTextEdit->appendHtml(finalMessage);
+    tThreadMessageBuffers threadMessageBuffers;
 
-                mBufferedMessages.clear();
-            }
-        }
+    {
+        const std::lock_guard<std::mutex> guard(g_ThreadMessageBuffersProtector());
+        auto& allThreadMessageBuffers = g_ThreadMessageBuffers();
 
-        mFlushBufferedMessagsTimer.stop();
-    });
-}
+        // buffers of the finished threads are released, once they are drained
+        allThreadMessageBuffers.erase(std::remove_if(allThreadMessageBuffers.begin(), allThreadMessageBuffers.end(),
+                                                     [](const tThreadMessageBufferPtr& pBuffer)
+        {
+            return false == pBuffer->isThreadAlive() &&
+                   true == pBuffer->empty() &&
+                   0 == pBuffer->getRateLimitState().numberOfSuppressedMessages;
+        }), allThreadMessageBuffers.end());
 
-void CConsoleCtrl::addMessage( const QString& message, const tMessageSettings& messageSettings )
-{
-    const QColor textColor = qApp->palette().text().color();
-    QString colorStr = QString("#%1").arg(textColor.rgba(), 8, 16);
-
-    bool isDarkModeOn = isDarkMode();
-    const QString msgHtml = "<font color=\"" + colorStr + "\">";
-    QString wrnStr = isDarkModeOn ? "#fafa00" : "#969600";
-    const QString wrnHtml = "<font color=\"" + wrnStr + "\">";
-    QString errorStr = isDarkModeOn ? "#fa0000" : "#960000";
-    const QString errHtml = "<font color=\"" + errorStr + "\">";
-    const QString endHtml = "</font>";
-    const QColor msgColor = qApp->palette().text().color();
-    const QColor wrnColor = isDarkModeOn ? QColor(250,250,0) : QColor(150,150,0);
-    const QColor errColor = isDarkModeOn ? QColor(250,0,0) : QColor(150,0,0);
+        threadMessageBuffers = allThreadMessageBuffers;
+    }
 
-    if(nullptr != mConsoleConfig.pConsoleTextEdit)
+    tMessageBufferItem item;
+
+    for(const auto& pBuffer : threadMessageBuffers)
     {
-        if(true == messageSettings.clear)
-        {
-            mConsoleConfig.pConsoleTextEdit->clear();
-        }
-        else
+        auto& rateLimitState = pBuffer->getRateLimitState();
+        const auto& threadIdStr = pBuffer->getThreadIdStr();
+
+        auto reportSuppressedMessages = [&rateLimitState, &addNote, &threadIdStr, &nowMs]()
         {
+            if(0 != rateLimitState.numberOfSuppressedMessages)
+            {
+                addNote(QString("%1 similar message(s) suppressed").arg(rateLimitState.numberOfSuppressedMessages), threadIdStr);
+                rateLimitState.numberOfSuppressedMessages = 0;
+            }
+
+            rateLimitState.lastSuppressionReportMs = nowMs;
+        };
 
-            QString messageEscaped = message.toHtmlEscaped();
-            messageEscaped.replace("\n", "<br/>");
+        const quint64 numberOfDroppedMessages = pBuffer->takeNumberOfDroppedMessages();
 
-            QString HTMLMessage;
-            HTMLMessage.reserve(messageEscaped.size() + 50);
+        // at most one buffer capacity per drain, so that the flooding thread is not able to block the drain
+        for(quint64 i = 0u; i < sThreadBufferCapacity && true == pBuffer->pop(item); ++i)
+        {
+            if(true == item.messageSettings.clear)
+            {
+                addLine(item, threadIdStr);
+                continue;
+            }
 
-            HTMLMessage.append("<pre>");
+            QString messageKey = getMessageKey(item);
 
-            if(true == messageSettings.bCustomColor)
+            if(messageKey == rateLimitState.lastMessageKey)
             {
-                HTMLMessage.append("<font color=\"").append(rgb2hex(messageSettings.color)).append("\">");
+                ++rateLimitState.numberOfSimilarMessages;
             }
             else
             {
-                switch(messageSettings.messageType)
-                {
-                    case eMessageType::eMsg: HTMLMessage.append(msgHtml); break;
-                    case eMessageType::eWrn: HTMLMessage.append(wrnHtml); break;
-                    case eMessageType::eErr: HTMLMessage.append(errHtml); break;
-                }
+                reportSuppressedMessages();
+                rateLimitState.lastMessageKey = std::move(messageKey);
+                rateLimitState.numberOfSimilarMessages = 1;
             }
 
-            HTMLMessage.append("[").append(QDateTime::currentDateTime().toString()).append("]");
-
-            switch(messageSettings.messageType)
+            if(rateLimitState.numberOfSimilarMessages > sMaxSimilarMessages)
             {
-                case eMessageType::eMsg: HTMLMessage.append("[M]"); break;
-                case eMessageType::eWrn: HTMLMessage.append("[W]"); break;
-                case eMessageType::eErr: HTMLMessage.append("[E]"); break;
+                ++rateLimitState.numberOfSuppressedMessages;
             }
+            else
+            {
+                addLine(item, threadIdStr);
+            }
+        }
+
+        if(0 != rateLimitState.numberOfSuppressedMessages &&
+           nowMs - rateLimitState.lastSuppressionReportMs >= sSuppressionReportPeriodMs)
+        {
+            reportSuppressedMessages();
+        }
 
-            HTMLMessage.append(" : ");
+        if(0u != numberOfDroppedMessages)
+        {
+            addNote(QString("%1 message(s) dropped due to the overflow of the thread's log buffer").arg(numberOfDroppedMessages), threadIdStr);
+        }
+    }
 
-            QString messageNormalized = messageEscaped.size() >= static_cast<int>(mConsoleConfig.maxMsgSize)
-                    ? messageEscaped.mid(0, static_cast<int>(mConsoleConfig.maxMsgSize)).append("...")
-                    : messageEscaped;
+    // messages of the different threads are interleaved in the order of sending
+    auto compareLines = [](const tConsoleLine& lhs, const tConsoleLine& rhs)
+    {
+        return lhs.timestampMs < rhs.timestampMs;
+    };
 
-            HTMLMessage.append(messageNormalized);
-            HTMLMessage.append(endHtml);
+    std::stable_sort(lines.begin(), lines.end(), compareLines);
 
-            HTMLMessage.append("</pre>");
+    // new lines go after the deferred ones, which were sent at the same time
+    auto& deferredLines = g_DeferredLines();
+    const auto numberOfPreviouslyDeferredLines = static_cast<std::ptrdiff_t>(deferredLines.size());
+    deferredLines.insert(deferredLines.end(), std::make_move_iterator(lines.begin()), std::make_move_iterator(lines.end()));
+    std::inplace_merge(deferredLines.begin(), deferredLines.begin() + numberOfPreviouslyDeferredLines, deferredLines.end(), compareLines);
+    lines.clear();
 
-            mBufferedMessages.push_back(HTMLMessage);
-            mFlushBufferedMessagsTimer.start(100);
-        }
+    // the last clear removes everything, which was sent before it, independently of the sending thread
+    bool bClear = false;
+    auto foundClearLine = std::find_if(deferredLines.rbegin(), deferredLines.rend(), [](const tConsoleLine& line)
+    {
+        return true == line.bClear;
+    });
+
+    if(foundClearLine != deferredLines.rend())
+    {
+        deferredLines.erase(deferredLines.begin(), foundClearLine.base());
+        bClear = true;
+    }
 
-        if(nullptr != mConsoleConfig.pTabWidget && nullptr != mConsoleConfig.pConsoleTab)
+    std::size_t numberOfRateLimitedMessages = 0u;
+
+    if(deferredLines.size() > sMaxDeferredMessages)
+    {
+        // the newest lines are suppressed, except for the errors
+        auto removedLinesBegin = std::remove_if(deferredLines.begin() + static_cast<std::ptrdiff_t>(sMaxDeferredMessages),
+                                                deferredLines.end(),
+                                                [](const tConsoleLine& line)
         {
-            auto* pTabWidget = mConsoleConfig.pTabWidget;
-            auto* pConsoleTab = mConsoleConfig.pConsoleTab;
-            auto* pTabBar = pTabWidget->tabBar();
+            return eMessageType::eErr != line.messageType;
+        });
+
+        numberOfRateLimitedMessages = static_cast<std::size_t>(std::distance(removedLinesBegin, deferredLines.end()));
+        deferredLines.erase(removedLinesBegin, deferredLines.end());
+    }
 
-            auto consoleTabIndex = pTabWidget->indexOf(pConsoleTab);
+    // everything above the limit waits for the next drain
+    const auto numberOfShownLines = static_cast<std::ptrdiff_t>(std::min(deferredLines.size(),
+                                                                         static_cast<std::size_t>(sMaxShownMessagesPerDrain)));
+    lines.assign(std::make_move_iterator(deferredLines.begin()), std::make_move_iterator(deferredLines.begin() + numberOfShownLines));
+    deferredLines.erase(deferredLines.begin(), deferredLines.begin() + numberOfShownLines);
 
-            ++mMessageCounters[messageSettings.messageType];
+    if(0u != numberOfRateLimitedMessages)
+    {
+        addNote(QString("%1 message(s) suppressed due to the rate limit of the console").arg(static_cast<quint64>(numberOfRateLimitedMessages)), QString());
+    }
 
-            if(consoleTabIndex != pTabWidget->currentIndex()) // if console view tab is not selected
-            {
-                if(messageSettings.messageType >= mCountedMessageType)
-                {
-                    mCountedMessageType = messageSettings.messageType;
+    auto* pConsoleTextEdit = mConsoleConfig.pConsoleTextEdit;
+
+    if(nullptr == pConsoleTextEdit)
+    {
+        return;
+    }
 
-                    // update tab's highlighting
-                    QColor tabHighlightingColor;
+    if(true == bClear)
+    {
+        pConsoleTextEdit->clear();
+    }
+
+    if(true == lines.empty())
+    {
+        return;
+    }
 
-                    switch(messageSettings.messageType)
-                    {
-                        case eMessageType::eMsg: tabHighlightingColor = msgColor; break;
-                        case eMessageType::eWrn: tabHighlightingColor = wrnColor; break;
-                        case eMessageType::eErr: tabHighlightingColor = errColor; break;
-                    }
+    const bool isDarkModeOn = isDarkMode();
+    QTextCharFormat msgFormat;
+    msgFormat.setForeground(qApp->palette().text().color());
+    QTextCharFormat wrnFormat;
+    wrnFormat.setForeground(isDarkModeOn ? QColor(250,250,0) : QColor(150,150,0));
+    QTextCharFormat errFormat;
+    errFormat.setForeground(isDarkModeOn ? QColor(250,0,0) : QColor(150,0,0));
 
-                    pTabBar->setTabTextColor(consoleTabIndex, tabHighlightingColor);
+    auto* pScrollBar = pConsoleTextEdit->verticalScrollBar();
+    const bool bIsScrolledToBottom = nullptr == pScrollBar || pScrollBar->value() == pScrollBar->maximum();
 
-                    // update tab's text
-                    pTabBar->setTabText( consoleTabIndex,
-                                         QString(g_TabName()).append(" (%1)").arg(QString::number(mMessageCounters[messageSettings.messageType])));
-                }
+    tMessageCounters newMessageCounters;
+
+    // whole batch is inserted as plain text within one edit block. No html is parsed
+    QTextCursor cursor(pConsoleTextEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+
+    bool bIsDocumentEmpty = pConsoleTextEdit->document()->isEmpty();
+
+    for(const auto& line : lines)
+    {
+        if(false == bIsDocumentEmpty)
+        {
+            cursor.insertBlock();
+        }
+
+        bIsDocumentEmpty = false;
+
+        if(true == line.bCustomColor)
+        {
+            QTextCharFormat customFormat;
+            customFormat.setForeground(line.color);
+            cursor.insertText(line.text, customFormat);
+        }
+        else
+        {
+            switch(line.messageType)
+            {
+                case eMessageType::eMsg: cursor.insertText(line.text, msgFormat); break;
+                case eMessageType::eWrn: cursor.insertText(line.text, wrnFormat); break;
+                case eMessageType::eErr: cursor.insertText(line.text, errFormat); break;
             }
-            else
+        }
+
+        ++newMessageCounters[line.messageType];
+    }
+
+    cursor.endEditBlock();
+
+    if(true == bIsScrolledToBottom && nullptr != pScrollBar)
+    {
+        pScrollBar->setValue(pScrollBar->maximum());
+    }
+
+    updateTabHighlighting(newMessageCounters);
+}
+
+void CConsoleCtrl::updateTabHighlighting( const tMessageCounters& newMessageCounters )
+{
+    if(nullptr == mConsoleConfig.pTabWidget || nullptr == mConsoleConfig.pConsoleTab)
+    {
+        return;
+    }
+
+    auto* pTabWidget = mConsoleConfig.pTabWidget;
+    auto* pConsoleTab = mConsoleConfig.pConsoleTab;
+    auto* pTabBar = pTabWidget->tabBar();
+
+    auto consoleTabIndex = pTabWidget->indexOf(pConsoleTab);
+
+    const bool isDarkModeOn = isDarkMode();
+    const QColor msgColor = qApp->palette().text().color();
+    const QColor wrnColor = isDarkModeOn ? QColor(250,250,0) : QColor(150,150,0);
+    const QColor errColor = isDarkModeOn ? QColor(250,0,0) : QColor(150,0,0);
+
+    // QMap is ordered, thus the most severe type is handled last
+    for(auto it = newMessageCounters.begin(); it != newMessageCounters.end(); ++it)
+    {
+        const auto& messageType = it.key();
+
+        mMessageCounters[messageType] += it.value();
+
+        if(consoleTabIndex != pTabWidget->currentIndex()) // if console view tab is not selected
+        {
+            if(messageType >= mCountedMessageType)
             {
-                // reset counter
-                mMessageCounters[messageSettings.messageType] = 0u;
+                mCountedMessageType = messageType;
+
+                // update tab's highlighting
+                QColor tabHighlightingColor;
+
+                switch(messageType)
+                {
+                    case eMessageType::eMsg: tabHighlightingColor = msgColor; break;
+                    case eMessageType::eWrn: tabHighlightingColor = wrnColor; break;
+                    case eMessageType::eErr: tabHighlightingColor = errColor; break;
+                }
+
+                pTabBar->setTabTextColor(consoleTabIndex, tabHighlightingColor);
+
+                // update tab's text
+                pTabBar->setTabText( consoleTabIndex,
+                                     QString(g_TabName()).append(" (%1)").arg(QString::number(mMessageCounters[messageType])));
             }
         }
+        else
+        {
+            // reset counter
+            mMessageCounters[messageType] = 0u;
+        }
     }
 }
 
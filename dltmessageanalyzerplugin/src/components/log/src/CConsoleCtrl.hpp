@@ -43,6 +43,9 @@ namespace NDLTMessageAnalyzer
          * @brief The CConsoleCtrl class - this purely statis class is used to send messages from any Qt-based thread to a GUI thread and place them into provided
          * text edit.
          * Used to implement debug console within the DLTMessageAnalyzer plugin.
+         * Each sending thread writes its messages into its own lock-free ring buffer. GUI thread periodically drains all buffers
+         * and appends the messages to the text edit as plain text in one batch. Floods of similar messages are collapsed into
+         * the "N similar messages suppressed" notes, and the number of the shown messages per drain is limited.
          */
         class CConsoleCtrl : public QObject
         {
@@ -86,13 +89,12 @@ namespace NDLTMessageAnalyzer
 
 private slots:
             /**
-             * @brief addMessage - when event form the client reaches thread, in which signletone instance is located -
-             * sends a message to the corresponding text edit.
-             * Depending on type of the message, highlights
-             * @param message - string of the message, to be added to console
-             * @param messageSettings - set of the message settings, which should be considered.
+             * @brief drainMessages - collects the messages from the buffers of all threads
+             * and appends them to the corresponding text edit. Called periodically in the thread, in which signletone instance is located.
+             * Messages above the per-drain limit are deferred to the next drain. Clear is applied in the order of sending.
+             * Depending on type of the messages, highlights the console tab
              */
-            void addMessage( const QString& message, const tMessageSettings& messageSettings );
+            void drainMessages();
 
         private: // methods
             /**
@@ -101,13 +103,19 @@ private slots:
              */
             CConsoleCtrl( const tConsoleConfig& consoleConfig );
 
+            typedef QMap<eMessageType, unsigned int> tMessageCounters;
+
+            /**
+             * @brief updateTabHighlighting - updates counters and highlighting of the console tab
+             * @param newMessageCounters - number of the newly shown messages of each type
+             */
+            void updateTabHighlighting( const tMessageCounters& newMessageCounters );
+
         private: // fields
             tConsoleConfig mConsoleConfig;
-            typedef QMap<eMessageType, unsigned int> tMessageCounters;
             tMessageCounters mMessageCounters;
             eMessageType mCountedMessageType;
-            QStringList mBufferedMessages;
-            QTimer mFlushBufferedMessagsTimer;
+            QTimer mDrainTimer;
         };
     }
 }
@@ -12,6 +12,8 @@
 #include "dltmessageanalyzerplugin.hpp"
 
 #include "common/Definitions.hpp"
+#include "common/CPerfCounters.hpp"
+#include "common/CTextToDLTConverter.hpp"
 
 #include "CConsoleInputProcessor.hpp"
 #include "../api/CLog.hpp"
@@ -85,6 +87,34 @@ static void availableUMLPackages(const QString& packageName)
     }
 }
 
+static void printPerfStats(const CPerfCounters::tStagesStats& stagesStats)
+{
+    auto toUs = [](const CPerfCounters::tDurationNs& durationNs)
+    {
+        return QString::number(static_cast<double>(durationNs) / 1000.0, 'f', 1);
+    };
+
+    SEND_MSG("stage | count | total, ms | avg, us | p50, us | p90, us | p99, us | max, us");
+
+    for(int i = 0; i < static_cast<int>(ePerfStage::eLast); ++i)
+    {
+        const auto& stageStats = stagesStats[static_cast<std::size_t>(i)];
+
+        if(0u != stageStats.count)
+        {
+            SEND_MSG(QString("%1 | %2 | %3 | %4 | %5 | %6 | %7 | %8")
+                     .arg(getPerfStageName(static_cast<ePerfStage>(i)))
+                     .arg(stageStats.count)
+                     .arg(QString::number(static_cast<double>(stageStats.totalNs) / 1000000.0, 'f', 1))
+                     .arg(toUs(stageStats.totalNs / static_cast<CPerfCounters::tDurationNs>(stageStats.count)))
+                     .arg(toUs(stageStats.getPercentileNs(50.0)))
+                     .arg(toUs(stageStats.getPercentileNs(90.0)))
+                     .arg(toUs(stageStats.getPercentileNs(99.0)))
+                     .arg(toUs(stageStats.maxNs)));
+        }
+    }
+}
+
 static bool printClassDiagram(const QString& packageName, bool excludeExternalDependencies)
 {
     auto printPackage = [&excludeExternalDependencies](const QString& packageName_)->bool
@@ -332,7 +362,7 @@ bool CConsoleInputProcessor::printHelp(const QString& command)
 {
     bool bResult = false;
 
-    static const auto scenarioMap = createScenariosMap();
+    const auto& scenarioMap = mScenariosMap;
 
     if(true == command.isEmpty())
     {
@@ -683,6 +713,9 @@ CConsoleInputProcessor::tScenariosMap CConsoleInputProcessor::createScenariosMap
             SEND_MSG( QString("Plantuml path environment variable value: \"No such variable exist\""));
         }
 
+        SEND_MSG( QString("Plantuml render server mode: \"%1\"")
+        .arg(getSettingsManager()->getUML_RenderServerMode() ? "on" : "off"));
+
         return bResult;
     },
     "- prints information about the currently used plantuml settings");
@@ -735,37 +768,72 @@ CConsoleInputProcessor::tScenariosMap CConsoleInputProcessor::createScenariosMap
 
                 if(foundTargetFileParam != params.end())
                 {
-                    bool bConversionAttempted = false;
+                    CTextToDLTConverter::tParameters parameters;
+                    parameters.sourceFilePath = foundSourceFileParam->second;
+                    parameters.targetFilePath = foundTargetFileParam->second;
 
-                    auto foundVersionParam = params.find("version");
+                    bool bParametersValid = true;
+
+                    auto foundVersionParam = params.find("v");
+
+                    if(foundVersionParam == params.end())
+                    {
+                        foundVersionParam = params.find("version");
+                    }
 
                     if(foundVersionParam != params.end())
                     {
                         if(foundVersionParam->second.toLower() == "v2")
                         {
-                            bResult = convertLogFileToDLTV2(foundSourceFileParam->second, foundTargetFileParam->second);
-                            bConversionAttempted = true;
+                            parameters.dltVersion = 2;
                         }
                         else if(foundVersionParam->second.toLower() == "v1")
                         {
-                            bResult = convertLogFileToDLTV1(foundSourceFileParam->second, foundTargetFileParam->second);
-                            bConversionAttempted = true;
+                            parameters.dltVersion = 1;
                         }
                         else
                         {
                             SEND_ERR(QString("Command [convert-txt-to-dlt-file]: Wrong value '%1' was passed for the parameter 'version'! "
                                              "Supported values are 'v1' and 'v2'.")
                                          .arg(foundVersionParam->second));
+                            bParametersValid = false;
                         }
                     }
-                    else
+
+                    auto foundTimestampRegexParam = params.find("tsr");
+
+                    if(foundTimestampRegexParam != params.end())
                     {
-                        bResult = convertLogFileToDLTV2(foundSourceFileParam->second, foundTargetFileParam->second);
-                        bConversionAttempted = true;
+                        parameters.timestampRegex = foundTimestampRegexParam->second;
                     }
 
-                    if(true == bConversionAttempted)
+                    auto foundTimestampFormatParam = params.find("tsf");
+
+                    if(foundTimestampFormatParam != params.end())
                     {
+                        parameters.timestampFormat = foundTimestampFormatParam->second;
+                    }
+
+                    auto foundThreadsParam = params.find("t");
+
+                    if(foundThreadsParam != params.end())
+                    {
+                        bool bConverted = false;
+                        parameters.numberOfThreads = foundThreadsParam->second.toInt(&bConverted);
+
+                        if(false == bConverted)
+                        {
+                            SEND_ERR(QString("Command [convert-txt-to-dlt-file]: non-integer value '%1' provided in \"t\" parameter")
+                                         .arg(foundThreadsParam->second));
+                            bParametersValid = false;
+                        }
+                    }
+
+                    if(true == bParametersValid)
+                    {
+                        auto conversionResult = CTextToDLTConverter::convert(parameters);
+                        bResult = conversionResult.bIsSuccessful;
+
                         if(false == bResult)
                         {
                             SEND_ERR(QString("Command [convert-txt-to-dlt-file]: Failed to convert the \"%1\" file to dlt format!")
@@ -773,7 +841,8 @@ CConsoleInputProcessor::tScenariosMap CConsoleInputProcessor::createScenariosMap
                         }
                         else
                         {
-                            SEND_MSG("Command [convert-txt-to-dlt-file]: Conversion successfully performed!");
+                            SEND_MSG(QString("Command [convert-txt-to-dlt-file]: Conversion successfully performed! %1")
+                                     .arg(conversionResult.getThroughputString()));
                         }
                     }
                 }
@@ -797,7 +866,78 @@ CConsoleInputProcessor::tScenariosMap CConsoleInputProcessor::createScenariosMap
     "- converts specified file with '\\n' separated set of strings to the dlt format"
     "[-sf=<source_file> // mandatory! Source file which we should convert to the dlt format]"
     "[-tf=<target file> // mandatory! Target file, into which we should save the content]"
-    "[-v=<version> // optional! Version of the dlt protocol. Supported values are 'v1' and 'v2'. Default value is 'v2']");
+    "[-v=<version> // optional! Version of the dlt protocol. Supported values are 'v1' and 'v2'. Default value is 'v2']"
+    "[-tsr=<timestamp_regex> // optional! Regex, which extracts the original timestamp from the line. "
+    "Named group 'ts' or the first capture group is used. By default the conversion time is used]"
+    "[-tsf=<timestamp_format> // optional! QDateTime format of the extracted timestamp, e.g. 'yyyy-MM-dd hh:mm:ss.zzz'. "
+    "By default the timestamp is treated as the number of seconds since the ECU start]"
+    "[-t=<threads> // optional! Number of the encoding threads. By default all cores are used]");
+
+    result["perf-stats"] = CConsoleInputProcessor::tScenarioData([](const CConsoleInputProcessor::tParamMap& params)
+    {
+        bool bResult = true;
+
+        auto& perfCounters = CPerfCounters::getInstance();
+
+        auto foundTraceParam = params.find("t");
+
+        if(foundTraceParam != params.end())
+        {
+            if(false == foundTraceParam->second.isEmpty())
+            {
+                int numberOfEvents = perfCounters.exportChromeTrace(foundTraceParam->second);
+
+                if(numberOfEvents >= 0)
+                {
+                    SEND_MSG(QString("Command [perf-stats]: %1 trace events were exported to \"%2\"")
+                             .arg(numberOfEvents)
+                             .arg(foundTraceParam->second));
+                }
+                else
+                {
+                    SEND_ERR(QString("Command [perf-stats]: was not able to write the trace to \"%1\"")
+                             .arg(foundTraceParam->second));
+                    bResult = false;
+                }
+            }
+            else
+            {
+                SEND_ERR("Command [perf-stats]: empty value provided in \"t\" parameter");
+                bResult = false;
+            }
+        }
+
+        if(true == bResult)
+        {
+            SEND_MSG("Performance counters of the analysis pipeline:");
+            printPerfStats(perfCounters.getAggregatedStats());
+
+            if(params.end() != params.find("pt"))
+            {
+                const auto threadStatsVec = perfCounters.getThreadStats();
+
+                for(const auto& threadStats : threadStatsVec)
+                {
+                    SEND_MSG(QString("Thread \"%1\":").arg(threadStats.threadName));
+                    printPerfStats(threadStats.stagesStats);
+                }
+            }
+        }
+
+        if(params.end() != params.find("r"))
+        {
+            perfCounters.reset();
+            SEND_MSG("Command [perf-stats]: performance counters were reset");
+        }
+
+        return bResult;
+    },
+    "- prints the per-stage performance counters of the analysis pipeline: chunk string building, queue wait, "
+    "regex match, highlighting, UML and plot view extraction, GUI delivery and model insertion. "
+    "Worker stages are measured per chunk."
+    "[-pt // optional! Additionally print the counters of each thread]"
+    "[-t=<trace_file> // optional! Export the recent samples as Chrome trace JSON, which can be opened in chrome://tracing]"
+    "[-r // optional! Reset the counters after printing]");
 
 #ifdef DMA_TC_MALLOC_PROFILING_ENABLED
     result["dump-memory-stats"] = CConsoleInputProcessor::tScenarioData([](const CConsoleInputProcessor::tParamMap&)
@@ -917,6 +1057,11 @@ bool CConsoleInputProcessor::processCommand(const QString& command, const QList<
     return bResult;
 }
 
+void CConsoleInputProcessor::addScenario(const tScenarioTag& scenarioTag, const tScenarioData& scenarioData)
+{
+    mScenariosMap[scenarioTag.toLower()] = scenarioData;
+}
+
 bool CConsoleInputProcessor::eventFilter(QObject* pObj, QEvent* pEvent)
 {
     bool bResult = false;
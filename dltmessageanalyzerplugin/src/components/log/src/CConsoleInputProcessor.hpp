@@ -42,6 +42,15 @@ public:
 
     bool processCommand(const QString& command, const QList<QString>& params);
 
+    /**
+     * @brief addScenario - registers an additional scenario, e.g. the one, which is
+     * implemented on top of the components, on which the log component can't depend.
+     * Already existing scenario with the same tag is replaced.
+     * @param scenarioTag - name of the command
+     * @param scenarioData - handler and description of the command
+     */
+    void addScenario(const tScenarioTag& scenarioTag, const tScenarioData& scenarioData);
+
 protected:
     bool eventFilter(QObject* pObj, QEvent* pEvent) override;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "memory"
+#include "vector"
 
 #include "QObject"
 #include "QString"
@@ -90,6 +91,22 @@ public:
      */
     virtual int getMsgIdFromIndexInMainTable(int msgId) const = 0;
 
+    /**
+     * @brief getMsgIdsFromIndexesInMainTable - bulk version of the getMsgIdFromIndexInMainTable
+     * @param fromIdx - index of the first message in the main table
+     * @param numberOfMessages - number of the consecutive messages in the main table
+     * @param msgIds - output vector, to which the non-filtered id-s of the messages are appended.
+     * Indexes outside of the file's range are skipped.
+     */
+    virtual void getMsgIdsFromIndexesInMainTable(const int& fromIdx, const int& numberOfMessages, std::vector<tMsgId>& msgIds) = 0;
+
+    /**
+     * @brief invalidateFilteredIndex - drops the index of the filtered messages.
+     * Should be called, once the filter configuration of the dlt-viewer has changed.
+     * Index is rebuilt on the next request.
+     */
+    virtual void invalidateFilteredIndex() = 0;
+
     //////////////////////// CACHING_FUNCTIONALITY ////////////////////////
 
     /**
@@ -107,7 +124,9 @@ public:
     virtual void setMaxCacheSize(const tCacheSizeB& cacheSize /*in bytes*/ ) = 0;
 
     /**
-     * @brief cacheMsgWrapper - caches theprovided message wrapper
+     * @brief cacheMsgWrapper - caches theprovided message wrapper.
+     * Each provided message is also announced via the msgWrapperArrived signal,
+     * no matter whether it was cached or not.
      * @param msgId - non-filtered id of the message
      * @param pMsgWrapper - pointer to the message
      * @return - true, if caching was successfully done.
@@ -115,6 +134,15 @@ public:
      */
     virtual bool cacheMsgWrapper( const int& msgId, const tMsgWrapperPtr& pMsgWrapper ) = 0;
 
+    /**
+     * @brief cacheMsgWrappers - caches the block of the provided message wrappers.
+     * Has the same effect as the cacheMsgWrapper call for each message of the block,
+     * while the size of the cache is accounted once per block.
+     * @param msgWrappers - block of the messages. Should be sorted by the message id in order to use the fast path
+     * @return - number of the cached messages
+     */
+    virtual int cacheMsgWrappers( const tMsgWrapperBlock& msgWrappers ) = 0;
+
     /**
      * @brief cacheMsgByIndex - caches message by its id
      * @param msgId - non-filtered id of the message
@@ -140,7 +168,8 @@ public:
     virtual bool cacheMsgByRange( const tIntRange& msgRange ) = 0;
 
     /**
-     * @brief resetCache - resets the cache
+     * @brief resetCache - resets the cache and the timestamp index.
+     * Should be called on each change of the file, so that nothing from the previous content is kept.
      */
     virtual void resetCache() = 0;
 
@@ -154,6 +183,16 @@ public:
      */
     virtual tIntRangeProperty normalizeSearchRange( const tIntRangeProperty& inputRange) = 0;
 
+    /**
+     * @brief getMainTableRangeFromTimeRange - finds the messages, which correspond to the time window.
+     * Uses the sparse timestamp index, which is filled during the caching of the decoded messages.
+     * Parts of the file, which were not decoded yet, are indexed on demand.
+     * @param timeRange - time window
+     * @return - range of the indexes in the main table [from, to]. If no message fits the window,
+     * "to" is less than "from". If time range is not set - the whole main table is returned.
+     */
+    virtual tIntRange getMainTableRangeFromTimeRange( const tTimeRange& timeRange ) = 0;
+
     /**
      * @brief getCacheStatusAsString - the same as "formCacheStatusString", but using states of the class.
      * @return - a string, which describes status of the cache
@@ -225,6 +264,13 @@ signals:
      * @param isFull - whether cache is full or not
      */
     void fullChanged(bool isFull);
+
+    /**
+     * @brief msgWrapperArrived - signal, which is fired each time, when a decoded message is provided to the file wrapper
+     * @param msgId - non-filtered id of the message
+     * @param pMsgWrapper - pointer to the message
+     */
+    void msgWrapperArrived(const tMsgId& msgId, const tMsgWrapperPtr& pMsgWrapper);
 };
 
 /**
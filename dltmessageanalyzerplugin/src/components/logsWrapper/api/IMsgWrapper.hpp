@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ctime"
 #include "memory"
 
 #include "QString"
@@ -14,6 +15,7 @@ public:
     virtual ~IMsgWrapper();
 
     virtual QString getTimeString() const = 0;
+    virtual const time_t& getTime() const = 0;
     virtual const unsigned int& getMicroseconds() const = 0;
     virtual const unsigned int& getTimestamp() const = 0;
     virtual const unsigned char& getMessageCounter() const = 0;
@@ -4,10 +4,23 @@
  * @brief   Implementation of the CDLTFileWrapper class
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+
 #include "QDebug"
 #include "QElapsedTimer"
 #include "QClipboard"
 #include "QApplication"
+#include "QDataStream"
+#include "QCryptographicHash"
+#include "QFileInfo"
+#include "QSaveFile"
+#include "QThread"
+#include "QThreadPool"
+#include "QTimer"
+#include "QRunnable"
 
 #include "components/log/api/CLog.hpp"
 
@@ -19,6 +32,217 @@
 
 #include "DMA_Plantuml.hpp"
 
+static const QString sSubFileIndexSuffix = ".dma_index";
+static const quint32 sSubFileIndexMagic = 0x444D4149; // "DMAI"
+static const quint32 sSubFileIndexVersion = 2;
+// size of the data at the beginning and at the end of the indexed part of the file, which is hashed to validate the persisted index
+static const qint64 sSubFileIndexValidationBlockSize = 4096;
+static const int sSubFilesIndexingProgressPeriodMs = 1000;
+static const qint64 sStorageHeaderMarkerSize = 4;
+
+/**
+ * @brief isStorageHeaderMarker - checks whether the "DLT\x01" or "DLT\x02" storage header marker is located at the specified position
+ */
+static bool isStorageHeaderMarker(const uchar* pData, const qint64& pos, const qint64& size)
+{
+    return pos >= 0 && pos + sStorageHeaderMarkerSize <= size &&
+           'D' == pData[pos] && 'L' == pData[pos + 1] && 'T' == pData[pos + 2] &&
+           ( 0x01 == pData[pos + 3] || 0x02 == pData[pos + 3] );
+}
+
+/**
+ * @brief findStorageHeaderMarker - finds the next storage header marker, starting from the specified position
+ * @return - position of the found marker or -1, if there is no marker till the end of the data
+ */
+static qint64 findStorageHeaderMarker(const uchar* pData, qint64 pos, const qint64& size)
+{
+    // memchr is vectorized by the standard libraries, so we jump between the 'D' candidates
+    // instead of feeding each byte to the state machine
+    while(pos + sStorageHeaderMarkerSize <= size)
+    {
+        auto pFound = static_cast<const uchar*>(std::memchr(pData + pos, 'D',
+                                                static_cast<std::size_t>(size - pos - sStorageHeaderMarkerSize + 1)));
+
+        if(nullptr == pFound)
+        {
+            break;
+        }
+
+        pos = pFound - pData;
+
+        if(true == isStorageHeaderMarker(pData, pos, size))
+        {
+            return pos;
+        }
+
+        ++pos;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief getFileModificationTime - gets the modification time of the file in milliseconds since epoch
+ */
+static qint64 getFileModificationTime(const QString& path)
+{
+    return QFileInfo(path).lastModified().toMSecsSinceEpoch();
+}
+
+/**
+ * @brief getIndexedBlocksHash - gets the hash of the first and of the last blocks of the indexed part of the file
+ * @param file - opened file
+ * @param firstMsgPos - position of the first indexed message
+ * @param indexedFileSize - size of the indexed part of the file
+ * @return - hash or empty array, if blocks were not read
+ */
+static QByteArray getIndexedBlocksHash(QFile& file, const qint64& firstMsgPos, const qint64& indexedFileSize)
+{
+    QByteArray result;
+
+    if(firstMsgPos >= 0 && firstMsgPos < indexedFileSize)
+    {
+        const qint64 firstBlockSize = qMin(sSubFileIndexValidationBlockSize, indexedFileSize - firstMsgPos);
+        const qint64 lastBlockPos = qMax(firstMsgPos, indexedFileSize - sSubFileIndexValidationBlockSize);
+        const qint64 lastBlockSize = indexedFileSize - lastBlockPos;
+
+        QByteArray firstBlock;
+        QByteArray lastBlock;
+
+        if(true == file.seek(firstMsgPos))
+        {
+            firstBlock = file.read(firstBlockSize);
+        }
+
+        if(true == file.seek(lastBlockPos))
+        {
+            lastBlock = file.read(lastBlockSize);
+        }
+
+        if(firstBlockSize == firstBlock.size() && lastBlockSize == lastBlock.size())
+        {
+            QCryptographicHash hashBuilder(QCryptographicHash::Sha1);
+            hashBuilder.addData(firstBlock);
+            hashBuilder.addData(lastBlock);
+            result = hashBuilder.result();
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief getMessageLength - gets the length of the message, including its storage header
+ * @return - length of the message or 0, if the headers are not yet completely available
+ */
+static qint64 getMessageLength(const uchar* pData, const qint64& pos, const qint64& size)
+{
+    qint64 storageLength = 16;
+
+    if(0x02 == pData[pos + 3])
+    {
+        if(pos + 14 > size)
+        {
+            return 0;
+        }
+
+        storageLength = 14 + pData[pos + 13];
+    }
+
+    if(pos + storageLength + 1 > size)
+    {
+        return 0;
+    }
+
+    // Read DLT protocol version
+    const auto version = (pData[pos + storageLength] & 0xe0) >> 5;
+    const qint64 lengthOffset = 2 == version ? 5 : 2;
+
+    if(pos + storageLength + lengthOffset + 2 > size)
+    {
+        return 0;
+    }
+
+    const qint64 messageLength = ( static_cast<qint64>(pData[pos + storageLength + lengthOffset]) << 8 ) |
+                                 pData[pos + storageLength + lengthOffset + 1];
+
+    return messageLength + storageLength;
+}
+
+/**
+ * @brief indexRegion - walks through the chain of messages and stores their offsets.
+ * Message is added only when the next message starts right after it, or when it is the last one in the file.
+ * In case of corrupted data the search is continued right after the marker of the last found message.
+ * @param pData - data to be indexed
+ * @param size - size of the data
+ * @param baseOffset - offset of the data within the file
+ * @param index - index to be extended
+ */
+static void indexRegion(const uchar* pData, const qint64& size, const qint64& baseOffset, QVector<qint64>& index)
+{
+    qint64 pos = findStorageHeaderMarker(pData, 0, size);
+
+    while(pos >= 0)
+    {
+        const qint64 messageLength = getMessageLength(pData, pos, size);
+
+        if(0 == messageLength)
+        {
+            // header is not completely written yet
+            break;
+        }
+
+        const qint64 nextPos = pos + messageLength;
+
+        if(nextPos == size)
+        {
+            // last message found in file
+            index.push_back(baseOffset + pos);
+            break;
+        }
+        else if(nextPos + sStorageHeaderMarkerSize > size)
+        {
+            // the message or the next marker are not completely written yet
+            break;
+        }
+        else if(true == isStorageHeaderMarker(pData, nextPos, size))
+        {
+            index.push_back(baseOffset + pos);
+            pos = nextPos;
+        }
+        else
+        {
+            pos = findStorageHeaderMarker(pData, pos + sStorageHeaderMarkerSize, size);
+        }
+    }
+}
+
+/**
+ * @brief The CSubFileIndexingTask class - runnable, which indexes a single sub-file on the thread pool
+ */
+class CSubFileIndexingTask : public QRunnable
+{
+public:
+    typedef std::function<void()> tTask;
+
+    explicit CSubFileIndexingTask(const tTask& task):
+    mTask(task)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        if(mTask)
+        {
+            mTask();
+        }
+    }
+
+private:
+    tTask mTask;
+};
+
 CDLTFileWrapper::CDLTFileWrapper(QDltFile* pFile):
     mpFile(pFile),
     mpMessageDecoder(nullptr),
@@ -27,7 +251,9 @@ CDLTFileWrapper::CDLTFileWrapper(QDltFile* pFile):
     mbCacheEnabled(false),
     mbIsFull(false),
     mCacheLoadPercentage(0),
-    mpSubFilesHandler(std::make_shared<CSubFilesHandler>())
+    mFilteredMsgIds(),
+    mTimestampIndex(),
+    mpSubFilesHandler(std::make_shared<CSubFilesHandler>(this))
 {
     mpSubFilesHandler->setFile(pFile);
 }
@@ -171,6 +397,96 @@ int CDLTFileWrapper::getMsgIdFromIndexInMainTable(int msgIdxInMainTable) const
     return result;
 }
 
+bool CDLTFileWrapper::updateFilteredIndex()
+{
+    if(nullptr == mpFile || false == mpFile->isFilter())
+    {
+        mFilteredMsgIds.clear();
+        return false;
+    }
+
+    const int filteredSize = mpFile->sizeFilter();
+    int indexedSize = static_cast<int>(mFilteredMsgIds.size());
+
+    // In case of the continuous analysis new messages are appended to the filtered set.
+    // Any other modification of the filter is reported via the invalidateFilteredIndex.
+    if(indexedSize > filteredSize)
+    {
+        mFilteredMsgIds.clear();
+        indexedSize = 0;
+    }
+
+    int prevMsgId = 0 != indexedSize ? mpFile->getMsgFilterPos(indexedSize - 1) : -1;
+
+    for(int i = indexedSize; i < filteredSize; ++i)
+    {
+        const int msgId = mpFile->getMsgFilterPos(i);
+
+        if(msgId <= prevMsgId || msgId < 0)
+        {
+            // e.g. filtered messages are sorted by time. Rank of the id does not match the index in the main table
+            mFilteredMsgIds.clear();
+            return false;
+        }
+
+        mFilteredMsgIds.add(static_cast<CRoaringBitmap::tValue>(msgId));
+        prevMsgId = msgId;
+    }
+
+    return true;
+}
+
+void CDLTFileWrapper::invalidateFilteredIndex()
+{
+    mFilteredMsgIds.clear();
+}
+
+void CDLTFileWrapper::getMsgIdsFromIndexesInMainTable(const int& fromIdx, const int& numberOfMessages, std::vector<tMsgId>& msgIds)
+{
+    if(nullptr == mpFile || numberOfMessages <= 0)
+    {
+        return;
+    }
+
+    const int fileSize = size();
+    const int from = std::max(0, fromIdx);
+    const int to = std::min(fileSize, fromIdx + numberOfMessages); // exclusive
+
+    if(from >= to)
+    {
+        return;
+    }
+
+    msgIds.reserve(msgIds.size() + static_cast<std::size_t>(to - from));
+
+    if(true == mpFile->isFilter())
+    {
+        if(true == updateFilteredIndex())
+        {
+            mFilteredMsgIds.forEach(static_cast<std::size_t>(from), static_cast<std::size_t>(to - from),
+                                    [&msgIds](const CRoaringBitmap::tValue& msgId)
+            {
+                msgIds.push_back(static_cast<tMsgId>(msgId));
+                return true;
+            });
+        }
+        else
+        {
+            for(int i = from; i < to; ++i)
+            {
+                msgIds.push_back(mpFile->getMsgFilterPos(i));
+            }
+        }
+    }
+    else
+    {
+        for(int i = from; i < to; ++i)
+        {
+            msgIds.push_back(i);
+        }
+    }
+}
+
 void CDLTFileWrapper::incrementCacheSize( const unsigned int& bytes )
 {
     auto oldCacheSizeMB = BToMB( mCurrentCacheSize );
@@ -278,10 +594,79 @@ bool CDLTFileWrapper::decodeAndCacheMsg( const int& msgId, QDltMsg& msg )
     return bResult;
 }
 
+void CDLTFileWrapper::addToTimestampIndex( const int& msgId, const tMsgWrapperPtr& pMsgWrapper )
+{
+    if(nullptr != pMsgWrapper)
+    {
+        CTimestampIndex::tMsgTime msgTime;
+        msgTime.storageTime = static_cast<CTimestampIndex::tTimeUs>(pMsgWrapper->getTime()) * 1000000 + pMsgWrapper->getMicroseconds();
+        msgTime.ecuTimestamp = static_cast<CTimestampIndex::tTimeUs>(pMsgWrapper->getTimestamp()) * 100; // 0.1 ms resolution
+        mTimestampIndex.addMessage(msgId, msgTime);
+    }
+}
+
+int CDLTFileWrapper::cacheMsgWrappers( const tMsgWrapperBlock& msgWrappers )
+{
+    int result = 0;
+    tCacheSizeB blockSize = 0u;
+    bool bCacheFull = false;
+
+    for(const auto& msgWrapperItem : msgWrappers)
+    {
+        const auto& msgId = msgWrapperItem.first;
+        const auto& pMsgWrapper = msgWrapperItem.second;
+
+        msgWrapperArrived(msgId, pMsgWrapper);
+        addToTimestampIndex(msgId, pMsgWrapper);
+
+        if(true == mbCacheEnabled && nullptr != pMsgWrapper)
+        {
+            if( mCurrentCacheSize + blockSize < mMaxCacheSize )
+            {
+                if(true == mCache.cache.isEmpty() || mCache.cache.lastKey() < msgId)
+                {
+                    // messages are decoded in the ascending order. Appending to the end does not need a lookup
+                    mCache.cache.insert(mCache.cache.cend(), msgId, pMsgWrapper);
+                }
+                else if(mCache.cache.end() == mCache.cache.find(msgId))
+                {
+                    mCache.cache.insert(msgId, pMsgWrapper);
+                }
+                else
+                {
+                    continue;
+                }
+
+                blockSize += pMsgWrapper->getSize();
+                ++result;
+            }
+            else
+            {
+                bCacheFull = true;
+            }
+        }
+    }
+
+    if(0u != blockSize)
+    {
+        incrementCacheSize(static_cast<unsigned int>(blockSize));
+    }
+
+    if(true == bCacheFull)
+    {
+        handleCacheFull(true);
+    }
+
+    return result;
+}
+
 bool CDLTFileWrapper::cacheMsgWrapper( const int& msgId, const tMsgWrapperPtr& pMsgWrapper )
 {
     bool bResult = false;
 
+    msgWrapperArrived(msgId, pMsgWrapper);
+    addToTimestampIndex(msgId, pMsgWrapper);
+
     if(true == mbCacheEnabled) // if cache functionality is enabled
     {
         if( mCurrentCacheSize < mMaxCacheSize ) // if we have free cache size
@@ -387,6 +772,9 @@ void CDLTFileWrapper::resetCache()
     mCurrentCacheSize = 0;
     mCacheLoadPercentage = 0;
 
+    // timestamps of the previous content of the file would break the search by time
+    mTimestampIndex.clear();
+
     currentSizeMbChanged(0);
     loadChanged(0);
 
@@ -437,33 +825,6 @@ void CDLTFileWrapper::setMaxCacheSize(const tCacheSizeB& cacheSize)
     maxSizeMbChanged( BToMB( mMaxCacheSize ) );
 }
 
-// use binary search to go from global to filtered indexes
-int CDLTFileWrapper::binarySearch(bool isFrom, const int& fromIdx, const int& toIdx, const int& targetIdx) const
-{
-    if (toIdx >= fromIdx) {
-        int mid = fromIdx + (toIdx - fromIdx) / 2;
-
-        // If the element is present at the middle
-        // itself
-        if (getMsgIdFromIndexInMainTable(mid) == targetIdx)
-            return mid;
-
-        // If element is smaller than mid, then
-        // it can only be present in left subarray
-        if (getMsgIdFromIndexInMainTable(mid) > targetIdx)
-            return binarySearch(isFrom, fromIdx, mid - 1, targetIdx);
-
-        // Else the element can only be present
-        // in right subarray
-        return binarySearch(isFrom, mid + 1, toIdx, targetIdx);
-    }
-
-    // We reach here when element is not
-    // present in array
-    // still we want to get a closest available element here
-    return (true == isFrom) ? std::min(fromIdx, toIdx) : std::max(fromIdx, toIdx);
-}
-
 tIntRangeProperty CDLTFileWrapper::normalizeSearchRange( const tIntRangeProperty& inputRange)
 {
     tIntRangeProperty result;
@@ -494,8 +855,20 @@ tIntRangeProperty CDLTFileWrapper::normalizeSearchRange( const tIntRangeProperty
         {
             result = inputRange;
             result.isFiltered = true;
-            result.fromFiltered = binarySearch( true, 0, mpFile->sizeFilter() - 1, result.from );
-            result.toFiltered = binarySearch( false, 0, mpFile->sizeFilter() - 1, result.to );
+
+            if(true == updateFilteredIndex())
+            {
+                // first filtered message, which is not less than "from", and last one, which is not greater than "to"
+                result.fromFiltered = static_cast<int>( mFilteredMsgIds.rank( static_cast<CRoaringBitmap::tValue>( std::max(0, result.from) ) ) );
+                result.toFiltered = static_cast<int>( mFilteredMsgIds.rank( static_cast<CRoaringBitmap::tValue>( std::max(0, result.to) ) + 1u ) ) - 1;
+                result.toFiltered = std::max(result.toFiltered, result.fromFiltered - 1);
+            }
+            else
+            {
+                // filtered messages are not ordered by id. Whole filtered set is analyzed
+                result.fromFiltered = 0;
+                result.toFiltered = mpFile->sizeFilter() - 1;
+            }
         }
         else
         {
@@ -506,6 +879,67 @@ tIntRangeProperty CDLTFileWrapper::normalizeSearchRange( const tIntRangeProperty
     return result;
 }
 
+bool CDLTFileWrapper::readMsgTime( const tMsgId& msgId, CTimestampIndex::tMsgTime& msgTime ) const
+{
+    bool bResult = false;
+
+    auto foundCachedItem = mCache.cache.find( msgId );
+
+    if(mCache.cache.end() != foundCachedItem && nullptr != foundCachedItem.value())
+    {
+        const auto& pMsgWrapper = foundCachedItem.value();
+        msgTime.storageTime = static_cast<CTimestampIndex::tTimeUs>(pMsgWrapper->getTime()) * 1000000 + pMsgWrapper->getMicroseconds();
+        msgTime.ecuTimestamp = static_cast<CTimestampIndex::tTimeUs>(pMsgWrapper->getTimestamp()) * 100;
+        bResult = true;
+    }
+    else if(nullptr != mpFile)
+    {
+        // only the headers are needed, thus the message is not decoded
+        QDltMsg msg;
+
+        if(true == msg.setMsg(mpFile->getMsg(msgId)))
+        {
+            msgTime.storageTime = static_cast<CTimestampIndex::tTimeUs>(msg.getTime()) * 1000000 + msg.getMicroseconds();
+            msgTime.ecuTimestamp = static_cast<CTimestampIndex::tTimeUs>(msg.getTimestamp()) * 100;
+            bResult = true;
+        }
+    }
+
+    return bResult;
+}
+
+tIntRange CDLTFileWrapper::getMainTableRangeFromTimeRange( const tTimeRange& timeRange )
+{
+    if(nullptr == mpFile)
+    {
+        return tIntRange(0, -1);
+    }
+
+    if(false == timeRange.isSet)
+    {
+        return tIntRange(0, size() - 1);
+    }
+
+    const auto msgIdRange = mTimestampIndex.findMsgIdRange( timeRange, mpFile->size(),
+                                                            [this](const tMsgId& msgId, CTimestampIndex::tMsgTime& msgTime)
+    {
+        return readMsgTime(msgId, msgTime);
+    });
+
+    if(msgIdRange.to < msgIdRange.from || false == mpFile->isFilter())
+    {
+        return msgIdRange;
+    }
+
+    tIntRangeProperty searchRange;
+    searchRange.from = msgIdRange.from;
+    searchRange.to = msgIdRange.to;
+    searchRange.isSet = true;
+    searchRange = normalizeSearchRange(searchRange);
+
+    return tIntRange(searchRange.fromFiltered, searchRange.toFiltered);
+}
+
 QString CDLTFileWrapper::getCacheStatusAsString() const
 {
     return formCacheStatusString( mCurrentCacheSize, mMaxCacheSize, mCacheLoadPercentage, mbCacheEnabled, mbIsFull );
@@ -560,13 +994,40 @@ void CDLTFileWrapper::copyFileNamesToClipboard( const tIntRange& msgsRange ) con
     }
 }
 
-CDLTFileWrapper::CSubFilesHandler::CSubFilesHandler():
+struct CDLTFileWrapper::CSubFilesHandler::tIndexingData
+{
+    struct tIndexingJob
+    {
+        QString filePath;
+        std::shared_ptr<CDLTFileItem> pFileItem;
+        bool bNewItem = false;
+        bool bIndexed = false;
+    };
+
+    std::vector<tIndexingJob> indexingJobs;
+    std::atomic<int> finishedJobsCounter{0};
+    std::atomic<qint64> lastProgressReportMs{0};
+    std::atomic<bool> bCancelled{false};
+    QElapsedTimer timer;
+};
+
+CDLTFileWrapper::CSubFilesHandler::CSubFilesHandler(QObject* pCallbackContext):
 mbSubFilesInitialized(false),
 mSubFilesMap(),
-mpFile(nullptr)
+mpFile(nullptr),
+mpCallbackContext(pCallbackContext),
+mpIndexingData(nullptr),
+mbUpdatePending(false),
+mIndexingThreadPool()
 {
 }
 
+CDLTFileWrapper::CSubFilesHandler::~CSubFilesHandler()
+{
+    // not yet started jobs are skipped. Destructor of the thread pool waits for the running ones
+    clearSubFiles();
+}
+
 void CDLTFileWrapper::CSubFilesHandler::setFile( QDltFile* pFile )
 {
     mpFile = pFile;
@@ -579,7 +1040,7 @@ void CDLTFileWrapper::CSubFilesHandler::setFile( QDltFile* pFile )
     {
         if(true == mbSubFilesInitialized)
         {
-            updateSubFiles();
+            static_cast<void>(updateSubFiles());
         }
         else
         {
@@ -593,7 +1054,7 @@ void CDLTFileWrapper::CSubFilesHandler::setSubFilesHandlingStatus(const bool& va
     if(false == mbSubFilesInitialized && true == value)
     {
         mbSubFilesInitialized = true;
-        updateSubFiles();
+        static_cast<void>(updateSubFiles());
     }
     else if(true == mbSubFilesInitialized && false == value)
     {
@@ -608,20 +1069,25 @@ tIntRangeList CDLTFileWrapper::CSubFilesHandler::getSubFilesSizeRanges() const
 
     if(true == mbSubFilesInitialized)
     {
-        const_cast<CSubFilesHandler*>(this)->updateSubFiles();
-
-        int processedIndexes = -1;
-
-        for(const auto& item : mSubFilesMap)
+        if(false == const_cast<CSubFilesHandler*>(this)->updateSubFiles())
+        {
+            SEND_WRN("[CSubFilesHandler] Sub-files are still being indexed. Please, retry once the indexing is finished");
+        }
+        else
         {
-            tIntRange analyzedRange;
-            analyzedRange.from = processedIndexes + 1;
-            analyzedRange.to += processedIndexes + 1 + item.second->size() - 1;
-            result.push_back(analyzedRange);
+            int processedIndexes = -1;
+
+            for(const auto& item : mSubFilesMap)
+            {
+                tIntRange analyzedRange;
+                analyzedRange.from = processedIndexes + 1;
+                analyzedRange.to += processedIndexes + 1 + item.second->size() - 1;
+                result.push_back(analyzedRange);
 
-            processedIndexes += item.second->size();
+                processedIndexes += item.second->size();
 
-            //SEND_MSG(QString("%1-%2\n").arg(analyzedRange.from).arg(analyzedRange.to));
+                //SEND_MSG(QString("%1-%2\n").arg(analyzedRange.from).arg(analyzedRange.to));
+            }
         }
     }
 
@@ -712,68 +1178,195 @@ bool CDLTFileWrapper::CSubFilesHandler::getSubFilesHandlingStatus() const
     return mbSubFilesInitialized;
 }
 
-void CDLTFileWrapper::CSubFilesHandler::updateSubFiles()
+bool CDLTFileWrapper::CSubFilesHandler::updateSubFiles()
 {
+    bool bResult = true;
+
     if(nullptr != mpFile)
     {
-        //QElapsedTimer timer;
+        if(nullptr != mpIndexingData)
+        {
+            // update is repeated once the ongoing indexing is finished
+            mbUpdatePending = true;
+            return false;
+        }
 
-        //timer.start();
+        auto pIndexingData = std::make_shared<tIndexingData>();
+        auto& indexingJobs = pIndexingData->indexingJobs;
+        bool bHasNewItems = false;
 
         auto numberOfFiles = mpFile->getNumberOfFiles();
+        indexingJobs.reserve(static_cast<std::size_t>(numberOfFiles));
 
         for(int i = 0; i < numberOfFiles; ++i)
         {
-            QString filePath = mpFile->getFileName(i);
-            auto foundSubFile = mSubFilesMap.find(filePath);
+            tIndexingData::tIndexingJob indexingJob;
+            indexingJob.filePath = mpFile->getFileName(i);
+
+            auto foundSubFile = mSubFilesMap.find(indexingJob.filePath);
 
             if(foundSubFile == mSubFilesMap.end())
             {
-                auto pNewFile = std::make_shared<CDLTFileItem>(filePath);
+                indexingJob.pFileItem = std::make_shared<CDLTFileItem>(indexingJob.filePath);
+                indexingJob.bNewItem = true;
+                bHasNewItems = true;
+            }
+            else
+            {
+                indexingJob.pFileItem = foundSubFile->second;
+            }
 
-                bool bIndexed = pNewFile->updateIndex();
+            indexingJobs.push_back(indexingJob);
+        }
 
-                if(true == bIndexed)
-                {
-                    mSubFilesMap.insert(std::make_pair(filePath, pNewFile));
-                }
-                else
+        auto processJob = [](tIndexingData::tIndexingJob& indexingJob)
+        {
+            if(true == indexingJob.bNewItem)
+            {
+                indexingJob.pFileItem->loadPersistedIndex();
+            }
+
+            indexingJob.bIndexed = indexingJob.pFileItem->updateIndex();
+
+            // index of the existing items is persisted only once, as the live files are re-indexed too often
+            if(true == indexingJob.bNewItem && true == indexingJob.bIndexed)
+            {
+                indexingJob.pFileItem->persistIndex();
+            }
+        };
+
+        if(false == bHasNewItems)
+        {
+            // only the appended part of the already indexed files is read
+            for(auto& indexingJob : indexingJobs)
+            {
+                processJob(indexingJob);
+            }
+        }
+        else
+        {
+            // new files are indexed from scratch, which takes seconds for the big traces.
+            // Each file is indexed independently, thus we can use all available cores without blocking the GUI thread
+            mpIndexingData = pIndexingData;
+            bResult = false;
+
+            mIndexingThreadPool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount(),
+                                                                       static_cast<int>(indexingJobs.size()))));
+
+            pIndexingData->timer.start();
+
+            for(std::size_t jobIdx = 0u; jobIdx < indexingJobs.size(); ++jobIdx)
+            {
+                mIndexingThreadPool.start(new CSubFileIndexingTask([this, pIndexingData, processJob, jobIdx]()
                 {
-                    QString str( QString("Was not able to index file \"%1\"").arg(filePath) );
-                    SEND_WRN(str);
-                }
+                    if(false == pIndexingData->bCancelled.load())
+                    {
+                        processJob(pIndexingData->indexingJobs[jobIdx]);
+                    }
+
+                    const int numberOfJobs = static_cast<int>(pIndexingData->indexingJobs.size());
+                    const int finishedJobs = ++pIndexingData->finishedJobsCounter;
+
+                    if(finishedJobs == numberOfJobs)
+                    {
+                        // posted event is dropped, if the context is destroyed before it is processed
+                        QTimer::singleShot(0, mpCallbackContext, [this, pIndexingData]()
+                        {
+                            finishSubFilesUpdate(pIndexingData);
+                        });
+                    }
+                    else if(false == pIndexingData->bCancelled.load())
+                    {
+                        const qint64 elapsedMs = pIndexingData->timer.elapsed();
+                        qint64 lastProgressReportMs = pIndexingData->lastProgressReportMs.load();
+
+                        // messages of the worker threads are drained by the console, while the GUI thread is free
+                        if(elapsedMs - lastProgressReportMs >= sSubFilesIndexingProgressPeriodMs &&
+                           true == pIndexingData->lastProgressReportMs.compare_exchange_strong(lastProgressReportMs, elapsedMs))
+                        {
+                            SEND_MSG(QString("[CSubFilesHandler] Indexing of sub-files: %1 of %2 files are indexed ( %3 ms )")
+                                     .arg(finishedJobs)
+                                     .arg(numberOfJobs)
+                                     .arg(elapsedMs));
+                        }
+                    }
+                }));
+            }
+        }
+    }
+
+    return bResult;
+}
+
+void CDLTFileWrapper::CSubFilesHandler::finishSubFilesUpdate(const tIndexingDataPtr& pIndexingData)
+{
+    if(pIndexingData != mpIndexingData)
+    {
+        // sub-files were cleared after the indexing was started
+        return;
+    }
+
+    mpIndexingData.reset();
+
+    if(pIndexingData->timer.elapsed() >= sSubFilesIndexingProgressPeriodMs)
+    {
+        SEND_MSG(QString("[CSubFilesHandler] Indexing of sub-files is finished: %1 files ( %2 ms )")
+                 .arg(pIndexingData->indexingJobs.size())
+                 .arg(pIndexingData->timer.elapsed()));
+    }
+
+    for(const auto& indexingJob : pIndexingData->indexingJobs)
+    {
+        if(true == indexingJob.bNewItem)
+        {
+            if(true == indexingJob.bIndexed)
+            {
+                mSubFilesMap.insert(std::make_pair(indexingJob.filePath, indexingJob.pFileItem));
             }
             else
             {
-                foundSubFile->second->updateIndex();
+                QString str( QString("Was not able to index file \"%1\"").arg(indexingJob.filePath) );
+                SEND_WRN(str);
             }
         }
+    }
 
-        //auto elapsed = timer.elapsed();
-        //SEND_MSG(QString("Update file data took %1 ms").arg(elapsed));
+    if(true == mbUpdatePending)
+    {
+        mbUpdatePending = false;
+
+        if(true == mbSubFilesInitialized)
+        {
+            static_cast<void>(updateSubFiles());
+        }
     }
 }
 
 void CDLTFileWrapper::CSubFilesHandler::clearSubFiles()
 {
     mSubFilesMap.clear();
+
+    if(nullptr != mpIndexingData)
+    {
+        mpIndexingData->bCancelled = true;
+        mpIndexingData.reset();
+    }
+
+    mbUpdatePending = false;
 }
 
 CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::CDLTFileItem(const QString& path):
-mPath(path)
+mPath(path),
+mInfile(),
+mIndexAll(),
+mIndexedFileSize(0),
+mPersistedIndexSize(0)
 {}
 
 bool CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::updateIndex()
 {
     bool bResult = false;
 
-    QByteArray buf;
-    qint64 pos = 0;
-    quint16 last_message_length = 0;
-    quint8 version=1;
-    qint64 lengthOffset=2;
-    qint64 storageLength=0;
-
     /* open file */
     if(false == mInfile.isOpen())
     {
@@ -785,202 +1378,55 @@ bool CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::updateIndex()
         }
         else
         {
-            /* start at last found position */
-            if(mIndexAll.size())
-            {
-                /* move behind last found position */
-                const QVector<qint64>* const_indexAll = &(mIndexAll);
-                pos = (*const_indexAll)[mIndexAll.size()-1];
-
-                // first move to beginnng of last found message
-                mInfile.seek(pos);
+            const qint64 fileSize = mInfile.size();
+            qint64 startPos = 0;
 
-                // read and get file storage length
-                buf = mInfile.read(14);
-                if(((unsigned char)buf.at(3))==2)
-                {
-                    storageLength = 14 + ((unsigned char)buf.at(13));
-                }
-                else
-                {
-                    storageLength = 16;
-                }
+            if(false == mIndexAll.isEmpty())
+            {
+                /* start at last found position. The last message is re-validated, as it might have been the last one in the file */
+                startPos = mIndexAll.back();
+                mIndexAll.pop_back();
 
-                // read and  get last message length
-                mInfile.seek(pos + storageLength);
-                buf = mInfile.read(7);
-                version = (((unsigned char)buf.at(0))&0xe0)>>5;
-                if(version==2)
+                if(startPos >= fileSize)
                 {
-                    lengthOffset = 5;
+                    // file was truncated
+                    mIndexAll.clear();
+                    startPos = 0;
                 }
-                else
-                {
-                    lengthOffset = 2;  // default
-                }
-                last_message_length = (unsigned char)buf.at(lengthOffset); // was 0
-                last_message_length = (last_message_length<<8 | ((unsigned char)buf.at(lengthOffset+1))) + storageLength; // was 1
-
-                // move just behind the next expected message
-                pos += (last_message_length - 1);
-                mInfile.seek(pos);
             }
-            else {
-                /* the file was empty the last call */
-                mInfile.seek(0);
-            }
-
-            /* Align kbytes, 1MB read at a time */
-            static const int READ_BUF_SZ = 1024 * 1024;
 
-            /* walk through the whole file and find all DLT0x01 markers */
-            /* store the found positions in the indexAll */
-            char lastFound = 0;
-            qint64 current_message_pos = 0;
-            qint64 next_message_pos = 0;
-            int counter_header = 0;
-            quint16 message_length = 0;
-            qint64 file_size = mInfile.size();
+            if(mPersistedIndexSize > mIndexAll.size())
+            {
+                mPersistedIndexSize = mIndexAll.size();
+            }
 
-            while(true)
+            if(fileSize > startPos)
             {
+                qint64 regionSize = fileSize - startPos;
 
-                /* read buffer from file */
-                buf = mInfile.read(READ_BUF_SZ);
-                if(buf.isEmpty())
-                    break; // EOF
+                // mapping avoids copying of the whole file through the 1 MB read buffers
+                const uchar* pData = mInfile.map(startPos, regionSize);
+                const bool bMapped = nullptr != pData;
+                QByteArray fallbackBuffer;
 
-                /* Use primitive buffer for faster access */
-                int cbuf_sz = buf.size();
-                const char *cbuf = buf.constData();
+                if(false == bMapped)
+                {
+                    mInfile.seek(startPos);
+                    fallbackBuffer = mInfile.read(regionSize);
+                    pData = reinterpret_cast<const uchar*>(fallbackBuffer.constData());
+                    regionSize = fallbackBuffer.size();
+                }
 
-                /* find marker in buffer */
-                for(int num=0;num<cbuf_sz;num++) {
-                    // search length of DLT message
-                    if(counter_header>0)
-                    {
-                        counter_header++;
-                        if(storageLength==13 && counter_header==13)
-                        {
-                            storageLength += ((unsigned char)cbuf[num]) + 1;
-                        }
-                        else if (counter_header==storageLength)
-                        {
-                            // Read DLT protocol version
-                            version = (((unsigned char)cbuf[num])&0xe0)>>5;
-                            if(version==1)
-                            {
-                                lengthOffset = 2;
-                            }
-                            else if(version==2)
-                            {
-                                lengthOffset = 5;
-                            }
-                            else
-                            {
-                                lengthOffset = 2;  // default
-                            }
-                        }
-                        else if (counter_header==(storageLength+lengthOffset)) // was 16
-                        {
-                            // Read low byte of message length
-                            message_length = (unsigned char)cbuf[num];
-                        }
-                        else if (counter_header==(storageLength+1+lengthOffset)) // was 17
-                        {
-                            // Read high byte of message length
-                            counter_header = 0;
-                            message_length = (message_length<<8 | ((unsigned char)cbuf[num])) + storageLength;
-                            next_message_pos = current_message_pos + message_length;
-                            if(next_message_pos==file_size)
-                            {
-                                // last message found in file
-                                mIndexAll.append(current_message_pos);
-                                break;
-                            }
-                            // speed up move directly to next message, if inside current buffer
-                            if((message_length > storageLength+2+lengthOffset)) // was 20
-                            {
-                                if((num+message_length-(storageLength+2+lengthOffset)<cbuf_sz))  // was 20
-                                {
-                                    num+=message_length-(storageLength+2+lengthOffset);  // was 20
-                                }
-                            }
-                        }
-                    }
-                    else if(cbuf[num] == 'D')
-                    {
-                        lastFound = 'D';
-                    }
-                    else if(lastFound == 'D' && cbuf[num] == 'L')
-                    {
-                        lastFound = 'L';
-                    }
-                    else if(lastFound == 'L' && cbuf[num] == 'T')
-                    {
-                        lastFound = 'T';
-                    }
-                    else if(lastFound == 'T' && (cbuf[num] == 0x01 || cbuf[num] == 0x02))
-                    {
-                        if(next_message_pos == 0)
-                        {
-                            // first message detected or first message after error
-                            current_message_pos = pos+num-3;
-                            counter_header = 3;
-                            if(cbuf[num] == 0x01)
-                                storageLength = 16;
-                            else
-                                storageLength = 13;
-                            // speed up move directly to message length, if inside current buffer
-                            if(num+9<cbuf_sz)
-                            {
-                                num+=9;
-                                counter_header+=9;
-                            }
-                        }
-                        else if( next_message_pos == (pos+num-3) )
-                        {
-                            // Add message only when it is in the correct position in relationship to the last message
-                            mIndexAll.append(current_message_pos);
-                            current_message_pos = pos+num-3;
-                            counter_header = 3;
-                            if(cbuf[num] == 0x01)
-                                storageLength = 16;
-                            else
-                                storageLength = 13;
-                            // speed up move directly to message length, if inside current buffer
-                            if(num+9<cbuf_sz)
-                            {
-                                num+=9;
-                                counter_header+=9;
-                            }
-                        }
-                        else if(next_message_pos > (pos+num-3))
-                        {
-                            // Header detected before end of message
-                        }
-                        else
-                        {
-                            // Header detected after end of message
-                            // start search for new message back after last header found
-                            mInfile.seek(current_message_pos+4);
-                            pos = current_message_pos+4;
-                            buf = mInfile.read(READ_BUF_SZ);
-                            cbuf_sz = buf.size();
-                            cbuf = buf.constData();
-                            num=0;
-                            next_message_pos = 0;
-                        }
-                        lastFound = 0;
-                    }
-                    else
-                    {
-                        lastFound = 0;
-                    }
+                indexRegion(pData, regionSize, startPos, mIndexAll);
+
+                if(true == bMapped)
+                {
+                    mInfile.unmap(const_cast<uchar*>(pData));
                 }
-                pos += cbuf_sz;
             }
 
+            mIndexedFileSize = fileSize;
+
             mInfile.close();
             bResult = true;
         }
@@ -995,11 +1441,136 @@ int CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::size()
     return mIndexAll.size();
 }
 
+bool CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::loadPersistedIndex()
+{
+    QFile indexFile(mPath + sSubFileIndexSuffix);
+
+    if(false == indexFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&indexFile);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0u;
+    quint32 version = 0u;
+    qint64 indexedFileSize = 0;
+    qint64 fileModificationTime = 0;
+    QByteArray indexedBlocksHash;
+    QVector<qint64> index;
+
+    stream >> magic >> version;
+
+    if(QDataStream::Ok != stream.status() ||
+       sSubFileIndexMagic != magic ||
+       sSubFileIndexVersion != version)
+    {
+        return false;
+    }
+
+    stream >> indexedFileSize >> fileModificationTime >> indexedBlocksHash >> index;
+
+    if(QDataStream::Ok != stream.status() ||
+       true == index.isEmpty())
+    {
+        return false;
+    }
+
+    QFile file(mPath);
+
+    if(false == file.open(QIODevice::ReadOnly) ||
+       file.size() < indexedFileSize ||
+       index.back() >= indexedFileSize)
+    {
+        return false;
+    }
+
+    // rotated or overwritten file with the same name has either another modification time or another content
+    if(getFileModificationTime(mPath) != fileModificationTime ||
+       true == indexedBlocksHash.isEmpty() ||
+       getIndexedBlocksHash(file, index.front(), indexedFileSize) != indexedBlocksHash)
+    {
+        SEND_WRN(QString("[CSubFilesHandler] Persisted index of the file \"%1\" does not match the file. File will be re-indexed.").arg(mPath));
+        return false;
+    }
+
+    auto checkMarker = [&file](const qint64& pos)
+    {
+        QByteArray marker;
+        const bool bSeek = file.seek(pos);
+
+        if(true == bSeek)
+        {
+            marker = file.read(sStorageHeaderMarkerSize);
+        }
+
+        return true == bSeek &&
+               isStorageHeaderMarker(reinterpret_cast<const uchar*>(marker.constData()), 0, marker.size());
+    };
+
+    if(false == checkMarker(index.front()) || false == checkMarker(index.back()))
+    {
+        SEND_WRN(QString("[CSubFilesHandler] Persisted index of the file \"%1\" is outdated. File will be re-indexed.").arg(mPath));
+        return false;
+    }
+
+    mIndexAll.swap(index);
+    mIndexedFileSize = indexedFileSize;
+    mPersistedIndexSize = mIndexAll.size();
+
+    return true;
+}
+
+void CDLTFileWrapper::CSubFilesHandler::CDLTFileItem::persistIndex()
+{
+    if(mPersistedIndexSize == mIndexAll.size() || true == mIndexAll.isEmpty())
+    {
+        return;
+    }
+
+    QFile file(mPath);
+    QByteArray indexedBlocksHash;
+
+    if(true == file.open(QIODevice::ReadOnly))
+    {
+        indexedBlocksHash = getIndexedBlocksHash(file, mIndexAll.front(), mIndexedFileSize);
+    }
+
+    if(true == indexedBlocksHash.isEmpty())
+    {
+        return;
+    }
+
+    QSaveFile indexFile(mPath + sSubFileIndexSuffix);
+
+    // the directory might be read-only. That is not an error, the file would be simply re-indexed next time.
+    if(true == indexFile.open(QIODevice::WriteOnly))
+    {
+        QDataStream stream(&indexFile);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        stream << sSubFileIndexMagic
+               << sSubFileIndexVersion
+               << mIndexedFileSize
+               << getFileModificationTime(mPath)
+               << indexedBlocksHash
+               << mIndexAll;
+
+        if(true == indexFile.commit())
+        {
+            mPersistedIndexSize = mIndexAll.size();
+        }
+    }
+}
+
 PUML_PACKAGE_BEGIN(DMA_LogsWrapper)
     PUML_CLASS_BEGIN_CHECKED(CDLTFileWrapper)
         PUML_INHERITANCE_CHECKED(IFileWrapper, implements)
         PUML_AGGREGATION_DEPENDENCY_CHECKED(QDltFile, 1, 1, uses)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(IMsgWrapper, 1, *, cache)
         PUML_USE_DEPENDENCY_CHECKED(CDLTMsgWrapper, 1, *, creates)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CRoaringBitmap, 1, 1, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CTimestampIndex, 1, 1, contains)
     PUML_CLASS_END()
 PUML_PACKAGE_END()
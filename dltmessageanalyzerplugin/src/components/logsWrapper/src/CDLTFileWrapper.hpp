@@ -12,10 +12,13 @@
 #include "QMap"
 #include "QObject"
 #include "QFile"
+#include "QThreadPool"
 
 #include "qdlt.h"
 
 #include "common/Definitions.hpp"
+#include "common/CRoaringBitmap.hpp"
+#include "CTimestampIndex.hpp"
 #include "../api/IFileWrapper.hpp"
 
 class QDltFile;
@@ -48,12 +51,15 @@ public:
     QString getFileName(int num = 0) override;
     bool isFiltered() const override;
     int getMsgIdFromIndexInMainTable(int msgIdxInMainTable) const override;
+    void getMsgIdsFromIndexesInMainTable(const int& fromIdx, const int& numberOfMessages, std::vector<tMsgId>& msgIds) override;
+    void invalidateFilteredIndex() override;
 
     //////////////////////// CACHING_FUNCTIONALITY ////////////////////////
 
     void setEnableCache(bool isEnabled) override;
     void setMaxCacheSize(const tCacheSizeB& cacheSize) override;
     bool cacheMsgWrapper( const int& msgId, const tMsgWrapperPtr& pMsgWrapper ) override;
+    int cacheMsgWrappers( const tMsgWrapperBlock& msgWrappers ) override;
     bool cacheMsgByIndex( const tMsgId& msgId ) override;
     bool cacheMsgByIndexes( const QSet<tMsgId> msgIdSet ) override;
     bool cacheMsgByRange( const tIntRange& msgRange ) override;
@@ -62,6 +68,7 @@ public:
     ////////////////////////////////////////////////////////////////////////
 
     tIntRangeProperty normalizeSearchRange( const tIntRangeProperty& inputRange) override;
+    tIntRange getMainTableRangeFromTimeRange( const tTimeRange& timeRange ) override;
     QString getCacheStatusAsString() const override;
 
     //////////////// SUB_FILES SECTION ////////////////
@@ -76,8 +83,21 @@ private:
     bool cacheDecodedMsg( const int& msgId, const QDltMsg& msg );
     bool decodeAndCacheMsg( const int& msgId, QDltMsg& msg ); // will decode incoming msg
     void incrementCacheSize( const unsigned int& bytes );
+    void addToTimestampIndex( const int& msgId, const tMsgWrapperPtr& pMsgWrapper );
     void handleCacheFull(bool isFull);
-    int binarySearch(bool isFrom, const int& fromIdx, const int& toIdx, const int& targetIdx) const;
+
+    /**
+     * @brief updateFilteredIndex - synchronizes the bitmap index with the filter of the file.
+     * Messages, which were added to the filtered set since the last call, are appended.
+     * Index is rebuilt from scratch after the invalidateFilteredIndex call.
+     * @return - true, if file is filtered and index is up to date. False otherwise.
+     */
+    bool updateFilteredIndex();
+
+    /**
+     * @brief readMsgTime - reads the time of the message from the cache or from the headers of the message in the file
+     */
+    bool readMsgTime( const tMsgId& msgId, CTimestampIndex::tMsgTime& msgTime ) const;
 
 private:
     QDltFile* mpFile;
@@ -97,12 +117,23 @@ private:
     bool mbIsFull;
     unsigned int mCacheLoadPercentage;
 
+    // non-filtered id-s of the filtered messages. Rank of the id is its index in the main table
+    CRoaringBitmap mFilteredMsgIds;
+
+    // maps the time to the non-filtered id-s of the messages
+    CTimestampIndex mTimestampIndex;
+
     ///////////////////////////////////////////////////////
 
     class CSubFilesHandler
     {
         public:
-            CSubFilesHandler();
+            /**
+             * @brief CSubFilesHandler - constructor
+             * @param pCallbackContext - object, in the thread of which the results of the indexing are applied
+             */
+            CSubFilesHandler(QObject* pCallbackContext);
+            ~CSubFilesHandler();
             void setFile( QDltFile* pFile );
             void setSubFilesHandlingStatus(const bool& value);
             bool getSubFilesHandlingStatus() const;
@@ -111,7 +142,23 @@ private:
             void copyFileNamesToClipboard( const tIntRange& msgsRange ) const;
 
         private:
-            void updateSubFiles();
+            struct tIndexingData;
+            typedef std::shared_ptr<tIndexingData> tIndexingDataPtr;
+
+            /**
+             * @brief updateSubFiles - updates the index of the sub-files.
+             * Already known sub-files are updated synchronously, as only the appended part of them is read.
+             * If there are new sub-files, all of them are indexed on the thread pool and the result is applied
+             * in the finishSubFilesUpdate call.
+             * @return - true, if the index is up to date. False, if indexing is scheduled or is still in progress.
+             */
+            bool updateSubFiles();
+
+            /**
+             * @brief finishSubFilesUpdate - applies the result of the asynchronous indexing.
+             * Result is dropped, if sub-files were cleared after the indexing was started.
+             */
+            void finishSubFilesUpdate(const tIndexingDataPtr& pIndexingData);
             void clearSubFiles();
 
         private:
@@ -124,6 +171,19 @@ private:
                     bool updateIndex();
                     int size();
 
+                    /**
+                     * @brief loadPersistedIndex - loads the offsets index, which was persisted next to the file.
+                     * Loaded index is used as a starting point of the further incremental indexing.
+                     * @return - true, if index was loaded and is still valid for the file. False otherwise.
+                     */
+                    bool loadPersistedIndex();
+
+                    /**
+                     * @brief persistIndex - stores the offsets index next to the file, if it has changed
+                     * since the last load or store operation.
+                     */
+                    void persistIndex();
+
                 private:
                     // file path
                     QString mPath;
@@ -133,11 +193,27 @@ private:
 
                     // index
                     QVector<qint64> mIndexAll;
+
+                    // size of the file at the moment of the last indexing
+                    qint64 mIndexedFileSize;
+
+                    // number of index entries, which are already persisted
+                    int mPersistedIndexSize;
             };
 
             typedef std::map<QString, std::shared_ptr<CDLTFileItem> > tSubFilesMap;
             tSubFilesMap mSubFilesMap;
             QDltFile* mpFile;
+            QObject* mpCallbackContext;
+
+            // data of the ongoing indexing. Nullptr, if there is no indexing in progress
+            tIndexingDataPtr mpIndexingData;
+
+            // whether update was requested during the ongoing indexing
+            bool mbUpdatePending;
+
+            // declared last, so that the running indexing tasks are finished before the rest of the members are destroyed
+            QThreadPool mIndexingThreadPool;
     };
 
     typedef std::shared_ptr<CSubFilesHandler> tSubFilesHandlerPtr;
@@ -146,6 +146,11 @@ QString CDLTMsgWrapper::getTimeString() const
     return QString(strtime);
 }
 
+const time_t& CDLTMsgWrapper::getTime() const
+{
+    return mTime;
+}
+
 const unsigned int& CDLTMsgWrapper::getMicroseconds() const
 {
     return mMicroseconds;
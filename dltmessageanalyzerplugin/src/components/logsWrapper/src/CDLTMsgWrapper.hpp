@@ -25,6 +25,7 @@ public:
     ~CDLTMsgWrapper();
 
     QString getTimeString() const override;
+    const time_t& getTime() const override;
     const unsigned int& getMicroseconds() const override;
     const unsigned int& getTimestamp() const override;
     const unsigned char& getMessageCounter() const override;
@@ -0,0 +1,371 @@
+/**
+ * @file    CTimestampIndex.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CTimestampIndex class
+ */
+
+#include <algorithm>
+
+#include "CTimestampIndex.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+// 1024 messages per block keep the index below 0.1 byte per message
+static const int sBlockSize = 1024;
+
+static bool isInTimeRange( const CTimestampIndex::tMsgTime& msgTime, const tTimeRange& timeRange )
+{
+    const auto& time = CTimestampIndex::getTime(msgTime, timeRange.timeSource);
+    return time >= timeRange.from && time <= timeRange.to;
+}
+
+//tBlock
+void CTimestampIndex::tBlock::add( const tMsgId& msgId, const tMsgTime& msgTime )
+{
+    if(0 == numberOfMessages)
+    {
+        minTime = msgTime;
+        maxTime = msgTime;
+    }
+    else
+    {
+        minTime.storageTime = std::min(minTime.storageTime, msgTime.storageTime);
+        minTime.ecuTimestamp = std::min(minTime.ecuTimestamp, msgTime.ecuTimestamp);
+        maxTime.storageTime = std::max(maxTime.storageTime, msgTime.storageTime);
+        maxTime.ecuTimestamp = std::max(maxTime.ecuTimestamp, msgTime.ecuTimestamp);
+    }
+
+    ++numberOfMessages;
+    lastMsgId = msgId;
+}
+
+bool CTimestampIndex::tBlock::intersects( const tTimeRange& timeRange ) const
+{
+    return 0 != numberOfMessages &&
+           getTime(minTime, timeRange.timeSource) <= timeRange.to &&
+           getTime(maxTime, timeRange.timeSource) >= timeRange.from;
+}
+
+//CTimestampIndex
+CTimestampIndex::CTimestampIndex():
+    mBlocks(),
+    mLastAddedMsgId(INVALID_MSG_ID),
+    mLastAddedMsgTime(),
+    mNonMonotonicTimeSources()
+{
+}
+
+bool& CTimestampIndex::isNonMonotonic( const eTimeSource& timeSource )
+{
+    return mNonMonotonicTimeSources[eTimeSource::eECUTimestamp == timeSource ? 1u : 0u];
+}
+
+const CTimestampIndex::tTimeUs& CTimestampIndex::getTime( const tMsgTime& msgTime, const eTimeSource& timeSource )
+{
+    return eTimeSource::eECUTimestamp == timeSource ? msgTime.ecuTimestamp : msgTime.storageTime;
+}
+
+void CTimestampIndex::addMessage( const tMsgId& msgId, const tMsgTime& msgTime )
+{
+    if(msgId < 0)
+    {
+        return;
+    }
+
+    const std::size_t blockIdx = static_cast<std::size_t>(msgId / sBlockSize);
+
+    if(blockIdx >= mBlocks.size())
+    {
+        mBlocks.resize(blockIdx + 1);
+    }
+
+    auto& block = mBlocks[blockIdx];
+
+    // messages are decoded in the ascending order. Everything else is already covered by the block
+    if(msgId > block.lastMsgId)
+    {
+        block.add(msgId, msgTime);
+    }
+
+    if(INVALID_MSG_ID != mLastAddedMsgId && msgId == mLastAddedMsgId + 1)
+    {
+        if(msgTime.storageTime < mLastAddedMsgTime.storageTime)
+        {
+            isNonMonotonic(eTimeSource::eStorageTime) = true;
+        }
+
+        if(msgTime.ecuTimestamp < mLastAddedMsgTime.ecuTimestamp)
+        {
+            isNonMonotonic(eTimeSource::eECUTimestamp) = true;
+        }
+    }
+
+    mLastAddedMsgId = msgId;
+    mLastAddedMsgTime = msgTime;
+}
+
+void CTimestampIndex::clear()
+{
+    mBlocks.clear();
+    mLastAddedMsgId = INVALID_MSG_ID;
+    mLastAddedMsgTime = tMsgTime();
+    mNonMonotonicTimeSources.fill(false);
+}
+
+bool CTimestampIndex::findBlocksRangeMonotonic( const tTimeRange& timeRange,
+                                                const int& numberOfMessages,
+                                                const tReadMsgTimeFunc& readMsgTimeFunc,
+                                                int& firstBlockIdx,
+                                                int& lastBlockIdx )
+{
+    struct tProbe
+    {
+        int blockIdx = 0;
+        tTimeUs minTime = 0;
+        tTimeUs maxTime = 0;
+    };
+
+    std::vector<tProbe> probes;
+
+    auto probeBlock = [this, &timeRange, &numberOfMessages, &readMsgTimeFunc, &probes](const int& blockIdx, tProbe& probe)
+    {
+        const int blockBegin = blockIdx * sBlockSize;
+        const int blockEnd = std::min(numberOfMessages, blockBegin + sBlockSize);
+        const auto& block = mBlocks[static_cast<std::size_t>(blockIdx)];
+
+        probe.blockIdx = blockIdx;
+
+        if(block.numberOfMessages >= blockEnd - blockBegin)
+        {
+            probe.minTime = getTime(block.minTime, timeRange.timeSource);
+            probe.maxTime = getTime(block.maxTime, timeRange.timeSource);
+        }
+        else
+        {
+            // for the monotonic timestamps the first and the last messages are the borders of the block
+            tMsgTime firstMsgTime;
+            tMsgTime lastMsgTime;
+
+            if(false == readMsgTimeFunc(blockBegin, firstMsgTime) || false == readMsgTimeFunc(blockEnd - 1, lastMsgTime))
+            {
+                return false;
+            }
+
+            probe.minTime = getTime(firstMsgTime, timeRange.timeSource);
+            probe.maxTime = getTime(lastMsgTime, timeRange.timeSource);
+
+            if(probe.minTime > probe.maxTime)
+            {
+                isNonMonotonic(timeRange.timeSource) = true;
+                return false;
+            }
+        }
+
+        probes.push_back(probe);
+        return true;
+    };
+
+    const int numberOfBlocks = ( numberOfMessages + sBlockSize - 1 ) / sBlockSize;
+    tProbe probe;
+
+    // first block, which ends after the start of the window
+    int lowerIdx = 0;
+    int upperIdx = numberOfBlocks;
+
+    while(lowerIdx < upperIdx)
+    {
+        const int middleIdx = lowerIdx + ( upperIdx - lowerIdx ) / 2;
+
+        if(false == probeBlock(middleIdx, probe))
+        {
+            return false;
+        }
+
+        if(probe.maxTime >= timeRange.from)
+        {
+            upperIdx = middleIdx;
+        }
+        else
+        {
+            lowerIdx = middleIdx + 1;
+        }
+    }
+
+    firstBlockIdx = lowerIdx;
+
+    // last block, which starts before the end of the window
+    lowerIdx = 0;
+    upperIdx = numberOfBlocks;
+
+    while(lowerIdx < upperIdx)
+    {
+        const int middleIdx = lowerIdx + ( upperIdx - lowerIdx ) / 2;
+
+        if(false == probeBlock(middleIdx, probe))
+        {
+            return false;
+        }
+
+        if(probe.minTime > timeRange.to)
+        {
+            upperIdx = middleIdx;
+        }
+        else
+        {
+            lowerIdx = middleIdx + 1;
+        }
+    }
+
+    lastBlockIdx = lowerIdx - 1;
+
+    // the probed blocks should not overlap each other. Otherwise, the bisection result is not reliable
+    std::sort(probes.begin(), probes.end(), [](const tProbe& lhs, const tProbe& rhs)
+    {
+        return lhs.blockIdx < rhs.blockIdx;
+    });
+
+    for(std::size_t probeIdx = 1u; probeIdx < probes.size(); ++probeIdx)
+    {
+        if(probes[probeIdx - 1u].blockIdx != probes[probeIdx].blockIdx &&
+           probes[probeIdx - 1u].maxTime > probes[probeIdx].minTime)
+        {
+            isNonMonotonic(timeRange.timeSource) = true;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CTimestampIndex::findBlocksRangeFilled( const tTimeRange& timeRange,
+                                             const int& numberOfMessages,
+                                             const tReadMsgTimeFunc& readMsgTimeFunc,
+                                             int& firstBlockIdx,
+                                             int& lastBlockIdx )
+{
+    const std::size_t numberOfBlocks = static_cast<std::size_t>( ( numberOfMessages + sBlockSize - 1 ) / sBlockSize );
+
+    firstBlockIdx = -1;
+    lastBlockIdx = -1;
+
+    for(std::size_t blockIdx = 0u; blockIdx < numberOfBlocks; ++blockIdx)
+    {
+        const int blockBegin = static_cast<int>(blockIdx) * sBlockSize;
+        const int blockEnd = std::min(numberOfMessages, blockBegin + sBlockSize);
+        auto& block = mBlocks[blockIdx];
+
+        if(block.numberOfMessages < blockEnd - blockBegin)
+        {
+            // some messages were not decoded yet. Block is rebuilt from the file
+            tBlock newBlock;
+            tMsgTime msgTime;
+
+            for(tMsgId msgId = blockBegin; msgId < blockEnd; ++msgId)
+            {
+                if(true == readMsgTimeFunc(msgId, msgTime))
+                {
+                    newBlock.add(msgId, msgTime);
+                }
+            }
+
+            block = newBlock;
+        }
+
+        if(true == block.intersects(timeRange))
+        {
+            if(firstBlockIdx < 0)
+            {
+                firstBlockIdx = static_cast<int>(blockIdx);
+            }
+
+            lastBlockIdx = static_cast<int>(blockIdx);
+        }
+    }
+
+    return firstBlockIdx >= 0;
+}
+
+tIntRange CTimestampIndex::findMsgIdRange( const tTimeRange& timeRange,
+                                           const int& numberOfMessages,
+                                           const tReadMsgTimeFunc& readMsgTimeFunc )
+{
+    tIntRange result(0, -1);
+
+    if(numberOfMessages <= 0 || timeRange.from > timeRange.to || !readMsgTimeFunc)
+    {
+        return result;
+    }
+
+    const std::size_t numberOfBlocks = static_cast<std::size_t>( ( numberOfMessages + sBlockSize - 1 ) / sBlockSize );
+
+    if(mBlocks.size() < numberOfBlocks)
+    {
+        mBlocks.resize(numberOfBlocks);
+    }
+
+    int firstBlockIdx = -1;
+    int lastBlockIdx = -1;
+    bool bFound = false;
+
+    if(false == isNonMonotonic(timeRange.timeSource) &&
+       true == findBlocksRangeMonotonic(timeRange, numberOfMessages, readMsgTimeFunc, firstBlockIdx, lastBlockIdx))
+    {
+        bFound = firstBlockIdx <= lastBlockIdx;
+    }
+    else
+    {
+        // bisection is not valid for the non-monotonic timestamps
+        bFound = findBlocksRangeFilled(timeRange, numberOfMessages, readMsgTimeFunc, firstBlockIdx, lastBlockIdx);
+    }
+
+    if(false == bFound)
+    {
+        return result;
+    }
+
+    // blocks are coarse, thus exact borders are found by reading the messages
+    const int rangeBegin = firstBlockIdx * sBlockSize;
+    const int rangeEnd = std::min(numberOfMessages, ( lastBlockIdx + 1 ) * sBlockSize);
+    tMsgTime msgTime;
+
+    int from = rangeBegin;
+
+    for(; from < rangeEnd; ++from)
+    {
+        if(true == readMsgTimeFunc(from, msgTime) && true == isInTimeRange(msgTime, timeRange))
+        {
+            break;
+        }
+    }
+
+    if(from == rangeEnd)
+    {
+        // blocks cover the window, but none of their messages is within it
+        return result;
+    }
+
+    int to = rangeEnd - 1;
+
+    for(; to > from; --to)
+    {
+        if(true == readMsgTimeFunc(to, msgTime) && true == isInTimeRange(msgTime, timeRange))
+        {
+            break;
+        }
+    }
+
+    result.from = from;
+    result.to = to;
+
+    return result;
+}
+
+std::size_t CTimestampIndex::getMemoryUsage() const
+{
+    return sizeof(CTimestampIndex) + mBlocks.capacity() * sizeof(tBlock);
+}
+
+PUML_PACKAGE_BEGIN(DMA_LogsWrapper)
+    PUML_CLASS_BEGIN_CHECKED(CTimestampIndex)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
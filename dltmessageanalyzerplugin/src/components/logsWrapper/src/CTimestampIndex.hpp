@@ -0,0 +1,126 @@
+/**
+ * @file    CTimestampIndex.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CTimestampIndex class
+ */
+#pragma once
+
+#include "array"
+#include "functional"
+#include "vector"
+
+#include "common/Definitions.hpp"
+
+/**
+ * @brief The CTimestampIndex class - sparse index, which maps the time to the id-s of the messages.
+ * Messages are grouped into the blocks of consecutive id-s. Each block keeps only the min and max values
+ * of the storage time and of the ECU timestamp of its messages. Thus, non-monotonic timestamps
+ * ( several ECU-s in one trace, restart of the ECU, etc. ) do not break the search - such block
+ * simply covers a wider time range.
+ * Blocks are filled with the messages, which pass through the file wrapper during the decoding.
+ * While the timestamps are monotonic, the time window is found by the bisection over the blocks,
+ * which reads only the headers of the first and of the last messages of the probed incomplete blocks.
+ * Once the timestamps are found to be non-monotonic, all incomplete blocks are filled on demand,
+ * by reading the headers of their messages.
+ */
+class CTimestampIndex
+{
+public:
+
+    typedef int64_t tTimeUs;
+
+    struct tMsgTime
+    {
+        tTimeUs storageTime = 0;
+        tTimeUs ecuTimestamp = 0;
+    };
+
+    /**
+     * @brief tReadMsgTimeFunc - reads the time of the message by its non-filtered id.
+     * Returns false, if the message was not found.
+     */
+    typedef std::function<bool(const tMsgId&, tMsgTime&)> tReadMsgTimeFunc;
+
+    CTimestampIndex();
+
+    /**
+     * @brief addMessage - adds the message to the index.
+     * Messages, which are already covered by their block, are ignored.
+     * @param msgId - non-filtered id of the message
+     * @param msgTime - time of the message
+     */
+    void addMessage( const tMsgId& msgId, const tMsgTime& msgTime );
+
+    void clear();
+
+    /**
+     * @brief findMsgIdRange - finds the range of messages, which corresponds to the time window.
+     * The range starts with the first message within the window and ends with the last one.
+     * Messages between them are not checked, thus in case of non-monotonic timestamps
+     * the range can contain messages from outside of the window.
+     * @param timeRange - time window
+     * @param numberOfMessages - overall non-filtered number of messages in the file
+     * @param readMsgTimeFunc - used to probe or to fill the incomplete blocks and to find the exact borders of the range
+     * @return - range of the non-filtered id-s [from, to]. If no message fits the window, "to" is less than "from"
+     */
+    tIntRange findMsgIdRange( const tTimeRange& timeRange,
+                              const int& numberOfMessages,
+                              const tReadMsgTimeFunc& readMsgTimeFunc );
+
+    /**
+     * @brief getMemoryUsage - gets the approximate number of the used bytes
+     */
+    std::size_t getMemoryUsage() const;
+
+    /**
+     * @brief getTime - gets the time of the message, which corresponds to the provided time source
+     */
+    static const tTimeUs& getTime( const tMsgTime& msgTime, const eTimeSource& timeSource );
+
+private:
+
+    struct tBlock
+    {
+        int numberOfMessages = 0;
+        tMsgId lastMsgId = INVALID_MSG_ID;
+        tMsgTime minTime;
+        tMsgTime maxTime;
+
+        void add( const tMsgId& msgId, const tMsgTime& msgTime );
+        bool intersects( const tTimeRange& timeRange ) const;
+    };
+
+    /**
+     * @brief findBlocksRangeMonotonic - finds the first and the last blocks, which intersect the time window,
+     * by the bisection over the blocks. Valid only for the monotonic timestamps.
+     * @return - false, if the timestamps were found to be non-monotonic during the search. True otherwise.
+     * If no block intersects the window, lastBlockIdx is less than firstBlockIdx.
+     */
+    bool findBlocksRangeMonotonic( const tTimeRange& timeRange,
+                                   const int& numberOfMessages,
+                                   const tReadMsgTimeFunc& readMsgTimeFunc,
+                                   int& firstBlockIdx,
+                                   int& lastBlockIdx );
+
+    /**
+     * @brief findBlocksRangeFilled - finds the first and the last blocks, which intersect the time window,
+     * filling all incomplete blocks by reading the headers of their messages.
+     * @return - true, if some block intersects the window. False otherwise.
+     */
+    bool findBlocksRangeFilled( const tTimeRange& timeRange,
+                                const int& numberOfMessages,
+                                const tReadMsgTimeFunc& readMsgTimeFunc,
+                                int& firstBlockIdx,
+                                int& lastBlockIdx );
+
+    bool& isNonMonotonic( const eTimeSource& timeSource );
+
+    std::vector<tBlock> mBlocks;
+
+    // last message, which was added to the index
+    tMsgId mLastAddedMsgId;
+    tMsgTime mLastAddedMsgTime;
+
+    // whether timestamps of the time source were found to decrease somewhere in the file
+    std::array<bool, static_cast<std::size_t>(eTimeSource::eLast)> mNonMonotonicTimeSources;
+};
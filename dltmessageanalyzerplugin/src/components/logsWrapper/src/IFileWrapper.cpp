@@ -62,14 +62,18 @@ PUML_PACKAGE_BEGIN(DMA_LogsWrapper_API)
         PUML_PURE_VIRTUAL_METHOD(+, QString getFileName(int num = 0) )
         PUML_PURE_VIRTUAL_METHOD(+, bool isFiltered() const )
         PUML_PURE_VIRTUAL_METHOD(+, int getMsgIdFromIndexInMainTable(int msgIdxInMainTable) const )
+        PUML_PURE_VIRTUAL_METHOD(+, void getMsgIdsFromIndexesInMainTable(const int& fromIdx, const int& numberOfMessages, std::vector<tMsgId>& msgIds) )
+        PUML_PURE_VIRTUAL_METHOD(+, void invalidateFilteredIndex() )
         PUML_PURE_VIRTUAL_METHOD(+, void setEnableCache(bool isEnabled) )
         PUML_PURE_VIRTUAL_METHOD(+, void setMaxCacheSize(const tCacheSizeB& cacheSize ) )
         PUML_PURE_VIRTUAL_METHOD(+, bool cacheMsgWrapper( const int& msgId, const tMsgWrapperPtr& pMsgWrapper ) )
+        PUML_PURE_VIRTUAL_METHOD(+, int cacheMsgWrappers( const tMsgWrapperBlock& msgWrappers ) )
         PUML_PURE_VIRTUAL_METHOD(+, bool cacheMsgByIndex( const tMsgId& msgId ) )
         PUML_PURE_VIRTUAL_METHOD(+, bool cacheMsgByIndexes( const QSet<tMsgId> msgIdSet ) )
         PUML_PURE_VIRTUAL_METHOD(+, bool cacheMsgByRange( const tIntRange& msgRange ) )
         PUML_PURE_VIRTUAL_METHOD(+, void resetCache() )
         PUML_PURE_VIRTUAL_METHOD(+, tIntRangeProperty normalizeSearchRange( const tIntRangeProperty& inputRange) )
+        PUML_PURE_VIRTUAL_METHOD(+, tIntRange getMainTableRangeFromTimeRange( const tTimeRange& timeRange ) )
         PUML_PURE_VIRTUAL_METHOD(+, QString getCacheStatusAsString() const )
         PUML_PURE_VIRTUAL_METHOD(+, void setSubFilesHandlingStatus(const bool& val) )
         PUML_PURE_VIRTUAL_METHOD(+, bool getSubFilesHandlingStatus() const )
@@ -19,6 +19,7 @@ DMA_FORCE_LINK_ANCHOR_CPP(IMsgWrapper)
 PUML_PACKAGE_BEGIN(DMA_LogsWrapper_API)
     PUML_CLASS_BEGIN(IMsgWrapper)
         PUML_PURE_VIRTUAL_METHOD(+, QString getTimeString() const )
+        PUML_PURE_VIRTUAL_METHOD(+, const time_t& getTime() const )
         PUML_PURE_VIRTUAL_METHOD(+, const unsigned int& getMicroseconds() const )
         PUML_PURE_VIRTUAL_METHOD(+, const unsigned int& getTimestamp() const )
         PUML_PURE_VIRTUAL_METHOD(+, const unsigned char& getMessageCounter() const )
@@ -57,6 +57,15 @@ public:
 
     virtual void filterPatterns( const QString& filter ) = 0;
 
+    typedef QMap<QString /*alias*/, double /*average match time per message in nanoseconds*/> tPatternsCostMap;
+
+    /**
+     * @brief setPatternsCost - sets the profiled cost of the patterns. Slow patterns are flagged in the view.
+     * Cost of the patterns, which are not mentioned in the map, is kept.
+     * @param patternsCostMap - cost of the patterns
+     */
+    virtual void setPatternsCost( const tPatternsCostMap& patternsCostMap ) = 0;
+
 signals:
     void patternsRefreshed();
 };
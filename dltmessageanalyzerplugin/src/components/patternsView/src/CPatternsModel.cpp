@@ -22,6 +22,8 @@ Q_DECLARE_METATYPE(CPatternsModel::tFilteredEntry)
 static const char* sTreeLevelSeparator = "_";
 static const char* sUsedCombinationLiteral = "%comb";
 static const char* sUsedDefaultLiteral = "%def";
+// patterns, which take more time per message, are flagged as slow
+static const double sSlowPatternThresholdNs = 10000.0;
 
 static QVector<tTreeItemPtr> sortingFunction (const QVector<tTreeItemPtr>& children,
         const int& sortingColumn,
@@ -209,7 +211,8 @@ CPatternsModel::CPatternsModel(const tSettingsManagerPtr& pSettingsManager,
     mpRootItem(nullptr),
     mSortingColumn(ePatternsColumn::AliasTreeLevel),
     mSortOrder(Qt::SortOrder::DescendingOrder),
-    mFilter()
+    mFilter(),
+    mPatternsCost()
 {
     mpRootItem = new CTreeItem(nullptr,
                                static_cast<int>(ePatternsColumn::AliasTreeLevel),
@@ -404,6 +407,38 @@ QVariant CPatternsModel::data(const QModelIndex &index, int role) const
     {
         result = QColor(0,0,0,0);
     }
+    else if ( ( role == Qt::ForegroundRole || role == Qt::ToolTipRole ) &&
+              ( index.column() == static_cast<int>(ePatternsColumn::AliasTreeLevel) ||
+                index.column() == static_cast<int>(ePatternsColumn::Alias) ) &&
+              false == mPatternsCost.isEmpty() )
+    {
+        tTreeItem *item = static_cast<tTreeItemPtr>(index.internalPointer());
+        auto foundCost = mPatternsCost.find( item->data(static_cast<int>(ePatternsColumn::Alias)).get<QString>() );
+
+        if(foundCost != mPatternsCost.end())
+        {
+            const bool bSlow = foundCost.value() >= sSlowPatternThresholdNs;
+
+            if(role == Qt::ForegroundRole)
+            {
+                if(true == bSlow)
+                {
+                    result = QColor(200,0,0);
+                }
+            }
+            else
+            {
+                QString toolTip = QString("Average match time per message - %1.").arg(formatDurationNs(foundCost.value()));
+
+                if(true == bSlow)
+                {
+                    toolTip.append(" The pattern is slow. Check the \"Cost\" column of the filters view to find its expensive groups.");
+                }
+
+                result = toolTip;
+            }
+        }
+    }
 
     return result;
 }
@@ -1471,6 +1506,16 @@ void CPatternsModel::filterPatterns( const QString& filter )
     filterPatternsInternal(true);
 }
 
+void CPatternsModel::setPatternsCost( const tPatternsCostMap& patternsCostMap )
+{
+    for(auto it = patternsCostMap.begin(); it != patternsCostMap.end(); ++it)
+    {
+        mPatternsCost.insert(it.key(), it.value());
+    }
+
+    updateView();
+}
+
 void CPatternsModel::refreshRegexPatterns()
 {
     resetData();
@@ -50,6 +50,7 @@ public:
     QString getAliasEditName( const QModelIndex& idx ) override;
     void filterPatterns( const QString& filter ) override;
     void refreshRegexPatterns() override;
+    void setPatternsCost( const tPatternsCostMap& patternsCostMap ) override;
     // Implementation of the IPatternsModel ( END )
 
     bool areAnyCombinedPatternsAvailable() const;
@@ -121,4 +122,5 @@ private:
     ePatternsColumn mSortingColumn;
     Qt::SortOrder mSortOrder;
     QString mFilter;
+    tPatternsCostMap mPatternsCost;
 };
@@ -39,6 +39,7 @@ PUML_PACKAGE_BEGIN(DMA_PatternsView_API)
         PUML_PURE_VIRTUAL_METHOD( +, QString getAliasEditName( const QModelIndex& idx ) )
         PUML_PURE_VIRTUAL_METHOD( +, void filterPatterns( const QString& filter ) )
         PUML_PURE_VIRTUAL_METHOD( +, void refreshRegexPatterns() )
+        PUML_PURE_VIRTUAL_METHOD( +, void setPatternsCost( const tPatternsCostMap& patternsCostMap ) )
         PUML_PURE_VIRTUAL_METHOD( +, signal void patternsRefreshed() )
     PUML_CLASS_END()
 PUML_PACKAGE_END()
@@ -8,14 +8,17 @@
 
 #include "memory"
 #include "functional"
+#include "cstdint"
 
 #include "QScrollArea"
 #include "QProcess"
+#include "QStringList"
 
 #include "components/settings/api/CSettingsManagerClient.hpp"
 
 class QProcess;
 class CImageViewer;
+class CPlantUMLRenderServer;
 class QPushButton;
 class QPlainTextEdit;
 
@@ -28,6 +31,21 @@ class CUMLView : public QScrollArea,
 public:
     CUMLView(QWidget *parent = nullptr);
     void generateUMLDiagram(const QString& diagramContent);
+
+    /**
+     * @brief startDiagramPages - drops the previously shown pages and switches the view to the
+     * "generation in progress" state. Pages are then provided one by one via the addDiagramPage.
+     */
+    void startDiagramPages();
+
+    /**
+     * @brief addDiagramPage - adds the next page of the diagram.
+     * The first page is shown immediately. The following ones are pre-rendered in the background,
+     * in case if the render server mode is active.
+     */
+    void addDiagramPage(const QString& diagramContent);
+    void showDiagramPage(int pageIndex);
+    int getDiagramPagesCount() const;
     bool isDiagramGenerationInProgress() const;
     void cancelDiagramGeneration();
     void clearDiagram();
@@ -63,13 +81,27 @@ private:
                                     tProcessPtr& pSubProcess,
                                     bool blocking);
 
+    /**
+     * @brief generateUMLDiagramWithRenderServer - renders PNG diagram using the long-lived plantuml process.
+     * Falls back to generateUMLDiagramInternal in case if render server fails to produce the image.
+     */
+    void generateUMLDiagramWithRenderServer(const QString& diagramContent,
+                                            const tGenerateDiagramCallback& callback);
+
+    void prerenderDiagramPage(const QString& diagramContent);
+
 private:
     bool mbDiagramShown;
     CImageViewer* mpImageViewer;
+    CPlantUMLRenderServer* mpRenderServer;
     tProcessPtr mpDiagramCreationSubProcess;
     tProcessPtr mpSaveSVGSubProcess;
     QString mDiagramContent;
+    QStringList mDiagramPages;
+    int mCurrentDiagramPage;
     bool mbDiagramGenerationInProgress;
+    // id of the latest diagram request. Callbacks of the older requests are ignored
+    uint64_t mDiagramRequestId;
     QString mLastSelectedFolder;
     QPushButton* mpUMLCreateDiagramFromTextButton;
     QPlainTextEdit* mpUMLTextEditor;
@@ -0,0 +1,332 @@
+/**
+ * @file    CPlantUMLRenderServer.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CPlantUMLRenderServer class
+ */
+
+#include "QProcess"
+#include "QCryptographicHash"
+#include "QRegularExpression"
+#include "QMetaEnum"
+
+#include "CPlantUMLRenderServer.hpp"
+#include "components/log/api/CLog.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+// the delimiter is printed by the plantuml after each rendered image.
+// It should be long enough to never appear inside of the PNG data.
+static const QByteArray sPipeDelimiter("___DMA_PLANTUML_PIPE_DELIMITER_6f1c2b7e___");
+static const int sRenderedImageCacheMaxCostKB = 64 * 1024;
+
+static int getImageCostKB(const QByteArray& imageData)
+{
+    return static_cast<int>(imageData.size() / 1024) + 1;
+}
+
+bool CPlantUMLRenderServer::tConfiguration::operator==(const tConfiguration& rhs) const
+{
+    return javaPath == rhs.javaPath &&
+           plantUMLPath == rhs.plantUMLPath &&
+           limitSizePixels == rhs.limitSizePixels;
+}
+
+bool CPlantUMLRenderServer::tConfiguration::operator!=(const tConfiguration& rhs) const
+{
+    return !(*this == rhs);
+}
+
+CPlantUMLRenderServer::CPlantUMLRenderServer(QObject* pParent):
+QObject(pParent),
+mpProcess(nullptr),
+mConfiguration(),
+mDelimiter(sPipeDelimiter),
+mOutputBuffer(),
+mNotWrittenInput(),
+mPendingRequests(),
+mRenderedImageCache(sRenderedImageCacheMaxCostKB)
+{
+}
+
+CPlantUMLRenderServer::~CPlantUMLRenderServer()
+{
+    stop();
+}
+
+bool CPlantUMLRenderServer::isPipeCompatible(const QString& diagramContent)
+{
+    static const QRegularExpression sStartRegex("^\\s*@start\\w+", QRegularExpression::MultilineOption);
+    static const QRegularExpression sEndRegex("^\\s*@end\\w+", QRegularExpression::MultilineOption);
+
+    auto countMatches = [&diagramContent](const QRegularExpression& regex)
+    {
+        int counter = 0;
+        auto it = regex.globalMatch(diagramContent);
+
+        while(it.hasNext())
+        {
+            it.next();
+            ++counter;
+        }
+
+        return counter;
+    };
+
+    return 1 == countMatches(sStartRegex) && 1 == countMatches(sEndRegex);
+}
+
+void CPlantUMLRenderServer::render(const tConfiguration& configuration,
+                                   const QString& diagramContent,
+                                   const tRenderCallback& callback)
+{
+    QByteArray diagramData = diagramContent.toUtf8();
+
+    if(false == diagramData.endsWith('\n'))
+    {
+        // plantuml renders the diagram only after the line with the "@end..." tag is terminated
+        diagramData.append('\n');
+    }
+
+    QCryptographicHash hashBuilder(QCryptographicHash::Sha1);
+    hashBuilder.addData(diagramData);
+    hashBuilder.addData(QByteArray::number(configuration.limitSizePixels));
+    const tDiagramHash hash = hashBuilder.result();
+
+    auto pCachedImage = mRenderedImageCache.object(hash);
+
+    if(nullptr != pCachedImage)
+    {
+        if(callback)
+        {
+            callback(true, *pCachedImage);
+        }
+    }
+    else if(true == ensureStarted(configuration))
+    {
+        tPendingRequest request;
+        request.hash = hash;
+        request.callback = callback;
+        mPendingRequests.push_back(request);
+
+        if(QProcess::Running == mpProcess->state())
+        {
+            mpProcess->write(diagramData);
+        }
+        else
+        {
+            // written, once the process is started
+            mNotWrittenInput.append(diagramData);
+        }
+    }
+    else
+    {
+        if(callback)
+        {
+            callback(false, QByteArray());
+        }
+    }
+}
+
+void CPlantUMLRenderServer::cancelPendingRequests()
+{
+    for(auto& request : mPendingRequests)
+    {
+        // requests are kept in the queue, as their images will still arrive in the same order
+        request.callback = tRenderCallback();
+    }
+}
+
+void CPlantUMLRenderServer::stop()
+{
+    mPendingRequests.clear();
+    mOutputBuffer.clear();
+    releaseProcess();
+}
+
+bool CPlantUMLRenderServer::isRunning() const
+{
+    return nullptr != mpProcess && QProcess::NotRunning != mpProcess->state();
+}
+
+bool CPlantUMLRenderServer::ensureStarted(const tConfiguration& configuration)
+{
+    if(true == isRunning() && configuration == mConfiguration)
+    {
+        return true;
+    }
+
+    if(nullptr != mpProcess)
+    {
+        SEND_MSG("[CPlantUMLRenderServer] Configuration has changed. Restarting plantuml process.");
+        // notify the clients, as their requests will never be served by the old process
+        failPendingRequests();
+        stop();
+    }
+
+    mConfiguration = configuration;
+    mpProcess = new QProcess(this);
+
+    QStringList arguments;
+    arguments.push_back(QString("-DPLANTUML_LIMIT_SIZE=%1").arg(configuration.limitSizePixels));
+    arguments.push_back(QString("-Djava.awt.headless=true"));
+    arguments.push_back(QString("-jar"));
+    arguments.push_back(configuration.plantUMLPath);
+    arguments.push_back(QString("-pipe"));
+    arguments.push_back(QString("-tpng"));
+    arguments.push_back(QString("-charset"));
+    arguments.push_back(QString("UTF-8"));
+    arguments.push_back(QString("-pipedelimitor"));
+    arguments.push_back(QString::fromLatin1(mDelimiter));
+
+    // NOLINTBEGIN(clang-analyzer-cplusplus.NewDeleteLeaks)
+    connect(mpProcess, &QProcess::started, this, [this]()
+    {
+        if(nullptr != mpProcess && false == mNotWrittenInput.isEmpty())
+        {
+            mpProcess->write(mNotWrittenInput);
+            mNotWrittenInput.clear();
+        }
+    });
+
+    connect(mpProcess, &QProcess::readyReadStandardOutput, this, [this]()
+    {
+        processOutput();
+    });
+
+    connect(mpProcess, &QProcess::readyReadStandardError, this, [this]()
+    {
+        if(nullptr != mpProcess)
+        {
+            const QString errorOutput = QString::fromUtf8(mpProcess->readAllStandardError()).trimmed();
+
+            if(false == errorOutput.isEmpty())
+            {
+                SEND_WRN(QString("[CPlantUMLRenderServer] %1").arg(errorOutput));
+            }
+        }
+    });
+
+    connect(mpProcess,
+            static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, [this](int exitCode, QProcess::ExitStatus)
+    {
+        SEND_WRN(QString("[CPlantUMLRenderServer] Plantuml process has exited with code %1.").arg(exitCode));
+        failPendingRequests();
+        mOutputBuffer.clear();
+        releaseProcess();
+    });
+
+    connect(mpProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error)
+    {
+        if(QProcess::FailedToStart == error || QProcess::Crashed == error)
+        {
+            QMetaEnum metaEnum = QMetaEnum::fromType<QProcess::ProcessError>();
+            SEND_ERR(QString("[CPlantUMLRenderServer] Error of the plantuml process - %1.")
+                     .arg(metaEnum.valueToKey(error)));
+            failPendingRequests();
+            mOutputBuffer.clear();
+            releaseProcess();
+        }
+    });
+    // NOLINTEND(clang-analyzer-cplusplus.NewDeleteLeaks)
+
+    // the GUI thread is not blocked till the JVM is started. Result is reported via the started or errorOccurred signals
+    mpProcess->start(configuration.javaPath, arguments);
+
+    // start can fail synchronously, in which case the process is already released by the error handler
+    return nullptr != mpProcess;
+}
+
+void CPlantUMLRenderServer::processOutput()
+{
+    if(nullptr == mpProcess)
+    {
+        return;
+    }
+
+    mOutputBuffer.append(mpProcess->readAllStandardOutput());
+
+    int delimiterIndex = mOutputBuffer.indexOf(mDelimiter);
+
+    while(delimiterIndex >= 0)
+    {
+        const QByteArray imageData = mOutputBuffer.left(delimiterIndex);
+
+        int consumedBytes = delimiterIndex + mDelimiter.size();
+
+        // delimiter is printed with the platform-specific line separator
+        while(consumedBytes < mOutputBuffer.size() &&
+              ( mOutputBuffer.at(consumedBytes) == '\r' || mOutputBuffer.at(consumedBytes) == '\n' ))
+        {
+            ++consumedBytes;
+        }
+
+        mOutputBuffer.remove(0, consumedBytes);
+
+        if(false == mPendingRequests.empty())
+        {
+            tPendingRequest request = mPendingRequests.front();
+            mPendingRequests.pop_front();
+
+            const bool bSuccess = false == imageData.isEmpty();
+
+            if(true == bSuccess)
+            {
+                mRenderedImageCache.insert(request.hash, new QByteArray(imageData), getImageCostKB(imageData));
+            }
+
+            if(request.callback)
+            {
+                request.callback(bSuccess, imageData);
+            }
+        }
+        else
+        {
+            SEND_WRN("[CPlantUMLRenderServer] Received image without the pending request. Image is dropped.");
+        }
+
+        delimiterIndex = mOutputBuffer.indexOf(mDelimiter);
+    }
+}
+
+void CPlantUMLRenderServer::failPendingRequests()
+{
+    tPendingRequests pendingRequests;
+    pendingRequests.swap(mPendingRequests);
+
+    for(const auto& request : pendingRequests)
+    {
+        if(request.callback)
+        {
+            request.callback(false, QByteArray());
+        }
+    }
+}
+
+void CPlantUMLRenderServer::releaseProcess()
+{
+    mNotWrittenInput.clear();
+
+    if(nullptr != mpProcess)
+    {
+        auto pProcess = mpProcess;
+        mpProcess = nullptr;
+
+        pProcess->disconnect(this);
+
+        if(QProcess::NotRunning != pProcess->state())
+        {
+            pProcess->closeWriteChannel();
+            pProcess->kill();
+        }
+
+        pProcess->deleteLater();
+    }
+}
+
+PUML_PACKAGE_BEGIN(DMA_PlantumlView)
+    PUML_CLASS_BEGIN_CHECKED(CPlantUMLRenderServer)
+        PUML_INHERITANCE_CHECKED(QObject, extends)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(QProcess, 1, 1, contains)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
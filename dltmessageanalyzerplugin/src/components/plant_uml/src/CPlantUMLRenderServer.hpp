@@ -0,0 +1,112 @@
+/**
+ * @file    CPlantUMLRenderServer.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CPlantUMLRenderServer class
+ */
+
+#pragma once
+
+#include "deque"
+#include "functional"
+
+#include "QObject"
+#include "QByteArray"
+#include "QCache"
+
+class QProcess;
+
+/**
+ * @brief The CPlantUMLRenderServer class - keeps one long-lived plantuml process,
+ * which is running in the "-pipe" mode. Diagrams are streamed to its stdin,
+ * rendered PNG images are read back from its stdout. That way the JVM start-up
+ * and the plantuml warm-up are paid only once per session.
+ * Rendered images are cached by the hash of the diagram content, so that
+ * unchanged diagrams are served without involvement of the plantuml at all.
+ */
+class CPlantUMLRenderServer : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    struct tConfiguration
+    {
+        bool operator==(const tConfiguration& rhs) const;
+        bool operator!=(const tConfiguration& rhs) const;
+        QString javaPath;
+        QString plantUMLPath;
+        int limitSizePixels = 0;
+    };
+
+    typedef std::function<void(bool bSuccess, const QByteArray& imageData)> tRenderCallback;
+
+    explicit CPlantUMLRenderServer(QObject* pParent = nullptr);
+    ~CPlantUMLRenderServer() override;
+
+    /**
+     * @brief isPipeCompatible - checks, whether the diagram can be rendered in the pipe mode.
+     * Pipe mode produces one image per diagram, thus only content with exactly one diagram is supported.
+     * @param diagramContent - content of the diagram
+     * @return - true, if diagram can be rendered by this class. False otherwise.
+     */
+    static bool isPipeCompatible(const QString& diagramContent);
+
+    /**
+     * @brief render - renders the PNG image of the provided diagram.
+     * Image is served from the cache, if the same diagram was already rendered
+     * with the same configuration. Otherwise the diagram is streamed to the plantuml process,
+     * which is (re-)started, if it is not running or if the configuration has changed.
+     * Start of the process is not awaited. Diagrams are queued till the process is started,
+     * and failure to start it is reported to the callbacks of the queued requests.
+     * @param configuration - java and plantuml configuration to be used
+     * @param diagramContent - content of the diagram
+     * @param callback - callback, which receives the rendered image.
+     * In case of the cache hit it is called synchronously.
+     */
+    void render(const tConfiguration& configuration,
+                const QString& diagramContent,
+                const tRenderCallback& callback);
+
+    /**
+     * @brief cancelPendingRequests - drops callbacks of all not yet rendered requests.
+     * The process itself is kept alive. Images of such requests will still be cached.
+     */
+    void cancelPendingRequests();
+
+    /**
+     * @brief stop - stops the plantuml process. Pending requests are dropped without notification.
+     */
+    void stop();
+
+    /**
+     * @brief isRunning - whether the plantuml process is currently alive
+     */
+    bool isRunning() const;
+
+private:
+
+    typedef QByteArray tDiagramHash;
+
+    struct tPendingRequest
+    {
+        tDiagramHash hash;
+        tRenderCallback callback;
+    };
+
+    typedef std::deque<tPendingRequest> tPendingRequests;
+
+    bool ensureStarted(const tConfiguration& configuration);
+    void processOutput();
+    void failPendingRequests();
+    void releaseProcess();
+
+private:
+    QProcess* mpProcess;
+    tConfiguration mConfiguration;
+    QByteArray mDelimiter;
+    QByteArray mOutputBuffer;
+    // diagrams, which were requested while the process was starting
+    QByteArray mNotWrittenInput;
+    tPendingRequests mPendingRequests;
+    QCache<tDiagramHash, QByteArray> mRenderedImageCache;
+};
@@ -18,6 +18,7 @@
 #include "QActionGroup"
 
 #include "CImageViewer.hpp"
+#include "CPlantUMLRenderServer.hpp"
 #include "../api/CUMLView.hpp"
 #include "components/settings/api/ISettingsManager.hpp"
 #include "components/log/api/CLog.hpp"
@@ -72,6 +73,20 @@ static QString get_UML_SVG_File_Name()
     return result;
 }
 
+static int get_PlantUML_LimitSize(const int& maxRows)
+{
+    auto usedPixelsInt = maxRows * 3500 /*pixels*/; // we give here some really big value to ensure that the whole diagram will be rendered.
+
+    const int minPixelsInt = 10000;
+
+    if(usedPixelsInt < minPixelsInt)
+    {
+        usedPixelsInt = minPixelsInt;
+    }
+
+    return usedPixelsInt;
+}
+
 static std::pair<QString /*command*/, QStringList /*arguments*/> get_PlantUML_Command(const QString& plantUMLPath,
                                                                                       const QString& javaPath,
                                                                                       const QString& PUMLFilePath,
@@ -82,14 +97,7 @@ static std::pair<QString /*command*/, QStringList /*arguments*/> get_PlantUML_Co
 
     result.first = javaPath;
 
-    auto usedPixelsInt = maxRows * 3500 /*pixels*/; // we give here some really big value to ensure that the whole diagram will be rendered.
-
-    const int minPixelsInt = 10000;
-
-    if(usedPixelsInt < minPixelsInt)
-    {
-        usedPixelsInt = minPixelsInt;
-    }
+    auto usedPixelsInt = get_PlantUML_LimitSize(maxRows);
 
     QString extensionStr;
 
@@ -116,19 +124,140 @@ static std::pair<QString /*command*/, QStringList /*arguments*/> get_PlantUML_Co
     return result;
 }
 
+static QString getDependencyPath( const QString& msgPrefix,
+                                  const ePathMode& pathMode,
+                                  const QString& defaultPath,
+                                  const QString& customPath,
+                                  const QString& envVar )
+{
+    QString targetPath = defaultPath;
+
+    switch(pathMode)
+    {
+        case ePathMode::eUseDefaultPath:
+        {
+            targetPath = defaultPath;
+        }
+            break;
+        case ePathMode::eUseCustomPath:
+        {
+            if(false == customPath.isEmpty())
+            {
+                targetPath = customPath;
+            }
+            else
+            {
+                SEND_WRN(QString("[CUMLView][%1] Custom path is empty. Fallback to the default path - \"%2\".")
+                         .arg(msgPrefix).arg(defaultPath));
+                targetPath = defaultPath;
+            }
+        }
+            break;
+        case ePathMode::eUseEnvVar:
+        {
+            const auto systemEnv = QProcessEnvironment::systemEnvironment();
+
+            if(true == systemEnv.contains(envVar))
+            {
+                targetPath = systemEnv.value(envVar);
+
+                if(true == targetPath.isEmpty())
+                {
+                    SEND_WRN(QString("[CUMLView][%1] Selected env. var. - \"%2\" - has an empty value. Fallback to the default path - \"%3\".")
+                             .arg(msgPrefix)
+                             .arg(envVar)
+                             .arg(defaultPath));
+                    targetPath = defaultPath;
+                }
+            }
+            else
+            {
+                SEND_WRN(QString("[CUMLView][%1] Selected env. var - \"%2\" - does not exist. Fallback to the default path - \"%3\".")
+                         .arg(msgPrefix)
+                         .arg(envVar)
+                         .arg(defaultPath));
+                targetPath = defaultPath;
+            }
+        }
+            break;
+        case ePathMode::eLast:
+        {
+            SEND_WRN(QString("[CUMLView][%1] saved ePathMode equal to eLast. Something went wrong! Fallback to the default path - \"%2\".")
+                     .arg(msgPrefix)
+                     .arg(defaultPath));
+
+            targetPath = defaultPath;
+        }
+            break;
+    }
+
+    return targetPath;
+}
+
+static CPlantUMLRenderServer::tConfiguration getRenderServerConfiguration(const tSettingsManagerPtr& pSettingsManager)
+{
+    CPlantUMLRenderServer::tConfiguration configuration;
+
+    configuration.plantUMLPath = getDependencyPath( "plantuml_path",
+                                                    static_cast<ePathMode>(pSettingsManager->getPlantumlPathMode()),
+                                                    pSettingsManager->getDefaultPlantumlPath(),
+                                                    pSettingsManager->getPlantumlCustomPath(),
+                                                    pSettingsManager->getPlantumlPathEnvVar());
+
+    configuration.javaPath = getDependencyPath( "java_path",
+                                                static_cast<ePathMode>(pSettingsManager->getJavaPathMode()),
+                                                pSettingsManager->getDefaultJavaPath(),
+                                                pSettingsManager->getJavaCustomPath(),
+                                                pSettingsManager->getJavaPathEnvVar());
+
+    configuration.limitSizePixels = get_PlantUML_LimitSize(pSettingsManager->getUML_MaxNumberOfRowsInDiagram());
+
+    return configuration;
+}
+
+static void store_PUML_File(const QString& PUML_file_path, const QString& diagramContent)
+{
+    QFile PUML_file(PUML_file_path);
+
+    // check whether puml exists
+    if(true == PUML_file.exists())
+    {
+        // if it exists - delete it
+        bool bRemoveResult = PUML_file.remove();
+
+        if(false == bRemoveResult)
+        {
+            SEND_WRN(QString("[CUMLView] Was not able to remove file - \"%1\"").arg(PUML_file_path));
+        }
+    }
+
+    // create new puml file
+    if(PUML_file.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Text))
+    {
+        QTextStream textStream(&PUML_file);
+        textStream << diagramContent;
+        PUML_file.close();
+    }
+}
 
 CUMLView::CUMLView(QWidget *parent):
 tParent(parent),
 mbDiagramShown(false),
 mpImageViewer(nullptr),
+mpRenderServer(nullptr),
 mpDiagramCreationSubProcess(nullptr),
 mpSaveSVGSubProcess(nullptr),
 mDiagramContent(),
+mDiagramPages(),
+mCurrentDiagramPage(0),
 mbDiagramGenerationInProgress(false),
+mDiagramRequestId(0u),
 mLastSelectedFolder(QString(".") + QDir::separator())
 {
     mpImageViewer = new CImageViewer(this);
     setWidget(mpImageViewer);
+
+    mpRenderServer = new CPlantUMLRenderServer(this);
 }
 
 void CUMLView::generateUMLDiagramInternal(const QString& diagramContent,
@@ -142,76 +271,6 @@ void CUMLView::generateUMLDiagramInternal(const QString& diagramContent,
         pSubProcess.reset();
     }
 
-    auto getDependencyPath = []( const QString& msgPrefix,
-            const ePathMode& pathMode,
-            const QString& defaultPath,
-            const QString& customPath,
-            const QString& envVar )
-    {
-        QString targetPath = defaultPath;
-
-        switch(pathMode)
-        {
-            case ePathMode::eUseDefaultPath:
-            {
-                targetPath = defaultPath;
-            }
-                break;
-            case ePathMode::eUseCustomPath:
-            {
-                if(false == customPath.isEmpty())
-                {
-                    targetPath = customPath;
-                }
-                else
-                {
-                    SEND_WRN(QString("[CUMLView][%1] Custom path is empty. Fallback to the default path - \"%2\".")
-                             .arg(msgPrefix).arg(defaultPath));
-                    targetPath = defaultPath;
-                }
-            }
-                break;
-            case ePathMode::eUseEnvVar:
-            {
-                const auto systemEnv = QProcessEnvironment::systemEnvironment();
-
-                if(true == systemEnv.contains(envVar))
-                {
-                    targetPath = systemEnv.value(envVar);
-
-                    if(true == targetPath.isEmpty())
-                    {
-                        SEND_WRN(QString("[CUMLView][%1] Selected env. var. - \"%2\" - has an empty value. Fallback to the default path - \"%3\".")
-                                 .arg(msgPrefix)
-                                 .arg(envVar)
-                                 .arg(defaultPath));
-                        targetPath = defaultPath;
-                    }
-                }
-                else
-                {
-                    SEND_WRN(QString("[CUMLView][%1] Selected env. var - \"%2\" - does not exist. Fallback to the default path - \"%3\".")
-                             .arg(msgPrefix)
-                             .arg(envVar)
-                             .arg(defaultPath));
-                    targetPath = defaultPath;
-                }
-            }
-                break;
-            case ePathMode::eLast:
-            {
-                SEND_WRN(QString("[CUMLView][%1] saved ePathMode equal to eLast. Something went wrong! Fallback to the default path - \"%2\".")
-                         .arg(msgPrefix)
-                         .arg(defaultPath));
-
-                targetPath = defaultPath;
-            }
-                break;
-        }
-
-        return targetPath;
-    };
-
     QString plantUMLPath = getDependencyPath( "plantuml_path",
                                               static_cast<ePathMode>(getSettingsManager()->getPlantumlPathMode()),
                                               getSettingsManager()->getDefaultPlantumlPath(),
@@ -236,27 +295,7 @@ void CUMLView::generateUMLDiagramInternal(const QString& diagramContent,
 
         QString PUML_file_path = get_UML_Storage_Path(getSettingsManager()->getSettingsFilepath()) + get_UML_PUML_File_Name();
 
-        QFile PUML_file(PUML_file_path);
-
-        // check whether puml exists
-        if(true == PUML_file.exists())
-        {
-            // if it exists - delete it
-            bool bRemoveResult = PUML_file.remove();
-
-            if(false == bRemoveResult)
-            {
-                SEND_WRN(QString("[CUMLView] Was not able to remove file - \"%1\"").arg(PUML_file_path));
-            }
-        }
-
-        // create new puml file
-        if(PUML_file.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Text))
-        {
-            QTextStream textStream(&PUML_file);
-            textStream << diagramContent;
-            PUML_file.close();
-        }
+        store_PUML_File(PUML_file_path, diagramContent);
 
         QString result_file_path = get_UML_Storage_Path(getSettingsManager()->getSettingsFilepath()) + ( extension == eDiagramExtension::e_PNG ? get_UML_PNG_File_Name() : get_UML_SVG_File_Name() );
 
@@ -331,6 +370,57 @@ void CUMLView::generateUMLDiagramInternal(const QString& diagramContent,
     }
 }
 
+void CUMLView::generateUMLDiagramWithRenderServer(const QString& diagramContent,
+                                                  const tGenerateDiagramCallback& callback)
+{
+    const auto configuration = getRenderServerConfiguration(getSettingsManager());
+
+    if(false == QFile::exists(configuration.plantUMLPath))
+    {
+        SEND_ERR(QString("[CUMLView] Specified plantuml path \"%1\" does not exist. Diagram creation interrupted.").arg(configuration.plantUMLPath));
+        callback(-1, QProcess::NormalExit);
+        return;
+    }
+
+    const QString storagePath = get_UML_Storage_Path(getSettingsManager()->getSettingsFilepath());
+
+    // check that target folder exists
+    if(false == QDir(storagePath).exists())
+    {
+        QDir().mkdir(storagePath);
+    }
+
+    // puml file is still needed for the "Save as ..." functionality
+    store_PUML_File(storagePath + get_UML_PUML_File_Name(), diagramContent);
+
+    mpRenderServer->render(configuration, diagramContent,
+                           [this, storagePath, diagramContent, callback](bool bSuccess, const QByteArray& imageData)
+    {
+        if(true == bSuccess)
+        {
+            const QString PNG_file_path = storagePath + get_UML_PNG_File_Name();
+            QFile PNG_file(PNG_file_path);
+
+            if(PNG_file.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Truncate))
+            {
+                PNG_file.write(imageData);
+                PNG_file.close();
+                callback(0, QProcess::NormalExit);
+            }
+            else
+            {
+                SEND_ERR(QString("[CUMLView] Was not able to write file - \"%1\"").arg(PNG_file_path));
+                callback(-1, QProcess::NormalExit);
+            }
+        }
+        else
+        {
+            SEND_WRN("[CUMLView] Render server was not able to produce the diagram. Fallback to the one-shot plantuml process.");
+            generateUMLDiagramInternal(diagramContent, eDiagramExtension::e_PNG, callback, mpDiagramCreationSubProcess, false);
+        }
+    });
+}
+
 void CUMLView::startGenerateUMLDiagram(const QString& diagramContent, bool isInternalCall)
 {
     if(false == isInternalCall)
@@ -346,8 +436,16 @@ void CUMLView::startGenerateUMLDiagram(const QString& diagramContent, bool isInt
 
     mbDiagramShown = false;
 
-    auto callback = [this, PNG_file_path, diagramContent](int exitCode, QProcess::ExitStatus exitStatus)
+    const auto requestId = ++mDiagramRequestId;
+
+    auto callback = [this, PNG_file_path, diagramContent, requestId](int exitCode, QProcess::ExitStatus exitStatus)
     {
+        // late result of the page, which is no longer the current one, should not overwrite the shown page
+        if(requestId != mDiagramRequestId)
+        {
+            return;
+        }
+
         auto viewPng = [this, &PNG_file_path, &diagramContent]()
         {
             if(true == mbDiagramGenerationInProgress)
@@ -396,14 +494,90 @@ void CUMLView::startGenerateUMLDiagram(const QString& diagramContent, bool isInt
     diagramGenerationStarted();
     mbDiagramGenerationInProgress = true;
 
-    generateUMLDiagramInternal(diagramContent, eDiagramExtension::e_PNG, callback, mpDiagramCreationSubProcess, false);
+    if(true == getSettingsManager()->getUML_RenderServerMode()
+    && true == CPlantUMLRenderServer::isPipeCompatible(diagramContent))
+    {
+        generateUMLDiagramWithRenderServer(diagramContent, callback);
+    }
+    else
+    {
+        generateUMLDiagramInternal(diagramContent, eDiagramExtension::e_PNG, callback, mpDiagramCreationSubProcess, false);
+    }
 }
 
 void CUMLView::generateUMLDiagram(const QString& diagramContent)
 {
+    mDiagramPages.clear();
+    mDiagramPages.push_back(diagramContent);
+    mCurrentDiagramPage = 0;
+
     startGenerateUMLDiagram(diagramContent, false);
 }
 
+void CUMLView::startDiagramPages()
+{
+    if(true == mbDiagramGenerationInProgress)
+    {
+        cancelDiagramGeneration();
+    }
+
+    mDiagramPages.clear();
+    mCurrentDiagramPage = 0;
+
+    clearDiagram();
+
+    // the first page might take a while to arrive. Generation is reported as started from this moment
+    mbDiagramGenerationInProgress = true;
+    diagramGenerationStarted();
+}
+
+void CUMLView::addDiagramPage(const QString& diagramContent)
+{
+    mDiagramPages.push_back(diagramContent);
+
+    if(1 == mDiagramPages.size())
+    {
+        if(true == mbDiagramGenerationInProgress)
+        {
+            showDiagramPage(0);
+        }
+    }
+    else
+    {
+        prerenderDiagramPage(diagramContent);
+    }
+}
+
+void CUMLView::showDiagramPage(int pageIndex)
+{
+    if(pageIndex >= 0 && pageIndex < mDiagramPages.size())
+    {
+        mCurrentDiagramPage = pageIndex;
+        startGenerateUMLDiagram(mDiagramPages[pageIndex], false);
+    }
+}
+
+int CUMLView::getDiagramPagesCount() const
+{
+    return static_cast<int>(mDiagramPages.size());
+}
+
+void CUMLView::prerenderDiagramPage(const QString& diagramContent)
+{
+    if(true == getSettingsManager()->getUML_RenderServerMode()
+    && true == CPlantUMLRenderServer::isPipeCompatible(diagramContent))
+    {
+        const auto configuration = getRenderServerConfiguration(getSettingsManager());
+
+        if(true == QFile::exists(configuration.plantUMLPath))
+        {
+            // the image is only put into the cache of the render server.
+            // That way switching to this page later on is instant.
+            mpRenderServer->render(configuration, diagramContent, CPlantUMLRenderServer::tRenderCallback());
+        }
+    }
+}
+
 bool CUMLView::isDiagramGenerationInProgress() const
 {
     return mbDiagramGenerationInProgress;
@@ -414,7 +588,10 @@ void CUMLView::cancelDiagramGeneration()
     if(true == mbDiagramGenerationInProgress)
     {
         mbDiagramGenerationInProgress = false;
+        // results of the already started rendering are ignored
+        ++mDiagramRequestId;
         mpDiagramCreationSubProcess.reset();
+        mpRenderServer->cancelPendingRequests();
         diagramGenerationFinished(false);
     }
 }
@@ -548,6 +725,8 @@ void CUMLView::handleSettingsManagerChange()
                 {
                     mbDiagramShown = false;
                     mDiagramContent.clear();
+                    mDiagramPages.clear();
+                    mCurrentDiagramPage = 0;
                     clearDiagram();
                 }
             });
@@ -556,6 +735,39 @@ void CUMLView::handleSettingsManagerChange()
             contextMenu.addAction(pAction);
         }
 
+        if(mDiagramPages.size() > 1)
+        {
+            contextMenu.addSeparator();
+
+            {
+                QAction* pAction = new QAction(QString("Page %1 of %2").arg(mCurrentDiagramPage + 1).arg(mDiagramPages.size()), this);
+                pAction->setEnabled(false);
+                contextMenu.addAction(pAction);
+            }
+
+            {
+                QAction* pAction = new QAction("Previous page", this);
+                connect(pAction, &QAction::triggered, [this]()
+                {
+                    showDiagramPage(mCurrentDiagramPage - 1);
+                });
+
+                pAction->setEnabled(mCurrentDiagramPage > 0);
+                contextMenu.addAction(pAction);
+            }
+
+            {
+                QAction* pAction = new QAction("Next page", this);
+                connect(pAction, &QAction::triggered, [this]()
+                {
+                    showDiagramPage(mCurrentDiagramPage + 1);
+                });
+
+                pAction->setEnabled(mCurrentDiagramPage + 1 < mDiagramPages.size());
+                contextMenu.addAction(pAction);
+            }
+        }
+
         contextMenu.addSeparator();
 
         {
@@ -598,6 +810,19 @@ void CUMLView::handleSettingsManagerChange()
                     pSubMenu->addAction(pAction);
                 }
 
+                {
+                    QAction* pAction = new QAction("Render server mode", this);
+                    pAction->setToolTip("Keep one plantuml process alive and reuse already rendered diagrams");
+                    connect(pAction, &QAction::triggered, [this](bool checked)
+                    {
+                        getSettingsManager()->setUML_RenderServerMode(checked);
+                    });
+                    pAction->setCheckable(true);
+                    pAction->setChecked(getSettingsManager()->getUML_RenderServerMode());
+
+                    pSubMenu->addAction(pAction);
+                }
+
                 {
                     QAction* pAction = new QAction("Max rows number ...", this);
                     connect(pAction, &QAction::triggered, [this]()
@@ -622,6 +847,31 @@ void CUMLView::handleSettingsManagerChange()
 
                     pSubMenu->addAction(pAction);
                 }
+
+                {
+                    QAction* pAction = new QAction("Rows per page ...", this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString rowsPerPageStr = QInputDialog::getText(  nullptr, "Rows per page",
+                                   "Set max rows number in one diagram page ( 0 - no paging ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getUML_RowsPerDiagramPage()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto rowsPerPage = rowsPerPageStr.toInt(&ok);
+
+                            if(true == ok && rowsPerPage >= 0)
+                            {
+                                getSettingsManager()->setUML_RowsPerDiagramPage(rowsPerPage);
+                            }
+                        }
+                    });
+
+                    pSubMenu->addAction(pAction);
+                }
             }
 
             contextMenu.addMenu(pSubMenu);
@@ -807,6 +1057,14 @@ void CUMLView::handleSettingsManagerChange()
     };
 
     connect( this, &QWidget::customContextMenuRequested, showContextMenu );
+
+    connect(getSettingsManager().get(), &ISettingsManager::UML_RenderServerModeChanged, this, [this](const bool& val)
+    {
+        if(false == val)
+        {
+            mpRenderServer->stop();
+        }
+    });
 }
 
 PUML_PACKAGE_BEGIN(DMA_PlantumlView_API)
@@ -814,6 +1072,7 @@ PUML_PACKAGE_BEGIN(DMA_PlantumlView_API)
         PUML_INHERITANCE_CHECKED(QScrollArea, extends)
         PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CImageViewer, 1, 1, contains)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CPlantUMLRenderServer, 1, 1, contains)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(QProcess, 1, 2, contains)
     PUML_CLASS_END()
 PUML_PACKAGE_END()
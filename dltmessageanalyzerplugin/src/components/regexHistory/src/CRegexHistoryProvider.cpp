@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <map>
 #include <set>
 
@@ -20,6 +23,14 @@
 const static QRegularExpression sFindLastPipeRegex("(.*)(?<!\\\\)(\\|)(?!.*(?<!\\\\)\\1)(.*)");
 const static int sMaximumRegexHistorySize = 100;
 const static int sSuggestionTypeRole = 123;
+// doubling of the usage counter is worth the same as being used one half-life later
+const static double sSuggestionRankHalfLifeSec = 7 * 24 * 3600;
+// fractional part of the rank is kept in the integer weight of the completion index
+const static double sSuggestionRankScale = 1000.0;
+// max number of the shown suggestions
+const static int sMaxNumberOfSuggestions = 50;
+// delay of the sync of the regex usage statistics to the settings manager
+const static int sPersistenceDelayMs = 1000;
 
 // CExtendedCompleter implementation
 
@@ -122,8 +133,15 @@ public:
 typedef std::multimap<tSuggestionRanking, tSuggestionRankingValuePtr> tSuggestionPreparationRankingMap;
 typedef std::multiset<tSuggestionRankingValuePtrWrapper> tSuggestionRankingSet;
 
-static void deleteNonRelevantElements(ISettingsManager::tRegexUsageStatisticsItemData& map)
+/**
+ * @brief deleteNonRelevantElements - deletes the least relevant elements, until the size limit is reached
+ * @param map - map to be shrunk
+ * @return - keys of the deleted elements
+ */
+static QStringList deleteNonRelevantElements(ISettingsManager::tRegexUsageStatisticsItemData& map)
 {
+    QStringList result;
+
     // Find the element with the oldest updateDateTime
     QDateTime oldestDateTime = QDateTime::currentDateTime(); // Initialize to current time for comparison
 
@@ -165,6 +183,7 @@ static void deleteNonRelevantElements(ISettingsManager::tRegexUsageStatisticsIte
     {
         if(map.size() > sMaximumRegexHistorySize)
         {
+            result.append(item.pSuggestionRankingValue->it.key());
             map.erase(item.pSuggestionRankingValue->it);
         }
         else
@@ -172,6 +191,25 @@ static void deleteNonRelevantElements(ISettingsManager::tRegexUsageStatisticsIte
             break;
         }
     }
+
+    return result;
+}
+
+/**
+ * @brief getSuggestionRank - frecency of the suggestion, i.e. its usage counter, which decays by half each half-life
+ * since its last usage. Rank is the logarithm of this value, measured in half-lives:
+ * lastUsage / halfLife + log2(usageCounter). Unlike the decayed counter itself, it does not depend on the current time,
+ * thus it is calculated once, when the suggestion is used, and stays comparable with the ranks of the other suggestions.
+ * @param item - statistics of the suggestion
+ * @return - rank of the suggestion. The higher is the better
+ */
+static CCompletionIndex::tWeight getSuggestionRank(const ISettingsManager::tRegexUsageStatisticsItem& item)
+{
+    const double rank = static_cast<double>(item.updateDateTime.toSecsSinceEpoch()) / sSuggestionRankHalfLifeSec +
+                        std::log2(static_cast<double>(std::max(1, item.usageCounter)));
+
+    // index drops the items with non-positive weight
+    return std::max<CCompletionIndex::tWeight>(1, static_cast<CCompletionIndex::tWeight>(rank * sSuggestionRankScale));
 }
 
 CRegexHistoryProvider::CRegexHistoryProvider(const tSettingsManagerPtr& pSettingsManager,
@@ -181,8 +219,39 @@ CSettingsManagerClient(pSettingsManager),
 mpRegexTextEdit(pRegexTextEdit),
 mpPatternsView(pPatternsView),
 mpDLTMessageAnalyzerController(pDLTMessageAnalyzerController),
-mbSuggestionActive(false)
+mbSuggestionActive(false),
+mRegexUsageStatistics(),
+mSuggestionIndexes(),
+mPersistenceTimer(),
+mbPersistingRegexUsageStatistics(false)
 {
+    mPersistenceTimer.setSingleShot(true);
+    mPersistenceTimer.setInterval(sPersistenceDelayMs);
+    connect(&mPersistenceTimer, &QTimer::timeout, this, [this]()
+    {
+        persistRegexUsageStatistics();
+    });
+
+    if(nullptr != getSettingsManager())
+    {
+        if(true == loadRegexUsageStatistics(getSettingsManager()->getRegexUsageStatistics()))
+        {
+            schedulePersistence();
+        }
+
+        connect(getSettingsManager().get(), &ISettingsManager::regexUsageStatisticsChanged,
+                this, [this](const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics)
+        {
+            handleRegexUsageStatisticsChange(regexUsageStatistics);
+        });
+
+        connect(getSettingsManager().get(), &ISettingsManager::regexUsageStatisticsAboutToBeStored,
+                this, [this]()
+        {
+            flushPersistence();
+        });
+    }
+
     if(nullptr != mpRegexTextEdit)
     {
         CExtendedCompleter* pCompleter = new CExtendedCompleter(this, mpRegexTextEdit);
@@ -312,6 +381,7 @@ mbSuggestionActive(false)
 
 CRegexHistoryProvider::~CRegexHistoryProvider()
 {
+    flushPersistence();
 }
 
 void CRegexHistoryProvider::handleSettingsManagerChange()
@@ -326,13 +396,127 @@ void CRegexHistoryProvider::handleSettingsManagerChange()
         });
     }
 
-    auto regexUsageStatistics = getSettingsManager()->getRegexUsageStatistics();
-    deleteNonRelevantElements(regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::TEXT]);
-    deleteNonRelevantElements(regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN]);
-    getSettingsManager()->setRegexUsageStatistics(regexUsageStatistics);
+    if(nullptr != getSettingsManager())
+    {
+        connect(getSettingsManager().get(), &ISettingsManager::regexUsageStatisticsChanged,
+                this, [this](const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics)
+        {
+            handleRegexUsageStatisticsChange(regexUsageStatistics);
+        });
+
+        connect(getSettingsManager().get(), &ISettingsManager::regexUsageStatisticsAboutToBeStored,
+                this, [this]()
+        {
+            flushPersistence();
+        });
+
+        mPersistenceTimer.stop();
+
+        // the loaded statistics are written back only if they were trimmed
+        if(true == loadRegexUsageStatistics(getSettingsManager()->getRegexUsageStatistics()))
+        {
+            schedulePersistence();
+        }
+    }
+}
+
+void CRegexHistoryProvider::handleRegexUsageStatisticsChange(const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics)
+{
+    // the statistics were loaded from another file. Our own updates are already applied.
+    if(false == mbPersistingRegexUsageStatistics)
+    {
+        mPersistenceTimer.stop();
+        loadRegexUsageStatistics(regexUsageStatistics);
+    }
+}
+
+bool CRegexHistoryProvider::loadRegexUsageStatistics(const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics)
+{
+    bool bResult = false;
+
+    mRegexUsageStatistics = regexUsageStatistics;
+    mSuggestionIndexes.clear();
+
+    for(auto it = mRegexUsageStatistics.begin(); it != mRegexUsageStatistics.end(); ++it)
+    {
+        if(false == deleteNonRelevantElements(it.value()).empty())
+        {
+            bResult = true;
+        }
+
+        auto& suggestionIndex = mSuggestionIndexes[it.key()];
+
+        for(auto jt = it.value().begin(); jt != it.value().end(); ++jt)
+        {
+            suggestionIndex.setWeight(jt.key(), getSuggestionRank(jt.value()));
+        }
+    }
+
+    return bResult;
 }
 
-CRegexHistoryProvider::tSuggestionsMap CRegexHistoryProvider::getSuggestions(const QString& input)
+void CRegexHistoryProvider::updateSuggestionIndex(const ISettingsManager::eRegexUsageStatisticsItemType& itemType, const QString& key)
+{
+    auto& suggestionIndex = mSuggestionIndexes[itemType];
+    const auto& itemData = mRegexUsageStatistics[itemType];
+    auto foundItem = itemData.find(key);
+
+    if(foundItem != itemData.end())
+    {
+        suggestionIndex.setWeight(key, getSuggestionRank(foundItem.value()));
+    }
+    else
+    {
+        suggestionIndex.setWeight(key, 0);
+    }
+}
+
+void CRegexHistoryProvider::incrementCounter(const ISettingsManager::eRegexUsageStatisticsItemType& itemType, const QString& key)
+{
+    auto& mapToCheck = mRegexUsageStatistics[itemType];
+
+    auto& updateItem = mapToCheck[key];
+    ++updateItem.usageCounter;
+    updateItem.updateDateTime = QDateTime::currentDateTime();
+    updateSuggestionIndex(itemType, key);
+
+    if(true == reachedTheSizeLimit(mapToCheck))
+    {
+        for(const auto& deletedKey : deleteNonRelevantElements(mapToCheck))
+        {
+            updateSuggestionIndex(itemType, deletedKey);
+        }
+    }
+}
+
+void CRegexHistoryProvider::schedulePersistence()
+{
+    if(false == mPersistenceTimer.isActive())
+    {
+        mPersistenceTimer.start();
+    }
+}
+
+void CRegexHistoryProvider::flushPersistence()
+{
+    if(true == mPersistenceTimer.isActive())
+    {
+        mPersistenceTimer.stop();
+        persistRegexUsageStatistics();
+    }
+}
+
+void CRegexHistoryProvider::persistRegexUsageStatistics()
+{
+    if(nullptr != getSettingsManager())
+    {
+        mbPersistingRegexUsageStatistics = true;
+        getSettingsManager()->setRegexUsageStatistics(mRegexUsageStatistics);
+        mbPersistingRegexUsageStatistics = false;
+    }
+}
+
+CRegexHistoryProvider::tSuggestionsMap CRegexHistoryProvider::getSuggestions(const QString& input, const int& maxNumberOfSuggestions)
 {
     tSuggestionsMap result;
 
@@ -357,37 +541,39 @@ CRegexHistoryProvider::tSuggestionsMap CRegexHistoryProvider::getSuggestions(con
         }
     }
 
-    const auto& regexUsageStatistics = getSettingsManager()->getRegexUsageStatistics();
-
     auto caseSensitiveOption = getSettingsManager()->getRegexCompletion_CaseSensitive() ?
                 Qt::CaseSensitive :
                 Qt::CaseInsensitive;
 
-    for (auto it = regexUsageStatistics.keyValueBegin(); it != regexUsageStatistics.keyValueEnd(); ++it)
+    auto searchPolicy = false == getSettingsManager()->getRegexCompletion_SearchPolicy() ?
+                CCompletionIndex::eSearchPolicy::eStartsWith :
+                CCompletionIndex::eSearchPolicy::eContains;
+
+    for(const auto& suggestionIndexPair : mSuggestionIndexes)
     {
-        for(auto jt = it->second.keyValueBegin(); jt != it->second.keyValueEnd(); ++jt)
-        {
-            bool bStringFound = false;
+        const auto& suggestionIndex = suggestionIndexPair.second;
 
-            if(false == getSettingsManager()->getRegexCompletion_SearchPolicy())
-            {
-                bStringFound = jt->first.startsWith(normalizedInput, caseSensitiveOption);
-            }
-            else
-            {
-                bStringFound = jt->first.contains(normalizedInput, caseSensitiveOption);
-            }
+        // each index provides its own top of the suggestions. The merged result is cut to the same limit below
+        const auto foundSuggestions = suggestionIndex.find(normalizedInput,
+                                                           searchPolicy,
+                                                           caseSensitiveOption,
+                                                           maxNumberOfSuggestions);
 
-            if(true == bStringFound)
-            {
-                tSuggestionData suggestionData;
-                suggestionData.regexUsageStatisticsItemType = it->first;
-                suggestionData.suggestionKey = jt->first;
-                result.insert(std::make_pair(jt->second.updateDateTime.toMSecsSinceEpoch(), suggestionData));
-            }
+        for(const auto& foundSuggestion : foundSuggestions)
+        {
+            tSuggestionData suggestionData;
+            suggestionData.regexUsageStatisticsItemType = suggestionIndexPair.first;
+            suggestionData.suggestionKey = foundSuggestion;
+            result.insert(std::make_pair(suggestionIndex.getWeight(foundSuggestion), suggestionData));
         }
     }
 
+    while(static_cast<int>(result.size()) > maxNumberOfSuggestions)
+    {
+        // map is ordered by the descending rank, thus the last item is the least relevant one
+        result.erase(std::prev(result.end()));
+    }
+
     return result;
 }
 
@@ -401,7 +587,7 @@ int CRegexHistoryProvider::updateSuggestions(const QString& input)
         QStandardItemModel* pModel = static_cast<QStandardItemModel*>(mCompletionData.pCompleter->model());
         pModel->clear();
 
-        auto suggestions = getSuggestions(input);
+        auto suggestions = getSuggestions(input, sMaxNumberOfSuggestions);
 
         auto numberOfAssignedSuggestions = 0;
         for(const auto& suggestion_pair : suggestions)
@@ -451,45 +637,27 @@ void CRegexHistoryProvider::clearSuggestions()
 
 void CRegexHistoryProvider::incrementPatternsCounter(const QStringList& aliases)
 {
-    auto regexUsageStatistics = getSettingsManager()->getRegexUsageStatistics();
-
     for(const auto& item : aliases)
     {
-        auto& updateItem = regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN][item];
-        ++updateItem.usageCounter;
-        updateItem.updateDateTime = QDateTime::currentDateTime();
+        incrementCounter(ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN, item);
     }
 
-    auto& mapToCheck = regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN];
-    if(true == reachedTheSizeLimit(mapToCheck))
+    if(false == aliases.empty())
     {
-        deleteNonRelevantElements(mapToCheck);
+        schedulePersistence();
     }
-
-    getSettingsManager()->setRegexUsageStatistics(regexUsageStatistics);
 }
 
 void CRegexHistoryProvider::incrementRegexTextCounter(const QString& regex)
 {
-    auto regexUsageStatistics = getSettingsManager()->getRegexUsageStatistics();
-
-    auto& updateItem = regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::TEXT][regex];
-    ++updateItem.usageCounter;
-    updateItem.updateDateTime = QDateTime::currentDateTime();
-
-    auto& mapToCheck = regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::TEXT];
-    if(true == reachedTheSizeLimit(mapToCheck))
-    {
-        deleteNonRelevantElements(mapToCheck);
-    }
-
-    getSettingsManager()->setRegexUsageStatistics(regexUsageStatistics);
+    incrementCounter(ISettingsManager::eRegexUsageStatisticsItemType::TEXT, regex);
+    schedulePersistence();
 }
 
 void CRegexHistoryProvider::handleAliasesChange(const ISettingsManager::tAliasItemMap& aliases)
 {
-    auto regexUsageStatistics = getSettingsManager()->getRegexUsageStatistics();
-    auto& aliasesUsageStatistics = regexUsageStatistics[ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN];
+    const auto itemType = ISettingsManager::eRegexUsageStatisticsItemType::STORED_REGEX_PATTERN;
+    auto& aliasesUsageStatistics = mRegexUsageStatistics[itemType];
     QSet<QString> aliasesSet;
 
     for(const auto& item : aliases)
@@ -506,12 +674,16 @@ void CRegexHistoryProvider::handleAliasesChange(const ISettingsManager::tAliasIt
         }
     }
 
-    // Remove the collected keys from the QMap
+    // Remove the collected keys from the QMap and from the index
     for (const QString& key : keysToRemove) {
         aliasesUsageStatistics.remove(key);
+        updateSuggestionIndex(itemType, key);
     }
 
-    getSettingsManager()->setRegexUsageStatistics(regexUsageStatistics);
+    if(false == keysToRemove.empty())
+    {
+        schedulePersistence();
+    }
 }
 
 bool CRegexHistoryProvider::getSuggestionActive()
@@ -542,5 +714,6 @@ PUML_PACKAGE_BEGIN(DMA_RegexHistory)
         PUML_AGGREGATION_DEPENDENCY_CHECKED(ISettingsManager, 1, 1, uses)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CExtendedCompleter, 1, 1, creates)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(QListView, 1, 1, creates)
+        PUML_COMPOSITION_DEPENDENCY_CHECKED(CCompletionIndex, 1, *, contains)
     PUML_CLASS_END()
 PUML_PACKAGE_END()
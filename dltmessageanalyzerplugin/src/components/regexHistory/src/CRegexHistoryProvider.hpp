@@ -7,6 +7,7 @@
 #include "QTimer"
 #include "QCompleter"
 
+#include "common/CCompletionIndex.hpp"
 #include "components/regexHistory/api/IRegexHistoryProvider.hpp"
 #include "components/settings/api/CSettingsManagerClient.hpp"
 #include "components/patternsView/api/CPatternsView.hpp"
@@ -62,11 +63,11 @@ public:
 protected:
     void handleSettingsManagerChange() override;
 
-    typedef int64_t tTimeSinceEpochMs;
+    typedef CCompletionIndex::tWeight tSuggestionRank;
 
     struct DescendingOrder
     {
-        bool operator()(const tTimeSinceEpochMs &a, const tTimeSinceEpochMs &b) const
+        bool operator()(const tSuggestionRank &a, const tSuggestionRank &b) const
         {
             return a > b; // Return true if 'a' should go before 'b'
         }
@@ -79,14 +80,42 @@ protected:
         tSuggestionKey suggestionKey;
     };
 
-    typedef std::multimap<tTimeSinceEpochMs, tSuggestionData, DescendingOrder> tSuggestionsMap;
+    typedef std::multimap<tSuggestionRank, tSuggestionData, DescendingOrder> tSuggestionsMap;
 
-    tSuggestionsMap getSuggestions(const QString& input);
+    /**
+     * @brief getSuggestions - gets the most relevant suggestions for the input
+     * @param input - text, entered by the user
+     * @param maxNumberOfSuggestions - max number of the returned suggestions
+     * @return - suggestions, ordered by their rank
+     */
+    tSuggestionsMap getSuggestions(const QString& input, const int& maxNumberOfSuggestions);
 
 private:
     void incrementPatternsCounter(const QStringList& aliases);
     void incrementRegexTextCounter(const QString& regex);
     void handleAliasesChange(const ISettingsManager::tAliasItemMap& aliases);
+    void handleRegexUsageStatisticsChange(const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics);
+
+    /**
+     * @brief loadRegexUsageStatistics - replaces the in-memory statistics with the given one and rebuilds the suggestion indexes
+     * @param regexUsageStatistics - statistics to be loaded
+     * @return - true, if the loaded statistics were trimmed to the size limit and differ from the given ones
+     */
+    bool loadRegexUsageStatistics(const ISettingsManager::tRegexUsageStatisticsItemMap& regexUsageStatistics);
+    void updateSuggestionIndex(const ISettingsManager::eRegexUsageStatisticsItemType& itemType, const QString& key);
+    void incrementCounter(const ISettingsManager::eRegexUsageStatisticsItemType& itemType, const QString& key);
+
+    /**
+     * @brief schedulePersistence - schedules the delayed sync of the in-memory statistics to the settings manager.
+     * Multiple updates, which happen within the delay, are stored at once.
+     */
+    void schedulePersistence();
+
+    /**
+     * @brief flushPersistence - immediately syncs the delayed updates to the settings manager, if there are any
+     */
+    void flushPersistence();
+    void persistRegexUsageStatistics();
 
 private:
     struct tCompletionData
@@ -102,4 +131,11 @@ private:
     CPatternsView* mpPatternsView;
     tDLTMessageAnalyzerControllerPtr mpDLTMessageAnalyzerController;
     bool mbSuggestionActive;
+
+    // in-memory copy of the statistics, which is updated in place and lazily synced to the settings manager
+    ISettingsManager::tRegexUsageStatisticsItemMap mRegexUsageStatistics;
+    typedef std::map<ISettingsManager::eRegexUsageStatisticsItemType, CCompletionIndex> tSuggestionIndexes;
+    tSuggestionIndexes mSuggestionIndexes;
+    QTimer mPersistenceTimer;
+    bool mbPersistingRegexUsageStatistics;
 };
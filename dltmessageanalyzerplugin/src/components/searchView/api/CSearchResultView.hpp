@@ -6,6 +6,11 @@
 #pragma once
 
 #include <QTableView>
+#include <QFontMetrics>
+#include <QColor>
+
+#include <memory>
+
 #include "common/Definitions.hpp"
 
 #include "components/settings/api/CSettingsManagerClient.hpp"
@@ -25,7 +30,14 @@ public:
 
     void setFile( const tFileWrapperPtr& pFile );
     virtual void setModel(QAbstractItemModel *model) override;
-    void copySelectionToClipboard( bool copyAsHTML, bool copyOnlyPayload ) const;
+    void copySelectionToClipboard( bool copyAsHTML, bool copyOnlyPayload );
+
+    /**
+     * @brief exportSelectionToFile - asks the user for the file path and streams the selected rows into it in the background
+     * @param copyAsHTML - whether rows should be exported as HTML
+     * @param copyOnlyPayload - whether only the payload column should be exported
+     */
+    void exportSelectionToFile( bool copyAsHTML, bool copyOnlyPayload );
     void newSearchStarted(const QString& regex);
     void scrollTo(const QModelIndex &index, ScrollHint hint = EnsureVisible) override;
     void setCoverageNoteProvider(const tCoverageNoteProviderPtr& pCoverageNoteProvider);
@@ -43,6 +55,9 @@ protected:
     void currentChanged(const QModelIndex &current,
                           const QModelIndex &previous) override;
     virtual void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles = QVector<int>()) override;
+    virtual void rowsInserted(const QModelIndex &parent, int start, int end) override;
+    virtual void rowsAboutToBeRemoved(const QModelIndex &parent, int start, int end) override;
+    virtual void reset() override;
     virtual void keyPressEvent ( QKeyEvent * event ) override;
 
     void handleSettingsManagerChange() override;
@@ -64,6 +79,22 @@ private:
     void updateWidth(bool force, tUpdateWidthSet updateWidthSet = tUpdateWidthSet());
     void forceUpdateWidthAndResetContentMap();
 
+    /**
+     * @brief measureRows - updates the max width of the content of the visible columns with the provided rows
+     * @param rowFrom - first row to be measured
+     * @param rowTo - last row to be measured
+     * @param updateWidthSet - output set of the columns, which max width has grown
+     */
+    void measureRows(const int& rowFrom, const int& rowTo, tUpdateWidthSet& updateWidthSet);
+
+    /**
+     * @brief resizeColumnByContent - sets the width of the column based on the tracked max width of its content.
+     * Falls back to the resizeColumnToContents, if the column was not measured yet.
+     * @param column - column to be resized
+     */
+    void resizeColumnByContent(const eSearchResultColumn& column);
+    void updateFontMetrics();
+
     eSearchResultColumn getLastVisibleColumn() const;
     void clearGroupedViewHighlighting();
 
@@ -75,6 +106,53 @@ private:
 
     void jumpToGroupedViewHighlightingMessage(eDirection direction);
 
+    struct tCopyContext
+    {
+        QVector<int> copyPasteColumns;
+        int firstCopyPasteColumn = 0;
+        int copyPasteColumnsSize = 0;
+        bool copyAsHTML = false;
+        bool bMarkTimeStampWithBold = false;
+        bool bMonoColorHighlighting = false;
+        QColor monoHighlightingColor;
+    };
+
+    tCopyContext createCopyContext( bool copyAsHTML, bool copyOnlyPayload ) const;
+
+    /**
+     * @brief getSelectedRowRanges - gets the sorted and merged ranges of the selected rows
+     */
+    tIntRangeList getSelectedRowRanges() const;
+
+    /**
+     * @brief appendRowAsString - renders the row in the format of the copy context and appends it to the result
+     */
+    void appendRowAsString( const int& row, const tCopyContext& copyContext, QString& result ) const;
+
+    enum class eSelectionExportTarget
+    {
+        eClipboard = 0,
+        eFile
+    };
+
+    /**
+     * @brief startSelectionExport - starts streaming of the selected rows into the file.
+     * Rows are rendered in time slices on the GUI thread, as the model data is not thread-safe.
+     * Progress is shown in the cancellable dialog. Previous export, if any, is cancelled.
+     * @param target - in case of the clipboard, rows are streamed into the temporary file,
+     * which content is put to the clipboard, if it does not exceed the size limit
+     * @param copyAsHTML - whether rows should be exported as HTML
+     * @param copyOnlyPayload - whether only the payload column should be exported
+     * @param filePath - target file path. Used only with the eFile target
+     */
+    void startSelectionExport( eSelectionExportTarget target,
+                               bool copyAsHTML,
+                               bool copyOnlyPayload,
+                               const QString& filePath );
+    void scheduleSelectionExport();
+    void processSelectionExport();
+    void finishSelectionExport( bool bCancelled );
+
 private:
 
     bool mbIsVerticalScrollBarVisible;
@@ -84,10 +162,18 @@ private:
     tIntRangeProperty mSearchRange;
     CSearchResultModel* mpSpecificModel;
 
-    typedef std::map<eSearchResultColumn, int /*max size of content*/> tContentSizeMap;
+    typedef std::map<eSearchResultColumn, int /*max width of content in pixels*/> tContentSizeMap;
     tContentSizeMap mContentSizeMap;
+    // rows [0, mNumberOfMeasuredRows) are already reflected in the mContentSizeMap
+    int mNumberOfMeasuredRows;
+    QFontMetrics mFontMetrics;
+    QFontMetrics mBoldFontMetrics;
+    int mCellMargin;
     tCoverageNoteProviderPtr mpCoverageNoteProvider;
     QTabWidget* mpMainTabWidget;
     QString mUsedRegex;
     QTableView* mpMainTableView;
+
+    struct tSelectionExport;
+    std::shared_ptr<tSelectionExport> mpSelectionExport;
 };
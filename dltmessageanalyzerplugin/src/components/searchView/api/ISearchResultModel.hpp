@@ -16,14 +16,27 @@ public:
     virtual ~ISearchResultModel();
 
     virtual void updateView(const int& fromRow = 0) = 0;
-    virtual std::pair<int /*rowNumber*/, QString /*diagramContent*/> getUMLDiagramContent() const = 0;
+    virtual void startUMLDiagramContentGeneration(const int& rowsPerPage) = 0;
+    /**
+     * @brief cancelUMLDiagramContentGeneration - stops the ongoing generation.
+     * UMLDiagramContentGenerationCancelled is emitted, if the generation was in progress
+     */
+    virtual void cancelUMLDiagramContentGeneration() = 0;
+    virtual bool isUMLDiagramContentGenerationInProgress() const = 0;
     virtual void resetData() = 0;
     virtual void setFile(const tFileWrapperPtr& pFile) = 0;
     virtual std::pair<bool, tIntRange> addNextMessageIdxVec(const tFoundMatchesPack& foundMatchesPack) = 0;
+    /**
+     * @brief evictMatches - evicts the oldest found matches, which do not fit into the retention limits
+     * @param maxMatches - maximum number of retained matches. 0 means no limit
+     * @param maxSeconds - maximum age of the retained matches in seconds. 0 means no limit
+     * @return - evicted matches, which should be removed from the dependent models
+     */
+    virtual tFoundMatchesPack evictMatches(const int& maxMatches, const int& maxSeconds) = 0;
     virtual int getFileIdx( const QModelIndex& idx ) const = 0;
     virtual int getRowByMsgId( const tMsgId& id ) const = 0;
-    virtual void setHighlightedRows( const tMsgIdSet& msgs ) = 0;
-    virtual const tMsgIdSet& getHighlightedRows() const = 0;
+    virtual void setHighlightedRows( const tMsgIdBitmap& msgs ) = 0;
+    virtual const tMsgIdBitmap& getHighlightedRows() const = 0;
     virtual const tFoundMatchesPackItem& getFoundMatchesItemPack( const QModelIndex& modelIndex ) const = 0;
 
     enum eGanttDataItemType
@@ -102,4 +115,9 @@ public:
     };
 
     virtual tPlotContent createPlotContent() const = 0;
+
+signals:
+    void UMLDiagramPageReady(int pageIndex, const QString& diagramContent);
+    void UMLDiagramContentGenerationFinished(int numberOfPages, int numberOfRows);
+    void UMLDiagramContentGenerationCancelled();
 };
@@ -468,7 +468,7 @@ void CSearchResultHighlightingDelegate::paint(QPainter *painter,
         const auto& matchData = pModel->getFoundMatchesItemPack(index);
         const auto& msgId = matchData.getItemMetadata().msgId;
 
-        if(customHighlightingRows.find(msgId) != customHighlightingRows.end())
+        if(msgId >= 0 && true == customHighlightingRows.contains(static_cast<tMsgIdBitmap::tValue>(msgId)))
         {
             bCustomBackgroundHighlighting = true;
         }
@@ -4,7 +4,10 @@
  * @brief   Implementation of the CSearchResultModel class
  */
 
+#include <algorithm>
+
 #include <QDateTime>
+#include <QElapsedTimer>
 
 #include "CSearchResultModel.hpp"
 #include "components/log/api/CLog.hpp"
@@ -17,9 +20,19 @@
 CSearchResultModel::CSearchResultModel(const tSettingsManagerPtr& pSettingsManager, QObject *):
 CSettingsManagerClient(pSettingsManager),
 mFoundMatchesPack(),
+mAddedPortions(),
 mpFile(nullptr),
-mHighlightMessages()
+mHighlightMessages(),
+mUMLDiagramGenerationState(),
+mUMLDiagramGenerationTimer()
 {
+    mUMLDiagramGenerationTimer.setSingleShot(false);
+    mUMLDiagramGenerationTimer.setInterval(0);
+
+    connect(&mUMLDiagramGenerationTimer, &QTimer::timeout, this, [this]()
+    {
+        processUMLDiagramContentChunk();
+    });
 }
 
 void CSearchResultModel::setFile(const tFileWrapperPtr& pFile)
@@ -35,8 +48,12 @@ void CSearchResultModel::updateView(const int& fromRow)
 
 void CSearchResultModel::resetData()
 {
+    // row indexes of the ongoing diagram generation would become invalid
+    cancelUMLDiagramContentGeneration();
+
     beginResetModel();
-    tFoundMatchesPackItemVec().swap(mFoundMatchesPack.matchedItemVec);
+    tFoundMatchesPackItemContainer().swap(mFoundMatchesPack.matchedItemVec);
+    tAddedPortions().swap(mAddedPortions);
     mHighlightMessages.clear();
     endResetModel();
     updateView();
@@ -235,17 +252,57 @@ std::pair<bool, tIntRange> CSearchResultModel::addNextMessageIdxVec(const tFound
 
     if(false == foundMatchesPack.matchedItemVec.empty())
     {
-        beginInsertRows(QModelIndex(), static_cast<int>(mFoundMatchesPack.matchedItemVec.size()),
-                        static_cast<int>(mFoundMatchesPack.matchedItemVec.size() + foundMatchesPack.matchedItemVec.size() - 1));
-        result.second.from = static_cast<int>(mFoundMatchesPack.matchedItemVec.size());
-        mFoundMatchesPack.matchedItemVec.insert(mFoundMatchesPack.matchedItemVec.end(),
-                                                foundMatchesPack.matchedItemVec.begin(),
-                                                foundMatchesPack.matchedItemVec.end());
-        result.second.to = static_cast<int>(mFoundMatchesPack.matchedItemVec.size() - 1);
+        auto& matchedItemVec = mFoundMatchesPack.matchedItemVec;
+
+        auto getMsgIdxInMainTable = [](const tFoundMatchesPackItemPtr& pItem)
+        {
+            return nullptr != pItem ? pItem->getItemMetadata().msgIdxInMainTable : INVALID_MSG_ID;
+        };
+
+        const auto firstAddedMsgIdx = getMsgIdxInMainTable(foundMatchesPack.matchedItemVec.front());
+        auto insertIt = matchedItemVec.end();
+
+        // portions of the analysis, which starts from the focus message, arrive out of order.
+        // Each of them covers a separate range of messages, thus it is inserted as a whole
+        if(false == matchedItemVec.empty() && getMsgIdxInMainTable(matchedItemVec.back()) > firstAddedMsgIdx)
+        {
+            insertIt = std::upper_bound(matchedItemVec.begin(), matchedItemVec.end(), firstAddedMsgIdx,
+                                        [&getMsgIdxInMainTable](const tMsgId& msgIdx, const tFoundMatchesPackItemPtr& pItem)
+            {
+                return msgIdx < getMsgIdxInMainTable(pItem);
+            });
+
+            // row indexes of the ongoing diagram generation would become invalid. The view is notified
+            cancelUMLDiagramContentGeneration();
+        }
+
+        const int insertRow = static_cast<int>(std::distance(matchedItemVec.begin(), insertIt));
+        const bool bAppended = matchedItemVec.end() == insertIt;
+
+        beginInsertRows(QModelIndex(), insertRow,
+                        static_cast<int>(insertRow + foundMatchesPack.matchedItemVec.size() - 1));
+        result.second.from = insertRow;
+        matchedItemVec.insert(insertIt,
+                              foundMatchesPack.matchedItemVec.begin(),
+                              foundMatchesPack.matchedItemVec.end());
+        result.second.to = static_cast<int>(insertRow + foundMatchesPack.matchedItemVec.size() - 1);
+
+        addRowsToPortions(static_cast<std::size_t>(insertRow),
+                          foundMatchesPack.matchedItemVec.size(),
+                          QDateTime::currentMSecsSinceEpoch());
 
         endInsertRows();
 
-        updateView(result.second.from);
+        if(true == bAppended)
+        {
+            updateView(result.second.from);
+        }
+        else
+        {
+            // only the inserted rows are changed. The view shifts its measured rows on the insertion
+            emit dataChanged( index(result.second.from, 0), index(result.second.to, columnCount(QModelIndex()) - 1) );
+            emit layoutChanged();
+        }
 
         result.first = true;
     }
@@ -253,6 +310,118 @@ std::pair<bool, tIntRange> CSearchResultModel::addNextMessageIdxVec(const tFound
     return result;
 }
 
+void CSearchResultModel::addRowsToPortions(const std::size_t& insertRow,
+                                           const std::size_t& numberOfRows,
+                                           const qint64& arrivalTimeMs)
+{
+    // portions cover the consecutive ranges of rows, starting from the first one, thus the eviction
+    // always removes the leading rows. Rows, inserted in the middle, are merged into the portion,
+    // which covers the insertion point. Its arrival time is refreshed, so that the new rows are not evicted
+    // before their time. Appended rows form a new portion.
+    std::size_t portionEndRow = 0u;
+
+    for(auto& addedPortion : mAddedPortions)
+    {
+        portionEndRow += addedPortion.numberOfRows;
+
+        if(insertRow < portionEndRow)
+        {
+            addedPortion.numberOfRows += numberOfRows;
+            addedPortion.arrivalTimeMs = std::max(addedPortion.arrivalTimeMs, arrivalTimeMs);
+            return;
+        }
+    }
+
+    tAddedPortion addedPortion;
+    addedPortion.arrivalTimeMs = arrivalTimeMs;
+    addedPortion.numberOfRows = numberOfRows;
+    mAddedPortions.push_back(addedPortion);
+}
+
+tFoundMatchesPack CSearchResultModel::evictMatches(const int& maxMatches, const int& maxSeconds)
+{
+    tFoundMatchesPack result;
+
+    auto& matchedItemVec = mFoundMatchesPack.matchedItemVec;
+    std::size_t numberOfEvictedRows = 0u;
+
+    if(maxSeconds > 0)
+    {
+        // arrival time is used instead of the dlt timestamps, as the timestamps of the different ECU-s
+        // are not comparable with each other and are reset on each restart of the ECU
+        const qint64 oldestAllowedArrivalTimeMs = QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(maxSeconds) * 1000;
+
+        for(const auto& addedPortion : mAddedPortions)
+        {
+            if(addedPortion.arrivalTimeMs >= oldestAllowedArrivalTimeMs)
+            {
+                break;
+            }
+
+            numberOfEvictedRows += addedPortion.numberOfRows;
+        }
+    }
+
+    if(maxMatches > 0 && matchedItemVec.size() > static_cast<std::size_t>(maxMatches))
+    {
+        numberOfEvictedRows = std::max(numberOfEvictedRows, matchedItemVec.size() - static_cast<std::size_t>(maxMatches));
+    }
+
+    numberOfEvictedRows = std::min(numberOfEvictedRows, matchedItemVec.size());
+
+    if(numberOfEvictedRows > 0u)
+    {
+        {
+            auto rowsToEvict = numberOfEvictedRows;
+
+            while(rowsToEvict > 0u && false == mAddedPortions.empty())
+            {
+                auto& addedPortion = mAddedPortions.front();
+
+                if(addedPortion.numberOfRows <= rowsToEvict)
+                {
+                    rowsToEvict -= addedPortion.numberOfRows;
+                    mAddedPortions.pop_front();
+                }
+                else
+                {
+                    addedPortion.numberOfRows -= rowsToEvict;
+                    rowsToEvict = 0u;
+                }
+            }
+        }
+
+        // ongoing generation of the diagram continues from the same message
+        if(true == mUMLDiagramGenerationState.bInProgress)
+        {
+            mUMLDiagramGenerationState.nextRow =
+                std::max(0, mUMLDiagramGenerationState.nextRow - static_cast<int>(numberOfEvictedRows));
+        }
+
+        const auto evictedEndIt = matchedItemVec.begin() + static_cast<std::ptrdiff_t>(numberOfEvictedRows);
+
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(numberOfEvictedRows) - 1);
+
+        result.matchedItemVec.assign(matchedItemVec.begin(), evictedEndIt);
+        matchedItemVec.erase(matchedItemVec.begin(), evictedEndIt);
+
+        endRemoveRows();
+
+        if(false == mHighlightMessages.empty())
+        {
+            for(const auto& pEvictedItem : result.matchedItemVec)
+            {
+                if(nullptr != pEvictedItem)
+                {
+                    mHighlightMessages.remove(static_cast<tMsgIdBitmap::tValue>(pEvictedItem->getItemMetadata().msgId));
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 int CSearchResultModel::getFileIdx( const QModelIndex& idx ) const
 {
     int result = -1;
@@ -293,310 +462,447 @@ QString CSearchResultModel::getStrValue(const int& row, const eSearchResultColum
     return result;
 }
 
-std::pair<int /*rowNumber*/, QString /*diagramContent*/> CSearchResultModel::getUMLDiagramContent() const
+QString CSearchResultModel::getUMLDiagramHeader(const int& autonumberStart) const
 {
-    std::pair<int, QString> result;
-
-    int& numberOfRows = result.first;
-    QString& outputString = result.second;
+    QString result;
 
-    outputString.append("@startuml\n");
+    result.append("@startuml\n");
 
     if(true == getSettingsManager()->getUML_Autonumber())
     {
-        outputString.append("autonumber\n");
+        // continue the numbering of the previous pages
+        result.append(QString("autonumber %1\n").arg(autonumberStart));
     }
 
-    outputString.append("skinparam backgroundColor white\n");
+    result.append("skinparam backgroundColor white\n");
 
 #ifdef __linux__
-    outputString.append("skinparam defaultFontName Ubuntu Mono\n");
+    result.append("skinparam defaultFontName Ubuntu Mono\n");
 #elif _WIN32
-    outputString.append("skinparam defaultFontName monospaced\n");
+    result.append("skinparam defaultFontName monospaced\n");
 #else
-    outputString.append("skinparam defaultFontName monospaced\n");
+    result.append("skinparam defaultFontName monospaced\n");
 #endif
 
-    //let's represent whether UML data is properly filled in
-    int row = 0;
+    return result;
+}
+
+bool CSearchResultModel::appendUMLDiagramRow(const int& row, QString& outputString) const
+{
+    bool bResult = false;
 
-    for(const auto& foundMatchPack : mFoundMatchesPack.matchedItemVec)
+    if(row < 0 || row >= static_cast<int>(mFoundMatchesPack.matchedItemVec.size()))
     {
-        if(nullptr != foundMatchPack)
+        return bResult;
+    }
+
+    const auto& foundMatchPack = mFoundMatchesPack.matchedItemVec[static_cast<std::size_t>(row)];
+
+    if(nullptr != foundMatchPack)
+    {
+        const auto& itemMetadata = foundMatchPack->getItemMetadata();
+
+        // message is fetched only once per row, and only for the rows, which are part of the diagram
+        tMsgWrapperPtr pMsg;
+
+        auto getRowStrValue = [this, &itemMetadata, &pMsg](const eSearchResultColumn& column)->QString
         {
-            QString subStr;
+            QString result;
 
-            const auto& itemMetadata = foundMatchPack->getItemMetadata();
+            if(nullptr == pMsg)
+            {
+                pMsg = mpFile->getMsg(itemMetadata.msgId);
+            }
+
+            auto pStrValue = getDataStrFromMsg(itemMetadata.msgId, pMsg, column);
 
-            if(nullptr != itemMetadata.pUMLInfo && true == itemMetadata.pUMLInfo->bUMLConstraintsFulfilled
-               && true == itemMetadata.pUMLInfo->bApplyForUMLCreation)
+            if(nullptr != pStrValue)
             {
-                // Result string - <UCL> <URT|URS|UE> <US> : [timestamp] <USID><UM>(<UA>)
+                result = std::move(*pStrValue);
+            }
 
-                tIntRange insertMethodFormattingRange;
-                tIntRange insertMethodFormattingOffset;
+            return result;
+        };
 
-                auto getUMLItemRepresentation = [this, &itemMetadata, &row](const eUML_ID& UML_ID)->std::pair<bool, QString>
-                {
-                    std::pair<bool, QString> UMLRepresentationResult;
-                    UMLRepresentationResult.first = false;
+        QString subStr;
 
-                    auto foundUMLDataItem = itemMetadata.pUMLInfo->UMLDataMap.find(UML_ID);
+        if(nullptr != itemMetadata.pUMLInfo && true == itemMetadata.pUMLInfo->bUMLConstraintsFulfilled
+           && true == itemMetadata.pUMLInfo->bApplyForUMLCreation)
+        {
+            // Result string - <UCL> <URT|URS|UE> <US> : [timestamp] <USID><UM>(<UA>)
+
+            tIntRange insertMethodFormattingRange;
+            tIntRange insertMethodFormattingOffset;
+
+            auto getUMLItemRepresentation = [&itemMetadata, &getRowStrValue](const eUML_ID& UML_ID)->std::pair<bool, QString>
+            {
+                std::pair<bool, QString> UMLRepresentationResult;
+                UMLRepresentationResult.first = false;
 
-                    if(foundUMLDataItem != itemMetadata.pUMLInfo->UMLDataMap.end())
+                auto foundUMLDataItem = itemMetadata.pUMLInfo->UMLDataMap.find(UML_ID);
+
+                if(foundUMLDataItem != itemMetadata.pUMLInfo->UMLDataMap.end())
+                {
+                    for(const auto& item : foundUMLDataItem->second)
                     {
-                        for(const auto& item : foundUMLDataItem->second)
+                        if(item.pUML_Custom_Value == nullptr ||
+                           true == item.pUML_Custom_Value->isEmpty()) // if there is no client-defined value
                         {
-                            if(item.pUML_Custom_Value == nullptr ||
-                               true == item.pUML_Custom_Value->isEmpty()) // if there is no client-defined value
+                            // let's use value from the corresponding group
+                            for(const auto& stringCoverageMapItem : item.stringCoverageMap)
                             {
-                                // let's use value from the corresponding group
-                                for(const auto& stringCoverageMapItem : item.stringCoverageMap)
-                                {
-                                    auto column = stringCoverageMapItem.first;
+                                auto column = stringCoverageMapItem.first;
 
-                                    QString message = getStrValue(row, column);
+                                QString message = getRowStrValue(column);
 
-                                    auto messageSize = message.size();
-                                    const auto& range = stringCoverageMapItem.second.range;
+                                auto messageSize = message.size();
+                                const auto& range = stringCoverageMapItem.second.range;
 
-                                    if(range.from >= 0 && range.from < messageSize &&
-                                       range.to >= 0 && range.to < messageSize )
+                                if(range.from >= 0 && range.from < messageSize &&
+                                   range.to >= 0 && range.to < messageSize )
+                                {
+                                    switch(UML_ID)
                                     {
-                                        switch(UML_ID)
+                                        case eUML_ID::UML_REQUEST:
+                                            UMLRepresentationResult.second.append("->");
+                                            break;
+                                        case eUML_ID::UML_RESPONSE:
+                                        case eUML_ID::UML_EVENT:
+                                            UMLRepresentationResult.second.append("<-");
+                                            break;
+                                        case eUML_ID::UML_ARGUMENTS:
                                         {
-                                            case eUML_ID::UML_REQUEST:
-                                                UMLRepresentationResult.second.append("->");
-                                                break;
-                                            case eUML_ID::UML_RESPONSE:
-                                            case eUML_ID::UML_EVENT:
-                                                UMLRepresentationResult.second.append("<-");
-                                                break;
-                                            case eUML_ID::UML_ARGUMENTS:
+                                            int numberOfCharacters = range.to - range.from + 1;
+                                            QString argString = message.mid(range.from, numberOfCharacters);
+                                            argString.replace("[[", "[ [");
+                                            argString.replace("]]", "] ]");
+                                            UMLRepresentationResult.second.append(argString);
+
+                                            if(true == stringCoverageMapItem.second.bAddSeparator)
                                             {
-                                                int numberOfCharacters = range.to - range.from + 1;
-                                                QString argString = message.mid(range.from, numberOfCharacters);
-                                                argString.replace("[[", "[ [");
-                                                argString.replace("]]", "] ]");
-                                                UMLRepresentationResult.second.append(argString);
-
-                                                if(true == stringCoverageMapItem.second.bAddSeparator)
-                                                {
-                                                    UMLRepresentationResult.second.append(" ");
-                                                }
+                                                UMLRepresentationResult.second.append(" ");
                                             }
-                                                break;
-                                            case eUML_ID::UML_CLIENT:
-                                            case eUML_ID::UML_SERVICE:
+                                        }
+                                            break;
+                                        case eUML_ID::UML_CLIENT:
+                                        case eUML_ID::UML_SERVICE:
+                                        {
+                                            QString str;
+                                            str.append("\"");
+                                            str.append(message.mid(range.from, range.to - range.from + 1));
+
+                                            if(true == stringCoverageMapItem.second.bAddSeparator)
                                             {
-                                                QString str;
-                                                str.append("\"");
-                                                str.append(message.mid(range.from, range.to - range.from + 1));
+                                                str.append(" ");
+                                            }
 
-                                                if(true == stringCoverageMapItem.second.bAddSeparator)
-                                                {
-                                                    str.append(" ");
-                                                }
+                                            str.append("\"");
 
-                                                str.append("\"");
+                                            UMLRepresentationResult.second.append(str);
+                                        }
+                                            break;
+                                        case eUML_ID::UML_TIMESTAMP:
+                                        {
+                                            QString str;
+                                            str.append("[");
+                                            str.append( message.mid(range.from, range.to - range.from + 1) );
+                                            str.append("] ");
 
-                                                UMLRepresentationResult.second.append(str);
-                                            }
-                                                break;
-                                            case eUML_ID::UML_TIMESTAMP:
-                                            {
-                                                QString str;
-                                                str.append("[");
-                                                str.append( message.mid(range.from, range.to - range.from + 1) );
-                                                str.append("] ");
+                                            UMLRepresentationResult.second.append(str);
+                                        }
+                                        break;
+                                        default:
+                                        {
+                                            UMLRepresentationResult.second.append(message.mid(range.from, range.to - range.from + 1));
 
-                                                UMLRepresentationResult.second.append(str);
-                                            }
-                                            break;
-                                            default:
+                                            if(true == stringCoverageMapItem.second.bAddSeparator)
                                             {
-                                                UMLRepresentationResult.second.append(message.mid(range.from, range.to - range.from + 1));
-
-                                                if(true == stringCoverageMapItem.second.bAddSeparator)
-                                                {
-                                                    UMLRepresentationResult.second.append(" ");
-                                                }
+                                                UMLRepresentationResult.second.append(" ");
                                             }
-                                                break;
                                         }
+                                            break;
                                     }
-
-                                    UMLRepresentationResult.first = true;
                                 }
+
+                                UMLRepresentationResult.first = true;
                             }
-                            else // otherwise
+                        }
+                        else // otherwise
+                        {
+                            switch(UML_ID)
                             {
-                                switch(UML_ID)
+                                case eUML_ID::UML_CLIENT:
+                                case eUML_ID::UML_SERVICE:
                                 {
-                                    case eUML_ID::UML_CLIENT:
-                                    case eUML_ID::UML_SERVICE:
-                                    {
-                                        QString str;
-                                        str.reserve(item.pUML_Custom_Value->size() + 2);
-                                        str.append("\"");
-                                        str.append(*item.pUML_Custom_Value);
-                                        str.append("\"");
-
-                                        // let's directly use client-defined value, ignoring value from the group
-                                        UMLRepresentationResult.second.append(str);
-                                    }
-                                        break;
-                                    case eUML_ID::UML_TIMESTAMP:
-                                    {
-                                        const auto column = eSearchResultColumn::Timestamp;
-                                        QString timestampVal = getStrValue(row, column);
-                                        QString str;
-                                        str.reserve(timestampVal.size() + 3);
-                                        str.append("[");
-                                        str.append( timestampVal );
-                                        str.append("] ");
-
-                                        // let's use dlt's native timestamp
-                                        UMLRepresentationResult.second.append(str);
-                                    }
-                                        break;
-                                    default:
-                                    {
-                                        // let's directly use client-defined value, ignoring value from the group
-                                        UMLRepresentationResult.second.append(*item.pUML_Custom_Value);
-                                    }
-                                        break;
+                                    QString str;
+                                    str.reserve(item.pUML_Custom_Value->size() + 2);
+                                    str.append("\"");
+                                    str.append(*item.pUML_Custom_Value);
+                                    str.append("\"");
+
+                                    // let's directly use client-defined value, ignoring value from the group
+                                    UMLRepresentationResult.second.append(str);
                                 }
-
-                                UMLRepresentationResult.first = true;
+                                    break;
+                                case eUML_ID::UML_TIMESTAMP:
+                                {
+                                    const auto column = eSearchResultColumn::Timestamp;
+                                    QString timestampVal = getRowStrValue(column);
+                                    QString str;
+                                    str.reserve(timestampVal.size() + 3);
+                                    str.append("[");
+                                    str.append( timestampVal );
+                                    str.append("] ");
+
+                                    // let's use dlt's native timestamp
+                                    UMLRepresentationResult.second.append(str);
+                                }
+                                    break;
+                                default:
+                                {
+                                    // let's directly use client-defined value, ignoring value from the group
+                                    UMLRepresentationResult.second.append(*item.pUML_Custom_Value);
+                                }
+                                    break;
                             }
+
+                            UMLRepresentationResult.first = true;
                         }
                     }
-                    else
+                }
+                else
+                {
+                    if(UML_ID == eUML_ID::UML_TIMESTAMP)
                     {
-                        if(UML_ID == eUML_ID::UML_TIMESTAMP)
-                        {
-                            const auto column = eSearchResultColumn::Timestamp;
-                            QString timestampVal = getStrValue(row, column);
-                            QString str;
-                            str.reserve(timestampVal.size() + 3);
-                            str.append("[");
-                            str.append( timestampVal );
-                            str.append("] ");
-
-                            // let's use dlt's native timestamp
-                            UMLRepresentationResult.second.append(str);
-                            UMLRepresentationResult.first = true;
-                        }
+                        const auto column = eSearchResultColumn::Timestamp;
+                        QString timestampVal = getRowStrValue(column);
+                        QString str;
+                        str.reserve(timestampVal.size() + 3);
+                        str.append("[");
+                        str.append( timestampVal );
+                        str.append("] ");
+
+                        // let's use dlt's native timestamp
+                        UMLRepresentationResult.second.append(str);
+                        UMLRepresentationResult.first = true;
                     }
+                }
 
-                    return UMLRepresentationResult;
-                };
+                return UMLRepresentationResult;
+            };
 
-                auto appendUMLData = [&getUMLItemRepresentation, &subStr](const eUML_ID& UML_ID)
-                {
-                    auto umlRepresentationResult = getUMLItemRepresentation(UML_ID);
+            auto appendUMLData = [&getUMLItemRepresentation, &subStr](const eUML_ID& UML_ID)
+            {
+                auto umlRepresentationResult = getUMLItemRepresentation(UML_ID);
 
-                    if(true == umlRepresentationResult.first)
-                    {
-                        subStr.append(umlRepresentationResult.second);
-                    }
-                    else
-                    {
-                        //SEND_ERR(QString("Was not able to find \"%1\" field!").arg(getUMLIDAsString(UML_ID)));
-                    }
-                };
-
-                appendUMLData(eUML_ID::UML_CLIENT);
-                subStr.append(" ");
-                appendUMLData(eUML_ID::UML_REQUEST);
-                appendUMLData(eUML_ID::UML_RESPONSE);
-                appendUMLData(eUML_ID::UML_EVENT);
-                subStr.append(" ");
-                appendUMLData(eUML_ID::UML_SERVICE);
-                subStr.append(" : ");
-                int wrappingStartingPoint = subStr.size();
-                appendUMLData(eUML_ID::UML_TIMESTAMP);
-                appendUMLData(eUML_ID::UML_SEQUENCE_ID);
-                subStr.append(" ");
-                insertMethodFormattingRange.from = subStr.size();
-                appendUMLData(eUML_ID::UML_METHOD);
-                insertMethodFormattingRange.to = subStr.size();
-                subStr.append("(");
-
-                if(true == getSettingsManager()->getUML_ShowArguments())
+                if(true == umlRepresentationResult.first)
                 {
-                    appendUMLData(eUML_ID::UML_ARGUMENTS);
+                    subStr.append(umlRepresentationResult.second);
                 }
                 else
                 {
-                    subStr.append(" ... ");
+                    //SEND_ERR(QString("Was not able to find \"%1\" field!").arg(getUMLIDAsString(UML_ID)));
                 }
+            };
+
+            appendUMLData(eUML_ID::UML_CLIENT);
+            subStr.append(" ");
+            appendUMLData(eUML_ID::UML_REQUEST);
+            appendUMLData(eUML_ID::UML_RESPONSE);
+            appendUMLData(eUML_ID::UML_EVENT);
+            subStr.append(" ");
+            appendUMLData(eUML_ID::UML_SERVICE);
+            subStr.append(" : ");
+            int wrappingStartingPoint = subStr.size();
+            appendUMLData(eUML_ID::UML_TIMESTAMP);
+            appendUMLData(eUML_ID::UML_SEQUENCE_ID);
+            subStr.append(" ");
+            insertMethodFormattingRange.from = subStr.size();
+            appendUMLData(eUML_ID::UML_METHOD);
+            insertMethodFormattingRange.to = subStr.size();
+            subStr.append("(");
+
+            if(true == getSettingsManager()->getUML_ShowArguments())
+            {
+                appendUMLData(eUML_ID::UML_ARGUMENTS);
+            }
+            else
+            {
+                subStr.append(" ... ");
+            }
 
-                subStr.append(")");
+            subStr.append(")");
 
-                subStr.append("\n");
+            subStr.append("\n");
 
-                // wrapping logic
+            // wrapping logic
+            {
+                if(true == getSettingsManager()->getUML_WrapOutput())
                 {
-                    if(true == getSettingsManager()->getUML_WrapOutput())
-                    {
-                        const int insertNewLineRange = 100;
+                    const int insertNewLineRange = 100;
 
-                        if(subStr.size() > insertNewLineRange)
-                        {
-                            const QString insertStr = "\\n";
+                    if(subStr.size() > insertNewLineRange)
+                    {
+                        const QString insertStr = "\\n";
 
-                            subStr.reserve(subStr.size() + ( insertStr.size() * ( (subStr.size() / insertNewLineRange) + 1 ) ) );
+                        subStr.reserve(subStr.size() + ( insertStr.size() * ( (subStr.size() / insertNewLineRange) + 1 ) ) );
 
-                            int currentIndex = wrappingStartingPoint + insertNewLineRange;
-                            int currentOffset = 0;
+                        int currentIndex = wrappingStartingPoint + insertNewLineRange;
+                        int currentOffset = 0;
 
-                            while( (currentIndex + currentOffset) < subStr.size())
+                        while( (currentIndex + currentOffset) < subStr.size())
+                        {
+                            if(currentIndex + currentOffset < insertMethodFormattingRange.from)
                             {
-                                if(currentIndex + currentOffset < insertMethodFormattingRange.from)
-                                {
-                                    insertMethodFormattingOffset.from += insertStr.size();
-                                }
-
-                                if(currentIndex + currentOffset < insertMethodFormattingRange.to)
-                                {
-                                    insertMethodFormattingOffset.to += insertStr.size();
-                                }
+                                insertMethodFormattingOffset.from += insertStr.size();
+                            }
 
-                                subStr.insert( currentIndex + currentOffset, insertStr );
-                                currentIndex += insertNewLineRange;
-                                currentOffset += insertStr.size();
+                            if(currentIndex + currentOffset < insertMethodFormattingRange.to)
+                            {
+                                insertMethodFormattingOffset.to += insertStr.size();
                             }
+
+                            subStr.insert( currentIndex + currentOffset, insertStr );
+                            currentIndex += insertNewLineRange;
+                            currentOffset += insertStr.size();
                         }
                     }
                 }
+            }
+
+            subStr.insert(insertMethodFormattingRange.from + insertMethodFormattingOffset.from, "__**");
+            subStr.insert(insertMethodFormattingRange.to + insertMethodFormattingOffset.to + 4, "**__");
+
+            outputString.append(subStr);
+            bResult = true;
+        }
+    }
+
+    return bResult;
+}
+
+void CSearchResultModel::startUMLDiagramContentGeneration(const int& rowsPerPage)
+{
+    // client has already switched to the new generation, thus the previous one is dropped silently
+    resetUMLDiagramGenerationState();
+
+    mUMLDiagramGenerationState.bInProgress = true;
+    mUMLDiagramGenerationState.rowsPerPage = rowsPerPage;
+    mUMLDiagramGenerationState.pageContent = getUMLDiagramHeader(1);
+
+    mUMLDiagramGenerationTimer.start();
+}
+
+void CSearchResultModel::cancelUMLDiagramContentGeneration()
+{
+    if(true == mUMLDiagramGenerationState.bInProgress)
+    {
+        resetUMLDiagramGenerationState();
+        emit UMLDiagramContentGenerationCancelled();
+    }
+}
+
+void CSearchResultModel::resetUMLDiagramGenerationState()
+{
+    mUMLDiagramGenerationTimer.stop();
+    mUMLDiagramGenerationState = tUMLDiagramGenerationState();
+}
+
+bool CSearchResultModel::isUMLDiagramContentGenerationInProgress() const
+{
+    return mUMLDiagramGenerationState.bInProgress;
+}
+
+void CSearchResultModel::finishUMLDiagramPage()
+{
+    auto& state = mUMLDiagramGenerationState;
+
+    state.pageContent.append("@enduml");
+
+    QString pageContent;
+    pageContent.swap(state.pageContent);
+
+    const int pageIndex = state.pageIndex;
+
+    ++state.pageIndex;
+    state.numberOfRowsInPage = 0;
+    state.pageContent = getUMLDiagramHeader(state.numberOfRows + 1);
+
+    emit UMLDiagramPageReady(pageIndex, pageContent);
+}
+
+void CSearchResultModel::processUMLDiagramContentChunk()
+{
+    // messages are fetched from the dlt file, which is accessible only from the main thread.
+    // Thus, the work is split into portions, which are limited in time, to keep the UI responsive.
+    static const qint64 sChunkTimeBudgetMs = 20;
+
+    if(false == mUMLDiagramGenerationState.bInProgress)
+    {
+        mUMLDiagramGenerationTimer.stop();
+        return;
+    }
+
+    auto& state = mUMLDiagramGenerationState;
+
+    const auto& maxRowsNumber = getSettingsManager()->getUML_MaxNumberOfRowsInDiagram();
+    const int rowsSize = static_cast<int>(mFoundMatchesPack.matchedItemVec.size());
+
+    QElapsedTimer chunkTimer;
+    chunkTimer.start();
 
-                subStr.insert(insertMethodFormattingRange.from + insertMethodFormattingOffset.from, "__**");
-                subStr.insert(insertMethodFormattingRange.to + insertMethodFormattingOffset.to + 4, "**__");
+    bool bLimitReached = false;
 
-                outputString.append(subStr);
+    while(state.nextRow < rowsSize && chunkTimer.elapsed() < sChunkTimeBudgetMs)
+    {
+        if(true == appendUMLDiagramRow(state.nextRow, state.pageContent))
+        {
+            ++state.numberOfRowsInPage;
+            ++state.numberOfRows;
 
-                ++numberOfRows;
+            // if we've reached the limit
+            if(state.numberOfRows >= maxRowsNumber)
+            {
+                // stop addition of new rows
+                SEND_WRN(QString("Not all UML content will be rendered. Number of rows in diagram was limited to %1 rows due to specified settings").arg(maxRowsNumber));
+                bLimitReached = true;
+                break;
+            }
 
-                const auto& maxRowsNumber = getSettingsManager()->getUML_MaxNumberOfRowsInDiagram();
+            if(state.rowsPerPage > 0 && state.numberOfRowsInPage >= state.rowsPerPage)
+            {
+                finishUMLDiagramPage();
 
-                // if we've reached the limit
-                if(numberOfRows >= maxRowsNumber)
+                // client might have cancelled the generation from the slot
+                if(false == state.bInProgress)
                 {
-                    // stop addition of new rows
-                    SEND_WRN(QString("Not all UML content will be rendered. Number of rows in diagram was limited to %1 rows due to specified settings").arg(maxRowsNumber));
-                    break;
+                    return;
                 }
             }
         }
 
-        ++row;
+        ++state.nextRow;
     }
 
-    outputString.append("@enduml");
+    if(true == bLimitReached || state.nextRow >= rowsSize)
+    {
+        if(state.numberOfRowsInPage > 0)
+        {
+            finishUMLDiagramPage();
 
-    return result;
+            if(false == state.bInProgress)
+            {
+                return;
+            }
+        }
+
+        const int numberOfPages = state.pageIndex;
+        const int numberOfRows = state.numberOfRows;
+
+        resetUMLDiagramGenerationState();
+
+        emit UMLDiagramContentGenerationFinished(numberOfPages, numberOfRows);
+    }
 }
 
 namespace detail
@@ -1677,13 +1983,13 @@ void CSearchResultModel::setPlotView_Applicability( const QModelIndex& index, bo
     }
 }
 
-void CSearchResultModel::setHighlightedRows(const tMsgIdSet& msgs)
+void CSearchResultModel::setHighlightedRows(const tMsgIdBitmap& msgs)
 {
     // SEND_ERR(QString("I need to highlight \"%1\" messages!").arg(msgs.size()));
     mHighlightMessages = msgs;
 }
 
-const tMsgIdSet& CSearchResultModel::getHighlightedRows() const
+const tMsgIdBitmap& CSearchResultModel::getHighlightedRows() const
 {
     return mHighlightMessages;
 }
@@ -10,6 +10,7 @@
 #include "QPair"
 #include "QModelIndex"
 #include "QWidget"
+#include "QTimer"
 
 #include "common/Definitions.hpp"
 
@@ -34,11 +35,14 @@ public:
     int getFileIdx( const QModelIndex& idx ) const override;
     int getRowByMsgId( const tMsgId& id ) const override;
     std::pair<bool, tIntRange> addNextMessageIdxVec(const tFoundMatchesPack& foundMatchesPack) override;
-    std::pair<int /*rowNumber*/, QString /*diagramContent*/> getUMLDiagramContent() const override;
+    tFoundMatchesPack evictMatches(const int& maxMatches, const int& maxSeconds) override;
+    void startUMLDiagramContentGeneration(const int& rowsPerPage) override;
+    void cancelUMLDiagramContentGeneration() override;
+    bool isUMLDiagramContentGenerationInProgress() const override;
     tPlotContent createPlotContent() const override;
-    void setHighlightedRows( const tMsgIdSet& msgs) override;
+    void setHighlightedRows( const tMsgIdBitmap& msgs) override;
     const tFoundMatchesPackItem& getFoundMatchesItemPack( const QModelIndex& modelIndex ) const override;
-    const tMsgIdSet& getHighlightedRows() const override;
+    const tMsgIdBitmap& getHighlightedRows() const override;
     // implementation of the ISearchResultModel ( END )
 
     int rowCount(const QModelIndex &parent) const override;
@@ -52,9 +56,69 @@ public:
 
     QString getStrValue(const int& row, const eSearchResultColumn& column) const;
 
+private:
+
+    QString getUMLDiagramHeader(const int& autonumberStart) const;
+
+    /**
+     * @brief appendUMLDiagramRow - appends the UML representation of the specified row to the output string.
+     * @param row - row to be represented
+     * @param outputString - string to append to
+     * @return - true, if row was added to the diagram. False otherwise.
+     */
+    bool appendUMLDiagramRow(const int& row, QString& outputString) const;
+
+    /**
+     * @brief processUMLDiagramContentChunk - processes the next portion of rows within the time budget
+     * and emits all pages, which were completed in scope of this portion.
+     */
+    void processUMLDiagramContentChunk();
+    void finishUMLDiagramPage();
+
+    /**
+     * @brief resetUMLDiagramGenerationState - stops the generation without notifying the client
+     */
+    void resetUMLDiagramGenerationState();
+
+    struct tUMLDiagramGenerationState
+    {
+        bool bInProgress = false;
+        int rowsPerPage = 0;
+        int nextRow = 0;
+        int pageIndex = 0;
+        int numberOfRowsInPage = 0;
+        int numberOfRows = 0;
+        QString pageContent;
+    };
+
+    /**
+     * @brief tAddedPortion - the portion of rows, which were added to the model at once.
+     * Used to evict the matches by their age, without storing the arrival time per each row.
+     */
+    struct tAddedPortion
+    {
+        qint64 arrivalTimeMs = 0;
+        std::size_t numberOfRows = 0u;
+    };
+
+    typedef std::deque<tAddedPortion> tAddedPortions;
+
+    /**
+     * @brief addRowsToPortions - accounts the added rows in the portions, which are used for the eviction by age
+     * @param insertRow - row, at which the rows were inserted
+     * @param numberOfRows - number of the inserted rows
+     * @param arrivalTimeMs - arrival time of the inserted rows
+     */
+    void addRowsToPortions(const std::size_t& insertRow,
+                           const std::size_t& numberOfRows,
+                           const qint64& arrivalTimeMs);
+
 private:
 
     tFoundMatchesPack mFoundMatchesPack;
+    tAddedPortions mAddedPortions;
     tFileWrapperPtr mpFile;
-    tMsgIdSet mHighlightMessages;
+    tMsgIdBitmap mHighlightMessages;
+    tUMLDiagramGenerationState mUMLDiagramGenerationState;
+    QTimer mUMLDiagramGenerationTimer;
 };
@@ -4,10 +4,13 @@
  * @brief   Implementation of the CSearchResultView class
  */
 
+#include <algorithm>
+
 #include "../api/CSearchResultView.hpp"
 
 #include "QHeaderView"
 #include "QScrollBar"
+#include "QStyle"
 #include "QApplication"
 #include "QClipboard"
 #include "QMimeData"
@@ -24,9 +27,17 @@
 #include <QFontDialog>
 #include <QTableWidget>
 #include <QActionGroup>
+#include <QProgressDialog>
+#include <QTemporaryFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QDir>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include "common/Definitions.hpp"
 #include "common/TOptional.hpp"
+#include "common/cpp_extensions.hpp"
 #include "CSearchResultHighlightingDelegate.hpp"
 #include "CSearchResultModel.hpp"
 #include "components/settings/api/ISettingsManager.hpp"
@@ -35,6 +46,40 @@
 
 #include "DMA_Plantuml.hpp"
 
+static const int NOT_FOUND_COLUMN_IDX = -1;
+// selections up to this number of rows are copied to the clipboard synchronously
+static const int sClipboardFastPathMaxRows = 10000;
+// bigger results of the background copy are offered to be saved to the file
+static const qint64 sMaxClipboardSize = 64 * 1024 * 1024;
+static const int sSelectionExportSliceMs = 30;
+static const int sSelectionExportProgressDelayMs = 500;
+
+static int getNumberOfRows( const tIntRangeList& rowRanges )
+{
+    int result = 0;
+
+    for(const auto& range : rowRanges)
+    {
+        result += range.to - range.from + 1;
+    }
+
+    return result;
+}
+
+struct CSearchResultView::tSelectionExport
+{
+    eSelectionExportTarget target = eSelectionExportTarget::eClipboard;
+    tCopyContext copyContext;
+    tIntRangeList rowRanges;
+    int rangeIdx = 0;
+    int currentRow = 0;
+    int numberOfRows = 0;
+    int numberOfExportedRows = 0;
+    qint64 exportedSize = 0;
+    std::unique_ptr<QFile> pFile;
+    QProgressDialog* pProgressDialog = nullptr;
+};
+
 CSearchResultView::CSearchResultView(QWidget *parent):
     tParent(parent),
     mbIsVerticalScrollBarVisible(false),
@@ -44,9 +89,14 @@ CSearchResultView::CSearchResultView(QWidget *parent):
     mSearchRange(),
     mpSpecificModel(nullptr),
     mContentSizeMap(),
+    mNumberOfMeasuredRows(0),
+    mFontMetrics(font()),
+    mBoldFontMetrics(font()),
+    mCellMargin(0),
     mpCoverageNoteProvider(nullptr),
     mpMainTabWidget(nullptr),
-    mpMainTableView(nullptr)
+    mpMainTableView(nullptr),
+    mpSelectionExport(nullptr)
 {
     connect(this, &QTableView::clicked, [this](const QModelIndex &index)
     {
@@ -72,12 +122,15 @@ CSearchResultView::CSearchResultView(QWidget *parent):
             }
         }
     });
+
+    updateFontMetrics();
 }
 
 void CSearchResultView::newSearchStarted(const QString& regex)
 {
     mUsedRegex = regex;
     mContentSizeMap.clear();
+    mNumberOfMeasuredRows = 0;
     mbIsViewFull = false;
     mbUserManuallyAdjustedLastVisibleColumnWidth = false;
 }
@@ -231,10 +284,42 @@ void CSearchResultView::setFile( const tFileWrapperPtr& pFile )
 void CSearchResultView::forceUpdateWidthAndResetContentMap()
 {
     mContentSizeMap.clear();
+    mNumberOfMeasuredRows = 0;
     mbUserManuallyAdjustedLastVisibleColumnWidth = false;
     updateWidth(true);
 }
 
+void CSearchResultView::updateFontMetrics()
+{
+    auto boldFont = font();
+    boldFont.setBold(true);
+
+    mFontMetrics = QFontMetrics(font());
+    mBoldFontMetrics = QFontMetrics(boldFont);
+
+    // the same margins are added by the QStyledItemDelegate::sizeHint
+    mCellMargin = 2 * ( style()->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, this) + 1 );
+}
+
+void CSearchResultView::resizeColumnByContent(const eSearchResultColumn& column)
+{
+    const auto columnIdx = static_cast<int>(column);
+    auto foundContentSize = mContentSizeMap.find(column);
+
+    // checkbox columns are not measured
+    if(foundContentSize == mContentSizeMap.end() ||
+       eSearchResultColumn::UML_Applicability == column ||
+       eSearchResultColumn::PlotView_Applicability == column)
+    {
+        resizeColumnToContents(columnIdx);
+    }
+    else
+    {
+        setColumnWidth(columnIdx, std::max(foundContentSize->second + mCellMargin,
+                                           horizontalHeader()->sectionSizeHint(columnIdx)));
+    }
+}
+
 eSearchResultColumn CSearchResultView::getLastVisibleColumn() const
 {
     eSearchResultColumn result = eSearchResultColumn::Last;
@@ -274,7 +359,7 @@ void CSearchResultView::updateWidth(bool force, tUpdateWidthSet updateWidthSet)
 
                 if(itemFound != updateWidthSet.end())
                 {
-                    resizeColumnToContents(i);
+                    resizeColumnByContent(static_cast<eSearchResultColumn>(i));
                 }
 
                 widthWithoutLastVisible += columnWidth(i);
@@ -310,7 +395,7 @@ void CSearchResultView::updateWidth(bool force, tUpdateWidthSet updateWidthSet)
 
             if(foundColumn != updateWidthSet.end())
             {
-                resizeColumnToContents(static_cast<int>(lastVisibleColumn));
+                resizeColumnByContent(lastVisibleColumn);
             }
         }
         break;
@@ -329,6 +414,8 @@ void CSearchResultView::dataChanged(const QModelIndex &topLeft, const QModelInde
 
     bool continueCheck = true;
 
+    // widths are adjusted to the streamed rows only until the view is full, so that the columns do not jump
+    // while the results keep arriving. Later rows are measured, once they are scrolled to or selected
     if(false == mbIsViewFull)
     {
         if(false == indexAt(rect().bottomLeft()).isValid())
@@ -387,37 +474,197 @@ void CSearchResultView::verticalScrollbarAction(int action)
     }
 }
 
-void CSearchResultView::updateWidthLogic(const int& rowFrom, const int& rowTo)
+void CSearchResultView::rowsInserted(const QModelIndex &parent, int start, int end)
 {
-    bool bShouldUpdateWidth = false;
+    tParent::rowsInserted(parent, start, end);
 
-    tUpdateWidthSet updateWidthSet;
+    // rows, inserted in the middle of the measured ones, are not measured yet.
+    // The border is moved to them, so that they are measured, once they are shown
+    if(start < mNumberOfMeasuredRows)
+    {
+        mNumberOfMeasuredRows = start;
+    }
+
+    if(nullptr != mpSelectionExport)
+    {
+        // inserted rows are not a part of the exported selection. Rows after them are shifted
+        const int numberOfInsertedRows = end - start + 1;
+
+        auto shiftRow = [&start, &numberOfInsertedRows](const int& row)
+        {
+            return row >= start ? row + numberOfInsertedRows : row;
+        };
+
+        auto& selectionExport = *mpSelectionExport;
+        tIntRangeList rowRanges;
+
+        for(int i = selectionExport.rangeIdx; i < selectionExport.rowRanges.size(); ++i)
+        {
+            const auto& range = selectionExport.rowRanges[i];
+
+            if(range.from < start && range.to >= start)
+            {
+                rowRanges.push_back(tIntRange(range.from, start - 1));
+                rowRanges.push_back(tIntRange(end + 1, shiftRow(range.to)));
+            }
+            else
+            {
+                rowRanges.push_back(tIntRange(shiftRow(range.from), shiftRow(range.to)));
+            }
+        }
+
+        selectionExport.rowRanges = rowRanges;
+        selectionExport.rangeIdx = 0;
+        selectionExport.currentRow = shiftRow(selectionExport.currentRow);
+    }
+}
+
+void CSearchResultView::rowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
+{
+    tParent::rowsAboutToBeRemoved(parent, start, end);
+
+    // max widths are kept. Only the border of the measured rows is shifted
+    if(start < mNumberOfMeasuredRows)
+    {
+        mNumberOfMeasuredRows -= std::min(end, mNumberOfMeasuredRows - 1) - start + 1;
+    }
+
+    if(nullptr != mpSelectionExport)
+    {
+        // rows, which are not exported yet, are shifted. Removed ones are skipped
+        const int numberOfRemovedRows = end - start + 1;
+
+        auto shiftFrom = [&start, &end, &numberOfRemovedRows](const int& row)
+        {
+            return row > end ? row - numberOfRemovedRows : ( row >= start ? start : row );
+        };
+
+        auto shiftTo = [&start, &end, &numberOfRemovedRows](const int& row)
+        {
+            return row > end ? row - numberOfRemovedRows : ( row >= start ? start - 1 : row );
+        };
+
+        auto& selectionExport = *mpSelectionExport;
+        tIntRangeList rowRanges;
+
+        for(int i = selectionExport.rangeIdx; i < selectionExport.rowRanges.size(); ++i)
+        {
+            const auto& range = selectionExport.rowRanges[i];
+            tIntRange shiftedRange(shiftFrom(range.from), shiftTo(range.to));
+
+            if(shiftedRange.from <= shiftedRange.to)
+            {
+                rowRanges.push_back(shiftedRange);
+            }
+        }
+
+        selectionExport.rowRanges = rowRanges;
+        selectionExport.rangeIdx = 0;
+        selectionExport.currentRow = shiftFrom(selectionExport.currentRow);
+
+        int numberOfRemainingRows = getNumberOfRows(rowRanges);
+
+        if(false == rowRanges.empty() && selectionExport.currentRow > rowRanges.front().from)
+        {
+            numberOfRemainingRows -= std::min(selectionExport.currentRow, rowRanges.front().to + 1) - rowRanges.front().from;
+        }
+
+        selectionExport.numberOfRows = selectionExport.numberOfExportedRows + numberOfRemainingRows;
+
+        if(nullptr != selectionExport.pProgressDialog)
+        {
+            selectionExport.pProgressDialog->setMaximum(selectionExport.numberOfRows);
+        }
+    }
+}
+
+void CSearchResultView::reset()
+{
+    tParent::reset();
+    mNumberOfMeasuredRows = 0;
+
+    // exported rows are gone together with the model data
+    finishSelectionExport(true);
+}
+
+void CSearchResultView::measureRows(const int& rowFrom, const int& rowTo, tUpdateWidthSet& updateWidthSet)
+{
+    const bool bBoldTimestamp = getSettingsManager()->getMarkTimeStampWithBold();
 
     for(int iColumn = 0; iColumn < static_cast<int>(eSearchResultColumn::Last); ++iColumn)
     {
-        if(false == isColumnHidden(iColumn))
+        auto searchColumn = static_cast<eSearchResultColumn>(iColumn);
+
+        if(true == isColumnHidden(iColumn) ||
+           eSearchResultColumn::UML_Applicability == searchColumn ||
+           eSearchResultColumn::PlotView_Applicability == searchColumn)
         {
-            for(int iRow = rowFrom; iRow <= rowTo; ++iRow)
+            continue;
+        }
+
+        auto& maxWidth = mContentSizeMap[searchColumn];
+
+        for(int iRow = rowFrom; iRow <= rowTo; ++iRow)
+        {
+            auto strValue = mpSpecificModel->getStrValue(iRow, searchColumn);
+
+            if(true == strValue.isEmpty())
             {
-                if(nullptr != mpSpecificModel)
-                {
-                    auto searchColumn = static_cast<eSearchResultColumn>(iColumn);
-                    auto strValue = mpSpecificModel->getStrValue(iRow, searchColumn);
+                continue;
+            }
 
-                    auto dataSize = strValue.size();
+            // highlighted parts are drawn with the bold font. Bold metrics give the upper bound for them
+            bool bBold = eSearchResultColumn::Timestamp == searchColumn && true == bBoldTimestamp;
 
-                    if(mContentSizeMap[searchColumn] < dataSize)
-                    {
-                        updateWidthSet.insert(searchColumn);
-                        mContentSizeMap[searchColumn] = dataSize;
-                        bShouldUpdateWidth = true;
-                    }
-                }
+            if(false == bBold)
+            {
+                const auto& highlightingInfo = mpSpecificModel->getFoundMatchesItemPack(mpSpecificModel->index(iRow, iColumn)).
+                                               getItemMetadata().highlightingInfoMultiColor;
+                bBold = highlightingInfo.end() != highlightingInfo.find(searchColumn);
+            }
+
+            const auto& fontMetrics = true == bBold ? mBoldFontMetrics : mFontMetrics;
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+            const auto dataWidth = fontMetrics.width(strValue);
+#else
+            const auto dataWidth = fontMetrics.horizontalAdvance(strValue);
+#endif
+
+            if(maxWidth < dataWidth)
+            {
+                updateWidthSet.insert(searchColumn);
+                maxWidth = dataWidth;
             }
         }
     }
+}
+
+void CSearchResultView::updateWidthLogic(const int& rowFrom, const int& rowTo)
+{
+    if(nullptr == mpSpecificModel || rowFrom > rowTo)
+    {
+        return;
+    }
+
+    int measureFrom = rowFrom;
+
+    // rows, which were measured on arrival, are not measured again
+    if(rowFrom <= mNumberOfMeasuredRows)
+    {
+        measureFrom = std::max(rowFrom, mNumberOfMeasuredRows);
+        mNumberOfMeasuredRows = std::max(mNumberOfMeasuredRows, rowTo + 1);
+    }
+
+    if(measureFrom > rowTo)
+    {
+        return;
+    }
+
+    tUpdateWidthSet updateWidthSet;
+    measureRows(measureFrom, rowTo, updateWidthSet);
 
-    if(true == bShouldUpdateWidth)
+    if(false == updateWidthSet.empty())
     {
         updateWidth(false, updateWidthSet);
     }
@@ -488,6 +735,7 @@ void CSearchResultView::setModel(QAbstractItemModel *model)
         //restore font from persistency
         const auto& usedFont = getSettingsManager()->getFont_SearchView();
         setFont(usedFont);
+        updateFontMetrics();
         verticalHeader->resizeSections(QHeaderView::Fixed);
         QFontMetrics fontMetrics( usedFont );
         verticalHeader->setDefaultSectionSize(fontMetrics.height());
@@ -581,26 +829,18 @@ QString CSearchResultView::getMainTableSelectionAsString() const
     return result;
 }
 
-QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyPayload ) const
+CSearchResultView::tCopyContext CSearchResultView::createCopyContext( bool copyAsHTML, bool copyOnlyPayload ) const
 {
-    QString result;
-
-    const QColor nonHighlightedColor(0,0,0);
+    tCopyContext result;
 
-    auto selectedRows = selectionModel()->selectedRows();
+    result.copyAsHTML = copyAsHTML;
+    result.bMarkTimeStampWithBold = getSettingsManager()->getMarkTimeStampWithBold();
+    result.bMonoColorHighlighting = getSettingsManager()->getSearchResultMonoColorHighlighting();
+    result.monoHighlightingColor = getSettingsManager()->getRegexMonoHighlightingColor();
 
-    QMap<int, QModelIndex> sortedSelectedRows;
-
-    for(const auto& index : selectedRows)
-    {
-        sortedSelectedRows.insert(index.row(), index);
-    }
-
-    const int NOT_FOUND_COLUMN_IDX = -1;
     int payloadColumnIdx = NOT_FOUND_COLUMN_IDX;
 
-    QVector<int> copyPasteColumns;
-    copyPasteColumns.reserve((static_cast<int>(eSearchResultColumn::Last)));
+    result.copyPasteColumns.reserve((static_cast<int>(eSearchResultColumn::Last)));
 
     {
         const auto& copyPasteColumnsMap = getSettingsManager()->getSearchResultColumnsCopyPasteMap();
@@ -612,7 +852,7 @@ QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyP
         {
             if(true == copyPaste)
             {
-                copyPasteColumns.push_back(columnsCounter);
+                result.copyPasteColumns.push_back(columnsCounter);
 
                 if(columnsCounter == static_cast<int>(eSearchResultColumn::Payload))
                 {
@@ -626,78 +866,128 @@ QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyP
         }
     }
 
-    typedef QPair<QString /*usual*/, QString /*rich*/> tCopyItem;
-    QVector<tCopyItem> copyItems;
-    int finalRichStringSize = 0;
-    int finalStringSize = 0;
+    result.copyPasteColumnsSize = result.copyPasteColumns.size();
+
+    if( (true == copyOnlyPayload) && (NOT_FOUND_COLUMN_IDX != payloadColumnIdx) )
+    {
+        result.firstCopyPasteColumn = payloadColumnIdx;
+        result.copyPasteColumnsSize = payloadColumnIdx + 1;
+    }
+
+    return result;
+}
+
+tIntRangeList CSearchResultView::getSelectedRowRanges() const
+{
+    tIntRangeList result;
+
+    if(nullptr == selectionModel())
+    {
+        return result;
+    }
+
+    // ranges of the selection are used instead of the selectedRows(), which creates an index per selected row
+    for(const auto& selectionRange : selectionModel()->selection())
+    {
+        if(true == selectionRange.isValid())
+        {
+            result.push_back(tIntRange(selectionRange.top(), selectionRange.bottom()));
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const tIntRange& lhs, const tIntRange& rhs)
+    {
+        return lhs.from < rhs.from;
+    });
 
-    int copyPasteColumnsSize = copyPasteColumns.size();
+    tIntRangeList mergedResult;
 
-    for(const auto& index : sortedSelectedRows)
+    for(const auto& range : result)
     {
-        auto getHighlightedColor = [this](const tHighlightingRange& range)
+        if(false == mergedResult.empty() && range.from <= mergedResult.back().to + 1)
+        {
+            mergedResult.back().to = std::max(mergedResult.back().to, range.to);
+        }
+        else
         {
-            QColor result;
+            mergedResult.push_back(range);
+        }
+    }
 
-            bool isMonoColorHighlighting = getSettingsManager()->getSearchResultMonoColorHighlighting();
-            bool isExplicitColor = range.explicitColor;
+    return mergedResult;
+}
 
-            if(true == isExplicitColor)
+void CSearchResultView::appendRowAsString( const int& row, const tCopyContext& copyContext, QString& result ) const
+{
+    const QColor nonHighlightedColor(0,0,0);
+
+    auto getHighlightedColor = [&copyContext](const tHighlightingRange& range)
+    {
+        QColor result;
+
+        bool isExplicitColor = range.explicitColor;
+
+        if(true == isExplicitColor)
+        {
+            result = range.color_code;
+        }
+        else
+        {
+            if(true == copyContext.bMonoColorHighlighting)
             {
-                result = range.color_code;
+                result = copyContext.monoHighlightingColor;
             }
             else
             {
-                if(true == isMonoColorHighlighting)
-                {
-                    result = getSettingsManager()->getRegexMonoHighlightingColor();
-                }
-                else
-                {
-                    result = range.color_code;
-                }
+                result = range.color_code;
             }
+        }
 
-            return result;
-        };
+        return result;
+    };
 
-        int i = 0;
+    const auto* pSpecificModel = dynamic_cast<CSearchResultModel*>(model());
 
-        if( (true == copyOnlyPayload) && (NOT_FOUND_COLUMN_IDX != payloadColumnIdx) )
-        {
-            i = payloadColumnIdx;
-            copyPasteColumnsSize = payloadColumnIdx + 1;
-        }
+    if(nullptr == pSpecificModel)
+    {
+        return;
+    }
+
+    const auto index = pSpecificModel->index(row, 0);
 
-        for( ; i < copyPasteColumnsSize; ++i )
+    for( int i = copyContext.firstCopyPasteColumn; i < copyContext.copyPasteColumnsSize; ++i )
+    {
+        auto columnId = copyContext.copyPasteColumns[i];
+        auto column = index.sibling(index.row(), columnId);
+        eSearchResultColumn field = static_cast<eSearchResultColumn>(columnId);
+        QString columnStr = column.data().value<QString>();
+
+        // only the requested format is built
+        auto attachText = [&copyContext,
+                &result,
+                &columnStr,
+                &i,
+                &field]
+                (const tIntRange& range,
+                const QColor& color,
+                bool isHighlighted)
         {
-            auto columnId = copyPasteColumns[i];
-            auto column = index.sibling(index.row(), columnId);
-            eSearchResultColumn field = static_cast<eSearchResultColumn>(columnId);
-            QString columnStr = column.data().value<QString>();
+            const bool bAddSeparator = ( i < copyContext.copyPasteColumnsSize - 1 &&
+                                         range.to == columnStr.size() - 1 );
+
+            QString subStr = columnStr.mid( range.from, range.to - range.from + 1 );
 
-            auto attachText = [this,
-                    &copyItems,
-                    &finalRichStringSize,
-                    &finalStringSize,
-                    &columnStr,
-                    &i,
-                    &copyPasteColumnsSize,
-                    &field]
-                    (const tIntRange& range,
-                    const QColor& color,
-                    bool isHighlighted)
+            if(false == copyContext.copyAsHTML)
+            {
+                result.append(subStr);
+            }
+            else
             {
                 bool isHighlightedExtended = ( isHighlighted ||
                                                ( eSearchResultColumn::Timestamp == field
-                                                 && true == getSettingsManager()->getMarkTimeStampWithBold() ) );
-
-                QString subStr = columnStr.mid( range.from, range.to - range.from + 1 );
+                                                 && true == copyContext.bMarkTimeStampWithBold ) );
 
-                QString str;
-                str.reserve(100 + subStr.size());
-
-                str.append("<font style=\"color:rgb(")
+                result.append("<font style=\"color:rgb(")
                         .append(QString::number(color.red()))
                         .append(",")
                         .append(QString::number(color.green()))
@@ -707,95 +997,75 @@ QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyP
 
                 if(true == isHighlightedExtended)
                 {
-                    str.append("<b>");
+                    result.append("<b>");
                 }
 
-                str.append(subStr.toHtmlEscaped());
+                result.append(subStr.toHtmlEscaped());
 
                 if(true == isHighlightedExtended)
                 {
-                    str.append("</b>");
+                    result.append("</b>");
                 }
 
-                str.append("</font>");
+                result.append("</font>");
+            }
 
-                if(i < copyPasteColumnsSize - 1 &&
-                   range.to == columnStr.size() - 1 )
-                {
-                    str.append(" ");
-                    subStr.append(" ");
-                }
+            if(true == bAddSeparator)
+            {
+                result.append(" ");
+            }
+        };
 
-                copyItems.push_back(tCopyItem(subStr, str));
+        const auto& matchesItemPack = pSpecificModel->getFoundMatchesItemPack( index );
 
-                finalRichStringSize += str.size();
-                finalStringSize += columnStr.size();
-            };
+        const auto& highlightingInfoMultiColor = matchesItemPack.getItemMetadata().highlightingInfoMultiColor;
+        auto foundHighlightingItem = highlightingInfoMultiColor.find(field);
 
-            const auto* pSpecificModel = dynamic_cast<CSearchResultModel*>(model());
+        if(highlightingInfoMultiColor.end() != foundHighlightingItem)
+        {
+            const auto& fieldRanges = matchesItemPack.getItemMetadata().fieldRanges;
+            const auto& foundfieldRange = fieldRanges.find(field);
 
-            if(nullptr != pSpecificModel)
+            if(fieldRanges.end() != foundfieldRange)
             {
-                const auto& matchesItemPack = pSpecificModel->getFoundMatchesItemPack( index );
+                int counter = 0;
 
-                const auto& highlightingInfoMultiColor = matchesItemPack.getItemMetadata().highlightingInfoMultiColor;
-                auto foundHighlightingItem = highlightingInfoMultiColor.find(field);
-
-                if(highlightingInfoMultiColor.end() != foundHighlightingItem)
+                for(auto it = foundHighlightingItem->begin(); it != foundHighlightingItem->end(); ++it)
                 {
-                    const auto& fieldRanges = matchesItemPack.getItemMetadata().fieldRanges;
-                    const auto& foundfieldRange = fieldRanges.find(field);
+                    const auto& range = *it;
 
-                    if(fieldRanges.end() != foundfieldRange)
+                    if(0 == counter)
                     {
-                        int counter = 0;
-
-                        for(auto it = foundHighlightingItem->begin(); it != foundHighlightingItem->end(); ++it)
+                        if(0 != range.from)
                         {
-                            const auto& range = *it;
-
-                            if(0 == counter)
-                            {
-                                if(0 != range.from)
-                                {
-                                    attachText( tIntRange(0, range.from - 1 ), nonHighlightedColor, false );
-                                }
-
-                                attachText( tIntRange( range.from, range.to ), getHighlightedColor(*it), true );
-                            }
-                            else if(0 < counter)
-                            {
-                                auto itPrev = it;
-                                --itPrev;
-                                const auto& prevRange = *(itPrev);
-
-                                if(prevRange.to < range.from)
-                                {
-                                    attachText( tIntRange(prevRange.to + 1, range.from - 1), nonHighlightedColor, false );
-                                }
-
-                                attachText( tIntRange( range.from, range.to ), getHighlightedColor(*it), true );
-                            }
+                            attachText( tIntRange(0, range.from - 1 ), nonHighlightedColor, false );
+                        }
 
-                            if(counter == static_cast<int>(foundHighlightingItem->size() - 1)) // last element
-                            {
-                                if( range.to < columnStr.size() - 1 )
-                                {
-                                    attachText( tIntRange(range.to + 1, columnStr.size() - 1), nonHighlightedColor, false );
-                                }
-                            }
+                        attachText( tIntRange( range.from, range.to ), getHighlightedColor(*it), true );
+                    }
+                    else if(0 < counter)
+                    {
+                        auto itPrev = it;
+                        --itPrev;
+                        const auto& prevRange = *(itPrev);
 
-                            ++counter;
+                        if(prevRange.to < range.from)
+                        {
+                            attachText( tIntRange(prevRange.to + 1, range.from - 1), nonHighlightedColor, false );
                         }
+
+                        attachText( tIntRange( range.from, range.to ), getHighlightedColor(*it), true );
                     }
-                    else
+
+                    if(counter == static_cast<int>(foundHighlightingItem->size() - 1)) // last element
                     {
-                        attachText( tIntRange(0, columnStr.size() - 1), nonHighlightedColor, false );
+                        if( range.to < columnStr.size() - 1 )
+                        {
+                            attachText( tIntRange(range.to + 1, columnStr.size() - 1), nonHighlightedColor, false );
+                        }
                     }
-                }
-                else
-                {
-                    attachText( tIntRange(0, columnStr.size() - 1), nonHighlightedColor, false );
+
+                    ++counter;
                 }
             }
             else
@@ -803,42 +1073,278 @@ QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyP
                 attachText( tIntRange(0, columnStr.size() - 1), nonHighlightedColor, false );
             }
         }
+        else
+        {
+            attachText( tIntRange(0, columnStr.size() - 1), nonHighlightedColor, false );
+        }
+    }
+
+    static const QString newLine("<br/>");
+    result.append(true == copyContext.copyAsHTML ? newLine : QString("\n"));
+}
+
+QString CSearchResultView::getSelectionAsString( bool copyAsHTML, bool copyOnlyPayload ) const
+{
+    QString result;
+
+    const auto copyContext = createCopyContext(copyAsHTML, copyOnlyPayload);
+
+    for(const auto& range : getSelectedRowRanges())
+    {
+        for(int row = range.from; row <= range.to; ++row)
+        {
+            appendRowAsString(row, copyContext, result);
+        }
+    }
 
-        static const QString newLine("<br/>");
-        copyItems.push_back(tCopyItem("\n",newLine));
-        finalStringSize+=newLine.size();
+    return result;
+}
+
+void CSearchResultView::copySelectionToClipboard( bool copyAsHTML, bool copyOnlyPayload )
+{
+    if(getNumberOfRows(getSelectedRowRanges()) <= sClipboardFastPathMaxRows)
+    {
+        QClipboard *pClipboard = QApplication::clipboard();
+        QMimeData *rich_text = new QMimeData();
+        rich_text->setText(getSelectionAsString(copyAsHTML, copyOnlyPayload));
+        pClipboard->setMimeData(rich_text);
     }
+    else
+    {
+        startSelectionExport(eSelectionExportTarget::eClipboard, copyAsHTML, copyOnlyPayload, QString());
+    }
+}
+
+void CSearchResultView::exportSelectionToFile( bool copyAsHTML, bool copyOnlyPayload )
+{
+    const QString filter = true == copyAsHTML ? QString("HTML files (*.html)") : QString("Text files (*.txt)");
 
-    QString finalRichText;
-    finalRichText.reserve(finalRichStringSize);
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export selection"), QDir::homePath(), filter);
 
-    QString finalText;
-    finalText.reserve(finalStringSize);
+    if(false == filePath.isEmpty())
+    {
+        startSelectionExport(eSelectionExportTarget::eFile, copyAsHTML, copyOnlyPayload, filePath);
+    }
+}
 
-    for(const auto& copyItem : copyItems)
+void CSearchResultView::startSelectionExport( eSelectionExportTarget target,
+                                              bool copyAsHTML,
+                                              bool copyOnlyPayload,
+                                              const QString& filePath )
+{
+    if(nullptr != mpSelectionExport)
     {
-        finalText.append(copyItem.first);
-        finalRichText.append(copyItem.second);
+        finishSelectionExport(true);
     }
 
-    if(copyAsHTML)
+    auto pSelectionExport = std::make_shared<tSelectionExport>();
+    pSelectionExport->target = target;
+    pSelectionExport->copyContext = createCopyContext(copyAsHTML, copyOnlyPayload);
+    pSelectionExport->rowRanges = getSelectedRowRanges();
+    pSelectionExport->numberOfRows = getNumberOfRows(pSelectionExport->rowRanges);
+
+    if(eSelectionExportTarget::eClipboard == target)
     {
-        result = finalRichText;
+        auto pTemporaryFile = cpp_14::make_unique<QTemporaryFile>();
+        pTemporaryFile->open();
+        pSelectionExport->pFile = std::move(pTemporaryFile);
     }
     else
     {
-        result = finalText;
+        pSelectionExport->pFile = cpp_14::make_unique<QFile>(filePath);
+        pSelectionExport->pFile->open(QIODevice::WriteOnly | QIODevice::Truncate);
     }
 
-    return result;
+    if(false == pSelectionExport->pFile->isOpen())
+    {
+        SEND_ERR(QString("[CSearchResultView] Failed to open file \"%1\" for the export of the selection: %2")
+                 .arg(pSelectionExport->pFile->fileName(), pSelectionExport->pFile->errorString()));
+        return;
+    }
+
+    auto* pProgressDialog = new QProgressDialog(QString("Exporting %1 rows ...").arg(pSelectionExport->numberOfRows),
+                                                "Cancel", 0, pSelectionExport->numberOfRows, this);
+    pProgressDialog->setWindowModality(Qt::NonModal);
+    pProgressDialog->setMinimumDuration(sSelectionExportProgressDelayMs);
+    pProgressDialog->setAutoClose(false);
+    pProgressDialog->setAutoReset(false);
+    pProgressDialog->setValue(0);
+
+    std::weak_ptr<tSelectionExport> pWeakSelectionExport = pSelectionExport;
+
+    connect(pProgressDialog, &QProgressDialog::canceled, this, [this, pWeakSelectionExport]()
+    {
+        if(nullptr != mpSelectionExport && pWeakSelectionExport.lock() == mpSelectionExport)
+        {
+            finishSelectionExport(true);
+        }
+    });
+
+    pSelectionExport->pProgressDialog = pProgressDialog;
+    mpSelectionExport = pSelectionExport;
+
+    scheduleSelectionExport();
+}
+
+void CSearchResultView::scheduleSelectionExport()
+{
+    std::weak_ptr<tSelectionExport> pWeakSelectionExport = mpSelectionExport;
+
+    QTimer::singleShot(0, this, [this, pWeakSelectionExport]()
+    {
+        // export might have been cancelled or replaced in the meantime
+        if(nullptr != mpSelectionExport && pWeakSelectionExport.lock() == mpSelectionExport)
+        {
+            processSelectionExport();
+        }
+    });
+}
+
+void CSearchResultView::processSelectionExport()
+{
+    auto& selectionExport = *mpSelectionExport;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString chunk;
+
+    // rows are rendered in time slices, so that the GUI stays responsive
+    while(selectionExport.rangeIdx < selectionExport.rowRanges.size() &&
+          timer.elapsed() < sSelectionExportSliceMs)
+    {
+        const auto& range = selectionExport.rowRanges[selectionExport.rangeIdx];
+
+        if(selectionExport.currentRow < range.from)
+        {
+            selectionExport.currentRow = range.from;
+        }
+
+        if(selectionExport.currentRow > range.to)
+        {
+            ++selectionExport.rangeIdx;
+            continue;
+        }
+
+        appendRowAsString(selectionExport.currentRow, selectionExport.copyContext, chunk);
+        ++selectionExport.currentRow;
+        ++selectionExport.numberOfExportedRows;
+    }
+
+    if(false == chunk.isEmpty())
+    {
+        const auto chunkUtf8 = chunk.toUtf8();
+
+        if(selectionExport.pFile->write(chunkUtf8) != chunkUtf8.size())
+        {
+            SEND_ERR(QString("[CSearchResultView] Failed to write the selection to the file \"%1\": %2")
+                     .arg(selectionExport.pFile->fileName(), selectionExport.pFile->errorString()));
+            finishSelectionExport(true);
+            return;
+        }
+
+        selectionExport.exportedSize += chunkUtf8.size();
+    }
+
+    if(nullptr != selectionExport.pProgressDialog)
+    {
+        selectionExport.pProgressDialog->setValue(selectionExport.numberOfExportedRows);
+    }
+
+    if(selectionExport.rangeIdx >= selectionExport.rowRanges.size())
+    {
+        finishSelectionExport(false);
+    }
+    else
+    {
+        scheduleSelectionExport();
+    }
 }
 
-void CSearchResultView::copySelectionToClipboard( bool copyAsHTML, bool copyOnlyPayload ) const
+void CSearchResultView::finishSelectionExport( bool bCancelled )
 {
-    QClipboard *pClipboard = QApplication::clipboard();
-    QMimeData *rich_text = new QMimeData();
-    rich_text->setText(getSelectionAsString(copyAsHTML, copyOnlyPayload));
-    pClipboard->setMimeData(rich_text);
+    auto pSelectionExport = mpSelectionExport;
+    mpSelectionExport.reset();
+
+    if(nullptr == pSelectionExport)
+    {
+        return;
+    }
+
+    if(nullptr != pSelectionExport->pProgressDialog)
+    {
+        pSelectionExport->pProgressDialog->close();
+        pSelectionExport->pProgressDialog->deleteLater();
+    }
+
+    auto& file = *pSelectionExport->pFile;
+
+    if(true == bCancelled)
+    {
+        SEND_MSG(QString("[CSearchResultView] Export of the selection was cancelled after %1 of %2 rows")
+                 .arg(pSelectionExport->numberOfExportedRows)
+                 .arg(pSelectionExport->numberOfRows));
+
+        if(eSelectionExportTarget::eFile == pSelectionExport->target)
+        {
+            // partially written file is of no use
+            file.remove();
+        }
+
+        return;
+    }
+
+    file.flush();
+
+    if(eSelectionExportTarget::eFile == pSelectionExport->target)
+    {
+        file.close();
+        SEND_MSG(QString("[CSearchResultView] %1 rows were exported to \"%2\"")
+                 .arg(pSelectionExport->numberOfExportedRows)
+                 .arg(file.fileName()));
+    }
+    else if(pSelectionExport->exportedSize <= sMaxClipboardSize)
+    {
+        file.seek(0);
+
+        QClipboard *pClipboard = QApplication::clipboard();
+        QMimeData *rich_text = new QMimeData();
+        rich_text->setText(QString::fromUtf8(file.readAll()));
+        pClipboard->setMimeData(rich_text);
+
+        SEND_MSG(QString("[CSearchResultView] %1 rows were copied to the clipboard")
+                 .arg(pSelectionExport->numberOfExportedRows));
+    }
+    else
+    {
+        // too big for the clipboard. The already rendered result is offered as a file
+        SEND_WRN(QString("[CSearchResultView] Selection of %1 bytes exceeds the clipboard limit of %2 bytes")
+                 .arg(pSelectionExport->exportedSize)
+                 .arg(sMaxClipboardSize));
+
+        const QString filter = true == pSelectionExport->copyContext.copyAsHTML ? QString("HTML files (*.html)") : QString("Text files (*.txt)");
+        QString targetFilePath = QFileDialog::getSaveFileName(this, tr("Selection is too big for the clipboard. Save as"),
+                                                              QDir::homePath(), filter);
+
+        if(false == targetFilePath.isEmpty())
+        {
+            if(true == QFileInfo::exists(targetFilePath))
+            {
+                QFile::remove(targetFilePath);
+            }
+
+            if(false == file.copy(targetFilePath))
+            {
+                SEND_ERR(QString("[CSearchResultView] Failed to copy file \"%1\" to \"%2\"").arg(file.fileName(), targetFilePath));
+            }
+            else
+            {
+                SEND_MSG(QString("[CSearchResultView] %1 rows were exported to \"%2\"")
+                         .arg(pSelectionExport->numberOfExportedRows)
+                         .arg(targetFilePath));
+            }
+        }
+    }
 }
 
 void CSearchResultView::keyPressEvent ( QKeyEvent * event )
@@ -1261,7 +1767,7 @@ void CSearchResultView::handleSettingsManagerChange()
                 copySelectionToClipboard( getSettingsManager()->getCopySearchResultAsHTML(), false );
             });
 
-            if(true == selectionModel()->selectedRows().empty())
+            if(false == selectionModel()->hasSelection())
             {
                 pAction->setEnabled(false);
             }
@@ -1277,7 +1783,22 @@ void CSearchResultView::handleSettingsManagerChange()
                 copySelectionToClipboard( getSettingsManager()->getCopySearchResultAsHTML(), true );
             });
 
-            if(true == selectionModel()->selectedRows().empty())
+            if(false == selectionModel()->hasSelection())
+            {
+                pAction->setEnabled(false);
+            }
+
+            contextMenu.addAction(pAction);
+        }
+
+        {
+            QAction* pAction = new QAction("Export selection to file ...", this);
+            connect(pAction, &QAction::triggered, this, [this]()
+            {
+                exportSelectionToFile( getSettingsManager()->getCopySearchResultAsHTML(), false );
+            });
+
+            if(false == selectionModel()->hasSelection())
             {
                 pAction->setEnabled(false);
             }
@@ -1757,6 +2278,161 @@ void CSearchResultView::handleSettingsManagerChange()
                 pSubMenu->addAction(pAction);
             }
 
+            pSubMenu->addSeparator();
+
+            {
+                QMenu* pSubSubMenu = new QMenu("Continuous search retention", this);
+
+                {
+                    QAction* pAction = new QAction(QString("Max matches ( %1 ) ...")
+                                                   .arg(getSettingsManager()->getSearchResultRetention_MaxMatches()), this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString maxMatchesStr = QInputDialog::getText(  nullptr, "Max matches",
+                                   "Set max number of retained matches of the continuous search ( 0 - no limit ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getSearchResultRetention_MaxMatches()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto maxMatches = maxMatchesStr.toInt(&ok);
+
+                            if(true == ok && maxMatches >= 0)
+                            {
+                                getSettingsManager()->setSearchResultRetention_MaxMatches(maxMatches);
+                            }
+                        }
+                    });
+
+                    pSubSubMenu->addAction(pAction);
+                }
+
+                {
+                    QAction* pAction = new QAction(QString("Max age, seconds ( %1 ) ...")
+                                                   .arg(getSettingsManager()->getSearchResultRetention_MaxSeconds()), this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString maxSecondsStr = QInputDialog::getText(  nullptr, "Max age",
+                                   "Set max age of the retained matches of the continuous search in seconds ( 0 - no limit ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getSearchResultRetention_MaxSeconds()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto maxSeconds = maxSecondsStr.toInt(&ok);
+
+                            if(true == ok && maxSeconds >= 0)
+                            {
+                                getSettingsManager()->setSearchResultRetention_MaxSeconds(maxSeconds);
+                            }
+                        }
+                    });
+
+                    pSubSubMenu->addAction(pAction);
+                }
+
+                pSubMenu->addMenu(pSubSubMenu);
+            }
+
+            {
+                QMenu* pSubSubMenu = new QMenu("Regex execution limits", this);
+
+                {
+                    QAction* pAction = new QAction(QString("Match limit ( %1 ) ...")
+                                                   .arg(getSettingsManager()->getRegexMatchLimit()), this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString valueStr = QInputDialog::getText(  nullptr, "Match limit",
+                                   "Set max number of the internal match calls of the regex per message ( 0 - default PCRE limit ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getRegexMatchLimit()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto value = valueStr.toInt(&ok);
+
+                            if(true == ok && value >= 0)
+                            {
+                                getSettingsManager()->setRegexMatchLimit(value);
+                            }
+                        }
+                    });
+
+                    pSubSubMenu->addAction(pAction);
+                }
+
+                {
+                    QAction* pAction = new QAction(QString("Depth limit ( %1 ) ...")
+                                                   .arg(getSettingsManager()->getRegexDepthLimit()), this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString valueStr = QInputDialog::getText(  nullptr, "Depth limit",
+                                   "Set max backtracking depth of the regex per message ( 0 - default PCRE limit ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getRegexDepthLimit()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto value = valueStr.toInt(&ok);
+
+                            if(true == ok && value >= 0)
+                            {
+                                getSettingsManager()->setRegexDepthLimit(value);
+                            }
+                        }
+                    });
+
+                    pSubSubMenu->addAction(pAction);
+                }
+
+                {
+                    QAction* pAction = new QAction(QString("Time budget per message, ms ( %1 ) ...")
+                                                   .arg(getSettingsManager()->getRegexMessageTimeBudgetMs()), this);
+                    connect(pAction, &QAction::triggered, [this]()
+                    {
+                        bool ok;
+
+                        QString valueStr = QInputDialog::getText(  nullptr, "Time budget",
+                                   "Set the regex matching time per message in milliseconds, after which the message is reported as a slow one ( 0 - disabled ):",
+                                   QLineEdit::Normal,
+                                   QString::number(getSettingsManager()->getRegexMessageTimeBudgetMs()), &ok );
+
+                        if(true == ok)
+                        {
+                            auto value = valueStr.toInt(&ok);
+
+                            if(true == ok && value >= 0)
+                            {
+                                getSettingsManager()->setRegexMessageTimeBudgetMs(value);
+                            }
+                        }
+                    });
+
+                    pSubSubMenu->addAction(pAction);
+                }
+
+                pSubMenu->addMenu(pSubSubMenu);
+            }
+
+            {
+                QAction* pAction = new QAction("Search around the selected message first", this);
+                connect(pAction, &QAction::triggered, this, [this](bool checked)
+                {
+                    getSettingsManager()->setSearchFocusFirst(checked);
+                });
+                pAction->setCheckable(true);
+                pAction->setChecked(getSettingsManager()->getSearchFocusFirst());
+                pSubMenu->addAction(pAction);
+            }
+
             contextMenu.addMenu(pSubMenu);
         }
 
@@ -2044,6 +2720,7 @@ void CSearchResultView::handleSettingsManagerChange()
     connect(getSettingsManager().get(), &ISettingsManager::font_SearchViewChanged, this, [this](const QFont& font)
     {
         setFont(font);
+        updateFontMetrics();
 
         QFontMetrics fontMetrics( font );
         verticalHeader()->setDefaultSectionSize(fontMetrics.height());
@@ -2086,7 +2763,7 @@ void CSearchResultView::clearGroupedViewHighlighting()
 {
     if(nullptr != mpSpecificModel)
     {
-        mpSpecificModel->setHighlightedRows(tMsgIdSet());
+        mpSpecificModel->setHighlightedRows(tMsgIdBitmap());
         viewport()->update();
     }
 }
@@ -2123,12 +2800,22 @@ void CSearchResultView::jumpToGroupedViewHighlightingMessage(eDirection directio
 
             auto jumpToFirstHighlightedElement = [&highlightedRows, &jumpToElement]()
             {
-                jumpToElement(*highlightedRows.begin());
+                tMsgIdBitmap::tValue firstElementId = 0u;
+
+                if(true == highlightedRows.select(0u, firstElementId))
+                {
+                    jumpToElement(static_cast<tMsgId>(firstElementId));
+                }
             };
 
             auto jumpToLastHighlightedElement = [&highlightedRows, &jumpToElement]()
             {
-                jumpToElement(* --highlightedRows.end());
+                tMsgIdBitmap::tValue lastElementId = 0u;
+
+                if(true == highlightedRows.select(highlightedRows.size() - 1u, lastElementId))
+                {
+                    jumpToElement(static_cast<tMsgId>(lastElementId));
+                }
             };
 
             if(false == selectedRows.empty())
@@ -2137,16 +2824,23 @@ void CSearchResultView::jumpToGroupedViewHighlightingMessage(eDirection directio
                 auto msgIdCell = selectedRow.sibling(selectedRow.row(), static_cast<int>(eSearchResultColumn::Index));
                 const auto msgId = msgIdCell.data().value<tMsgId>();
 
+                if(msgId < 0)
+                {
+                    jumpToFirstHighlightedElement();
+                    return;
+                }
+
+                const auto bitmapMsgId = static_cast<tMsgIdBitmap::tValue>(msgId);
+
                 switch(direction)
                 {
                     case eDirection::Next:
                     {
-                        auto upper = std::upper_bound(highlightedRows.begin(), highlightedRows.end(), msgId);
+                        tMsgIdBitmap::tValue nextElementId = 0u;
 
-                        if (upper != highlightedRows.end())
+                        if (true == highlightedRows.findNext(bitmapMsgId, nextElementId))
                         {
-                            auto nextElementId = *upper;
-                            jumpToElement(nextElementId);
+                            jumpToElement(static_cast<tMsgId>(nextElementId));
                         }
                         else
                         {
@@ -2156,12 +2850,11 @@ void CSearchResultView::jumpToGroupedViewHighlightingMessage(eDirection directio
                     break;
                     case eDirection::Previous:
                     {
-                        auto lower = std::lower_bound(highlightedRows.begin(), highlightedRows.end(), msgId);
+                        tMsgIdBitmap::tValue previousElementId = 0u;
 
-                        if (lower != highlightedRows.begin())
+                        if (true == highlightedRows.findPrevious(bitmapMsgId, previousElementId))
                         {
-                            auto previousElementId = *(--lower);
-                            jumpToElement(previousElementId);
+                            jumpToElement(static_cast<tMsgId>(previousElementId));
                         }
                         else
                         {
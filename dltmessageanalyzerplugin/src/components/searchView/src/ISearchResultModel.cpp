@@ -128,10 +128,13 @@ DMA_FORCE_LINK_ANCHOR_CPP(ISearchResultModel)
 PUML_PACKAGE_BEGIN(DMA_SearchView_API)
     PUML_CLASS_BEGIN(ISearchResultModel)
         PUML_PURE_VIRTUAL_METHOD( +, void updateView(const int& fromRow = 0) )
-        PUML_PURE_VIRTUAL_METHOD( +,  std::pair<int__QString > getUMLDiagramContent() const )
+        PUML_PURE_VIRTUAL_METHOD( +,  void startUMLDiagramContentGeneration(const int& rowsPerPage) )
+        PUML_PURE_VIRTUAL_METHOD( +,  void cancelUMLDiagramContentGeneration() )
+        PUML_PURE_VIRTUAL_METHOD( +,  bool isUMLDiagramContentGenerationInProgress() const )
         PUML_PURE_VIRTUAL_METHOD( +,  void resetData() )
         PUML_PURE_VIRTUAL_METHOD( +,  void setFile(const tFileWrapperPtr& pFile) )
         PUML_PURE_VIRTUAL_METHOD( +,  std::pair<bool__tIntRange> addNextMessageIdxVec(const tFoundMatchesPack& foundMatchesPack) )
+        PUML_PURE_VIRTUAL_METHOD( +,  tFoundMatchesPack evictMatches(const int& maxMatches, const int& maxSeconds) )
         PUML_PURE_VIRTUAL_METHOD( +,  int getFileIdx( const QModelIndex& idx ) const )
         PUML_PURE_VIRTUAL_METHOD( +,  tPlotContent createPlotContent() const )
     PUML_CLASS_END()
@@ -142,6 +142,8 @@ public:
     virtual void setUML_ShowArguments(const bool& val) = 0;
     virtual void setUML_WrapOutput(const bool& val) = 0;
     virtual void setUML_Autonumber(const bool& val) = 0;
+    virtual void setUML_RenderServerMode(const bool& val) = 0;
+    virtual void setUML_RowsPerDiagramPage(const int& val) = 0;
     virtual void setPlotViewFeatureActive(const bool& val) = 0;
     virtual void setFiltersCompletion_CaseSensitive(const bool& val) = 0;
     virtual void setFiltersCompletion_MaxNumberOfSuggestions(const int& val) = 0;
@@ -149,6 +151,14 @@ public:
     virtual void setFiltersCompletion_CompletionPopUpWidth(const int& val) = 0;
     virtual void setFiltersCompletion_SearchPolicy(const bool& val) = 0;
     virtual void setSearchViewLastColumnWidthStrategy(const int& val) = 0;
+    virtual void setSearchResultRetention_MaxMatches(const int& val) = 0;
+    virtual void setSearchResultRetention_MaxSeconds(const int& val) = 0;
+    virtual void setRegexMatchLimit(const int& val) = 0;
+    virtual void setRegexDepthLimit(const int& val) = 0;
+    virtual void setRegexMessageTimeBudgetMs(const int& val) = 0;
+    virtual void setRegexCostProfiling(const bool& val) = 0;
+    virtual void setSearchFocusFirst(const bool& val) = 0;
+    virtual void setSearchPreview(const bool& val) = 0;
     virtual void setPlantumlPathMode(const int& val) = 0;
     virtual void setPlantumlPathEnvVar(const QString& val) = 0;
     virtual void setPlantumlCustomPath(const QString& val) = 0;
@@ -214,6 +224,8 @@ public:
     virtual const bool& getUML_ShowArguments() const = 0;
     virtual const bool& getUML_WrapOutput() const = 0;
     virtual const bool& getUML_Autonumber() const = 0;
+    virtual const bool& getUML_RenderServerMode() const = 0;
+    virtual const int& getUML_RowsPerDiagramPage() const = 0;
     virtual const bool& getPlotViewFeatureActive() const = 0;
     virtual const bool& getFiltersCompletion_CaseSensitive() const = 0;
     virtual const int& getFiltersCompletion_MaxNumberOfSuggestions() const = 0;
@@ -221,6 +233,14 @@ public:
     virtual const int& getFiltersCompletion_CompletionPopUpWidth() const = 0;
     virtual const bool& getFiltersCompletion_SearchPolicy() const = 0;
     virtual const int& getSearchViewLastColumnWidthStrategy() const = 0;
+    virtual const int& getSearchResultRetention_MaxMatches() const = 0;
+    virtual const int& getSearchResultRetention_MaxSeconds() const = 0;
+    virtual const int& getRegexMatchLimit() const = 0;
+    virtual const int& getRegexDepthLimit() const = 0;
+    virtual const int& getRegexMessageTimeBudgetMs() const = 0;
+    virtual const bool& getRegexCostProfiling() const = 0;
+    virtual const bool& getSearchFocusFirst() const = 0;
+    virtual const bool& getSearchPreview() const = 0;
     virtual const int& getPlantumlPathMode() const = 0;
     virtual const QString& getPlantumlPathEnvVar() const = 0;
     virtual const QString& getPlantumlCustomPath() const = 0;
@@ -252,6 +272,8 @@ signals:
 
     // regex usage statistics
     void regexUsageStatisticsChanged( const tRegexUsageStatisticsItemMap& regexUsageStatistics );
+    // emitted right before the statistics are stored to the file. Delayed updates should be pushed synchronously
+    void regexUsageStatisticsAboutToBeStored();
 
     // general settings
     void numberOfThreadsChanged( int numberOfThreads );
@@ -286,6 +308,8 @@ signals:
     void UML_ShowArgumentsChanged(const bool& UML_ShowArguments);
     void UML_WrapOutputChanged(const bool& UML_WrapOutput);
     void UML_AutonumberChanged(const bool& UML_Autonumber);
+    void UML_RenderServerModeChanged(const bool& UML_RenderServerMode);
+    void UML_RowsPerDiagramPageChanged(const int& UML_RowsPerDiagramPage);
     void plotViewFeatureActiveChanged(const bool& plotViewFeatureActive);
     void filtersCompletion_CaseSensitiveChanged(const bool& filtersCompletion_CaseSensitive);
     void filtersCompletion_MaxNumberOfSuggestionsChanged(const int& filtersCompletion_MaxNumberOfSuggestions);
@@ -293,6 +317,14 @@ signals:
     void filtersCompletion_CompletionPopUpWidthChanged(const int& filtersCompletion_CompletionPopUpWidth);
     void filtersCompletion_SearchPolicyChanged(const bool& filtersCompletion_SearchPolicy);
     void searchViewLastColumnWidthStrategyChanged(const int& payloadWidthChanged);
+    void searchResultRetention_MaxMatchesChanged(const int& searchResultRetention_MaxMatches);
+    void searchResultRetention_MaxSecondsChanged(const int& searchResultRetention_MaxSeconds);
+    void regexMatchLimitChanged(const int& regexMatchLimit);
+    void regexDepthLimitChanged(const int& regexDepthLimit);
+    void regexMessageTimeBudgetMsChanged(const int& regexMessageTimeBudgetMs);
+    void regexCostProfilingChanged(const bool& regexCostProfiling);
+    void searchFocusFirstChanged(const bool& searchFocusFirst);
+    void searchPreviewChanged(const bool& searchPreview);
     void plantumlPathModeChanged(const int& plantumlPathMode);
     void plantumlPathEnvVarChanged(const QString& plantumlPathEnvVar);
     void plantumlCustomPathChanged(const QString& plantumlPathEnvVar);
@@ -5,6 +5,8 @@
  */
 
 #include "QFile"
+#include "QSaveFile"
+#include "QRunnable"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -26,6 +28,9 @@ static const QString sSettingsManager_RegexUsageStatistics_SubDirectory = "regex
 static const QString sSettingsManager_User_SettingsFile = "user_settings.json";
 static const QString sSettingsManager_Root_SettingsFile = "root_settings.json";
 
+// delay, during which the updates of the settings are collected before being stored to the files
+static const int sStoreSettingsDelayMs = 500;
+
 static const QString sSettingsManagerVersionKey = "settingsManagerVersion";
 static const QString sAliasesKey = "aliases";
 static const QString sRegexUsageStatisticsKey = "regexUsageStatistics";
@@ -74,6 +79,8 @@ static const QString sUML_MaxNumberOfRowsInDiagramKey = "UML_MaxNumberOfRowsInDi
 static const QString sUML_ShowArgumentsKey = "UML_ShowArguments";
 static const QString sUML_WrapOutputKey = "UML_WrapOutput";
 static const QString sUML_AutonumberKey = "UML_Autonumber";
+static const QString sUML_RenderServerModeKey = "UML_RenderServerMode";
+static const QString sUML_RowsPerDiagramPageKey = "UML_RowsPerDiagramPage";
 
 static const QString sPlotViewFeatureActiveKey = "PlotViewFeatureActive";
 
@@ -84,6 +91,14 @@ static const QString sFiltersCompletion_CompletionPopUpWidthKey = "FiltersComple
 static const QString sFiltersCompletion_SearchPolicyKey = "FiltersCompletion_SearchPolicy";
 
 static const QString sSearchViewLastColumnWidthStrategyKey = "SearchViewLastColumnWidthStrategy";
+static const QString sSearchResultRetention_MaxMatchesKey = "SearchResultRetention_MaxMatches";
+static const QString sSearchResultRetention_MaxSecondsKey = "SearchResultRetention_MaxSeconds";
+static const QString sRegexMatchLimitKey = "RegexMatchLimit";
+static const QString sRegexDepthLimitKey = "RegexDepthLimit";
+static const QString sRegexMessageTimeBudgetMsKey = "RegexMessageTimeBudgetMs";
+static const QString sRegexCostProfilingKey = "RegexCostProfiling";
+static const QString sSearchFocusFirstKey = "SearchFocusFirst";
+static const QString sSearchPreviewKey = "SearchPreview";
 static const QString sPlantumlPathMode = "PlantumlPathMode";
 static const QString sPlantumlPathEnvVar = "PlantumlPathEnvVar";
 static const QString sPlantumlCustomPath = "PlantumlCustomPath";
@@ -248,6 +263,7 @@ static tRegexFiltersColumnsVisibilityMap fillInDefaultRegexFiltersColumnsVisibil
     // fields, which are visible by default
     result.insert(eRegexFiltersColumn::Index, true);
     result.insert(eRegexFiltersColumn::ItemType, true);
+    result.insert(eRegexFiltersColumn::Cost, false);
     result.insert(eRegexFiltersColumn::Value, true);
 
     return result;
@@ -276,6 +292,68 @@ static tGroupedViewColumnsVisibilityMap fillInDefaultGroupedViewColumnsVisibilit
 static const tGroupedViewColumnsVisibilityMap sDefaultGroupedViewColumnsVisibilityMap
 = fillInDefaultGroupedViewColumnsVisibilityMap();
 
+/**
+ * @brief writeSettingsFile - writes the settings to the file.
+ * Content is written to a temporary file, which then atomically replaces the target one.
+ * Thus, the interrupted write never leaves a truncated settings file.
+ * @param filePath - path to the target file
+ * @param settingsArray - content of the file
+ * @return - result of the operation
+ */
+static ISettingsManager::tOperationResult writeSettingsFile(const QString& filePath, const QJsonArray& settingsArray)
+{
+    ISettingsManager::tOperationResult result;
+    result.bResult = false;
+
+    QSaveFile jsonFile(filePath);
+
+    if(jsonFile.open(QFile::WriteOnly))
+    {
+        QJsonDocument jsonDoc( settingsArray );
+        // Uncomment this to see the content of the generated file
+        //qDebug() << "doc - " << jsonDoc.toJson();
+        jsonFile.write( jsonDoc.toJson() );
+
+        if(true == jsonFile.commit())
+        {
+            result.bResult = true;
+        }
+        else
+        {
+            result.err = QString("[%1] Failed to write file - \"%2\": %3").arg(__FUNCTION__).arg(filePath).arg(jsonFile.errorString());
+        }
+    }
+    else
+    {
+        result.err = QString("[%1] Failed to open file - \"%2\"").arg(__FUNCTION__).arg(filePath);
+    }
+
+    return result;
+}
+
+class CStoreSettingsFileTask : public QRunnable
+{
+public:
+    typedef std::function<void()> tTask;
+
+    explicit CStoreSettingsFileTask(const tTask& task):
+    mTask(task)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        if(mTask)
+        {
+            mTask();
+        }
+    }
+
+private:
+    tTask mTask;
+};
+
 CSettingsManager::CSettingsManager():
     mSetting_SettingsManagerVersion(createArithmeticSettingsItem<tSettingsManagerVersion>(sSettingsManagerVersionKey,
         [this](const tSettingsManagerVersion&,
@@ -286,8 +364,7 @@ CSettingsManager::CSettingsManager():
         [this](const tAliasItemMap&, const tAliasItemMap& data){ aliasesChanged(data); },
         [this]()
         {
-            QString regexSettingsFilePath = getRegexDirectory() + QDir::separator() + mSetting_SelectedRegexFile.getData();
-            storeRegexConfigCustomPath(regexSettingsFilePath);
+            scheduleStore(eSettingsFile::Regex);
         },
                                                    tAliasItemMap())),
     mSetting_NumberOfThreads(createRangedArithmeticSettingsItem<int>(sNumberOfThreadsKey,
@@ -393,6 +470,9 @@ CSettingsManager::CSettingsManager():
         {
             QString regexSettingsFilePath = getRegexDirectory() + QDir::separator() + data;
 
+            // pending updates of the aliases belong to the previously selected file
+            flushPendingStores();
+
             clearRegexConfig();
             loadRegexConfigCustomPath(regexSettingsFilePath);
 
@@ -400,13 +480,9 @@ CSettingsManager::CSettingsManager():
 
             if(true == mbInitialised && false == oldData.isEmpty())
             {
-                auto result = storeRegexUsageStatisticsDataCustomPath(oldRegexUsageStatisticsFilePath);
-
-                if(false == result.bResult)
-                {
-                    SEND_ERR(QString("Was not able to store regex usage statistics due "
-                                     "to the following error: %1").arg(result.err));
-                }
+                // delayed updates belong to the previously selected file
+                regexUsageStatisticsAboutToBeStored();
+                storeAsync(oldRegexUsageStatisticsFilePath, getRegexUsageStatisticsData());
             }
 
             clearRegexUsageStatisticsData();
@@ -456,6 +532,14 @@ CSettingsManager::CSettingsManager():
         [this](const bool&, const bool& data){UML_AutonumberChanged(data);},
         [this](){tryStoreSettingsConfig();},
         true)),
+    mSetting_UML_RenderServerMode(createBooleanSettingsItem(sUML_RenderServerModeKey,
+        [this](const bool&, const bool& data){UML_RenderServerModeChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        true)),
+    mSetting_UML_RowsPerDiagramPage(createArithmeticSettingsItem<int>(sUML_RowsPerDiagramPageKey,
+        [this](const int&, const int& data){UML_RowsPerDiagramPageChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        500)),
     mPlotViewFeatureActiveProtector(),
     mSetting_PlotViewFeatureActive(createBooleanSettingsItem(sPlotViewFeatureActiveKey,
         [this](const bool&, const bool& data){plotViewFeatureActiveChanged(data);},
@@ -498,6 +582,43 @@ CSettingsManager::CSettingsManager():
         TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(static_cast<int>(eSearchViewLastColumnWidthStrategy::eReset),
                                                                                               static_cast<int>(eSearchViewLastColumnWidthStrategy::eFitToContent))),
         static_cast<int>(eSearchViewLastColumnWidthStrategy::eFitToContent))),
+    mSetting_SearchResultRetention_MaxMatches(createRangedArithmeticSettingsItem<int>(sSearchResultRetention_MaxMatchesKey,
+        [this](const int&, const int& data){searchResultRetention_MaxMatchesChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(0, 100000000)),
+        0)),
+    mSetting_SearchResultRetention_MaxSeconds(createRangedArithmeticSettingsItem<int>(sSearchResultRetention_MaxSecondsKey,
+        [this](const int&, const int& data){searchResultRetention_MaxSecondsChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(0, 604800)),
+        0)),
+    mSetting_RegexMatchLimit(createRangedArithmeticSettingsItem<int>(sRegexMatchLimitKey,
+        [this](const int&, const int& data){regexMatchLimitChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(0, 100000000)),
+        1000000)),
+    mSetting_RegexDepthLimit(createRangedArithmeticSettingsItem<int>(sRegexDepthLimitKey,
+        [this](const int&, const int& data){regexDepthLimitChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(0, 100000000)),
+        0)),
+    mSetting_RegexMessageTimeBudgetMs(createRangedArithmeticSettingsItem<int>(sRegexMessageTimeBudgetMsKey,
+        [this](const int&, const int& data){regexMessageTimeBudgetMsChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        TRangedSettingItem<int>::tOptionalAllowedRange(TRangedSettingItem<int>::tAllowedRange(0, 60000)),
+        0)),
+    mSetting_RegexCostProfiling(createBooleanSettingsItem(sRegexCostProfilingKey,
+        [this](const bool&, const bool& data){regexCostProfilingChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        false)),
+    mSetting_SearchFocusFirst(createBooleanSettingsItem(sSearchFocusFirstKey,
+        [this](const bool&, const bool& data){searchFocusFirstChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        false)),
+    mSetting_SearchPreview(createBooleanSettingsItem(sSearchPreviewKey,
+        [this](const bool&, const bool& data){searchPreviewChanged(data);},
+        [this](){tryStoreSettingsConfig();},
+        false)),
     mSetting_PlantumlPathMode(createRangedArithmeticSettingsItem<int>(sPlantumlPathMode,
         [this](const int&, const int& data){plantumlPathModeChanged(data);},
         [this](){tryStoreSettingsConfig();},
@@ -555,8 +676,20 @@ CSettingsManager::CSettingsManager():
     mUserSettingItemPtrVec(),
     mPatternsSettingItemPtrVec(),
     mRegexUsageStatisticsDataItemPtrVec(),
+    mDirtySettingsFiles(),
+    mStoreSettingsTimer(),
+    mStoreSettingsThreadPool(),
     mbInitialised(false)
 {
+    mStoreSettingsThreadPool.setMaxThreadCount(1);
+
+    mStoreSettingsTimer.setSingleShot(true);
+    mStoreSettingsTimer.setInterval(sStoreSettingsDelayMs);
+    connect(&mStoreSettingsTimer, &QTimer::timeout, this, [this]()
+    {
+        flushPendingStores();
+    });
+
     /////////////// ROOT SETTINGS ///////////////
     mRootSettingItemPtrVec.push_back(&mSetting_SettingsManagerVersion);
 
@@ -593,6 +726,8 @@ CSettingsManager::CSettingsManager():
     mUserSettingItemPtrVec.push_back(&mSetting_UML_ShowArguments);
     mUserSettingItemPtrVec.push_back(&mSetting_UML_WrapOutput);
     mUserSettingItemPtrVec.push_back(&mSetting_UML_Autonumber);
+    mUserSettingItemPtrVec.push_back(&mSetting_UML_RenderServerMode);
+    mUserSettingItemPtrVec.push_back(&mSetting_UML_RowsPerDiagramPage);
     mUserSettingItemPtrVec.push_back(&mSetting_PlotViewFeatureActive);
     mUserSettingItemPtrVec.push_back(&mSetting_FiltersCompletion_CaseSensitive);
     mUserSettingItemPtrVec.push_back(&mSetting_FiltersCompletion_MaxNumberOfSuggestions);
@@ -602,6 +737,14 @@ CSettingsManager::CSettingsManager():
     mUserSettingItemPtrVec.push_back(&mSetting_RegexCompletion_CaseSensitive);
     mUserSettingItemPtrVec.push_back(&mSetting_RegexCompletion_SearchPolicy);
     mUserSettingItemPtrVec.push_back(&mSetting_SearchViewLastColumnWidthStrategy);
+    mUserSettingItemPtrVec.push_back(&mSetting_SearchResultRetention_MaxMatches);
+    mUserSettingItemPtrVec.push_back(&mSetting_SearchResultRetention_MaxSeconds);
+    mUserSettingItemPtrVec.push_back(&mSetting_RegexMatchLimit);
+    mUserSettingItemPtrVec.push_back(&mSetting_RegexDepthLimit);
+    mUserSettingItemPtrVec.push_back(&mSetting_RegexMessageTimeBudgetMs);
+    mUserSettingItemPtrVec.push_back(&mSetting_RegexCostProfiling);
+    mUserSettingItemPtrVec.push_back(&mSetting_SearchFocusFirst);
+    mUserSettingItemPtrVec.push_back(&mSetting_SearchPreview);
     mUserSettingItemPtrVec.push_back(&mSetting_PlantumlPathMode);
     mUserSettingItemPtrVec.push_back(&mSetting_PlantumlPathEnvVar);
     mUserSettingItemPtrVec.push_back(&mSetting_PlantumlCustomPath);
@@ -619,11 +762,18 @@ CSettingsManager::CSettingsManager():
     mRegexUsageStatisticsDataItemPtrVec.push_back(&mSetting_RegexUsageStatistics);
 }
 
+CSettingsManager::~CSettingsManager()
+{
+    mStoreSettingsTimer.stop();
+    flushPendingStores();
+    waitForAsyncStores();
+}
+
 void CSettingsManager::tryStoreSettingsConfig()
 {
     if(true == getWriteSettingsOnEachUpdate())
     {
-        storeSettingsConfig();
+        scheduleStore(eSettingsFile::User);
     }
 }
 
@@ -631,10 +781,89 @@ void CSettingsManager::tryStoreRootConfig()
 {
     if(true == getWriteSettingsOnEachUpdate())
     {
-        storeRootConfig();
+        scheduleStore(eSettingsFile::Root);
     }
 }
 
+void CSettingsManager::scheduleStore(const eSettingsFile& settingsFile)
+{
+    if(QThread::currentThread() != thread())
+    {
+        // e.g. the highlighting gradient, which can be set from any thread
+        QTimer::singleShot(0, this, [this, settingsFile]()
+        {
+            scheduleStore(settingsFile);
+        });
+
+        return;
+    }
+
+    QString filePath;
+
+    switch(settingsFile)
+    {
+        case eSettingsFile::Root:
+            filePath = getRootSettingsFilepath();
+            break;
+        case eSettingsFile::User:
+            filePath = getUserSettingsFilepath();
+            break;
+        case eSettingsFile::Regex:
+            filePath = getRegexDirectory() + QDir::separator() + mSetting_SelectedRegexFile.getData();
+            break;
+    }
+
+    mDirtySettingsFiles[settingsFile] = filePath;
+
+    // the timer is not restarted, so that the continuous updates, e.g. slider drags, are still stored
+    if(false == mStoreSettingsTimer.isActive())
+    {
+        mStoreSettingsTimer.start();
+    }
+}
+
+void CSettingsManager::flushPendingStores()
+{
+    mStoreSettingsTimer.stop();
+
+    for(const auto& dirtySettingsFile : mDirtySettingsFiles)
+    {
+        switch(dirtySettingsFile.first)
+        {
+            case eSettingsFile::Root:
+                storeAsync(dirtySettingsFile.second, getRootConfigData());
+                break;
+            case eSettingsFile::User:
+                storeAsync(dirtySettingsFile.second, getSettingsConfigData());
+                break;
+            case eSettingsFile::Regex:
+                storeAsync(dirtySettingsFile.second, getRegexConfigData());
+                break;
+        }
+    }
+
+    mDirtySettingsFiles.clear();
+}
+
+void CSettingsManager::storeAsync(const QString& filePath, const QJsonArray& settingsArray)
+{
+    // json array is implicitly shared, thus the copy is cheap and is safe to be used in another thread
+    mStoreSettingsThreadPool.start(new CStoreSettingsFileTask([filePath, settingsArray]()
+    {
+        auto result = writeSettingsFile(filePath, settingsArray);
+
+        if(false == result.bResult)
+        {
+            SEND_ERR(QString("[CSettingsManager] Was not able to store settings due to the following error: %1").arg(result.err));
+        }
+    }));
+}
+
+void CSettingsManager::waitForAsyncStores()
+{
+    mStoreSettingsThreadPool.waitForDone();
+}
+
 CSettingsManager::tOperationResult CSettingsManager::backwardCompatibility()
 {
     SEND_MSG(QString("[CSettingsManager] Performing setting manager update."));
@@ -1276,7 +1505,7 @@ TSettingItem<tRegexFiltersColumnsVisibilityMap> CSettingsManager::createRegexFil
 
     auto readFunc = [](const QJsonValueRef& JSONItem,
                        tRegexFiltersColumnsVisibilityMap& data,
-                       const tRegexFiltersColumnsVisibilityMap&)->bool
+                       const tRegexFiltersColumnsVisibilityMap& defaultValue)->bool
     {
         bool bResult = false;
 
@@ -1316,6 +1545,15 @@ TSettingItem<tRegexFiltersColumnsVisibilityMap> CSettingsManager::createRegexFil
                 }
             }
 
+            // columns, which were added after the settings file was stored, get their default visibility
+            for(auto it = defaultValue.begin(); it != defaultValue.end(); ++it)
+            {
+                if(false == data.contains(it.key()))
+                {
+                    data.insert(it.key(), it.value());
+                }
+            }
+
             bResult = true;
         }
 
@@ -1446,37 +1684,31 @@ CSettingsManager::tOperationResult CSettingsManager::loadRootConfig()
 
 CSettingsManager::tOperationResult CSettingsManager::storeRootConfig()
 {
-    CSettingsManager::tOperationResult result;
-    result.bResult = false;
-
-    QString rootConfigPath = getRootSettingsFilepath();
-
-    QFile jsonFile(rootConfigPath);
-
-    if(jsonFile.open(QFile::WriteOnly))
-    {
-        QJsonArray settingsArray;
-
-        for(auto* pSetting : mRootSettingItemPtrVec)
-        {
-            settingsArray.append(pSetting->writeData());
-        }
+    return writeSettingsFile(getRootSettingsFilepath(), getRootConfigData());
+}
 
-        QJsonDocument jsonDoc( settingsArray );
-        jsonFile.write( jsonDoc.toJson() );
+QJsonArray CSettingsManager::getRootConfigData() const
+{
+    QJsonArray settingsArray;
 
-        result.bResult = true;
-    }
-    else
+    for(auto* pSetting : mRootSettingItemPtrVec)
     {
-        result.err = QString("[%1] Was not able to open file - \"%2\"").arg(__FUNCTION__).arg(rootConfigPath);
+        settingsArray.append(pSetting->writeData());
     }
 
-    return result;
+    return settingsArray;
 }
 
 CSettingsManager::tOperationResult CSettingsManager::storeConfigs()
 {
+    // clients should push their delayed updates before the statistics are stored
+    regexUsageStatisticsAboutToBeStored();
+
+    // everything is stored synchronously below. Background writes should not overwrite it afterwards.
+    mStoreSettingsTimer.stop();
+    mDirtySettingsFiles.clear();
+    waitForAsyncStores();
+
     CSettingsManager::tOperationResult  result = storeRootConfig();
 
     if( true == result.bResult )
@@ -1890,6 +2122,16 @@ void CSettingsManager::setUML_Autonumber(const bool& val)
     mSetting_UML_Autonumber.setData(val);
 }
 
+void CSettingsManager::setUML_RenderServerMode(const bool& val)
+{
+    mSetting_UML_RenderServerMode.setData(val);
+}
+
+void CSettingsManager::setUML_RowsPerDiagramPage(const int& val)
+{
+    mSetting_UML_RowsPerDiagramPage.setData(val);
+}
+
 void CSettingsManager::setPlotViewFeatureActive(const bool& val)
 {
     std::lock_guard<std::recursive_mutex> lock(*const_cast<std::recursive_mutex*>(&mPlotViewFeatureActiveProtector));
@@ -1946,6 +2188,46 @@ void CSettingsManager::setSearchViewLastColumnWidthStrategy(const int& val)
     mSetting_SearchViewLastColumnWidthStrategy.setData(val);
 }
 
+void CSettingsManager::setSearchResultRetention_MaxMatches(const int& val)
+{
+    mSetting_SearchResultRetention_MaxMatches.setData(val);
+}
+
+void CSettingsManager::setSearchResultRetention_MaxSeconds(const int& val)
+{
+    mSetting_SearchResultRetention_MaxSeconds.setData(val);
+}
+
+void CSettingsManager::setRegexMatchLimit(const int& val)
+{
+    mSetting_RegexMatchLimit.setData(val);
+}
+
+void CSettingsManager::setRegexDepthLimit(const int& val)
+{
+    mSetting_RegexDepthLimit.setData(val);
+}
+
+void CSettingsManager::setRegexMessageTimeBudgetMs(const int& val)
+{
+    mSetting_RegexMessageTimeBudgetMs.setData(val);
+}
+
+void CSettingsManager::setRegexCostProfiling(const bool& val)
+{
+    mSetting_RegexCostProfiling.setData(val);
+}
+
+void CSettingsManager::setSearchFocusFirst(const bool& val)
+{
+    mSetting_SearchFocusFirst.setData(val);
+}
+
+void CSettingsManager::setSearchPreview(const bool& val)
+{
+    mSetting_SearchPreview.setData(val);
+}
+
 void CSettingsManager::setPlantumlPathMode(const int& val)
 {
     mSetting_PlantumlPathMode.setData(val);
@@ -2163,6 +2445,16 @@ const bool& CSettingsManager::getUML_Autonumber() const
     return mSetting_UML_Autonumber.getData();
 }
 
+const bool& CSettingsManager::getUML_RenderServerMode() const
+{
+    return mSetting_UML_RenderServerMode.getData();
+}
+
+const int& CSettingsManager::getUML_RowsPerDiagramPage() const
+{
+    return mSetting_UML_RowsPerDiagramPage.getData();
+}
+
 const bool& CSettingsManager::getPlotViewFeatureActive() const
 {
     std::lock_guard<std::recursive_mutex> lock(*const_cast<std::recursive_mutex*>(&mPlotViewFeatureActiveProtector));
@@ -2219,6 +2511,46 @@ const int& CSettingsManager::getSearchViewLastColumnWidthStrategy() const
     return mSetting_SearchViewLastColumnWidthStrategy.getData();
 }
 
+const int& CSettingsManager::getSearchResultRetention_MaxMatches() const
+{
+    return mSetting_SearchResultRetention_MaxMatches.getData();
+}
+
+const int& CSettingsManager::getSearchResultRetention_MaxSeconds() const
+{
+    return mSetting_SearchResultRetention_MaxSeconds.getData();
+}
+
+const int& CSettingsManager::getRegexMatchLimit() const
+{
+    return mSetting_RegexMatchLimit.getData();
+}
+
+const int& CSettingsManager::getRegexDepthLimit() const
+{
+    return mSetting_RegexDepthLimit.getData();
+}
+
+const int& CSettingsManager::getRegexMessageTimeBudgetMs() const
+{
+    return mSetting_RegexMessageTimeBudgetMs.getData();
+}
+
+const bool& CSettingsManager::getRegexCostProfiling() const
+{
+    return mSetting_RegexCostProfiling.getData();
+}
+
+const bool& CSettingsManager::getSearchFocusFirst() const
+{
+    return mSetting_SearchFocusFirst.getData();
+}
+
+const bool& CSettingsManager::getSearchPreview() const
+{
+    return mSetting_SearchPreview.getData();
+}
+
 const int& CSettingsManager::getPlantumlPathMode() const
 {
     return mSetting_PlantumlPathMode.getData();
@@ -2300,32 +2632,19 @@ void CSettingsManager::refreshRegexConfiguration()
 
 CSettingsManager::tOperationResult CSettingsManager::storeRegexConfigCustomPath(const QString &filePath) const
 {
-    CSettingsManager::tOperationResult result;
-    result.bResult = false;
-
-    QFile jsonFile(filePath);
-
-    if(jsonFile.open(QFile::WriteOnly))
-    {
-        QJsonArray settingsArray;
-
-        for(auto* pSettingItem : mPatternsSettingItemPtrVec)
-        {
-            settingsArray.append(pSettingItem->writeData());
-        }
+    return writeSettingsFile(filePath, getRegexConfigData());
+}
 
-        QJsonDocument jsonDoc( settingsArray );
-        jsonFile.write( jsonDoc.toJson() );
+QJsonArray CSettingsManager::getRegexConfigData() const
+{
+    QJsonArray settingsArray;
 
-        result.bResult = true;
-    }
-    else
+    for(auto* pSettingItem : mPatternsSettingItemPtrVec)
     {
-        result.bResult = false;
-        result.err = QString("[%1] Failed to open file - \"%2\"").arg(__FUNCTION__).arg(filePath);
+        settingsArray.append(pSettingItem->writeData());
     }
 
-    return result;
+    return settingsArray;
 }
 
 CSettingsManager::tOperationResult CSettingsManager::loadRegexConfigCustomPath(const QString &filePath)
@@ -2368,35 +2687,21 @@ void CSettingsManager::clearRegexConfig()
 CSettingsManager::tOperationResult
 CSettingsManager::storeRegexUsageStatisticsDataCustomPath( const QString& filePath ) const
 {
-    CSettingsManager::tOperationResult result;
-    result.bResult = false;
-
-    QFile jsonFile(filePath);
-
-    if(jsonFile.open(QFile::WriteOnly))
-    {
-        QJsonArray settingsArray;
-
-        for(auto* pSettingItem : mRegexUsageStatisticsDataItemPtrVec)
-        {
-            settingsArray.append(pSettingItem->writeData());
-        }
+    return writeSettingsFile(filePath, getRegexUsageStatisticsData());
+}
 
-        QJsonDocument jsonDoc( settingsArray );
-        jsonFile.write( jsonDoc.toJson() );
+QJsonArray CSettingsManager::getRegexUsageStatisticsData() const
+{
+    QJsonArray settingsArray;
 
-        result.bResult = true;
-    }
-    else
+    for(auto* pSettingItem : mRegexUsageStatisticsDataItemPtrVec)
     {
-        result.bResult = false;
-        result.err = QString("[%1] Failed to open file - \"%2\"").arg(__FUNCTION__).arg(filePath);
+        settingsArray.append(pSettingItem->writeData());
     }
 
-    return result;
+    return settingsArray;
 }
 
-
 CSettingsManager::tOperationResult
 CSettingsManager::loadRegexUsageStatisticsDataCustomPath( const QString& filePath )
 {
@@ -2448,42 +2753,27 @@ CSettingsManager::tOperationResult  CSettingsManager::storeSettingsConfig()
 
 CSettingsManager::tOperationResult CSettingsManager::storeSettingsConfigCustomPath(const QString& filepath)
 {
-    CSettingsManager::tOperationResult result;
-    result.bResult = false;
+    return writeSettingsFile(filepath, getSettingsConfigData());
+}
 
-    QFile jsonFile(filepath);
+QJsonArray CSettingsManager::getSettingsConfigData() const
+{
+    QJsonArray settingsArray;
 
-    if(jsonFile.open(QFile::WriteOnly))
+    for( auto* pSetting : mUserSettingItemPtrVec )
     {
-        QJsonArray settingsArray;
-
-        for( auto* pSetting : mUserSettingItemPtrVec )
+        if(pSetting == &mSetting_SearchResultHighlightingGradient)
         {
-            if(pSetting == &mSetting_SearchResultHighlightingGradient)
-            {
-                std::lock_guard<std::recursive_mutex> lock(*const_cast<std::recursive_mutex*>(&mSearchResultHighlightingGradientProtector));
-                settingsArray.append(pSetting->writeData());
-            }
-            else
-            {
-                settingsArray.append(pSetting->writeData());
-            }
+            std::lock_guard<std::recursive_mutex> lock(*const_cast<std::recursive_mutex*>(&mSearchResultHighlightingGradientProtector));
+            settingsArray.append(pSetting->writeData());
+        }
+        else
+        {
+            settingsArray.append(pSetting->writeData());
         }
-
-        QJsonDocument jsonDoc( settingsArray );
-        // Uncomment this to see the content of the generated file
-        //qDebug() << "doc - " << jsonDoc.toJson();
-        jsonFile.write( jsonDoc.toJson() );
-
-        result.bResult = true;
-    }
-    else
-    {
-        result.bResult = false;
-        result.err = QString("[%1] Failed to open file - \"%2\"").arg(__FUNCTION__).arg(filepath);
     }
 
-    return result;
+    return settingsArray;
 }
 
 CSettingsManager::tOperationResult CSettingsManager::loadSettingsConfigCustomPath(const QString& filepath)
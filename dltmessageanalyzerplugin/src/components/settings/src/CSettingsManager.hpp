@@ -8,6 +8,11 @@
 
 #include "memory"
 #include <mutex>
+#include <map>
+
+#include "QTimer"
+#include "QThreadPool"
+#include "QJsonArray"
 
 #include "../api/ISettingsManager.hpp"
 #include "TSettingItem.hpp"
@@ -23,6 +28,8 @@ public:
      */
     CSettingsManager();
 
+    ~CSettingsManager() override;
+
     tOperationResult storeConfigs() override;
     tOperationResult loadConfigs() override;
 
@@ -91,6 +98,8 @@ public:
     void setUML_ShowArguments(const bool& val) override;
     void setUML_WrapOutput(const bool& val) override;
     void setUML_Autonumber(const bool& val) override;
+    void setUML_RenderServerMode(const bool& val) override;
+    void setUML_RowsPerDiagramPage(const int& val) override;
     void setPlotViewFeatureActive(const bool& val) override;
     void setFiltersCompletion_CaseSensitive(const bool& val) override;
     void setFiltersCompletion_MaxNumberOfSuggestions(const int& val) override;
@@ -98,6 +107,14 @@ public:
     void setFiltersCompletion_CompletionPopUpWidth(const int& val) override;
     void setFiltersCompletion_SearchPolicy(const bool& val) override;
     void setSearchViewLastColumnWidthStrategy(const int& val) override;
+    void setSearchResultRetention_MaxMatches(const int& val) override;
+    void setSearchResultRetention_MaxSeconds(const int& val) override;
+    void setRegexMatchLimit(const int& val) override;
+    void setRegexDepthLimit(const int& val) override;
+    void setRegexMessageTimeBudgetMs(const int& val) override;
+    void setRegexCostProfiling(const bool& val) override;
+    void setSearchFocusFirst(const bool& val) override;
+    void setSearchPreview(const bool& val) override;
     void setPlantumlPathMode(const int& val) override;
     void setPlantumlPathEnvVar(const QString& val) override;
     void setPlantumlCustomPath(const QString& val) override;
@@ -158,6 +175,8 @@ public:
     const bool& getUML_ShowArguments() const override;
     const bool& getUML_WrapOutput() const override;
     const bool& getUML_Autonumber() const override;
+    const bool& getUML_RenderServerMode() const override;
+    const int& getUML_RowsPerDiagramPage() const override;
     const bool& getPlotViewFeatureActive() const override;
     const bool& getFiltersCompletion_CaseSensitive() const override;
     const int& getFiltersCompletion_MaxNumberOfSuggestions() const override;
@@ -165,6 +184,14 @@ public:
     const int& getFiltersCompletion_CompletionPopUpWidth() const override;
     const bool& getFiltersCompletion_SearchPolicy() const override;
     const int& getSearchViewLastColumnWidthStrategy() const override;
+    const int& getSearchResultRetention_MaxMatches() const override;
+    const int& getSearchResultRetention_MaxSeconds() const override;
+    const int& getRegexMatchLimit() const override;
+    const int& getRegexDepthLimit() const override;
+    const int& getRegexMessageTimeBudgetMs() const override;
+    const bool& getRegexCostProfiling() const override;
+    const bool& getSearchFocusFirst() const override;
+    const bool& getSearchPreview() const override;
     const int& getPlantumlPathMode() const override;
     const QString& getPlantumlPathEnvVar() const override;
     const QString& getPlantumlCustomPath() const override;
@@ -310,6 +337,42 @@ private: // methods
      */
     void tryStoreRootConfig();
 
+    enum class eSettingsFile
+    {
+        Root = 0,
+        User,
+        Regex
+    };
+
+    /**
+     * @brief scheduleStore - marks the file as dirty. All dirty files are stored in the background
+     * after the short delay, so that the burst of updates results in a single write of each file.
+     * @param settingsFile - file to be stored
+     */
+    void scheduleStore(const eSettingsFile& settingsFile);
+
+    /**
+     * @brief flushPendingStores - serializes content of all dirty files and passes it to the background writer
+     */
+    void flushPendingStores();
+
+    /**
+     * @brief storeAsync - writes the content to the file in the background thread
+     * @param filePath - path to the target file
+     * @param settingsArray - content of the file
+     */
+    void storeAsync(const QString& filePath, const QJsonArray& settingsArray);
+
+    /**
+     * @brief waitForAsyncStores - blocks till all background writes are finished
+     */
+    void waitForAsyncStores();
+
+    QJsonArray getRootConfigData() const;
+    QJsonArray getSettingsConfigData() const;
+    QJsonArray getRegexConfigData() const;
+    QJsonArray getRegexUsageStatisticsData() const;
+
     TSettingItem<bool> createBooleanSettingsItem(const QString& key,
                                                  const TSettingItem<bool>::tUpdateDataFunc& updateDataFunc,
                                                  const TSettingItem<bool>::tUpdateSettingsFileFunc& updateFileFunc,
@@ -483,6 +546,8 @@ private: // fields
     TSettingItem<bool> mSetting_UML_ShowArguments;
     TSettingItem<bool> mSetting_UML_WrapOutput;
     TSettingItem<bool> mSetting_UML_Autonumber;
+    TSettingItem<bool> mSetting_UML_RenderServerMode;
+    TSettingItem<int> mSetting_UML_RowsPerDiagramPage;
 
     // Plot view settings
     std::recursive_mutex mPlotViewFeatureActiveProtector;
@@ -500,6 +565,16 @@ private: // fields
     TSettingItem<bool> mSetting_RegexCompletion_SearchPolicy; // 0 - startWith; 1 - contains
 
     TRangedSettingItem<int> mSetting_SearchViewLastColumnWidthStrategy;
+    TRangedSettingItem<int> mSetting_SearchResultRetention_MaxMatches;
+    TRangedSettingItem<int> mSetting_SearchResultRetention_MaxSeconds;
+
+    // Regex execution limits. 0 - no limit
+    TRangedSettingItem<int> mSetting_RegexMatchLimit;
+    TRangedSettingItem<int> mSetting_RegexDepthLimit;
+    TRangedSettingItem<int> mSetting_RegexMessageTimeBudgetMs;
+    TSettingItem<bool> mSetting_RegexCostProfiling;
+    TSettingItem<bool> mSetting_SearchFocusFirst;
+    TSettingItem<bool> mSetting_SearchPreview;
 
     // Plantuml path settings
     TRangedSettingItem<int> mSetting_PlantumlPathMode;
@@ -528,5 +603,12 @@ private: // fields
     tSettingItemsPtrVec mPatternsSettingItemPtrVec;
     tSettingItemsPtrVec mRegexUsageStatisticsDataItemPtrVec;
 
+    // dirty files, which are waiting to be stored. Path is resolved at the moment of the update.
+    typedef std::map<eSettingsFile, QString /*file path*/> tDirtySettingsFilesMap;
+    tDirtySettingsFilesMap mDirtySettingsFiles;
+    QTimer mStoreSettingsTimer;
+    // single thread, so that the writes to the same file are done in the order of their scheduling
+    QThreadPool mStoreSettingsThreadPool;
+
     bool mbInitialised;
 };
@@ -21,6 +21,8 @@
 #include "components/log/api/CLog.hpp"
 
 #include "plugin/api/form.h"
+#include "plugin/api/CHeadlessBenchmark.hpp"
+#include "plugin/api/CHeadlessSearch.hpp"
 
 #include "components/analyzer/api/CAnalyzerComponent.hpp"
 #include "components/log/api/CLogComponent.hpp"
@@ -49,8 +51,6 @@
 
 #include "DMA_Plantuml.hpp"
 
-Q_DECLARE_METATYPE(tMsgWrapperPtr)
-
 DLTMessageAnalyzerPlugin::DLTMessageAnalyzerPlugin():
 mpForm(nullptr),
 mpDLTMessageAnalyzer(nullptr),
@@ -78,9 +78,11 @@ mDisconnectionTimer()
 #ifndef PLUGIN_API_COMPATIBILITY_MODE_1_0_0
 ,mpMainTableView(nullptr)
 #endif
+,mIngestionMutex()
+,mIngestionBuffer()
+,mIngestedBlock()
 {
     //qDebug() << "DLTMessageAnalyzerPlugin lives in thread - " << QThread::currentThreadId();
-    qRegisterMetaType<tMsgWrapperPtr>("tMsgWrapperPtr");
 
     DMA::PlantUML::Creator::getInstance().initialize();
     DMA::PlantUML::Creator::getInstance().setBackgroundColor("#FEFEFE");
@@ -389,7 +391,7 @@ QWidget* DLTMessageAnalyzerPlugin::initViewer()
     }
 
     connect(mpGroupedViewComponent->getGroupedView(), &CGroupedView::searchViewHighlightingRequested,
-            this, [this](const tMsgIdSet& msgs)
+            this, [this](const tMsgIdBitmap& msgs)
     {
         auto pSearchModel = mpSearchViewComponent->getSearchResultModel();
         auto* pSearchView = mpSearchViewComponent->getSearchResultView();
@@ -400,7 +402,16 @@ QWidget* DLTMessageAnalyzerPlugin::initViewer()
            nullptr != mpGroupedViewComponent->getGroupedView())
         {
             pSearchModel->setHighlightedRows(msgs);
-            auto jumpRow = pSearchModel->getRowByMsgId(*msgs.begin());
+
+            tMsgIdBitmap::tValue firstMsgId = 0u;
+
+            if(false == msgs.select(0u, firstMsgId))
+            {
+                // nothing to jump to
+                return;
+            }
+
+            auto jumpRow = pSearchModel->getRowByMsgId(static_cast<tMsgId>(firstMsgId));
 
             if(jumpRow >= 0)
             {
@@ -622,6 +633,23 @@ bool DLTMessageAnalyzerPlugin::command(QString command, QList<QString> params)
         mComponents.push_back(pSettingsComponent);
     }
 
+    if(nullptr == mpLogsWrapperComponent)
+    {
+        auto pLogsWrapperComponent = std::make_shared<CLogsWrapperComponent>();
+        mpLogsWrapperComponent = pLogsWrapperComponent;
+
+        auto initResult = pLogsWrapperComponent->startInit();
+
+        if(false == initResult.bIsOperationSuccessful)
+        {
+            mErrorString = QString("Failed to initialize %1").arg(pLogsWrapperComponent->getName());
+            SEND_ERR(mErrorString);
+            return false;
+        }
+
+        mComponents.push_back(pLogsWrapperComponent);
+    }
+
     if(nullptr == mpHeadlessConsoleInputProcessor)
     {
         const auto pSettingsManager = nullptr != mpSettingsComponent
@@ -629,6 +657,14 @@ bool DLTMessageAnalyzerPlugin::command(QString command, QList<QString> params)
                                     : tSettingsManagerPtr();
         mpHeadlessConsoleInputProcessor = std::make_shared<CConsoleInputProcessor>(nullptr,
                                                                                    pSettingsManager);
+
+        // the search and benchmark scenarios depend on the analyzer, thus it is registered from the outside of the log component
+        mpHeadlessConsoleInputProcessor->addScenario("search",
+                                                     CHeadlessSearch::createScenarioData(pSettingsManager,
+                                                                                         mpLogsWrapperComponent));
+        mpHeadlessConsoleInputProcessor->addScenario("benchmark",
+                                                     CHeadlessBenchmark::createScenarioData(pSettingsManager,
+                                                                                            mpLogsWrapperComponent));
     }
 
     if(false == mpHeadlessConsoleInputProcessor->processCommand(command, params))
@@ -642,6 +678,12 @@ bool DLTMessageAnalyzerPlugin::command(QString command, QList<QString> params)
 
 void DLTMessageAnalyzerPlugin::initFileStart(QDltFile *file)
 {
+    {
+        // messages of the previous file should not get into the new one
+        std::lock_guard<std::mutex> lock(mIngestionMutex);
+        mIngestionBuffer.clear();
+    }
+
     if(nullptr != mpLogsWrapperComponent)
     {
         mpFile = mpLogsWrapperComponent->createDLTFileWrapper(file);
@@ -704,19 +746,37 @@ void DLTMessageAnalyzerPlugin::initMsgDecoded(int index, QDltMsg &msg)
 
         tMsgWrapperPtr pMessageWrapper = mpLogsWrapperComponent->createDLTMsgWrapper(msg);
 
+        bool bScheduleFlush = false;
+
         //qDebug() << "initMsgDecoded comes from thread - " << QThread::currentThreadId();
-        QMetaObject::invokeMethod(this, "initMsgDecodedForwarded", Qt::QueuedConnection,
-                                  Q_ARG(int, index),
-                                  Q_ARG(tMsgWrapperPtr, pMessageWrapper));
+        {
+            std::lock_guard<std::mutex> lock(mIngestionMutex);
+            // one flush is requested per non-empty buffer. Everything decoded till its execution goes in the same block
+            bScheduleFlush = mIngestionBuffer.empty();
+            mIngestionBuffer.emplace_back(index, std::move(pMessageWrapper));
+        }
+
+        if(true == bScheduleFlush)
+        {
+            QMetaObject::invokeMethod(this, "flushIngestionBuffer", Qt::QueuedConnection);
+        }
     }
 }
 
-void DLTMessageAnalyzerPlugin::initMsgDecodedForwarded(int index, tMsgWrapperPtr pMessageWrapper)
+void DLTMessageAnalyzerPlugin::flushIngestionBuffer()
 {
-    if(nullptr != mpFile)
     {
-        mpFile->cacheMsgWrapper(index, pMessageWrapper);
+        std::lock_guard<std::mutex> lock(mIngestionMutex);
+        // capacity of the previous block is reused by the decoding side
+        mIngestedBlock.swap(mIngestionBuffer);
     }
+
+    if(nullptr != mpFile && false == mIngestedBlock.empty())
+    {
+        mpFile->cacheMsgWrappers(mIngestedBlock);
+    }
+
+    mIngestedBlock.clear();
 }
 
 void DLTMessageAnalyzerPlugin::initFileFinish()
@@ -850,9 +910,11 @@ void DLTMessageAnalyzerPlugin::updateMsg(int, QDltMsg &)
 
 }
 
-void DLTMessageAnalyzerPlugin::updateMsgDecoded(int, QDltMsg &)
+void DLTMessageAnalyzerPlugin::updateMsgDecoded(int index, QDltMsg &msg)
 {
-
+    // messages, which are received during the online session, are processed in the same way as the initial ones.
+    // That feeds the tail mode of the continuous search.
+    initMsgDecoded(index, msg);
 }
 
 void DLTMessageAnalyzerPlugin::updateFileFinish()
@@ -1033,6 +1095,8 @@ PUML_PACKAGE_BEGIN(DMA_Plugin)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CLogsWrapperComponent, 1, 1, contains)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CPlotViewComponent, 1, 1, contains)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CRegexHistoryComponent, 1, 1, contains)
+        PUML_USE_DEPENDENCY_CHECKED(CHeadlessSearch, 1, 1, provides headless search command)
+        PUML_USE_DEPENDENCY_CHECKED(CHeadlessBenchmark, 1, 1, provides headless benchmark command)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(CCoverageNoteComponent, 1, 1, contains)
         PUML_COMPOSITION_DEPENDENCY_CHECKED(QTimer, 1, 1, contains)
     PUML_CLASS_END()
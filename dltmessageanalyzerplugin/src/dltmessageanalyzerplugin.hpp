@@ -7,6 +7,7 @@
 #pragma once
 
 #include "memory"
+#include "mutex"
 
 #include <QObject>
 #include <QTimer>
@@ -94,7 +95,11 @@ signals:
     void analysisWithEmptyStringRequested();
 
 public slots:
-    void initMsgDecodedForwarded(int index, tMsgWrapperPtr pMsg);
+    /**
+     * @brief flushIngestionBuffer - hands over the decoded messages to the file wrapper as a single block.
+     * Executed in the main thread.
+     */
+    void flushIngestionBuffer();
 
 private: // methods
 
@@ -174,4 +179,9 @@ private: // members
 #ifndef PLUGIN_API_COMPATIBILITY_MODE_1_0_0
     QTableView* mpMainTableView;
 #endif
+
+    // decoded messages, which are waiting to be handed over to the file wrapper
+    std::mutex mIngestionMutex;
+    tMsgWrapperBlock mIngestionBuffer;
+    tMsgWrapperBlock mIngestedBlock;
 };
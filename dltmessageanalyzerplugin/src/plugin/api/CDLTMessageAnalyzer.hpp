@@ -22,11 +22,13 @@
 
 
 #include "common/Definitions.hpp"
+#include "common/TLRUCache.hpp"
 #include "components/analyzer/api/IDLTMessageAnalyzerControllerConsumer.hpp"
 #include "components/settings/api/CSettingsManagerClient.hpp"
 #include "components/coverageNote/api/ICoverageNoteProvider.hpp"
 
 #include "QElapsedTimer"
+#include "QTimer"
 
 class QRegularExpression;
 class QCheckBox;
@@ -46,6 +48,8 @@ class ISearchResultModel;
 class CTableMemoryJumper;
 class CCustomPlotExtended;
 class CRegexHistoryTextEdit;
+class CSearchPreview;
+struct tSearchPreviewResult;
 
 /**
  * @brief The CDLTMessageAnalyzer class - used as a main controller of the plugin.
@@ -249,6 +253,26 @@ signals:
 
         void updateProgress(int progress, eRequestState requestState, bool silent);
 
+        /**
+         * @brief applyRegexCostProfile - forwards the regex cost profile to the filters view and
+         * attributes the cost of the alternation branches to the patterns, which were combined into the regex
+         * @param regexCostProfile - profile of the finished analysis
+         */
+        void applyRegexCostProfile(const tRegexCostProfile& regexCostProfile);
+
+        /**
+         * @brief scheduleSearchPreview - schedules the preview of the regex, which is being typed.
+         * Preview is not done, while the analysis is running
+         */
+        void scheduleSearchPreview();
+
+        /**
+         * @brief showSearchPreview - shows the first matches of the preview in the search view
+         * and in the filters view, and the estimated number of matches in the status label
+         * @param searchPreviewResult - result of the preview
+         */
+        void showSearchPreview(const tSearchPreviewResult& searchPreviewResult);
+
         std::shared_ptr<QRegularExpression> createRegex( const QString& regex,
                                                          const QString& onSuccessMessages,
                                                          const QString& onFailureMessages,
@@ -263,6 +287,14 @@ signals:
                                                          CRegexHistoryTextEdit* pRegexTextEdit,
                                                          QWidget* pErrorAnimationWidget = nullptr);
 
+        /**
+         * @brief getCompiledRegex - gets the compiled and optimized regex. Recently used regexes are taken from the cache.
+         * @param regex - pattern of the regex
+         * @param patternOptions - options of the regex
+         * @return - instance of the regex. Might be invalid
+         */
+        QRegularExpression getCompiledRegex( const QString& regex, const QRegularExpression::PatternOptions& patternOptions );
+
         void updateStatusLabel( const QString& text, bool isError = false );
         void processOverwritePattern(const QString& alias, const QString checkedRegex, const QModelIndex editItem = QModelIndex());
 
@@ -273,6 +305,17 @@ signals:
         void handleLoadedConfig();
         void resetSearchRange();
         bool isContinuousAnalysis() const;
+
+        /**
+         * @brief applySearchResultRetentionPolicy - evicts the oldest matches of the continuous analysis,
+         * which do not fit into the retention limits, from the search view, grouped view and completion data.
+         */
+        void applySearchResultRetentionPolicy();
+
+        /**
+         * @brief updateSearchResultRetentionTimer - runs the periodic eviction, if the age limit of the matches is set
+         */
+        void updateSearchResultRetentionTimer();
         void hidePatternLogic(bool userTriggered);
         void updatePatternsInPersistency();
 
@@ -316,6 +359,15 @@ signals:
         int mNumberOfDots;
         bool mbIsConnected;
         tFileWrapperPtr mpFile;
+        // grouped view indices of the current analysis. Used to remove the evicted matches from the grouped view
+        tGroupedViewIndices mGroupedViewIndices;
+        // aliases of the patterns, which were combined into the regex of the current analysis
+        QStringList mSelectedAliases;
+
+        // compiled regexes share their JIT-compiled code between the copies
+        typedef std::pair<QString /*pattern*/, int /*pattern options*/> tCompiledRegexKey;
+        typedef TLRUCache<tCompiledRegexKey, QRegularExpression> tCompiledRegexCache;
+        tCompiledRegexCache mCompiledRegexCache;
 
 #ifndef PLUGIN_API_COMPATIBILITY_MODE_1_0_0
         QDltMessageDecoder* mpMessageDecoder;
@@ -324,13 +376,12 @@ signals:
         QDltPluginManager mPluginManager;
 #endif
         std::shared_ptr<CRegexDirectoryMonitor> mpRegexDirectoryMonitor;
+        std::shared_ptr<CSearchPreview> mpSearchPreview;
 
         // timers
-#ifdef DEBUG_BUILD
-        QElapsedTimer mMeasurementNotificationTimer;
-#endif
-
         QElapsedTimer mMeasurementRequestTimer;
+        // evicts the outdated matches, while no new ones arrive
+        QTimer mSearchResultRetentionTimer;
         std::shared_ptr<CTableMemoryJumper> mpSearchViewTableJumper;
         std::weak_ptr<IDLTLogsWrapperCreator> mpDLTLogsWrapperCreator;
 
@@ -0,0 +1,78 @@
+/**
+ * @file    CHeadlessBenchmark.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CHeadlessBenchmark class
+ */
+
+#pragma once
+
+#include "memory"
+
+#include "QString"
+
+#include "common/Definitions.hpp"
+#include "components/log/src/CConsoleInputProcessor.hpp"
+#include "components/settings/api/CSettingsManagerClient.hpp"
+
+/**
+ * @brief The CHeadlessBenchmark class - reproducible end-to-end benchmark of the analysis pipeline.
+ * Generates the synthetic dlt trace, runs the set of representative regexes over it with the help of
+ * CHeadlessSearch and stores the throughput, latency percentiles and peak RSS to the JSON report.
+ * Reports of the different commits can be compared to track the performance regressions.
+ */
+class CHeadlessBenchmark : public CSettingsManagerClient
+{
+public:
+
+    enum class ePayloadDistribution
+    {
+        eUniform = 0,
+        eNormal
+    };
+
+    struct tParameters
+    {
+        // number of messages in the generated trace
+        int numberOfMessages = 100000;
+        // min and max payload size in characters
+        int minPayloadSize = 20;
+        int maxPayloadSize = 200;
+        ePayloadDistribution payloadDistribution = ePayloadDistribution::eUniform;
+        // seed of the pseudo-random generator. The same seed produces the same trace
+        unsigned int seed = 42u;
+        // version of the dlt protocol of the generated trace. 1 or 2
+        int dltVersion = 2;
+        // number of runs of each regex
+        int numberOfIterations = 3;
+        // overall number of the analysis threads. Values less or equal to 0 mean QThread::idealThreadCount()
+        int numberOfThreads = 0;
+        // directory, in which the trace is generated. Empty value means the temporary directory
+        QString workingDirectory;
+        // file, to which the report is written
+        QString reportFilePath;
+        // free-form label, e.g. commit id, which is stored in the report
+        QString label;
+    };
+
+    CHeadlessBenchmark( const tSettingsManagerPtr& pSettingsManager,
+                        const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator );
+
+    /**
+     * @brief run - runs the benchmark and blocks till it is finished
+     * @param parameters - parameters of the benchmark
+     * @return - true, if the report was successfully written. False otherwise
+     */
+    bool run( const tParameters& parameters );
+
+    /**
+     * @brief createScenarioData - creates the "benchmark" command of the console input processor
+     * @param pSettingsManager - settings manager instance
+     * @param pDLTLogsWrapperCreator - creator of the file wrappers
+     * @return - scenario data, which can be registered within the console input processor
+     */
+    static CConsoleInputProcessor::tScenarioData createScenarioData( const tSettingsManagerPtr& pSettingsManager,
+                                                                     const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator );
+
+private:
+    std::shared_ptr<IDLTLogsWrapperCreator> mpDLTLogsWrapperCreator;
+};
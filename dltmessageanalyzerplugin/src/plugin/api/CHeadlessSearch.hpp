@@ -0,0 +1,93 @@
+/**
+ * @file    CHeadlessSearch.hpp
+ * @author  vgoncharuk
+ * @brief   Declaration of the CHeadlessSearch class
+ */
+
+#pragma once
+
+#include "memory"
+#include "vector"
+
+#include "QString"
+#include "QStringList"
+
+#include "common/Definitions.hpp"
+#include "components/log/src/CConsoleInputProcessor.hpp"
+#include "components/settings/api/CSettingsManagerClient.hpp"
+
+/**
+ * @brief The CHeadlessSearch class - runs the multi-threaded analysis over the set of dlt files without any GUI.
+ * Found matches, per-file results and grouped view statistics are streamed in form of JSON-lines.
+ * Used by the "search" command of the headless console input processor, e.g. for the CI logs triage.
+ * Note! Should be used from the thread, which has no running analysis, as it spins its own event loop.
+ */
+class CHeadlessSearch : public CSettingsManagerClient
+{
+public:
+
+    struct tParameters
+    {
+        // dlt files or directories with dlt files, which should be analyzed
+        QStringList paths;
+        // regex, which should be used for the search. Has priority over the aliases
+        QString regex;
+        // aliases of the saved patterns, which should be combined into the search regex
+        QStringList aliases;
+        // overall number of the analysis threads. Values less or equal to 0 mean QThread::idealThreadCount()
+        int numberOfThreads = 0;
+        // number of files, which are analyzed at the same time. Values less or equal to 0 mean "as many as threads"
+        int numberOfParallelFiles = 0;
+        // file, to which the JSON-lines are written. Empty value means stdout
+        QString outputFilePath;
+        // whether only the statistics lines should be written, without the lines of the found matches
+        bool bStatisticsOnly = false;
+        // whether the JSON-lines should be written at all. E.g. benchmark is interested only in the result
+        bool bWriteJSONLines = true;
+        // whether UML and plot view data should be extracted from the matches
+        bool bUMLFeatureActive = false;
+        bool bPlotViewFeatureActive = false;
+        // optional time window. Only messages within it are analyzed
+        tTimeRange timeRange;
+    };
+
+    typedef std::vector<qint64> tDurationsUs;
+
+    struct tResult
+    {
+        // whether all files were analyzed without errors
+        bool bIsSuccessful = false;
+        int numberOfMatches = 0;
+        int numberOfAnalyzedFiles = 0;
+        int numberOfFailedFiles = 0;
+        qint64 numberOfMessages = 0;
+        // opening and indexing of each file
+        tDurationsUs indexingDurationsUs;
+        // analysis of each successfully analyzed file
+        tDurationsUs analysisDurationsUs;
+        // time between the consecutive deliveries of the analyzed chunks
+        tDurationsUs chunkLatenciesUs;
+    };
+
+    CHeadlessSearch( const tSettingsManagerPtr& pSettingsManager,
+                     const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator );
+
+    /**
+     * @brief run - runs the search and blocks till all files are analyzed
+     * @param parameters - parameters of the search
+     * @return - result of the search
+     */
+    tResult run( const tParameters& parameters );
+
+    /**
+     * @brief createScenarioData - creates the "search" command of the console input processor
+     * @param pSettingsManager - settings manager instance
+     * @param pDLTLogsWrapperCreator - creator of the file wrappers
+     * @return - scenario data, which can be registered within the console input processor
+     */
+    static CConsoleInputProcessor::tScenarioData createScenarioData( const tSettingsManagerPtr& pSettingsManager,
+                                                                     const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator );
+
+private:
+    std::shared_ptr<IDLTLogsWrapperCreator> mpDLTLogsWrapperCreator;
+};
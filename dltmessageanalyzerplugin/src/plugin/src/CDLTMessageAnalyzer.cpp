@@ -40,6 +40,7 @@
 #include "components/searchView/api/CSearchResultView.hpp"
 #include "components/searchView/api/ISearchResultModel.hpp"
 #include "components/analyzer/api/IDLTMessageAnalyzerController.hpp"
+#include "components/analyzer/api/CSearchPreview.hpp"
 #include "common/CBGColorAnimation.hpp"
 #include "components/patternsView/api/CPatternsView.hpp"
 #include "components/filtersView/api/CFiltersView.hpp"
@@ -47,6 +48,7 @@
 #include "components/log/api/CLog.hpp"
 #include "components/plant_uml/api/CUMLView.hpp"
 #include "common/CTableMemoryJumper.hpp"
+#include "common/CPerfCounters.hpp"
 #include "common/CQtHelper.hpp"
 #include "components/plotView/api/CCustomPlotExtended.hpp"
 
@@ -56,6 +58,9 @@
 
 #include "DMA_Plantuml.hpp"
 
+// number of the recently used regexes, which are kept compiled
+static const std::size_t sCompiledRegexCacheSize = 16u;
+
 namespace NShortcuts
 {
     static bool isSaveRegexPatternShortcut( QKeyEvent * pEvent )
@@ -111,18 +116,20 @@ CDLTMessageAnalyzer::CDLTMessageAnalyzer(const std::weak_ptr<IDLTMessageAnalyzer
     mRequestId(INVALID_REQUEST_ID),
     mNumberOfDots(0),
     mbIsConnected(false),
+    mGroupedViewIndices(),
+    mSelectedAliases(),
+    mCompiledRegexCache(sCompiledRegexCacheSize),
 #ifndef PLUGIN_API_COMPATIBILITY_MODE_1_0_0
     mpMessageDecoder(nullptr),
 #else
     mDecoderPluginsList(),
     mPluginManager(),
 #endif
-    mpRegexDirectoryMonitor(nullptr)
+    mpRegexDirectoryMonitor(nullptr),
+    mpSearchPreview(nullptr)
   // timers
-  #ifdef DEBUG_BUILD
-  , mMeasurementNotificationTimer()
-  #endif
   , mMeasurementRequestTimer()
+  , mSearchResultRetentionTimer()
   , mpSearchViewTableJumper(pSearchViewTableJumper)
   , mpDLTLogsWrapperCreator(pDLTLogsWrapperCreator)
   , mpCustomPlotExtended(pCustomPlotExtended)
@@ -166,6 +173,29 @@ CDLTMessageAnalyzer::CDLTMessageAnalyzer(const std::weak_ptr<IDLTMessageAnalyzer
         }
     }
 
+    mpSearchPreview = std::make_shared<CSearchPreview>(getSettingsManager());
+
+    connect( mpSearchPreview.get(), &CSearchPreview::previewFinished, this, [this](const tSearchPreviewResult& searchPreviewResult)
+    {
+        showSearchPreview(searchPreviewResult);
+    });
+
+    connect( getSettingsManager().get(), &ISettingsManager::searchPreviewChanged, this, [this](const bool& searchPreview)
+    {
+        if(false == searchPreview)
+        {
+            mpSearchPreview->cancelPreview();
+        }
+    });
+
+    if(nullptr != mpRegexTextEdit)
+    {
+        connect( mpRegexTextEdit, &QTextEdit::textChanged, this, [this]()
+        {
+            scheduleSearchPreview();
+        });
+    }
+
     if(nullptr != mpProgressBar)
     {
         mpProgressBar->setRange(0, 100);
@@ -279,6 +309,17 @@ CDLTMessageAnalyzer::CDLTMessageAnalyzer(const std::weak_ptr<IDLTMessageAnalyzer
                 pContextMenu->addAction(pAction);
             }
 
+            {
+                QAction* pAction = new QAction("Preview while typing", mpRegexTextEdit);
+                connect(pAction, &QAction::triggered, this, [this](bool checked)
+                {
+                    getSettingsManager()->setSearchPreview(checked);
+                });
+                pAction->setCheckable(true);
+                pAction->setChecked(getSettingsManager()->getSearchPreview());
+                pContextMenu->addAction(pAction);
+            }
+
             pContextMenu->addSeparator();
 
             {
@@ -1188,6 +1229,67 @@ CDLTMessageAnalyzer::CDLTMessageAnalyzer(const std::weak_ptr<IDLTMessageAnalyzer
         createSequenceDiagram();
     });
 
+    connect(getSettingsManager().get(), &ISettingsManager::UML_RowsPerDiagramPageChanged,
+            this, [this](int)
+    {
+        createSequenceDiagram();
+    });
+
+    connect(getSettingsManager().get(), &ISettingsManager::searchResultRetention_MaxMatchesChanged,
+            this, [this](int)
+    {
+        applySearchResultRetentionPolicy();
+    });
+
+    connect(getSettingsManager().get(), &ISettingsManager::searchResultRetention_MaxSecondsChanged,
+            this, [this](int)
+    {
+        updateSearchResultRetentionTimer();
+        applySearchResultRetentionPolicy();
+    });
+
+    connect(&mSearchResultRetentionTimer, &QTimer::timeout, this, [this]()
+    {
+        applySearchResultRetentionPolicy();
+    });
+
+    updateSearchResultRetentionTimer();
+
+    if(nullptr != mpSearchResultModel && nullptr != mpUMLView)
+    {
+        connect(mpSearchResultModel.get(), &ISearchResultModel::UMLDiagramPageReady,
+                this, [this](int, const QString& diagramContent)
+        {
+            mpUMLView->addDiagramPage(diagramContent);
+        });
+
+        connect(mpSearchResultModel.get(), &ISearchResultModel::UMLDiagramContentGenerationFinished,
+                this, [this](int, int numberOfRows)
+        {
+            if(0 == numberOfRows)
+            {
+                mpUMLView->cancelDiagramGeneration();
+                SEND_WRN( "Can't form empty UML diagram. 0 rows from the \"Search view\" were selected for diagram's creation." );
+            }
+        });
+
+        connect(mpSearchResultModel.get(), &ISearchResultModel::UMLDiagramContentGenerationCancelled,
+                this, [this]()
+        {
+            // e.g. search result was reset or re-ordered, while the diagram was being generated
+            mpUMLView->cancelDiagramGeneration();
+        });
+
+        connect(mpUMLView, &CUMLView::diagramGenerationFinished, this, [this](bool success)
+        {
+            if(false == success)
+            {
+                // includes the cancellation by the user
+                mpSearchResultModel->cancelUMLDiagramContentGeneration();
+            }
+        });
+    }
+
     if(nullptr != mpRegexTextEdit)
     {
         mpRegexTextEdit->installEventFilter(this);
@@ -1263,16 +1365,9 @@ void CDLTMessageAnalyzer::createSequenceDiagram() const
 {
     if(nullptr != mpSearchResultModel && nullptr != mpUMLView)
     {
-        auto UMLResult = mpSearchResultModel->getUMLDiagramContent();
-
-        if(0 != UMLResult.first)
-        {
-            mpUMLView->generateUMLDiagram(UMLResult.second);
-        }
-        else
-        {
-            SEND_WRN( "Can't form empty UML diagram. 0 rows from the \"Search view\" were selected for diagram's creation." );
-        }
+        // content is produced in chunks. Pages are delivered to the view as soon as they are ready
+        mpUMLView->startDiagramPages();
+        mpSearchResultModel->startUMLDiagramContentGeneration(getSettingsManager()->getUML_RowsPerDiagramPage());
     }
 }
 
@@ -1340,6 +1435,29 @@ void CDLTMessageAnalyzer::handleLoadedConfig()
     }
 }
 
+QRegularExpression CDLTMessageAnalyzer::getCompiledRegex( const QString& regex, const QRegularExpression::PatternOptions& patternOptions )
+{
+    const tCompiledRegexKey compiledRegexKey(regex, static_cast<int>(patternOptions));
+
+    auto pCachedRegex = mCompiledRegexCache.find(compiledRegexKey);
+
+    if(nullptr != pCachedRegex)
+    {
+        return *pCachedRegex;
+    }
+
+    QRegularExpression result(regex, patternOptions);
+
+    if(true == result.isValid())
+    {
+        // compile and JIT-optimize the pattern now, instead of doing it within the first search
+        result.optimize();
+        mCompiledRegexCache.insert(compiledRegexKey, result);
+    }
+
+    return result;
+}
+
 std::shared_ptr<QRegularExpression> CDLTMessageAnalyzer::createRegex( const QString& regex,
                                                                       const QString& onSuccessMessages,
                                                                       const QString& onFailureMessages,
@@ -1354,7 +1472,7 @@ std::shared_ptr<QRegularExpression> CDLTMessageAnalyzer::createRegex( const QStr
                 QRegularExpression::NoPatternOption:
                 QRegularExpression::CaseInsensitiveOption;
 
-    std::shared_ptr<QRegularExpression> pResult = std::make_shared<QRegularExpression>(regex_, caseSensitiveOption);
+    std::shared_ptr<QRegularExpression> pResult = std::make_shared<QRegularExpression>(getCompiledRegex(regex_, caseSensitiveOption));
 
     if(0 != regex_.size())
     {
@@ -1405,7 +1523,7 @@ std::shared_ptr<QRegularExpression> CDLTMessageAnalyzer::createRegex( const QStr
                 QRegularExpression::NoPatternOption:
                 QRegularExpression::CaseInsensitiveOption;
 
-    std::shared_ptr<QRegularExpression> pResult = std::make_shared<QRegularExpression>(regex_, caseSensitiveOption);
+    std::shared_ptr<QRegularExpression> pResult = std::make_shared<QRegularExpression>(getCompiledRegex(regex_, caseSensitiveOption));
 
     if(0 != regex_.size())
     {
@@ -1614,6 +1732,12 @@ bool CDLTMessageAnalyzer::analyze(const QStringList* pSelectedAliases)
     mpFile->setMaxCacheSize( MBToB( static_cast<unsigned int>(getSettingsManager()->getCacheMaxSizeMB() ) ) );
     mpFile->setEnableCache( getSettingsManager()->getCacheEnabled() );
 
+    if(nullptr != mpSearchPreview)
+    {
+        // results of the full analysis replace the preview
+        mpSearchPreview->cancelPreview();
+    }
+
     tryStop();
 
     mpSearchResultModel->resetData();
@@ -1630,6 +1754,8 @@ bool CDLTMessageAnalyzer::analyze(const QStringList* pSelectedAliases)
         regex = mpRegexTextEdit->toPlainText();
     }
 
+    mSelectedAliases = nullptr != pSelectedAliases ? *pSelectedAliases : QStringList();
+
     if(nullptr != mpSearchResultView)
     {
         mpSearchResultView->newSearchStarted(regex);
@@ -1677,6 +1803,14 @@ bool CDLTMessageAnalyzer::analyze(const QStringList* pSelectedAliases)
             nullptr != pSelectedAliases ? *pSelectedAliases : QStringList()
         );
 
+        if(true == getSettingsManager()->getSearchFocusFirst() &&
+           nullptr != mpMainTableView &&
+           true == mpMainTableView->currentIndex().isValid())
+        {
+            // results around the message, which is selected in the main table, are delivered first
+            requestParameters.focusMessage = mpMainTableView->currentIndex().row();
+        }
+
         releaseMemoryToOS();
 
         auto requestId = requestAnalyze( requestParameters,
@@ -1690,9 +1824,6 @@ bool CDLTMessageAnalyzer::analyze(const QStringList* pSelectedAliases)
 
         if(true == bRunning)
         {
-#ifdef DEBUG_BUILD
-            mMeasurementNotificationTimer.restart();
-#endif
             mMeasurementRequestTimer.restart();
 
             analysisStatusChanged(true);
@@ -1717,6 +1848,73 @@ bool CDLTMessageAnalyzer::isContinuousAnalysis() const
     return bResult;
 }
 
+void CDLTMessageAnalyzer::applySearchResultRetentionPolicy()
+{
+    // retention limits are applicable only to the live sessions, which might grow forever
+    if( nullptr == mpSearchResultModel ||
+        INVALID_REQUEST_ID == mRequestId ||
+        false == isContinuousAnalysis() )
+    {
+        return;
+    }
+
+    const auto& maxMatches = getSettingsManager()->getSearchResultRetention_MaxMatches();
+    const auto& maxSeconds = getSettingsManager()->getSearchResultRetention_MaxSeconds();
+
+    if(0 == maxMatches && 0 == maxSeconds)
+    {
+        return;
+    }
+
+    const auto evictedMatches = mpSearchResultModel->evictMatches(maxMatches, maxSeconds);
+
+    if(true == evictedMatches.matchedItemVec.empty())
+    {
+        return;
+    }
+
+    const bool bGroupedViewActive = nullptr != mpGroupedViewModel &&
+                                    true == isGroupedViewFeatureActiveForCurrentAnalysis();
+
+    for(auto evictedMatchesIt = evictedMatches.matchedItemVec.begin();
+        evictedMatchesIt != evictedMatches.matchedItemVec.end();
+        ++evictedMatchesIt)
+    {
+        if(nullptr != *evictedMatchesIt)
+        {
+            if(true == bGroupedViewActive)
+            {
+                mpGroupedViewModel->removeMatches( mGroupedViewIndices,
+                                                   (*evictedMatchesIt)->getFoundMatches(),
+                                                   evictedMatchesIt + 1 == evictedMatches.matchedItemVec.end() );
+            }
+
+            if(nullptr != mpFiltersModel)
+            {
+                mpFiltersModel->removeCompletionData((*evictedMatchesIt)->getFoundMatches());
+            }
+        }
+    }
+}
+
+void CDLTMessageAnalyzer::updateSearchResultRetentionTimer()
+{
+    // age of the matches is checked once per second. Without the timer it would be checked only on arrival of the new matches
+    static const int sRetentionCheckPeriodMs = 1000;
+
+    if(0 != getSettingsManager()->getSearchResultRetention_MaxSeconds())
+    {
+        if(false == mSearchResultRetentionTimer.isActive())
+        {
+            mSearchResultRetentionTimer.start(sRetentionCheckPeriodMs);
+        }
+    }
+    else
+    {
+        mSearchResultRetentionTimer.stop();
+    }
+}
+
 void CDLTMessageAnalyzer::cancel()
 {
     if( nullptr == mpProgressBar ||
@@ -1858,17 +2056,163 @@ void CDLTMessageAnalyzer::updateProgress(int progress, eRequestState requestStat
     mpProgressBar->repaint();
 }
 
+void CDLTMessageAnalyzer::applyRegexCostProfile(const tRegexCostProfile& regexCostProfile)
+{
+    if(nullptr != mpFiltersModel)
+    {
+        mpFiltersModel->setRegexCostProfile(regexCostProfile);
+    }
+
+    if(nullptr == mpPatternsModel || true == mSelectedAliases.isEmpty())
+    {
+        return;
+    }
+
+    // restore the regex, which was combined from the selected patterns, to find out the ranges of the patterns
+    QString combinedRegex;
+    QVector<QPair<QString /*alias*/, tIntRange>> aliasRanges;
+
+    for(const auto& alias : mSelectedAliases)
+    {
+        auto searchResult = mpPatternsModel->search(alias);
+
+        if(false == searchResult.bFound)
+        {
+            return;
+        }
+
+        if(false == combinedRegex.isEmpty())
+        {
+            combinedRegex.append("|");
+        }
+
+        const auto aliasRegex = searchResult.foundIdx.sibling(searchResult.foundIdx.row(),
+                                                              static_cast<int>(ePatternsColumn::Regex)).data().value<QString>();
+        aliasRanges.push_back(qMakePair(alias, tIntRange(combinedRegex.size(), combinedRegex.size() + aliasRegex.size() - 1)));
+        combinedRegex.append(aliasRegex);
+    }
+
+    // patterns were edited after the start of the analysis
+    if(combinedRegex != regexCostProfile.regex)
+    {
+        return;
+    }
+
+    IPatternsModel::tPatternsCostMap patternsCostMap;
+
+    if(1 == aliasRanges.size() && true == regexCostProfile.branchDurationsNs.isEmpty())
+    {
+        patternsCostMap.insert(aliasRanges.front().first, regexCostProfile.getAverageDurationNs(regexCostProfile.overallDurationNs));
+    }
+    else
+    {
+        for(const auto& aliasRange : aliasRanges)
+        {
+            int64_t durationNs = 0;
+            bool bFound = false;
+
+            for(auto it = regexCostProfile.branchDurationsNs.begin(); it != regexCostProfile.branchDurationsNs.end(); ++it)
+            {
+                if(it.key().from >= aliasRange.second.from && it.key().from <= aliasRange.second.to)
+                {
+                    durationNs += it.value();
+                    bFound = true;
+                }
+            }
+
+            if(true == bFound)
+            {
+                patternsCostMap.insert(aliasRange.first, regexCostProfile.getAverageDurationNs(durationNs));
+            }
+        }
+    }
+
+    if(false == patternsCostMap.isEmpty())
+    {
+        mpPatternsModel->setPatternsCost(patternsCostMap);
+    }
+}
+
+void CDLTMessageAnalyzer::scheduleSearchPreview()
+{
+    if(nullptr == mpSearchPreview || nullptr == mpRegexTextEdit)
+    {
+        return;
+    }
+
+    const auto regex = mpRegexTextEdit->toPlainText();
+
+    // preview should not mix up with the results of the running analysis
+    if(false == getSettingsManager()->getSearchPreview() ||
+       nullptr == mpFile ||
+       0 == mpFile->size() ||
+       true == regex.isEmpty() ||
+       INVALID_REQUEST_ID != mRequestId)
+    {
+        mpSearchPreview->cancelPreview();
+        return;
+    }
+
+    auto caseSensitiveOption = getSettingsManager()->getCaseSensitiveRegex() ?
+                QRegularExpression::NoPatternOption:
+                QRegularExpression::CaseInsensitiveOption;
+
+    mpSearchPreview->schedulePreview(mpFile,
+                                     regex,
+                                     caseSensitiveOption,
+                                     getSettingsManager()->getSearchResultColumnsSearchMap());
+}
+
+void CDLTMessageAnalyzer::showSearchPreview(const tSearchPreviewResult& searchPreviewResult)
+{
+    if(INVALID_REQUEST_ID != mRequestId ||
+       nullptr == mpSearchResultModel ||
+       nullptr == mpGroupedViewModel ||
+       nullptr == mpFiltersModel)
+    {
+        return;
+    }
+
+    if(false == searchPreviewResult.errorString.isEmpty())
+    {
+        updateStatusLabel( QString("Preview. Regex error: %1").arg(searchPreviewResult.errorString), true );
+        return;
+    }
+
+    mpSearchResultModel->resetData();
+    mpSearchResultModel->setFile(mpFile);
+    mpGroupedViewModel->resetData();
+    mpFiltersModel->resetCompletionData();
+
+    if(nullptr != mpSearchResultView)
+    {
+        mpSearchResultView->newSearchStarted(searchPreviewResult.regexStr);
+    }
+
+    static_cast<void>(mpSearchResultModel->addNextMessageIdxVec(searchPreviewResult.firstMatches));
+
+    // capture groups of the previewed matches are shown in the filters view
+    for(const auto& pMatch : searchPreviewResult.firstMatches.matchedItemVec)
+    {
+        if(nullptr != pMatch)
+        {
+            mpFiltersModel->addCompletionData(pMatch->getFoundMatches());
+        }
+    }
+
+    updateStatusLabel( QString("Preview: ~%1 matches estimated ( %2 of %3 sampled messages matched%4 ). First %5 are shown. Press \"Enter\" to run the full search.")
+                       .arg(searchPreviewResult.estimatedNumberOfMatches)
+                       .arg(searchPreviewResult.numberOfMatchesInSample)
+                       .arg(searchPreviewResult.numberOfSampledMessages)
+                       .arg(true == searchPreviewResult.bTimeCapReached ? ", stopped by the time cap" : "")
+                       .arg(static_cast<int>(searchPreviewResult.firstMatches.matchedItemVec.size())),
+                       false );
+}
+
 void CDLTMessageAnalyzer::progressNotification(const tProgressNotificationData& progressNotificationData)
 {
     //qDebug() << "CDLTMessageAnalyzer::" << __FUNCTION__;
 
-    //#ifdef DEBUG_BUILD
-    //        qDebug() << QString("CDLTMessageAnalyzer::progressNotification: start; request id - %1; was waiting for - %2 ms")
-    //                    .arg(requestId)
-    //                    .arg(QLocale().toString(mMeasurementNotificationTimer.elapsed()), 4);
-    //        mMeasurementNotificationTimer.restart();
-    //#endif
-
     if(mRequestId == progressNotificationData.requestId)
     {
         if( nullptr == mpGroupedViewModel ||
@@ -1878,8 +2222,17 @@ void CDLTMessageAnalyzer::progressNotification(const tProgressNotificationData&
             return;
         }
 
+        CPerfScope perfScope(ePerfStage::eModelInsertion);
+
         //qDebug() << "CDLTMessageAnalyzer::" << __FUNCTION__ << ": progress - " << progress << "; requestStats - " << static_cast<int>(requestState);
 
+        mGroupedViewIndices = progressNotificationData.groupedViewIndices;
+
+        if(false == progressNotificationData.regexCostProfile.isEmpty())
+        {
+            applyRegexCostProfile(progressNotificationData.regexCostProfile);
+        }
+
         switch(progressNotificationData.requestState)
         {
             case eRequestState::SUCCESSFUL:
@@ -2003,15 +2356,9 @@ void CDLTMessageAnalyzer::progressNotification(const tProgressNotificationData&
                 mpSearchViewTableJumper->checkRows(checkSet);
             }
         }
-    }
-
-    //#ifdef DEBUG_BUILD
-    //        qDebug() << QString("CDLTMessageAnalyzer::progressNotification: end; request id - %1; method took - %2 ms")
-    //                    .arg(requestId)
-    //                    .arg(QLocale().toString(mMeasurementNotificationTimer.elapsed()), 4);
-    //        mMeasurementNotificationTimer.restart();
-    //#endif
 
+        applySearchResultRetentionPolicy();
+    }
 }
 
 void CDLTMessageAnalyzer::exportGroupedViewToHTML()
@@ -2603,6 +2950,12 @@ void CDLTMessageAnalyzer::setMainTableView( QTableView* pMainTableView )
 void CDLTMessageAnalyzer::configurationChanged()
 {
     mSearchRange.isFiltered = false; // reset filtering of range
+
+    if(nullptr != mpFile)
+    {
+        // filter of the dlt-viewer might have changed
+        mpFile->invalidateFilteredIndex();
+    }
     cancel();
 }
 
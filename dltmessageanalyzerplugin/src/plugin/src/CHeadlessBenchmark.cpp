@@ -0,0 +1,466 @@
+/**
+ * @file    CHeadlessBenchmark.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CHeadlessBenchmark class
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "QDateTime"
+#include "QDir"
+#include "QElapsedTimer"
+#include "QFile"
+#include "QFileInfo"
+#include "QJsonArray"
+#include "QJsonDocument"
+#include "QJsonObject"
+#include "QSysInfo"
+#include "QTextStream"
+#include "QThread"
+
+#include "../api/CHeadlessBenchmark.hpp"
+#include "../api/CHeadlessSearch.hpp"
+
+#include "dltmessageanalyzerplugin.hpp"
+#include "common/OSHelper.hpp"
+#include "components/log/api/CLog.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+static const QString sBenchmarkCommandName = "benchmark";
+static const QString sDefaultReportFileName = "dma_benchmark_report.json";
+static const int sReportFormatVersion = 1;
+
+namespace
+{
+    struct tBenchmarkScenario
+    {
+        QString name;
+        QString regex;
+        bool bUML;
+        bool bPlotView;
+    };
+
+    // representative regexes, which cover the plain search and all kinds of the scripted regex groups
+    const std::vector<tBenchmarkScenario>& getBenchmarkScenarios()
+    {
+        static const std::vector<tBenchmarkScenario> sScenarios =
+        {
+            { "plain-text", "status=error", false, false },
+            { "grouped-view", "status=(?<GV_1>\\w+) code=(?<GV_2>\\d+)", false, false },
+            { "uml", "(?<UCL>Client\\d+): sent (?:(?<URT>RQ)|(?<URS>RP)) to (?<US>Service\\d+) - (?<UM>\\w+)\\((?<UA>.*?)\\)", true, false },
+            { "plot", "(?<PXU_CPUC_milliseconds>(?<PYU_CPUC_percents>(?<PARType_CPUC_LINEAR>(?<PXN_CPUC_Timestamp>(?<PYN_CPUC_CPUConsumption>cpu))))), "
+                      "(?<PXT_4yw2Mw2dw2Hw2mw2sw3f>(?<PXData_CPUC_1>[\\d]{4}-[\\d]{2}-[\\d]{2} [\\d]{2}:[\\d]{2}:[\\d]{2}[\\.]*[\\d]{0,3})),"
+                      "(?<PGN_CPUC_1>(?<PGMD_CPUC_1_AppName>App\\d+)),(?<PYData_CPUC_1>[\\d]+)", false, true }
+        };
+
+        return sScenarios;
+    }
+}
+
+static bool generateTrace( const CHeadlessBenchmark::tParameters& parameters,
+                           const QString& textFilePath,
+                           const QString& dltFilePath )
+{
+    bool bResult = false;
+
+    QFile textFile(textFilePath);
+
+    if(false == textFile.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+    {
+        SEND_ERR(QString("[CHeadlessBenchmark] Failed to open file \"%1\"!").arg(textFilePath));
+        return bResult;
+    }
+
+    std::mt19937 generator(parameters.seed);
+    std::uniform_int_distribution<int> uniformPayloadSize(parameters.minPayloadSize, parameters.maxPayloadSize);
+    std::normal_distribution<double> normalPayloadSize( ( parameters.minPayloadSize + parameters.maxPayloadSize ) / 2.0,
+                                                        qMax(1.0, ( parameters.maxPayloadSize - parameters.minPayloadSize ) / 6.0) );
+    std::uniform_int_distribution<int> messageKind(0, 9);
+    std::uniform_int_distribution<int> smallNumber(0, 15);
+    std::uniform_int_distribution<int> percents(0, 100);
+    std::uniform_int_distribution<int> symbol(0, 25);
+
+    static const char* sStatuses[] = { "ok", "ok", "ok", "warning", "error" };
+    std::uniform_int_distribution<int> status(0, static_cast<int>(sizeof(sStatuses)/sizeof(sStatuses[0])) - 1);
+
+    QTextStream stream(&textFile);
+    QString line;
+
+    for(int i = 0; i < parameters.numberOfMessages; ++i)
+    {
+        const int kind = messageKind(generator);
+
+        if(kind < 3)
+        {
+            line = QString("Client%1: sent %2 to Service%3 - method%4(arg%5)")
+                   .arg(smallNumber(generator))
+                   .arg(0 == smallNumber(generator) % 2 ? "RQ" : "RP")
+                   .arg(smallNumber(generator))
+                   .arg(smallNumber(generator))
+                   .arg(smallNumber(generator));
+        }
+        else if(kind < 5)
+        {
+            line = QString("cpu, 2024-05-24 18:%1:%2.%3,App%4,%5")
+                   .arg(i / 60000 % 60, 2, 10, QChar('0'))
+                   .arg(i / 1000 % 60, 2, 10, QChar('0'))
+                   .arg(i % 1000, 3, 10, QChar('0'))
+                   .arg(smallNumber(generator) % 4)
+                   .arg(percents(generator));
+        }
+        else
+        {
+            line = QString("status=%1 code=%2")
+                   .arg(sStatuses[status(generator)])
+                   .arg(smallNumber(generator));
+        }
+
+        const int payloadSize = CHeadlessBenchmark::ePayloadDistribution::eUniform == parameters.payloadDistribution ?
+                                uniformPayloadSize(generator) :
+                                qBound(parameters.minPayloadSize,
+                                       static_cast<int>(normalPayloadSize(generator)),
+                                       parameters.maxPayloadSize);
+
+        if(line.size() < payloadSize)
+        {
+            line.append(' ');
+
+            while(line.size() < payloadSize)
+            {
+                line.append(QChar('a' + symbol(generator)));
+            }
+        }
+
+        stream << line << '\n';
+    }
+
+    stream.flush();
+    textFile.close();
+
+    bResult = 1 == parameters.dltVersion ?
+              convertLogFileToDLTV1(textFilePath, dltFilePath) :
+              convertLogFileToDLTV2(textFilePath, dltFilePath);
+
+    return bResult;
+}
+
+static QJsonObject getDurationStatistics( CHeadlessSearch::tDurationsUs durationsUs )
+{
+    QJsonObject result;
+
+    result["count"] = static_cast<qint64>(durationsUs.size());
+
+    if(false == durationsUs.empty())
+    {
+        std::sort(durationsUs.begin(), durationsUs.end());
+
+        // nearest-rank percentile
+        auto getPercentile = [&durationsUs](int percentile)->qint64
+        {
+            const std::size_t rank = ( durationsUs.size() * static_cast<std::size_t>(percentile) + 99u ) / 100u;
+            return durationsUs[ rank > 0u ? rank - 1u : 0u ];
+        };
+
+        qint64 sum = 0;
+
+        for(const auto& duration : durationsUs)
+        {
+            sum += duration;
+        }
+
+        result["minUs"] = durationsUs.front();
+        result["p50Us"] = getPercentile(50);
+        result["p90Us"] = getPercentile(90);
+        result["p99Us"] = getPercentile(99);
+        result["maxUs"] = durationsUs.back();
+        result["meanUs"] = sum / static_cast<qint64>(durationsUs.size());
+    }
+
+    return result;
+}
+
+static qint64 getPeakRSSSizeUnchecked()
+{
+    uint64_t result = 0u;
+    return true == getPeakRSSSize(result) ? static_cast<qint64>(result) : -1;
+}
+
+//CHeadlessBenchmark
+CHeadlessBenchmark::CHeadlessBenchmark( const tSettingsManagerPtr& pSettingsManager,
+                                        const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator ):
+CSettingsManagerClient(pSettingsManager),
+mpDLTLogsWrapperCreator(pDLTLogsWrapperCreator)
+{}
+
+bool CHeadlessBenchmark::run( const tParameters& parameters )
+{
+    bool bResult = false;
+
+    if(nullptr == getSettingsManager() || nullptr == mpDLTLogsWrapperCreator)
+    {
+        SEND_ERR("[CHeadlessBenchmark] Benchmark is not possible without settings manager and logs wrapper!");
+        return bResult;
+    }
+
+    const QDir workingDirectory(parameters.workingDirectory.isEmpty() ? QDir::tempPath() : parameters.workingDirectory);
+    const QString baseName = QString("dma_benchmark_%1_%2").arg(parameters.numberOfMessages).arg(parameters.seed);
+    const QString textFilePath = workingDirectory.filePath(baseName + ".txt");
+    const QString dltFilePath = workingDirectory.filePath(baseName + ".dlt");
+    const QString reportFilePath = parameters.reportFilePath.isEmpty() ?
+                                   workingDirectory.filePath(sDefaultReportFileName) :
+                                   parameters.reportFilePath;
+
+    SEND_MSG(QString("[CHeadlessBenchmark] Generating trace with %1 messages ...").arg(parameters.numberOfMessages));
+
+    QElapsedTimer generationTimer;
+    generationTimer.start();
+
+    if(false == generateTrace(parameters, textFilePath, dltFilePath))
+    {
+        SEND_ERR("[CHeadlessBenchmark] Failed to generate the trace!");
+        QFile::remove(textFilePath);
+        QFile::remove(dltFilePath);
+        return bResult;
+    }
+
+    const qint64 generationDurationMs = generationTimer.elapsed();
+    const int numberOfThreads = parameters.numberOfThreads > 0 ? parameters.numberOfThreads : QThread::idealThreadCount();
+
+    QJsonArray scenarios;
+    bResult = true;
+
+    for(const auto& scenario : getBenchmarkScenarios())
+    {
+        SEND_MSG(QString("[CHeadlessBenchmark] Running scenario \"%1\" ...").arg(scenario.name));
+
+        CHeadlessSearch::tParameters searchParameters;
+        searchParameters.paths.append(dltFilePath);
+        searchParameters.regex = scenario.regex;
+        searchParameters.numberOfThreads = numberOfThreads;
+        searchParameters.bWriteJSONLines = false;
+        searchParameters.bUMLFeatureActive = scenario.bUML;
+        searchParameters.bPlotViewFeatureActive = scenario.bPlotView;
+
+        CHeadlessSearch::tDurationsUs indexingDurationsUs;
+        CHeadlessSearch::tDurationsUs analysisDurationsUs;
+        CHeadlessSearch::tDurationsUs chunkLatenciesUs;
+        qint64 numberOfMessages = 0;
+        qint64 numberOfMatches = 0;
+        qint64 analysisDurationUs = 0;
+
+        for(int iteration = 0; iteration < qMax(1, parameters.numberOfIterations); ++iteration)
+        {
+            CHeadlessSearch headlessSearch(getSettingsManager(), mpDLTLogsWrapperCreator);
+            const auto searchResult = headlessSearch.run(searchParameters);
+
+            if(false == searchResult.bIsSuccessful)
+            {
+                SEND_ERR(QString("[CHeadlessBenchmark] Scenario \"%1\" failed!").arg(scenario.name));
+                bResult = false;
+                break;
+            }
+
+            numberOfMessages += searchResult.numberOfMessages;
+            numberOfMatches += searchResult.numberOfMatches;
+
+            for(const auto& duration : searchResult.analysisDurationsUs)
+            {
+                analysisDurationUs += duration;
+            }
+
+            indexingDurationsUs.insert(indexingDurationsUs.end(), searchResult.indexingDurationsUs.begin(), searchResult.indexingDurationsUs.end());
+            analysisDurationsUs.insert(analysisDurationsUs.end(), searchResult.analysisDurationsUs.begin(), searchResult.analysisDurationsUs.end());
+            chunkLatenciesUs.insert(chunkLatenciesUs.end(), searchResult.chunkLatenciesUs.begin(), searchResult.chunkLatenciesUs.end());
+        }
+
+        const double analysisDurationSec = static_cast<double>(qMax<qint64>(analysisDurationUs, 1)) / 1000000.0;
+
+        QJsonObject stages;
+        stages["indexing"] = getDurationStatistics(indexingDurationsUs);
+        stages["analysis"] = getDurationStatistics(analysisDurationsUs);
+        stages["chunkDelivery"] = getDurationStatistics(chunkLatenciesUs);
+
+        QJsonObject scenarioObject;
+        scenarioObject["name"] = scenario.name;
+        scenarioObject["regex"] = scenario.regex;
+        scenarioObject["successful"] = bResult;
+        scenarioObject["messages"] = numberOfMessages;
+        scenarioObject["matches"] = numberOfMatches;
+        scenarioObject["messagesPerSecond"] = static_cast<double>(numberOfMessages) / analysisDurationSec;
+        scenarioObject["matchesPerSecond"] = static_cast<double>(numberOfMatches) / analysisDurationSec;
+        scenarioObject["stages"] = stages;
+        scenarios.append(scenarioObject);
+
+        SEND_MSG(QString("[CHeadlessBenchmark] Scenario \"%1\": %2 messages/s; %3 matches/s")
+                 .arg(scenario.name)
+                 .arg(static_cast<qint64>(static_cast<double>(numberOfMessages) / analysisDurationSec))
+                 .arg(static_cast<qint64>(static_cast<double>(numberOfMatches) / analysisDurationSec)));
+
+        if(false == bResult)
+        {
+            break;
+        }
+    }
+
+    QJsonObject trace;
+    trace["messages"] = parameters.numberOfMessages;
+    trace["minPayloadSize"] = parameters.minPayloadSize;
+    trace["maxPayloadSize"] = parameters.maxPayloadSize;
+    trace["payloadDistribution"] = ePayloadDistribution::eUniform == parameters.payloadDistribution ? "uniform" : "normal";
+    trace["seed"] = static_cast<qint64>(parameters.seed);
+    trace["dltVersion"] = parameters.dltVersion;
+    trace["fileSize"] = QFileInfo(dltFilePath).size();
+    trace["generationDurationMs"] = generationDurationMs;
+
+    QJsonObject environment;
+    environment["pluginVersion"] = DLT_MESSAGE_ANALYZER_PLUGIN_VERSION;
+    environment["qtVersion"] = qVersion();
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["cpuArchitecture"] = QSysInfo::currentCpuArchitecture();
+    environment["idealThreadCount"] = QThread::idealThreadCount();
+    environment["threads"] = numberOfThreads;
+    environment["umlFeatureActive"] = getSettingsManager()->getUML_FeatureActive();
+    environment["plotViewFeatureActive"] = getSettingsManager()->getPlotViewFeatureActive();
+
+    QJsonObject report;
+    report["formatVersion"] = sReportFormatVersion;
+    report["label"] = parameters.label;
+    report["dateTime"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["successful"] = bResult;
+    report["environment"] = environment;
+    report["trace"] = trace;
+    report["iterations"] = qMax(1, parameters.numberOfIterations);
+    report["scenarios"] = scenarios;
+    report["peakRSSKb"] = getPeakRSSSizeUnchecked();
+
+    QFile::remove(textFilePath);
+    QFile::remove(dltFilePath);
+
+    QFile reportFile(reportFilePath);
+
+    if(true == reportFile.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        reportFile.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+        reportFile.close();
+        SEND_MSG(QString("[CHeadlessBenchmark] Report was written to \"%1\"").arg(reportFilePath));
+    }
+    else
+    {
+        SEND_ERR(QString("[CHeadlessBenchmark] Failed to write the report to \"%1\"!").arg(reportFilePath));
+        bResult = false;
+    }
+
+    return bResult;
+}
+
+CConsoleInputProcessor::tScenarioData CHeadlessBenchmark::createScenarioData( const tSettingsManagerPtr& pSettingsManager,
+                                                                              const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator )
+{
+    return CConsoleInputProcessor::tScenarioData([pSettingsManager, pDLTLogsWrapperCreator](const CConsoleInputProcessor::tParamMap& params)
+    {
+        bool bResult = false;
+        bool bParamsOk = true;
+
+        auto getIntParam = [&params, &bParamsOk](const QString& paramName, int defaultValue, int minValue)->int
+        {
+            int result = defaultValue;
+            auto foundParam = params.find(paramName);
+
+            if(foundParam != params.end())
+            {
+                bool bConverted = false;
+                result = foundParam->second.toInt(&bConverted);
+
+                if(false == bConverted || result < minValue)
+                {
+                    SEND_ERR(QString("Command [%1]: Wrong value '%2' was passed for the parameter '%3'!")
+                             .arg(sBenchmarkCommandName)
+                             .arg(foundParam->second)
+                             .arg(paramName));
+                    bParamsOk = false;
+                }
+            }
+
+            return result;
+        };
+
+        auto getStringParam = [&params](const QString& paramName)->QString
+        {
+            auto foundParam = params.find(paramName);
+            return foundParam != params.end() ? foundParam->second : QString();
+        };
+
+        CHeadlessBenchmark::tParameters parameters;
+        parameters.numberOfMessages = getIntParam("m", parameters.numberOfMessages, 1);
+        parameters.minPayloadSize = getIntParam("pmin", parameters.minPayloadSize, 0);
+        parameters.maxPayloadSize = getIntParam("pmax", parameters.maxPayloadSize, parameters.minPayloadSize);
+        parameters.seed = static_cast<unsigned int>(getIntParam("seed", static_cast<int>(parameters.seed), 0));
+        parameters.numberOfIterations = getIntParam("i", parameters.numberOfIterations, 1);
+        parameters.numberOfThreads = getIntParam("t", parameters.numberOfThreads, 0);
+        parameters.workingDirectory = getStringParam("d");
+        parameters.reportFilePath = getStringParam("o");
+        parameters.label = getStringParam("label");
+
+        const QString payloadDistribution = getStringParam("pd").toLower();
+
+        if(payloadDistribution == "normal")
+        {
+            parameters.payloadDistribution = CHeadlessBenchmark::ePayloadDistribution::eNormal;
+        }
+        else if(false == payloadDistribution.isEmpty() && payloadDistribution != "uniform")
+        {
+            SEND_ERR(QString("Command [%1]: Wrong value '%2' was passed for the parameter 'pd'! "
+                             "Supported values are 'uniform' and 'normal'.")
+                     .arg(sBenchmarkCommandName)
+                     .arg(payloadDistribution));
+            bParamsOk = false;
+        }
+
+        const QString version = getStringParam("v").toLower();
+
+        if(version == "v1")
+        {
+            parameters.dltVersion = 1;
+        }
+        else if(false == version.isEmpty() && version != "v2")
+        {
+            SEND_ERR(QString("Command [%1]: Wrong value '%2' was passed for the parameter 'v'! "
+                             "Supported values are 'v1' and 'v2'.")
+                     .arg(sBenchmarkCommandName)
+                     .arg(version));
+            bParamsOk = false;
+        }
+
+        if(true == bParamsOk)
+        {
+            CHeadlessBenchmark headlessBenchmark(pSettingsManager, pDLTLogsWrapperCreator);
+            bResult = headlessBenchmark.run(parameters);
+        }
+
+        return bResult;
+    },
+    "- generates the synthetic dlt trace, runs the representative regexes over it and writes the throughput, "
+    "latency percentiles and peak RSS to the JSON report"
+    "[-m=<messages> // optional! Number of messages in the trace. Default value is 100000]"
+    "[-pmin=<size> // optional! Min payload size. Default value is 20]"
+    "[-pmax=<size> // optional! Max payload size. Default value is 200]"
+    "[-pd=<distribution> // optional! Payload size distribution. Supported values are 'uniform' and 'normal'. Default value is 'uniform']"
+    "[-seed=<seed> // optional! Seed of the trace generator. Default value is 42]"
+    "[-v=<version> // optional! Version of the dlt protocol. Supported values are 'v1' and 'v2'. Default value is 'v2']"
+    "[-i=<iterations> // optional! Number of runs of each regex. Default value is 3]"
+    "[-t=<threads> // optional! Number of analysis threads. Default value is the number of the CPU cores]"
+    "[-d=<directory> // optional! Directory for the generated trace. Default value is the temporary directory]"
+    "[-o=<report-file> // optional! Report file. Default value is 'dma_benchmark_report.json' in the trace directory]"
+    "[-label=<label> // optional! Label, e.g. commit id, which is stored in the report]");
+}
+
+PUML_PACKAGE_BEGIN(DMA_Plugin_API)
+    PUML_CLASS_BEGIN_CHECKED(CHeadlessBenchmark)
+        PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
+        PUML_AGGREGATION_DEPENDENCY_CHECKED(IDLTLogsWrapperCreator, 1, 1, uses)
+        PUML_USE_DEPENDENCY_CHECKED(CHeadlessSearch, 1, *, creates)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()
@@ -0,0 +1,759 @@
+/**
+ * @file    CHeadlessSearch.cpp
+ * @author  vgoncharuk
+ * @brief   Implementation of the CHeadlessSearch class
+ */
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include "QDateTime"
+#include "QDir"
+#include "QFile"
+#include "QFileInfo"
+#include "QThread"
+#include "QTimer"
+#include "QEventLoop"
+#include "QElapsedTimer"
+#include "QJsonArray"
+#include "QJsonDocument"
+#include "QJsonObject"
+
+#include "qdlt.h"
+
+#include "../api/CHeadlessSearch.hpp"
+
+#include "components/analyzer/api/IDLTMessageAnalyzerControllerConsumer.hpp"
+#include "components/analyzer/src/CMTAnalyzer.hpp"
+#include "components/logsWrapper/api/IDLTLogsWrapperCreator.hpp"
+#include "components/logsWrapper/api/IFileWrapper.hpp"
+#include "components/logsWrapper/api/IMsgWrapper.hpp"
+#include "components/log/api/CLog.hpp"
+
+#include "DMA_Plantuml.hpp"
+
+static const QString sSearchCommandName = "search";
+static const QString sPathsSeparator = ";";
+static const QString sDltFilesNameFilter = "*.dlt";
+
+/**
+ * @brief The CHeadlessSearchConsumer class - consumer of the analysis results of a single file
+ */
+class CHeadlessSearchConsumer : public IDLTMessageAnalyzerControllerConsumer
+{
+public:
+    typedef std::function<void(const tProgressNotificationData&)> tProgressHandler;
+
+    CHeadlessSearchConsumer( const std::weak_ptr<IDLTMessageAnalyzerController>& pController,
+                             const tProgressHandler& progressHandler ):
+    IDLTMessageAnalyzerControllerConsumer(pController),
+    mProgressHandler(progressHandler)
+    {}
+
+    tRequestId startAnalysis( const tRequestParameters& requestParameters,
+                              bool bUMLFeatureActive,
+                              bool bPlotViewFeatureActive )
+    {
+        // grouped view data is always parsed to be able to provide the grouped statistics
+        return requestAnalyze(requestParameters, bUMLFeatureActive, bPlotViewFeatureActive, true);
+    }
+
+    void progressNotification( const tProgressNotificationData& progressNotificationData ) override
+    {
+        if(mProgressHandler)
+        {
+            mProgressHandler(progressNotificationData);
+        }
+    }
+
+private:
+    tProgressHandler mProgressHandler;
+};
+
+/**
+ * @brief The CJSONLinesWriter class - writes the JSON objects to the stdout or to the file. One object per line.
+ * Disabled writer silently drops all objects.
+ */
+class CJSONLinesWriter
+{
+public:
+    bool open( const QString& outputFilePath, bool bEnabled )
+    {
+        bool bResult = false;
+
+        mbEnabled = bEnabled;
+
+        if(false == mbEnabled)
+        {
+            bResult = true;
+        }
+        else if(true == outputFilePath.isEmpty())
+        {
+            bResult = mOutput.open(stdout, QIODevice::WriteOnly);
+        }
+        else
+        {
+            mOutput.setFileName(outputFilePath);
+            bResult = mOutput.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        }
+
+        return bResult;
+    }
+
+    void write( const QJsonObject& object )
+    {
+        if(true == mbEnabled)
+        {
+            mOutput.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+            mOutput.write("\n");
+        }
+    }
+
+    void flush()
+    {
+        if(true == mbEnabled)
+        {
+            mOutput.flush();
+        }
+    }
+
+private:
+    QFile mOutput;
+    bool mbEnabled = true;
+};
+
+typedef std::vector<QString> tGroupKey;
+
+struct tGroupStatistics
+{
+    int messages = 0;
+    qint64 payload = 0;
+};
+
+typedef std::map<tGroupKey, tGroupStatistics> tGroupStatisticsMap;
+
+struct tFileSearchData
+{
+    QString filePath;
+    std::unique_ptr<QDltFile> pDltFile;
+    tFileWrapperPtr pFile;
+    std::shared_ptr<CHeadlessSearchConsumer> pConsumer;
+    tRequestId requestId = INVALID_REQUEST_ID;
+    int numberOfMatches = 0;
+    tGroupStatisticsMap groupStatisticsMap;
+    QElapsedTimer timer;
+    qint64 analysisStartUs = 0;
+    qint64 lastNotificationUs = 0;
+};
+
+typedef std::shared_ptr<tFileSearchData> tFileSearchDataPtr;
+
+/**
+ * @brief parseTime - parses the border of the time window.
+ * ECU timestamp is expected as a number of seconds, e.g. "1234.5678".
+ * Storage time is expected as a local date-time, e.g. "2024-01-31 12:00:00.123", or as a number of seconds since epoch.
+ * @return - true, if the value was parsed. False otherwise
+ */
+static bool parseTime( const QString& value, const eTimeSource& timeSource, int64_t& timeUs )
+{
+    bool bResult = false;
+
+    const double seconds = value.toDouble(&bResult);
+
+    if(true == bResult)
+    {
+        timeUs = static_cast<int64_t>( seconds * 1000000.0 );
+    }
+    else if(eTimeSource::eStorageTime == timeSource)
+    {
+        static const QStringList sDateTimeFormats = { "yyyy-MM-dd hh:mm:ss.zzz",
+                                                      "yyyy-MM-dd hh:mm:ss",
+                                                      "yyyy/MM/dd hh:mm:ss.zzz",
+                                                      "yyyy/MM/dd hh:mm:ss" };
+
+        for(const auto& format : sDateTimeFormats)
+        {
+            const auto dateTime = QDateTime::fromString(value, format);
+
+            if(true == dateTime.isValid())
+            {
+                timeUs = dateTime.toMSecsSinceEpoch() * 1000;
+                bResult = true;
+                break;
+            }
+        }
+    }
+
+    return bResult;
+}
+
+static QStringList collectFiles( const QStringList& paths )
+{
+    QStringList result;
+
+    for(const auto& path : paths)
+    {
+        QFileInfo fileInfo(path);
+
+        if(true == fileInfo.isDir())
+        {
+            const auto entries = QDir(path).entryInfoList(QStringList(sDltFilesNameFilter), QDir::Files, QDir::Name);
+
+            for(const auto& entry : entries)
+            {
+                result.append(entry.absoluteFilePath());
+            }
+        }
+        else
+        {
+            result.append(path);
+        }
+    }
+
+    return result;
+}
+
+static QJsonObject createMatchObject( const QString& filePath,
+                                      const tFoundMatchesPackItem& foundMatchesPackItem,
+                                      const tFileWrapperPtr& pFile )
+{
+    const auto& itemMetadata = foundMatchesPackItem.getItemMetadata();
+    const auto& foundMatches = foundMatchesPackItem.getFoundMatches();
+
+    QJsonObject result;
+    result["type"] = "match";
+    result["file"] = filePath;
+    result["index"] = itemMetadata.msgIdxInMainTable;
+    result["msgId"] = itemMetadata.msgId;
+    result["timestamp"] = static_cast<qint64>(itemMetadata.timeStamp);
+
+    auto pMsg = pFile->getMsg(itemMetadata.msgId);
+
+    if(nullptr != pMsg)
+    {
+        result["ecuId"] = pMsg->getEcuid();
+        result["apId"] = pMsg->getApid();
+        result["ctxId"] = pMsg->getCtid();
+        result["payload"] = pMsg->getPayload();
+    }
+
+    QJsonArray groups;
+
+    for(const auto& foundMatch : foundMatches.foundMatchesVec)
+    {
+        QJsonObject group;
+        group["group"] = foundMatch.idx;
+        group["value"] = foundMatch.matchStr;
+        groups.append(group);
+    }
+
+    result["groups"] = groups;
+
+    return result;
+}
+
+static void updateGroupStatistics( const tGroupedViewIndices& groupedViewIndices,
+                                   const tFoundMatches& foundMatches,
+                                   tGroupStatisticsMap& groupStatisticsMap )
+{
+    // keys are ordered in the same way, in which the grouped view builds its tree
+    std::map<tGroupedViewIdx, QString> sortingMap;
+
+    for(const auto& foundMatch : foundMatches.foundMatchesVec)
+    {
+        auto foundIndex = groupedViewIndices.find(foundMatch.idx);
+
+        if(foundIndex != groupedViewIndices.end())
+        {
+            sortingMap.insert(std::make_pair(foundIndex->second, foundMatch.matchStr));
+        }
+    }
+
+    tGroupKey groupKey;
+    groupKey.reserve(sortingMap.size());
+
+    for(const auto& sortingItem : sortingMap)
+    {
+        groupKey.push_back(sortingItem.second);
+
+        auto& groupStatistics = groupStatisticsMap[groupKey];
+        ++groupStatistics.messages;
+        groupStatistics.payload += foundMatches.msgSizeBytes;
+    }
+}
+
+//CHeadlessSearch
+CHeadlessSearch::CHeadlessSearch( const tSettingsManagerPtr& pSettingsManager,
+                                  const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator ):
+CSettingsManagerClient(pSettingsManager),
+mpDLTLogsWrapperCreator(pDLTLogsWrapperCreator)
+{}
+
+CHeadlessSearch::tResult CHeadlessSearch::run( const tParameters& parameters )
+{
+    tResult result;
+
+    if(nullptr == getSettingsManager() || nullptr == mpDLTLogsWrapperCreator)
+    {
+        SEND_ERR("[CHeadlessSearch] Search is not possible without settings manager and logs wrapper!");
+        return result;
+    }
+
+    QString regexStr = parameters.regex;
+    QStringList selectedAliases;
+
+    if(true == regexStr.isEmpty())
+    {
+        const auto& aliases = getSettingsManager()->getAliases();
+
+        for(const auto& alias : parameters.aliases)
+        {
+            auto foundAlias = aliases.find(alias);
+
+            if(foundAlias == aliases.end())
+            {
+                SEND_ERR(QString("[CHeadlessSearch] Pattern with alias \"%1\" was not found in the selected regex configuration!").arg(alias));
+                return result;
+            }
+
+            if(false == regexStr.isEmpty())
+            {
+                regexStr.append("|");
+            }
+
+            regexStr.append(foundAlias->regex);
+            selectedAliases.append(alias);
+        }
+    }
+
+    if(true == regexStr.isEmpty())
+    {
+        SEND_ERR("[CHeadlessSearch] Search regex is empty!");
+        return result;
+    }
+
+    auto caseSensitiveOption = getSettingsManager()->getCaseSensitiveRegex() ?
+                QRegularExpression::NoPatternOption:
+                QRegularExpression::CaseInsensitiveOption;
+
+    QRegularExpression regex(addRegexOptions(regexStr), caseSensitiveOption);
+
+    if(false == regex.isValid())
+    {
+        SEND_ERR(QString("[CHeadlessSearch] Regex error: %1").arg(getFormattedRegexError(regex)));
+        return result;
+    }
+
+    regex.optimize();
+
+    const QStringList files = collectFiles(parameters.paths);
+
+    if(true == files.isEmpty())
+    {
+        SEND_ERR("[CHeadlessSearch] No files to analyze!");
+        return result;
+    }
+
+    CJSONLinesWriter writer;
+
+    if(false == writer.open(parameters.outputFilePath, parameters.bWriteJSONLines))
+    {
+        SEND_ERR(QString("[CHeadlessSearch] Failed to open the output \"%1\"!").arg(parameters.outputFilePath));
+        return result;
+    }
+
+    // the thread budget is shared between the files, which are analyzed at the same time
+    const int numberOfThreads = parameters.numberOfThreads > 0 ? parameters.numberOfThreads : QThread::idealThreadCount();
+    const int numberOfParallelFiles = qMin( files.size(),
+                                            parameters.numberOfParallelFiles > 0 ?
+                                            qMin(parameters.numberOfParallelFiles, numberOfThreads) :
+                                            numberOfThreads );
+    const int numberOfThreadsPerFile = qMax(1, numberOfThreads / numberOfParallelFiles);
+
+    auto pController = IDLTMessageAnalyzerController::createInstance<CMTAnalyzer>(getSettingsManager(), numberOfThreads);
+
+    const auto searchColumns = getSettingsManager()->getSearchResultColumnsSearchMap();
+
+    std::deque<QString> pendingFiles(files.begin(), files.end());
+    std::map<tRequestId, tFileSearchDataPtr> activeFiles;
+    QEventLoop eventLoop;
+
+    result.bIsSuccessful = true;
+
+    auto finishFile = [&writer, &result](const tFileSearchDataPtr& pFileSearchData, bool bIsSuccessful)
+    {
+        for(const auto& groupStatisticsItem : pFileSearchData->groupStatisticsMap)
+        {
+            QJsonArray path;
+
+            for(const auto& key : groupStatisticsItem.first)
+            {
+                path.append(key);
+            }
+
+            QJsonObject group;
+            group["type"] = "group";
+            group["file"] = pFileSearchData->filePath;
+            group["path"] = path;
+            group["messages"] = groupStatisticsItem.second.messages;
+            group["payload"] = groupStatisticsItem.second.payload;
+            writer.write(group);
+        }
+
+        QJsonObject file;
+        file["type"] = "file";
+        file["file"] = pFileSearchData->filePath;
+        file["status"] = bIsSuccessful ? "ok" : "error";
+        file["messages"] = nullptr != pFileSearchData->pFile ? pFileSearchData->pFile->size() : 0;
+        file["matches"] = pFileSearchData->numberOfMatches;
+        file["durationMs"] = pFileSearchData->timer.elapsed();
+        writer.write(file);
+        writer.flush();
+
+        if(true == bIsSuccessful)
+        {
+            ++result.numberOfAnalyzedFiles;
+
+            if(nullptr != pFileSearchData->pFile)
+            {
+                result.numberOfMessages += pFileSearchData->pFile->size();
+            }
+        }
+        else
+        {
+            ++result.numberOfFailedFiles;
+            result.bIsSuccessful = false;
+        }
+    };
+
+    std::function<void()> startNextFiles;
+
+    startNextFiles = [&]()
+    {
+        while(static_cast<int>(activeFiles.size()) < numberOfParallelFiles &&
+              false == pendingFiles.empty())
+        {
+            auto pFileSearchData = std::make_shared<tFileSearchData>();
+            pFileSearchData->filePath = pendingFiles.front();
+            pendingFiles.pop_front();
+            pFileSearchData->timer.start();
+
+            pFileSearchData->pDltFile = std::unique_ptr<QDltFile>(new QDltFile());
+
+            if(false == pFileSearchData->pDltFile->open(pFileSearchData->filePath) ||
+               false == pFileSearchData->pDltFile->createIndex())
+            {
+                SEND_ERR(QString("[CHeadlessSearch] Failed to open file \"%1\"!").arg(pFileSearchData->filePath));
+                finishFile(pFileSearchData, false);
+                continue;
+            }
+
+            pFileSearchData->pFile = mpDLTLogsWrapperCreator->createDLTFileWrapper(pFileSearchData->pDltFile.get());
+            pFileSearchData->analysisStartUs = pFileSearchData->timer.nsecsElapsed() / 1000;
+            pFileSearchData->lastNotificationUs = pFileSearchData->analysisStartUs;
+            result.indexingDurationsUs.push_back(pFileSearchData->analysisStartUs);
+
+            if(0 == pFileSearchData->pFile->size())
+            {
+                finishFile(pFileSearchData, true);
+                continue;
+            }
+
+            int fromMessage = 0;
+            int numberOfMessages = pFileSearchData->pFile->size();
+
+            if(true == parameters.timeRange.isSet)
+            {
+                // the range is passed down to the analysis, so that the time window is not resolved twice
+                const auto timeRangeMessages = pFileSearchData->pFile->getMainTableRangeFromTimeRange(parameters.timeRange);
+
+                if(timeRangeMessages.to < timeRangeMessages.from)
+                {
+                    // nothing to analyze in this file
+                    finishFile(pFileSearchData, true);
+                    continue;
+                }
+
+                fromMessage = timeRangeMessages.from;
+                numberOfMessages = timeRangeMessages.to - timeRangeMessages.from + 1;
+            }
+
+            tFileSearchData* pRawFileSearchData = pFileSearchData.get();
+
+            auto progressHandler = [&, pRawFileSearchData](const tProgressNotificationData& progressNotificationData)
+            {
+                auto foundActiveFile = activeFiles.find(progressNotificationData.requestId);
+
+                if(foundActiveFile == activeFiles.end() ||
+                   foundActiveFile->second.get() != pRawFileSearchData)
+                {
+                    return;
+                }
+
+                const qint64 notificationUs = pRawFileSearchData->timer.nsecsElapsed() / 1000;
+                result.chunkLatenciesUs.push_back(notificationUs - pRawFileSearchData->lastNotificationUs);
+                pRawFileSearchData->lastNotificationUs = notificationUs;
+
+                for(const auto& pFoundMatchesPackItem : progressNotificationData.processedMatches.matchedItemVec)
+                {
+                    ++pRawFileSearchData->numberOfMatches;
+
+                    if(false == parameters.bStatisticsOnly)
+                    {
+                        writer.write(createMatchObject(pRawFileSearchData->filePath,
+                                                       *pFoundMatchesPackItem,
+                                                       pRawFileSearchData->pFile));
+                    }
+
+                    if(false == progressNotificationData.groupedViewIndices.empty())
+                    {
+                        updateGroupStatistics(progressNotificationData.groupedViewIndices,
+                                              pFoundMatchesPackItem->getFoundMatches(),
+                                              pRawFileSearchData->groupStatisticsMap);
+                    }
+                }
+
+                if(eRequestState::PROGRESS != progressNotificationData.requestState)
+                {
+                    result.numberOfMatches += pRawFileSearchData->numberOfMatches;
+                    result.analysisDurationsUs.push_back(notificationUs - pRawFileSearchData->analysisStartUs);
+                    finishFile(foundActiveFile->second, eRequestState::SUCCESSFUL == progressNotificationData.requestState);
+
+                    // the handler belongs to the consumer of the erased file, thus everything else is posted
+                    auto pFinishedFileSearchData = foundActiveFile->second;
+                    activeFiles.erase(foundActiveFile);
+
+                    QTimer::singleShot(0, &eventLoop, [&, pFinishedFileSearchData]()
+                    {
+                        Q_UNUSED(pFinishedFileSearchData)
+                        startNextFiles();
+                    });
+                }
+            };
+
+            pFileSearchData->pConsumer = IDLTMessageAnalyzerControllerConsumer::createInstance<CHeadlessSearchConsumer>(pController, progressHandler);
+
+            tRequestParameters requestParameters( pFileSearchData->pFile,
+                                                  fromMessage,
+                                                  numberOfMessages,
+                                                  regex,
+                                                  numberOfThreadsPerFile,
+                                                  false,
+                                                  searchColumns,
+                                                  regexStr,
+                                                  selectedAliases );
+
+            pFileSearchData->requestId = pFileSearchData->pConsumer->startAnalysis(requestParameters,
+                                                                                   parameters.bUMLFeatureActive,
+                                                                                   parameters.bPlotViewFeatureActive);
+
+            if(INVALID_REQUEST_ID == pFileSearchData->requestId)
+            {
+                SEND_ERR(QString("[CHeadlessSearch] Failed to start analysis of the file \"%1\"!").arg(pFileSearchData->filePath));
+                finishFile(pFileSearchData, false);
+                continue;
+            }
+
+            activeFiles.insert(std::make_pair(pFileSearchData->requestId, pFileSearchData));
+        }
+
+        if(true == activeFiles.empty() && true == pendingFiles.empty())
+        {
+            eventLoop.quit();
+        }
+    };
+
+    QTimer::singleShot(0, &eventLoop, startNextFiles);
+    eventLoop.exec();
+
+    QJsonObject summary;
+    summary["type"] = "summary";
+    summary["regex"] = regexStr;
+    summary["files"] = result.numberOfAnalyzedFiles + result.numberOfFailedFiles;
+    summary["failedFiles"] = result.numberOfFailedFiles;
+    summary["matches"] = result.numberOfMatches;
+    summary["threads"] = numberOfThreads;
+    summary["parallelFiles"] = numberOfParallelFiles;
+    writer.write(summary);
+    writer.flush();
+
+    return result;
+}
+
+CConsoleInputProcessor::tScenarioData CHeadlessSearch::createScenarioData( const tSettingsManagerPtr& pSettingsManager,
+                                                                           const std::shared_ptr<IDLTLogsWrapperCreator>& pDLTLogsWrapperCreator )
+{
+    return CConsoleInputProcessor::tScenarioData([pSettingsManager, pDLTLogsWrapperCreator](const CConsoleInputProcessor::tParamMap& params)
+    {
+        bool bResult = false;
+
+        auto getIntParam = [&params](const QString& paramName, int defaultValue, bool& bOk)->int
+        {
+            int result = defaultValue;
+            auto foundParam = params.find(paramName);
+
+            if(foundParam != params.end())
+            {
+                bool bConverted = false;
+                result = foundParam->second.toInt(&bConverted);
+
+                if(false == bConverted)
+                {
+                    bOk = false;
+                    SEND_ERR(QString("Command [%1]: Wrong value '%2' was passed for the parameter '%3'!")
+                             .arg(sSearchCommandName)
+                             .arg(foundParam->second)
+                             .arg(paramName));
+                }
+            }
+
+            return result;
+        };
+
+        auto foundFilesParam = params.find("f");
+
+        if(foundFilesParam == params.end() || true == foundFilesParam->second.isEmpty())
+        {
+            SEND_ERR(QString("Command [%1]: required parameter \"f\" not found!").arg(sSearchCommandName));
+            return bResult;
+        }
+
+        CHeadlessSearch::tParameters parameters;
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+        parameters.paths = foundFilesParam->second.split(sPathsSeparator, QString::SplitBehavior::SkipEmptyParts);
+#else
+        parameters.paths = foundFilesParam->second.split(sPathsSeparator, Qt::SkipEmptyParts);
+#endif
+
+        auto foundRegexParam = params.find("r");
+
+        if(foundRegexParam != params.end())
+        {
+            parameters.regex = foundRegexParam->second;
+        }
+
+        auto foundAliasesParam = params.find("p");
+
+        if(foundAliasesParam != params.end())
+        {
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+            parameters.aliases = foundAliasesParam->second.split(sPathsSeparator, QString::SplitBehavior::SkipEmptyParts);
+#else
+            parameters.aliases = foundAliasesParam->second.split(sPathsSeparator, Qt::SkipEmptyParts);
+#endif
+        }
+
+        if(true == parameters.regex.isEmpty() && true == parameters.aliases.isEmpty())
+        {
+            SEND_ERR(QString("Command [%1]: one of the parameters \"r\" or \"p\" should be provided!").arg(sSearchCommandName));
+            return bResult;
+        }
+
+        auto foundOutputParam = params.find("o");
+
+        if(foundOutputParam != params.end())
+        {
+            parameters.outputFilePath = foundOutputParam->second;
+        }
+
+        parameters.bStatisticsOnly = params.find("s") != params.end();
+
+        bool bParamsOk = true;
+        parameters.numberOfThreads = getIntParam("t", 0, bParamsOk);
+        parameters.numberOfParallelFiles = getIntParam("pf", 0, bParamsOk);
+        const int minMatches = getIntParam("min", 1, bParamsOk);
+        const int maxMatches = getIntParam("max", -1, bParamsOk);
+
+        auto foundFromTimeParam = params.find("from");
+        auto foundToTimeParam = params.find("to");
+
+        if(foundFromTimeParam != params.end() || foundToTimeParam != params.end())
+        {
+            auto& timeRange = parameters.timeRange;
+            timeRange.isSet = true;
+            timeRange.timeSource = params.find("ecu") != params.end() ? eTimeSource::eECUTimestamp : eTimeSource::eStorageTime;
+            timeRange.from = std::numeric_limits<int64_t>::min();
+            timeRange.to = std::numeric_limits<int64_t>::max();
+
+            auto parseTimeParam = [&timeRange, &bParamsOk](const CConsoleInputProcessor::tParamMap::const_iterator& foundParam, int64_t& timeUs)
+            {
+                if(false == parseTime(foundParam->second, timeRange.timeSource, timeUs))
+                {
+                    bParamsOk = false;
+                    SEND_ERR(QString("Command [%1]: Wrong value '%2' was passed for the parameter '%3'!")
+                             .arg(sSearchCommandName)
+                             .arg(foundParam->second)
+                             .arg(foundParam->first));
+                }
+            };
+
+            if(foundFromTimeParam != params.end())
+            {
+                parseTimeParam(foundFromTimeParam, timeRange.from);
+            }
+
+            if(foundToTimeParam != params.end())
+            {
+                parseTimeParam(foundToTimeParam, timeRange.to);
+            }
+        }
+
+        if(false == bParamsOk)
+        {
+            return bResult;
+        }
+
+        CHeadlessSearch headlessSearch(pSettingsManager, pDLTLogsWrapperCreator);
+        const auto searchResult = headlessSearch.run(parameters);
+
+        if(false == searchResult.bIsSuccessful)
+        {
+            SEND_ERR(QString("Command [%1]: %2 file(s) failed to be analyzed!")
+                     .arg(sSearchCommandName)
+                     .arg(searchResult.numberOfFailedFiles));
+        }
+        else if(searchResult.numberOfMatches < minMatches ||
+                ( maxMatches >= 0 && searchResult.numberOfMatches > maxMatches ))
+        {
+            SEND_ERR(QString("Command [%1]: %2 match(es) found, which is out of the expected range!")
+                     .arg(sSearchCommandName)
+                     .arg(searchResult.numberOfMatches));
+        }
+        else
+        {
+            SEND_MSG(QString("Command [%1]: %2 match(es) found in %3 file(s)")
+                     .arg(sSearchCommandName)
+                     .arg(searchResult.numberOfMatches)
+                     .arg(searchResult.numberOfAnalyzedFiles));
+            bResult = true;
+        }
+
+        return bResult;
+    },
+    "- runs the search over the dlt files and streams the found matches and the grouped view statistics in form of JSON-lines. "
+    "Fails, if any file was not analyzed or if the number of matches is out of the expected range"
+    "[-f=<files> // mandatory! ';'-separated list of dlt files or directories with dlt files]"
+    "[-r=<regex> // regex to search with. Has priority over the 'p' parameter]"
+    "[-p=<aliases> // ';'-separated list of the pattern aliases from the selected regex configuration]"
+    "[-t=<threads> // optional! Overall number of analysis threads. Default value is the number of the CPU cores]"
+    "[-pf=<parallel-files> // optional! Number of files, which are analyzed at the same time. Default value is the number of threads]"
+    "[-o=<output-file> // optional! File, into which the JSON-lines are written. Default value is stdout]"
+    "[-s // optional! Write only the statistics, without the found matches]"
+    "[-min=<min-matches> // optional! Minimal expected number of matches. Default value is 1]"
+    "[-max=<max-matches> // optional! Maximal expected number of matches. By default is not limited]"
+    "[-from=<time> // optional! Start of the time window, e.g. '2024-01-31 12:00:00.000' or seconds since epoch. By default is not limited]"
+    "[-to=<time> // optional! End of the time window. By default is not limited]"
+    "[-ecu // optional! Time window is specified in seconds of the ECU timestamp, instead of the storage time]");
+}
+
+PUML_PACKAGE_BEGIN(DMA_Plugin_API)
+    PUML_CLASS_BEGIN_CHECKED(CHeadlessSearch)
+        PUML_INHERITANCE_CHECKED(CSettingsManagerClient, extends)
+        PUML_AGGREGATION_DEPENDENCY_CHECKED(IDLTLogsWrapperCreator, 1, 1, uses)
+        PUML_USE_DEPENDENCY_CHECKED(CMTAnalyzer, 1, 1, creates)
+    PUML_CLASS_END()
+PUML_PACKAGE_END()